@@ -25,6 +25,7 @@
 #include <NovusTypes.h>
 #include <robin_hood.h>
 #include "../../../Loaders/NDBC/NDBC.h"
+#include "../../../Utils/MemoryMappedFile.h"
 
 struct NDBCSingleton
 {
@@ -36,9 +37,15 @@ struct NDBCSingleton
 		_loadedNDBCFileNames.push_back(name);
 
 		NDBC::File& file = _nameHashToDBCFile[stringHash];
-		file.GetBuffer() = new DynamicBytebuffer(size);
 		file.GetStringTable() = new StringTable();
 
+		// Files loaded from disk are mapped instead, they only get a buffer once the editor saves them
+		if (size > 0)
+		{
+			file.GetBuffer() = new DynamicBytebuffer(size);
+			file.SetData(file.GetBuffer()->GetDataPointer());
+		}
+
 		return file;
 	}
 
@@ -54,6 +61,7 @@ struct NDBCSingleton
 
 		delete file.GetBuffer();
 		delete file.GetStringTable();
+		file.GetMappedFile().reset();
 
 		for (std::vector<std::string>::iterator fileNameItr = _loadedNDBCFileNames.begin(); fileNameItr != _loadedNDBCFileNames.end(); fileNameItr++)
 		{
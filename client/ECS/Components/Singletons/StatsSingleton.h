@@ -8,16 +8,18 @@ struct EngineStatsSingleton
         f32 deltaTime;
         f32 simulationFrameTime;
         f32 renderFrameTime;
+        f32 renderWaitTime; // Time the game thread spent waiting on the render thread, always 0 when rendering serially
     };
 
     std::deque<Frame> frameStats;
 
-    void AddTimings(f32 deltaTime, f32 simulationTime, f32 renderTime)
+    void AddTimings(f32 deltaTime, f32 simulationTime, f32 renderTime, f32 renderWaitTime)
     {
         Frame newFrame;
         newFrame.deltaTime = deltaTime;
         newFrame.renderFrameTime = renderTime;
         newFrame.simulationFrameTime = simulationTime;
+        newFrame.renderWaitTime = renderWaitTime;
 
         //dont allow more than 120 frames stored
         if (frameStats.size() > 120)
@@ -48,17 +50,19 @@ struct EngineStatsSingleton
                 averaged.deltaTime += f.deltaTime;
                 averaged.renderFrameTime += f.renderFrameTime;
                 averaged.simulationFrameTime += f.simulationFrameTime;
+                averaged.renderWaitTime += f.renderWaitTime;
             }
 
             averaged.deltaTime /= count;
             averaged.renderFrameTime /= count;
             averaged.simulationFrameTime /= count;
+            averaged.renderWaitTime /= count;
 
             return averaged;
         }
         else
         {
-            return Frame{ 0.f,0.f,0.f };
+            return Frame{ 0.f,0.f,0.f,0.f };
         }
     }
 };
\ No newline at end of file
@@ -25,9 +25,11 @@
 #include <NovusTypes.h>
 #include <Containers/StringTable.h>
 
+#include "../../../Loaders/Texture/TextureManifest.h"
+
 struct TextureSingleton
 {
 	TextureSingleton() {}
 
-	std::unordered_map<u32, std::string> textureHashToPath;
+	TextureManifest textureManifest;
 };
@@ -0,0 +1,96 @@
+#include "SystemScheduler.h"
+#include <taskflow/taskflow.hpp>
+
+SystemScheduler::System& SystemScheduler::System::WriteEntities()
+{
+    AddAccess(AccessType::Entities, _registry, nullptr, true);
+    return *this;
+}
+
+SystemScheduler::System& SystemScheduler::System::Exclusive()
+{
+    _isExclusive = true;
+    return *this;
+}
+
+bool SystemScheduler::System::ConflictsWith(const System& other) const
+{
+    if (_isExclusive || other._isExclusive)
+        return true;
+
+    for (const Access& access : _accesses)
+    {
+        for (const Access& otherAccess : other._accesses)
+        {
+            if (access.type != otherAccess.type || access.owner != otherAccess.owner || access.key != otherAccess.key)
+                continue;
+
+            // Concurrent reads are fine, anything involving a write is not
+            if (access.isWrite || otherAccess.isWrite)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void SystemScheduler::System::AddAccess(AccessType type, const void* owner, const void* key, bool isWrite)
+{
+    for (Access& access : _accesses)
+    {
+        if (access.type == type && access.owner == owner && access.key == key)
+        {
+            access.isWrite |= isWrite;
+            return;
+        }
+    }
+
+    _accesses.push_back({ type, owner, key, isWrite });
+}
+
+SystemScheduler::System& SystemScheduler::AddSystem(const std::string& name, entt::registry& registry, std::function<void()>&& func)
+{
+    return _systems.emplace_back(name, &registry, std::move(func));
+}
+
+SystemScheduler::System& SystemScheduler::AddSystem(const std::string& name, std::function<void()>&& func)
+{
+    return _systems.emplace_back(name, nullptr, std::move(func));
+}
+
+void SystemScheduler::Build(tf::Framework& framework)
+{
+    size_t numSystems = _systems.size();
+
+    std::vector<tf::Task> tasks;
+    tasks.reserve(numSystems);
+
+    // ancestors[i][j] is true if system i already (transitively) waits for system j
+    std::vector<std::vector<bool>> ancestors(numSystems, std::vector<bool>(numSystems, false));
+
+    for (size_t i = 0; i < numSystems; i++)
+    {
+        System& system = _systems[i];
+
+        tf::Task& task = tasks.emplace_back(framework.emplace(std::move(system._func)));
+        task.name(system._name);
+
+        // Walk backwards so the closest conflicting systems are added first, edges that are already implied by them are skipped
+        for (size_t j = i; j-- > 0;)
+        {
+            if (ancestors[i][j] || !system.ConflictsWith(_systems[j]))
+                continue;
+
+            task.gather(tasks[j]);
+
+            ancestors[i][j] = true;
+            for (size_t k = 0; k < j; k++)
+            {
+                if (ancestors[j][k])
+                    ancestors[i][k] = true;
+            }
+        }
+    }
+
+    _systems.clear();
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <NovusTypes.h>
+#include <entt.hpp>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace tf
+{
+    class Framework;
+}
+
+// Builds the update framework out of systems that declare what they read and write
+// Systems are added in the order they would run if everything ran sequentially, a system then only waits for the earlier systems it conflicts with
+class SystemScheduler
+{
+public:
+    enum class AccessType : u8
+    {
+        Component,
+        Singleton,
+        Entities,
+        Resource
+    };
+
+    struct Access
+    {
+        AccessType type;
+        const void* owner; // The registry for components, singletons and entities, nullptr for resources
+        const void* key;
+        bool isWrite;
+    };
+
+    class System
+    {
+    public:
+        System(const std::string& name, entt::registry* registry, std::function<void()>&& func) : _name(name), _registry(registry), _func(std::move(func)) { }
+
+        // Components accessed through views, get or all_of, writing also covers emplace, remove and clear of that component
+        template <typename... Components>
+        System& Read()
+        {
+            (AddComponentAccess<Components>(false), ...);
+            return *this;
+        }
+
+        template <typename... Components>
+        System& Write()
+        {
+            (AddComponentAccess<Components>(true), ...);
+            return *this;
+        }
+
+        // Singletons stored in the registry context
+        template <typename... Singletons>
+        System& ReadSingleton()
+        {
+            (AddAccess(AccessType::Singleton, _registry, GetTypeKey<Singletons>(), false), ...);
+            return *this;
+        }
+
+        template <typename... Singletons>
+        System& WriteSingleton()
+        {
+            (AddAccess(AccessType::Singleton, _registry, GetTypeKey<Singletons>(), true), ...);
+            return *this;
+        }
+
+        // Anything living outside of the registries, like cameras, renderers or ImGui
+        template <typename... Resources>
+        System& ReadResource()
+        {
+            (AddAccess(AccessType::Resource, nullptr, GetTypeKey<Resources>(), false), ...);
+            return *this;
+        }
+
+        template <typename... Resources>
+        System& WriteResource()
+        {
+            (AddAccess(AccessType::Resource, nullptr, GetTypeKey<Resources>(), true), ...);
+            return *this;
+        }
+
+        // Creating or destroying entities touches every pool in the registry, so this conflicts with all component access in the same registry
+        System& WriteEntities();
+
+        // The system calls into code we can't reason about (network handlers, scripts) and has to run on its own
+        System& Exclusive();
+
+        bool ConflictsWith(const System& other) const;
+
+        const std::string& GetName() const { return _name; }
+
+    private:
+        template <typename T>
+        static const void* GetTypeKey()
+        {
+            static const u8 key = 0;
+            return &key;
+        }
+
+        template <typename Component>
+        void AddComponentAccess(bool isWrite)
+        {
+            // Pools are created lazily on first access which modifies the registry itself, make sure they exist before systems start running concurrently
+            _registry->reserve<Component>(0);
+
+            AddAccess(AccessType::Component, _registry, GetTypeKey<Component>(), isWrite);
+            AddAccess(AccessType::Entities, _registry, nullptr, false);
+        }
+
+        void AddAccess(AccessType type, const void* owner, const void* key, bool isWrite);
+
+    private:
+        std::string _name;
+        entt::registry* _registry = nullptr;
+        std::function<void()> _func;
+
+        std::vector<Access> _accesses;
+        bool _isExclusive = false;
+
+        friend class SystemScheduler;
+    };
+
+    // The returned reference is only meant for chaining the access declarations
+    System& AddSystem(const std::string& name, entt::registry& registry, std::function<void()>&& func);
+    System& AddSystem(const std::string& name, std::function<void()>&& func);
+
+    // Emplaces one task per system into the framework and derives the dependencies between them
+    void Build(tf::Framework& framework);
+
+private:
+    std::deque<System> _systems;
+};
@@ -23,6 +23,7 @@
 #include <Gameplay/ECS/Components/Movement.h>
 
 #include <InputManager.h>
+#include <CVar/CVarSystem.h>
 #include <entt.hpp>
 #include <glm/gtx/rotate_vector.hpp>
 #include <glm/gtx/euler_angles.hpp>
@@ -252,13 +253,14 @@ void MovementSystem::Update(entt::registry& registry)
             bool isGrounded = false;
             f32 timeToCollide = 0;
 
-            //vec3 triangleNormal;
-            //f32 triangleSteepness = 0;
-            bool willCollide = false;// PhysicsUtils::CheckCollisionForCModels(currentMap, movement, localplayerCModelInfo, triangleNormal, triangleSteepness, timeToCollide);
+            vec3 triangleNormal;
+            f32 triangleSteepness = 0;
+            bool collisionEnabled = *CVarSystem::Get()->GetIntCVar("complexModels.collisionEnable"_h);
+            bool willCollide = collisionEnabled && PhysicsUtils::CheckCollisionForCModels(currentMap, movement, localplayerCModelInfo, triangleNormal, triangleSteepness, timeToCollide);
             if (willCollide)
             {
-                //transform.position += (movement.velocity * timeToCollide) * timeSingleton.deltaTime;
-                //isGrounded = triangleSteepness <= 50;
+                transform.position += (movement.velocity * timeToCollide) * timeSingleton.deltaTime;
+                isGrounded = triangleSteepness <= 50;
             }
             else
             {
@@ -65,6 +65,11 @@ void UpdateCModelInfoSystem::Update(entt::registry& registry)
                         entityList.erase(itr);
                     });
                 }
+
+                if (Terrain::ChunkCollisionBroadphase* broadphase = currentMap.GetCollisionBroadphaseByChunkID(cmodelInfo.currentChunkID))
+                {
+                    broadphase->isDirty = true;
+                }
             }
         }
 
@@ -86,6 +91,11 @@ void UpdateCModelInfoSystem::Update(entt::registry& registry)
                 {
                     collidableEntityList->PushBack(entity);
                 }
+
+                if (Terrain::ChunkCollisionBroadphase* broadphase = currentMap.GetCollisionBroadphaseByChunkID(chunkID))
+                {
+                    broadphase->isDirty = true;
+                }
             }
         }
 
@@ -27,6 +27,10 @@ void UpdateModelTransformSystem::Update(entt::registry& registry)
     {
         modelView.each([&](const auto entity, Transform& transform, ModelDisplayInfo& modelDisplayInfo)
         {
+            // The model is still loading, CModelRenderer marks the transform dirty again once it has an instance
+            if (modelDisplayInfo.instanceID == std::numeric_limits<u32>().max())
+                return;
+
             mat4x4& instanceMatrix = instanceMatrices[modelDisplayInfo.instanceID];
 
             // Update the instance
@@ -384,8 +384,8 @@ namespace Editor
                 Terrain::LayerData& layerData = cell->layers[i];
                 if (layerData.textureId != layerData.TextureIdInvalid)
                 {
-                    const std::string& texture = textureSingleton.textureHashToPath[layerData.textureId];
-                    ImGui::BulletText("Texture %u: %s", i, texture.c_str());
+                    const char* texture = textureSingleton.textureManifest.GetPath(layerData.textureId);
+                    ImGui::BulletText("Texture %u: %s", i, texture);
                     continue;
                 }
             }
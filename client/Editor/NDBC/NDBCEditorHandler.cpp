@@ -163,58 +163,77 @@ bool NDBCEditorHandler::SaveSelectedNDBC()
     fs::path ndbcPath = fs::absolute("Data/extracted/Ndbc");
     fs::path outputPath = (ndbcPath / ndbcName).replace_extension("ndbc");
 
-    std::ofstream output(outputPath, std::ofstream::out | std::ofstream::binary);
-    {
-        NDBC::File* file = ndbcSingleton.GetNDBCFile(ndbcNameHash);
+    NDBC::File* file = ndbcSingleton.GetNDBCFile(ndbcNameHash);
 
-        DynamicBytebuffer*& fileBuffer = file->GetBuffer();
-        DynamicBytebuffer* buffer = new DynamicBytebuffer(fileBuffer->size);
-        std::vector<NDBC::NDBCColumn>& columns = file->GetColumns();
+    DynamicBytebuffer*& fileBuffer = file->GetBuffer();
+    std::unique_ptr<MemoryMappedFile>& mappedFile = file->GetMappedFile();
 
-        buffer->Put<NDBC::NDBCHeader>(file->GetHeader());
+    size_t fileSize = mappedFile ? mappedFile->GetSize() : fileBuffer->size;
+    DynamicBytebuffer* buffer = new DynamicBytebuffer(fileSize);
+    std::vector<NDBC::NDBCColumn>& columns = file->GetColumns();
 
+    // Saving always writes the current layout, even if the file was loaded from an unindexed one
+    file->GetHeader().version = NDBC::NDBC_VERSION;
+    buffer->Put<NDBC::NDBCHeader>(file->GetHeader());
 
-        u32 numColumns = static_cast<u32>(columns.size());
-        buffer->Put<u32>(numColumns);
+    u32 numColumns = static_cast<u32>(columns.size());
+    buffer->Put<u32>(numColumns);
 
-        if (numColumns > 0)
+    if (numColumns > 0)
+    {
+        for (u32 i = 0; i < columns.size(); i++)
         {
-            for (u32 i = 0; i < columns.size(); i++)
-            {
-                NDBC::NDBCColumn& column = columns[i];
-                buffer->PutString(column.name.c_str());
-                buffer->PutU32(column.dataType);
-            }
+            NDBC::NDBCColumn& column = columns[i];
+            buffer->PutString(column.name.c_str());
+            buffer->PutU32(column.dataType);
         }
+    }
 
-        // Write numRows, Rows and Stringtable
-        u32 numRows = file->GetNumRows();
-        buffer->Put<u32>(numRows);
+    // Write numRows, Rows, the row index and the Stringtable
+    u32 numRows = file->GetNumRows();
+    buffer->Put<u32>(numRows);
 
-        if (numRows > 0)
-        {
-            size_t dataOffsetInOldBuffer = file->GetBufferOffsetToRowData();
-            u32 dataSize = (numColumns * 4) * numRows; // We always 4 byte align the columns which mean we can predict
+    // Rows are 4 byte aligned so the loader can use them in place
+    while (buffer->writtenData % 4 != 0)
+    {
+        buffer->Put<u8>(0);
+    }
 
-            file->SetBufferOffsetToRowData(buffer->writtenData);
-            buffer->PutBytes(&fileBuffer->GetDataPointer()[dataOffsetInOldBuffer], dataSize);
-        }
+    u32 rowSize = numColumns * 4; // We always 4 byte align the columns which mean we can predict
+    const u8* rows = &file->GetData()[file->GetBufferOffsetToRowData()];
+    size_t rowDataOffset = buffer->writtenData;
 
-        // Save StringTable "TODO: When we copy the Dynamic ByteBuffer we want to serialize the stringtable into the buffer and then do a single write into output
-        
-        if (!file->GetStringTable()->Serialize(buffer))
-        {
-            DebugHandler::PrintError("Failed to write StringTable during NDBCEditorHandler::SaveSelectedNDBC() for %s", _selectedNDBC);
-            return false;
-        }
+    if (numRows > 0)
+    {
+        u32 dataSize = rowSize * numRows;
+        buffer->PutBytes(const_cast<u8*>(rows), dataSize);
+    }
 
-        output.write(reinterpret_cast<char const*>(buffer->GetDataPointer()), buffer->writtenData);
-        output.close();
+    // The ids might have been edited, so the index is always rebuilt
+    size_t rowIndexOffset = buffer->writtenData;
+    NDBC::File::WriteRowIndex(buffer, rows, numRows, rowSize);
 
-        delete fileBuffer;
-        fileBuffer = buffer;
+    // Save StringTable "TODO: When we copy the Dynamic ByteBuffer we want to serialize the stringtable into the buffer and then do a single write into output
+    if (!file->GetStringTable()->Serialize(buffer))
+    {
+        DebugHandler::PrintError("Failed to write StringTable during NDBCEditorHandler::SaveSelectedNDBC() for %s", _selectedNDBC);
+        delete buffer;
+        return false;
     }
 
+    // The file can't be replaced while it is still mapped on every platform, so we switch over to the new buffer first
+    delete fileBuffer;
+    fileBuffer = buffer;
+    mappedFile.reset();
+
+    file->SetData(buffer->GetDataPointer());
+    file->SetBufferOffsetToRowData(rowDataOffset);
+    file->SetRowIndexOffset(rowIndexOffset);
+
+    std::ofstream output(outputPath, std::ofstream::out | std::ofstream::binary);
+    output.write(reinterpret_cast<char const*>(buffer->GetDataPointer()), buffer->writtenData);
+    output.close();
+
     return true;
 }
 
@@ -441,7 +460,7 @@ void NDBCEditorHandler::DrawDefaultLayout()
 
     u32 dbcNameHash = StringUtils::fnv1a_32(_selectedNDBC, strlen(_selectedNDBC));
     NDBC::File* file = ndbcSingleton.GetNDBCFile(dbcNameHash);
-    DynamicBytebuffer*& fileBuffer = file->GetBuffer();
+    u8* fileData = file->GetData();
     std::vector<NDBC::NDBCColumn>& columns = file->GetColumns();
 
     u32 numColumns = static_cast<u32>(columns.size());
@@ -479,12 +498,12 @@ void NDBCEditorHandler::DrawDefaultLayout()
             bool isFloat = column.dataType == 2;
             if (isFloat)
             {
-                f32* value = reinterpret_cast<f32*>(&fileBuffer->GetDataPointer()[file->GetBufferOffsetToRowData() + finalOffset]);
+                f32* value = reinterpret_cast<f32*>(&fileData[file->GetBufferOffsetToRowData() + finalOffset]);
                 ImGui::InputFloat("", value);
             }
             else
             {
-                i32* value = reinterpret_cast<i32*>(&fileBuffer->GetDataPointer()[file->GetBufferOffsetToRowData() + finalOffset]);
+                i32* value = reinterpret_cast<i32*>(&fileData[file->GetBufferOffsetToRowData() + finalOffset]);
                 ImGui::InputInt("", value);
             }
 
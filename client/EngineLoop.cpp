@@ -20,6 +20,7 @@
 #include "Rendering/RendertargetVisualizer.h"
 #include "Rendering/CameraFreelook.h"
 #include "Rendering/CameraOrbital.h"
+#include "Rendering/DebugRenderer.h"
 #include "Rendering/AnimationSystem/AnimationSystem.h"
 #include "Editor/Editor.h"
 #include "Window/Window.h"
@@ -38,6 +39,10 @@
 #include "ECS/Components/Singletons/ScriptSingleton.h"
 #include "ECS/Components/Singletons/ConfigSingleton.h"
 #include "ECS/Components/Singletons/LocalplayerSingleton.h"
+#include "ECS/Components/Singletons/MapSingleton.h"
+#include "ECS/Components/Singletons/NDBCSingleton.h"
+#include "ECS/Components/Singletons/DayNightSingleton.h"
+#include "ECS/Components/Singletons/AreaUpdateSingleton.h"
 #include "ECS/Components/Network/ConnectionSingleton.h"
 
 // Components
@@ -46,13 +51,28 @@
 #include "ECS/Components/Physics/Rigidbody.h"
 #include "ECS/Components/Rendering/DebugBox.h"
 #include "ECS/Components/Rendering/CModelInfo.h"
+#include "ECS/Components/Rendering/Collidable.h"
 #include "ECS/Components/Rendering/VisibleModel.h"
 #include "ECS/Components/Rendering/ModelDisplayInfo.h"
 
+#include "UI/ECS/Components/Singletons/UIDataSingleton.h"
+#include "UI/ECS/Components/Singletons/UICollisionGridSingleton.h"
 #include "UI/ECS/Components/Transform.h"
 #include "UI/ECS/Components/NotCulled.h"
+#include "UI/ECS/Components/Destroy.h"
+#include "UI/ECS/Components/Image.h"
+#include "UI/ECS/Components/Text.h"
+#include "UI/ECS/Components/InputField.h"
+#include "UI/ECS/Components/Relation.h"
+#include "UI/ECS/Components/Collision.h"
+#include "UI/ECS/Components/SortKey.h"
+#include "UI/ECS/Components/Dirty.h"
+#include "UI/ECS/Components/BoundsDirty.h"
+#include "UI/ECS/Components/SortKeyDirty.h"
+#include "UI/ECS/Components/LayoutDirty.h"
 
 // Systems
+#include "ECS/SystemScheduler.h"
 #include "ECS/Systems/Network/ConnectionSystems.h"
 #include "ECS/Systems/Rendering/UpdateModelTransformSystem.h"
 #include "ECS/Systems/Rendering/UpdateCModelInfoSystem.h"
@@ -62,6 +82,7 @@
 #include "ECS/Systems/DayNightSystem.h"
 
 #include "UI/ECS/Systems/DeleteElementsSystem.h"
+#include "UI/ECS/Systems/UpdateLayoutSystem.h"
 #include "UI/ECS/Systems/UpdateRenderingSystem.h"
 #include "UI/ECS/Systems/UpdateBoundsSystem.h"
 #include "UI/ECS/Systems/UpdateCullingSystem.h"
@@ -94,6 +115,7 @@
 
 AutoCVar_Int CVAR_FramerateLock("framerate.lock", "enable locking framerate", 1, CVarFlags::EditCheckbox);
 AutoCVar_Int CVAR_FramerateTarget("framerate.target", "target framerate", 60);
+AutoCVar_Int CVAR_RenderThreadEnabled("render.threadEnabled", "record the render graph on a separate thread while the next frame is simulated", 0, CVarFlags::EditCheckbox);
 
 
 EngineLoop::EngineLoop() : 
@@ -121,6 +143,7 @@ void EngineLoop::Start()
         return;
 
     ServiceLocator::SetMainInputQueue(&_inputQueue);
+    ServiceLocator::SetJobExecutor(_jobTaskflow.share_executor());
 
     std::thread threadRun = std::thread(&EngineLoop::Run, this);
     threadRun.detach();
@@ -167,16 +190,7 @@ bool EngineLoop::Init()
     LoaderSystem* loaderSystem = LoaderSystem::Get();
     loaderSystem->Init();
 
-    bool failedToLoad = false;
-    for (Loader* loader : loaderSystem->GetLoaders())
-    {
-        failedToLoad |= !loader->Init();
-
-        if (failedToLoad)
-            break;
-    }
-
-    if (failedToLoad)
+    if (!loaderSystem->Load())
         return false;
 
     // Create Cameras (Must happen before ClientRenderer is created)
@@ -322,6 +336,7 @@ void EngineLoop::Run()
     Timer timer;
     Timer updateTimer;
     Timer renderTimer;
+    Timer renderWaitTimer;
     
     EngineStatsSingleton::Frame timings;
     while (true)
@@ -335,25 +350,62 @@ void EngineLoop::Run()
         timeSingleton.lifeTimeInMS = timeSingleton.lifeTimeInS * 1000;
         timeSingleton.deltaTime = deltaTime;
 
+        bool useRenderThread = CVAR_RenderThreadEnabled.Get() == 1;
+        if (useRenderThread != _renderThread.joinable())
+        {
+            if (useRenderThread)
+                StartRenderThread();
+            else
+                StopRenderThread();
+        }
+
         updateTimer.Reset();
-        
-        if (!Update(deltaTime))
-            break;
+        timings.renderWaitTime = 0.0f;
+
+        if (useRenderThread)
+        {
+            // The simulation only touches game state, so it overlaps the render thread recording the previous frame
+            ImguiNewFrame();
+            UpdateSimulation();
+
+            renderWaitTimer.Reset();
+            WaitForRenderThread();
+            timings.renderWaitTime = renderWaitTimer.GetLifeTime();
+
+            // The render thread is idle now, this is the CPU time of the frame it just finished
+            timings.renderFrameTime = _renderThreadFrameTime;
+
+            if (!PollInput(deltaTime))
+                break;
+        }
+        else
+        {
+            if (!PollInput(deltaTime))
+                break;
+
+            ImguiNewFrame();
+            UpdateSimulation();
+        }
+
+        UpdateSync(deltaTime);
         
         DrawEngineStats(&statsSingleton);
         DrawImguiMenuBar();
         RendertargetVisualizer* rendertargetVisualizer = _clientRenderer->GetRendertargetVisualizer();
         rendertargetVisualizer->DrawImgui();
 
-        timings.simulationFrameTime = updateTimer.GetLifeTime();
+        timings.simulationFrameTime = updateTimer.GetLifeTime() - timings.renderWaitTime;
         
         renderTimer.Reset();
         
-        Render();
+        Render(useRenderThread);
         
-        timings.renderFrameTime = renderTimer.GetLifeTime();
+        if (!useRenderThread)
+        {
+            timings.renderFrameTime = renderTimer.GetLifeTime();
+        }
         
-        statsSingleton.AddTimings(timings.deltaTime, timings.simulationFrameTime, timings.renderFrameTime);
+        statsSingleton.AddTimings(timings.deltaTime, timings.simulationFrameTime, timings.renderFrameTime, timings.renderWaitTime);
 
         bool lockFrameRate = CVAR_FramerateLock.Get() == 1;
         if (lockFrameRate)
@@ -379,6 +431,8 @@ void EngineLoop::Run()
         FrameMark;
     }
 
+    StopRenderThread();
+
     // Clean up stuff here
     Message exitMessage;
     exitMessage.code = MSG_OUT_EXIT_CONFIRM;
@@ -390,14 +444,12 @@ void EngineLoop::Cleanup()
     NetworkUtils::DeInitNetwork(&_updateFramework.gameRegistry);
 }
 
-bool EngineLoop::Update(f32 deltaTime)
+bool EngineLoop::PollInput(f32 deltaTime)
 {
     bool shouldExit = _clientRenderer->UpdateWindow(deltaTime) == false;
     if (shouldExit)
         return false;
 
-    ImguiNewFrame();
-
     Message message;
     while (_inputQueue.try_dequeue(message))
     {
@@ -432,10 +484,22 @@ bool EngineLoop::Update(f32 deltaTime)
         }
     }
 
-    // Update Systems will modify the Camera, so we wait with updating the Camera 
-    // until we are sure it is static for the rest of the frame
-    UpdateSystems();
+    return true;
+}
 
+void EngineLoop::UpdateSimulation()
+{
+    ZoneScopedNC("UpdateSimulation", tracy::Color::DarkBlue);
+    RunFramework(_updateFramework.simulationFramework);
+}
+
+void EngineLoop::UpdateSync(f32 deltaTime)
+{
+    ZoneScopedNC("UpdateSync", tracy::Color::DarkBlue);
+    RunFramework(_updateFramework.syncFramework);
+
+    // The systems will modify the Camera, so we wait with updating the Camera 
+    // until we are sure it is static for the rest of the frame
     uvec2 renderResolution = _clientRenderer->GetRenderResolution();
 
     Camera* camera = ServiceLocator::GetCamera();
@@ -463,15 +527,12 @@ bool EngineLoop::Update(f32 deltaTime)
             configSingleton.uiConfig.ClearDirty();
         }
     }
-    
-    return true;
 }
-void EngineLoop::UpdateSystems()
+void EngineLoop::RunFramework(tf::Framework& framework)
 {
-    ZoneScopedNC("UpdateSystems", tracy::Color::DarkBlue)
     {
         ZoneScopedNC("Taskflow::Run", tracy::Color::DarkBlue)
-            _updateFramework.taskflow.run(_updateFramework.framework);
+            _updateFramework.taskflow.run(framework);
     }
     {
         ZoneScopedNC("Taskflow::WaitForAll", tracy::Color::DarkBlue)
@@ -479,17 +540,93 @@ void EngineLoop::UpdateSystems()
     }
 }
 
-void EngineLoop::Render()
+void EngineLoop::Render(bool useRenderThread)
 {
     ZoneScopedNC("EngineLoop::Render", tracy::Color::Red2)
 
     ImGui::Render();
-    _clientRenderer->Render();
+
+    TimeSingleton& timeSingleton = _updateFramework.gameRegistry.ctx<TimeSingleton>();
+    _clientRenderer->CaptureFrameSnapshot(timeSingleton.deltaTime);
+
+    if (useRenderThread)
+    {
+        KickRenderThread();
+    }
+    else
+    {
+        _clientRenderer->Render();
+    }
+}
+
+void EngineLoop::StartRenderThread()
+{
+    _renderThreadHasWork = false;
+    _renderThreadShouldExit = false;
+    _renderThread = std::thread(&EngineLoop::RenderThreadMain, this);
+}
+
+void EngineLoop::StopRenderThread()
+{
+    if (!_renderThread.joinable())
+        return;
+
+    {
+        std::unique_lock lock(_renderThreadMutex);
+        _renderThreadShouldExit = true;
+    }
+    _renderThreadCondition.notify_all();
+
+    // The render thread finishes the frame it was given before it exits
+    _renderThread.join();
+}
+
+void EngineLoop::KickRenderThread()
+{
+    {
+        std::unique_lock lock(_renderThreadMutex);
+        _renderThreadHasWork = true;
+    }
+    _renderThreadCondition.notify_all();
+}
+
+void EngineLoop::WaitForRenderThread()
+{
+    ZoneScopedNC("EngineLoop::WaitForRenderThread", tracy::Color::Red2);
+
+    std::unique_lock lock(_renderThreadMutex);
+    _renderThreadCondition.wait(lock, [this]() { return !_renderThreadHasWork; });
+}
+
+void EngineLoop::RenderThreadMain()
+{
+    tracy::SetThreadName("RenderThread");
+
+    Timer renderTimer;
+    while (true)
+    {
+        {
+            std::unique_lock lock(_renderThreadMutex);
+            _renderThreadCondition.wait(lock, [this]() { return _renderThreadHasWork || _renderThreadShouldExit; });
+
+            if (!_renderThreadHasWork)
+                break;
+        }
+
+        renderTimer.Reset();
+        _clientRenderer->Render();
+
+        {
+            std::unique_lock lock(_renderThreadMutex);
+            _renderThreadFrameTime = renderTimer.GetLifeTime();
+            _renderThreadHasWork = false;
+        }
+        _renderThreadCondition.notify_all();
+    }
 }
 
 void EngineLoop::SetupUpdateFramework()
 {
-    tf::Framework& framework = _updateFramework.framework;
     entt::registry& gameRegistry = _updateFramework.gameRegistry;
     entt::registry& uiRegistry = _updateFramework.uiRegistry;
 
@@ -497,137 +634,150 @@ void EngineLoop::SetupUpdateFramework()
     ServiceLocator::SetUIRegistry(&uiRegistry);
     SetupMessageHandler();
 
-    // ConnectionUpdateSystem
-    tf::Task connectionUpdateSystemTask = framework.emplace([&gameRegistry]()
+    // Systems are added in the order they would run sequentially, the scheduler only makes a system wait for earlier systems it conflicts with
+    // The simulation systems may run while the render thread records the previous frame, anything touching state the renderers read goes in the sync systems
+    SystemScheduler simulationScheduler;
+    SystemScheduler syncScheduler;
+
+    // MovementSystem
+    simulationScheduler.AddSystem("MovementSystem", gameRegistry, [&gameRegistry]()
+    {
+        ZoneScopedNC("MovementSystem::Update", tracy::Color::Blue2);
+        MovementSystem::Update(gameRegistry);
+    }).Read<ModelDisplayInfo, CModelInfo>()
+      .Write<Transform, Movement, TransformIsDirty>()
+      .ReadSingleton<TimeSingleton, MapSingleton, ConnectionSingleton>()
+      .WriteSingleton<LocalplayerSingleton>()
+      .ReadResource<InputManager, CModelRenderer>()
+      .WriteResource<Camera, DebugRenderer, AnimationSystem>();
+
+    // DayNightSystem
+    simulationScheduler.AddSystem("DayNightSystem", gameRegistry, [&gameRegistry]()
+    {
+        ZoneScopedNC("DayNightSystem::Update", tracy::Color::Blue2);
+        DayNightSystem::Update(gameRegistry);
+    }).ReadSingleton<TimeSingleton>()
+      .WriteSingleton<DayNightSingleton>()
+      .WriteResource<ImGuiContext>();
+
+    // AreaUpdateSystem
+    simulationScheduler.AddSystem("AreaUpdateSystem", gameRegistry, [&gameRegistry]()
+    {
+        ZoneScopedNC("AreaUpdateSystem::Update", tracy::Color::Blue2);
+        AreaUpdateSystem::Update(gameRegistry);
+    }).ReadSingleton<TimeSingleton, NDBCSingleton, DayNightSingleton>()
+      .WriteSingleton<AreaUpdateSingleton, MapSingleton>()
+      .ReadResource<Camera>();
+
+    // SimulateDebugCubeSystem
+    simulationScheduler.AddSystem("SimulateDebugCubeSystem", gameRegistry, [this, &gameRegistry]()
+    {
+        ZoneScopedNC("SimulateDebugCubeSystem::Update", tracy::Color::Blue2);
+        SimulateDebugCubeSystem::Update(gameRegistry, _clientRenderer->GetDebugRenderer());
+    }).Read<DebugBox>()
+      .Write<Transform, Rigidbody, TransformIsDirty>()
+      .ReadSingleton<TimeSingleton>()
+      .WriteResource<DebugRenderer>();
+
+    // UpdateCModelInfoSystem (The per chunk entity lists are SafeVectors, the map itself is only read)
+    simulationScheduler.AddSystem("UpdateCModelInfoSystem", gameRegistry, [&gameRegistry]()
+    {
+        ZoneScopedNC("UpdateCModelInfoSystem::Update", tracy::Color::Blue2);
+        UpdateCModelInfoSystem::Update(gameRegistry);
+    }).Read<Transform, TransformIsDirty, Collidable>()
+      .Write<CModelInfo>()
+      .ReadSingleton<MapSingleton>();
+
+    // UpdateModelTransformSystem
+    simulationScheduler.AddSystem("UpdateModelTransformSystem", gameRegistry, [&gameRegistry]()
+    {
+        ZoneScopedNC("UpdateModelTransformSystem::Update", tracy::Color::Blue2);
+        UpdateModelTransformSystem::Update(gameRegistry);
+        gameRegistry.clear<TransformIsDirty>();
+    }).Read<ModelDisplayInfo, VisibleModel, ModelIsReusedInstance, ModelCreatedThisFrame>()
+      .Write<Transform, TransformIsDirty>()
+      .WriteResource<CModelRenderer>();
+
+    simulationScheduler.Build(_updateFramework.simulationFramework);
+
+    // ConnectionUpdateSystem (Packet handlers can touch anything)
+    syncScheduler.AddSystem("ConnectionUpdateSystem", gameRegistry, [&gameRegistry]()
     {
         ZoneScopedNC("ConnectionUpdateSystem::Update", tracy::Color::Blue2);
         ConnectionUpdateSystem::Update(gameRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
+    }).Exclusive();
 
     /* UI SYSTEMS */
     // DeleteElementsSystem
-    /*tf::Task uiDeleteElementSystem = framework.emplace([&uiRegistry, &gameRegistry]()
+    syncScheduler.AddSystem("DeleteElementsSystem", uiRegistry, [&uiRegistry]()
     {
         ZoneScopedNC("DeleteElementsSystem::Update", tracy::Color::Gainsboro);
         UISystem::DeleteElementsSystem::Update(uiRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
+    }).Read<UIComponent::Destroy>()
+      .WriteSingleton<UISingleton::UIDataSingleton, UISingleton::UICollisionGridSingleton>()
+      .WriteEntities();
+
+    // UpdateLayoutSystem
+    syncScheduler.AddSystem("UpdateLayoutSystem", uiRegistry, [&uiRegistry]()
+    {
+        ZoneScopedNC("UpdateLayoutSystem::Update", tracy::Color::Gainsboro);
+        UISystem::UpdateLayoutSystem::Update(uiRegistry);
+    }).Read<UIComponent::Relation>()
+      .Write<UIComponent::Transform, UIComponent::LayoutDirty, UIComponent::Dirty, UIComponent::BoundsDirty>();
 
     // UpdateRenderingSystem
-    tf::Task uiUpdateRenderingSystem = framework.emplace([&uiRegistry, &gameRegistry]()
+    syncScheduler.AddSystem("UpdateRenderingSystem", uiRegistry, [&uiRegistry]()
     {
         ZoneScopedNC("UpdateRenderingSystem::Update", tracy::Color::Gainsboro);
         UISystem::UpdateRenderingSystem::Update(uiRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    uiUpdateRenderingSystem.gather(uiDeleteElementSystem);
+    }).Read<UIComponent::Transform, UIComponent::InputField, UIComponent::Dirty>()
+      .Write<UIComponent::Image, UIComponent::Text>()
+      .ReadSingleton<UISingleton::UIDataSingleton>()
+      .WriteResource<Renderer::Renderer>();
 
     // UpdateBoundsSystem
-    tf::Task uiUpdateBoundsSystemTask = framework.emplace([&uiRegistry, &gameRegistry]()
+    syncScheduler.AddSystem("UpdateBoundsSystem", uiRegistry, [&uiRegistry]()
     {
         ZoneScopedNC("UpdateBoundsSystem::Update", tracy::Color::Gainsboro);
         UISystem::UpdateBoundsSystem::Update(uiRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    uiUpdateRenderingSystem.gather(uiDeleteElementSystem);
+    }).Read<UIComponent::Transform, UIComponent::Relation, UIComponent::BoundsDirty>()
+      .Write<UIComponent::Collision>()
+      .WriteSingleton<UISingleton::UICollisionGridSingleton>();
 
     // UpdateCullingSystem
-    tf::Task uiUpdateCullingSystemTask = framework.emplace([&uiRegistry, &gameRegistry]()
+    syncScheduler.AddSystem("UpdateCullingSystem", uiRegistry, [&uiRegistry]()
     {
         ZoneScopedNC("UpdateCullingSystem::Update", tracy::Color::Gainsboro);
         UISystem::UpdateCullingSystem::Update(uiRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    uiUpdateRenderingSystem.gather(uiDeleteElementSystem);
-    
+    }).Read<UIComponent::Transform, UIComponent::Dirty>()
+      .Write<UIComponent::NotCulled>()
+      .ReadSingleton<UISingleton::UIDataSingleton>();
+
     // BuildSortKeySystem
-    tf::Task uiBuildSortKeySystemTask = framework.emplace([&uiRegistry, &gameRegistry]()
+    syncScheduler.AddSystem("BuildSortKeySystem", uiRegistry, [&uiRegistry]()
     {
         ZoneScopedNC("BuildSortKeySystem::Update", tracy::Color::Gainsboro);
         UISystem::BuildSortKeySystem::Update(uiRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    uiUpdateRenderingSystem.gather(uiDeleteElementSystem);
+    }).Read<UIComponent::Relation>()
+      .Write<UIComponent::SortKey, UIComponent::SortKeyDirty>()
+      .WriteSingleton<UISingleton::UICollisionGridSingleton>();
 
     // FinalCleanUpSystem
-    tf::Task uiFinalCleanUpSystemTask = framework.emplace([&uiRegistry, &gameRegistry]()
+    syncScheduler.AddSystem("FinalCleanUpSystem", uiRegistry, [&uiRegistry]()
     {
-        ZoneScopedNC("UpdateRenderingSystem::Update", tracy::Color::Gainsboro);
+        ZoneScopedNC("FinalCleanUpSystem::Update", tracy::Color::Gainsboro);
         UISystem::FinalCleanUpSystem::Update(uiRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    uiFinalCleanUpSystemTask.gather(uiUpdateRenderingSystem);
-    uiFinalCleanUpSystemTask.gather(uiUpdateCullingSystemTask);
-    uiFinalCleanUpSystemTask.gather(uiBuildSortKeySystemTask);*/
+    }).Write<UIComponent::Dirty, UIComponent::BoundsDirty, UIComponent::SortKeyDirty>();
     /* END UI SYSTEMS */
 
-    // MovementSystem
-    tf::Task movementSystemTask = framework.emplace([&gameRegistry]()
-    {
-        ZoneScopedNC("MovementSystem::Update", tracy::Color::Blue2);
-        MovementSystem::Update(gameRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    movementSystemTask.gather(connectionUpdateSystemTask);
-
-    // DayNightSystem
-    tf::Task dayNightSystemTask = framework.emplace([&gameRegistry]()
-    {
-        ZoneScopedNC("DayNightSystem::Update", tracy::Color::Blue2);
-        DayNightSystem::Update(gameRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    dayNightSystemTask.gather(movementSystemTask);
-
-    // AreaUpdateSystem
-    tf::Task areaUpdateSystemTask = framework.emplace([&gameRegistry]()
-    {
-        ZoneScopedNC("AreaUpdateSystem::Update", tracy::Color::Blue2);
-        AreaUpdateSystem::Update(gameRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    areaUpdateSystemTask.gather(dayNightSystemTask);
-
-    // SimulateDebugCubeSystem
-    tf::Task simulateDebugCubeSystemTask = framework.emplace([this, &gameRegistry]()
-    {
-        ZoneScopedNC("SimulateDebugCubeSystem::Update", tracy::Color::Blue2);
-        SimulateDebugCubeSystem::Update(gameRegistry, _clientRenderer->GetDebugRenderer());
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    simulateDebugCubeSystemTask.gather(areaUpdateSystemTask);
-
-    // UpdateCModelInfoSystem
-    tf::Task updateCModelInfoSystemTask = framework.emplace([this, &gameRegistry]()
-    {
-        ZoneScopedNC("UpdateCModelInfoSystem::Update", tracy::Color::Blue2);
-        UpdateCModelInfoSystem::Update(gameRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-    });
-    updateCModelInfoSystemTask.gather(simulateDebugCubeSystemTask);
-
-    // UpdateModelTransformSystem
-    tf::Task updateModelTransformSystemTask = framework.emplace([this, &gameRegistry]()
-    {
-        ZoneScopedNC("UpdateModelTransformSystem::Update", tracy::Color::Blue2);
-        UpdateModelTransformSystem::Update(gameRegistry);
-        //gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
-        gameRegistry.clear<TransformIsDirty>();
-    });
-    updateModelTransformSystemTask.gather(updateCModelInfoSystemTask);
-
     // ScriptSingletonTask
-    tf::Task scriptSingletonTask = framework.emplace([&uiRegistry, &gameRegistry]()
+    syncScheduler.AddSystem("ScriptSingletonTask", []()
     {
         ZoneScopedNC("ScriptSingletonTask::Update", tracy::Color::Blue2);
-
         ServiceLocator::GetScriptEngine()->Execute();
-        //gameRegistry.ctx<ScriptSingleton>().ExecuteTransactions();
-        //gameRegistry.ctx<ScriptSingleton>().ResetCompletedSystems();
-    });
-    //scriptSingletonTask.gather(uiFinalCleanUpSystemTask);
-    scriptSingletonTask.gather(updateModelTransformSystemTask);
+    }).Exclusive();
+
+    syncScheduler.Build(_updateFramework.syncFramework);
 }
 void EngineLoop::SetupMessageHandler()
 {
@@ -936,6 +1086,13 @@ void EngineLoop::DrawMapStats()
 
         if (ImGui::BeginTabItem("Basic Info"))
         {
+            TerrainRenderer* terrainRenderer = _clientRenderer->GetTerrainRenderer();
+            if (terrainRenderer->IsLoadingMap())
+            {
+                ImGui::Text("Loading Chunks");
+                ImGui::ProgressBar(terrainRenderer->GetMapLoadProgress());
+            }
+
             if (!mapIsLoaded)
             {
                 ImGui::Text("No Map Loaded");
@@ -1463,6 +1620,7 @@ void EngineLoop::DrawPerformance(EngineStatsSingleton* stats)
     {
         ImGui::Text("Update Time (ms) : %f", average.simulationFrameTime * 1000);
         ImGui::Text("Render Time CPU (ms): %f", average.renderFrameTime * 1000);
+        ImGui::Text("Render Wait Time (ms): %f", average.renderWaitTime * 1000);
 
         //read the frame buffer to gather timings for the histograms
         std::vector<float> updateTimes;
@@ -1471,10 +1629,14 @@ void EngineLoop::DrawPerformance(EngineStatsSingleton* stats)
         std::vector<float> renderTimes;
         renderTimes.reserve(stats->frameStats.size());
 
+        std::vector<float> renderWaitTimes;
+        renderWaitTimes.reserve(stats->frameStats.size());
+
         for (int i = 0; i < stats->frameStats.size(); i++)
         {
             updateTimes.push_back(stats->frameStats[i].simulationFrameTime * 1000);
             renderTimes.push_back(stats->frameStats[i].renderFrameTime * 1000);
+            renderWaitTimes.push_back(stats->frameStats[i].renderWaitTime * 1000);
         }
 
         ImPlot::SetNextPlotLimits(0.0, 120.0, 0, 33.0);
@@ -1485,9 +1647,70 @@ void EngineLoop::DrawPerformance(EngineStatsSingleton* stats)
         {
             ImPlot::PlotLine("Update Time", updateTimes.data(), (int)updateTimes.size());
             ImPlot::PlotLine("Render Time", renderTimes.data(), (int)renderTimes.size());
+            ImPlot::PlotLine("Render Wait Time", renderWaitTimes.data(), (int)renderWaitTimes.size());
             ImPlot::EndPlot();
         }
     }
+
+    // Pass Recording
+    {
+        const std::vector<ClientRenderer::PassRecordTiming>& passRecordTimings = _clientRenderer->GetPassRecordTimings();
+
+        f32 totalRecordTime = 0.0f;
+        for (const ClientRenderer::PassRecordTiming& timing : passRecordTimings)
+        {
+            totalRecordTime += timing.recordTime;
+        }
+
+        ImGui::Spacing();
+        bool showPassRecording = ImGui::CollapsingHeader("Pass Recording");
+
+        // With parallel recording the sum is CPU time spread over several threads, not how long recording took
+        ImGui::SameLine(windowWidth - ImGui::CalcTextSize("Total (ms): 00.000 (parallel)").x);
+        ImGui::Text("Total (ms): %.3f%s", totalRecordTime * 1000, _clientRenderer->WasRecordedInParallel() ? " (parallel)" : "");
+
+        if (showPassRecording)
+        {
+            for (const ClientRenderer::PassRecordTiming& timing : passRecordTimings)
+            {
+                ImGui::Text("%s", timing.name.c_str());
+
+                // Passes that were disabled in Setup don't get recorded at all
+                if (!timing.isExecuting)
+                {
+                    ImGui::SameLine(windowWidth - ImGui::CalcTextSize("disabled").x);
+                    ImGui::TextDisabled("disabled");
+                    continue;
+                }
+
+                ImGui::SameLine(windowWidth - ImGui::CalcTextSize("00.000").x);
+                ImGui::Text("%.3f", timing.recordTime * 1000);
+            }
+        }
+    }
+
+    // Descriptor Set Cache
+    {
+        u32 hits = _clientRenderer->GetNumDescriptorSetCacheHits();
+        u32 misses = _clientRenderer->GetNumDescriptorSetCacheMisses();
+        u32 binds = hits + misses;
+
+        f32 hitPercent = (binds > 0) ? (static_cast<f32>(hits) / static_cast<f32>(binds)) * 100 : 0.0f;
+
+        ImGui::Spacing();
+        bool showDescriptorSets = ImGui::CollapsingHeader("Descriptor Sets");
+
+        ImGui::SameLine(windowWidth - ImGui::CalcTextSize("Hits: 100.00%").x);
+        ImGui::Text("Hits: %.2f%%", hitPercent);
+
+        if (showDescriptorSets)
+        {
+            // Counted over the last frame, every miss allocated or rewrote a descriptor set
+            ImGui::Text("Cache Hits: %u", hits);
+            ImGui::Text("Cache Misses: %u", misses);
+            ImGui::Text("Cached Sets: %u", _clientRenderer->GetNumCachedDescriptorSets());
+        }
+    }
 }
 
 void EngineLoop::DrawCullingStatsEntry(std::string_view name, u32 drawCalls, u32 survivedDrawCalls, bool isCollapsed)
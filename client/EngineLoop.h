@@ -28,6 +28,9 @@
 #include <Utils/ConcurrentQueue.h>
 #include <taskflow/taskflow.hpp>
 #include <entity/fwd.hpp>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 
 namespace tf
@@ -44,7 +47,8 @@ struct FrameworkRegistryPair
 {
     entt::registry gameRegistry;
     entt::registry uiRegistry;
-    tf::Framework framework;
+    tf::Framework simulationFramework; // Only touches game state, runs while the render thread records the previous frame
+    tf::Framework syncFramework; // Touches state the renderers read from (UI, network, scripts), runs while the render thread is idle
     tf::Taskflow taskflow;
 };
 
@@ -79,9 +83,17 @@ private:
     void Run();
     void Cleanup();
 
-    bool Update(f32 deltaTime);
-    void UpdateSystems();
-    void Render();
+    bool PollInput(f32 deltaTime);
+    void UpdateSimulation();
+    void UpdateSync(f32 deltaTime);
+    void RunFramework(tf::Framework& framework);
+    void Render(bool useRenderThread);
+
+    void StartRenderThread();
+    void StopRenderThread();
+    void KickRenderThread();
+    void WaitForRenderThread();
+    void RenderThreadMain();
 
     void SetupUpdateFramework();
     void SetupMessageHandler();
@@ -103,7 +115,15 @@ private:
     moodycamel::ConcurrentQueue<Message> _inputQueue;
     moodycamel::ConcurrentQueue<Message> _outputQueue;
     FrameworkRegistryPair _updateFramework;
+    tf::Taskflow _jobTaskflow; // Only owns the executor that ServiceLocator::GetJobExecutor hands out
 
     ClientRenderer* _clientRenderer;
     Editor::Editor* _editor;
+
+    std::thread _renderThread;
+    std::mutex _renderThreadMutex;
+    std::condition_variable _renderThreadCondition;
+    bool _renderThreadHasWork = false;
+    bool _renderThreadShouldExit = false;
+    f32 _renderThreadFrameTime = 0.0f; // CPU time of the last frame the render thread finished
 };
\ No newline at end of file
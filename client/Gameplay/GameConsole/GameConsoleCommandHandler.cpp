@@ -14,6 +14,14 @@ GameConsoleCommandHandler::GameConsoleCommandHandler()
     RegisterCommand("storeloc"_h, GameConsoleCommands::HandleStoreLoc);
 
     RegisterCommand("morph"_h, GameConsoleCommands::HandleMorph);
+    RegisterCommand("mapbench"_h, GameConsoleCommands::HandleMapBenchmark);
+    RegisterCommand("collisionbench"_h, GameConsoleCommands::HandleCollisionBenchmark);
+    RegisterCommand("sweeptest"_h, GameConsoleCommands::HandleSweepTest);
+    RegisterCommand("uibench"_h, GameConsoleCommands::HandleUIHitTestBenchmark);
+    RegisterCommand("texstream"_h, GameConsoleCommands::HandleTextureStreaming);
+    RegisterCommand("texbench"_h, GameConsoleCommands::HandleTextureLookupBenchmark);
+    RegisterCommand("cmodelbench"_h, GameConsoleCommands::HandleCModelLoadBenchmark);
+    RegisterCommand("renderstats"_h, GameConsoleCommands::HandleRenderStats);
 }
 
 bool GameConsoleCommandHandler::HandleCommand(GameConsole* gameConsole, std::string& command)
@@ -12,6 +12,16 @@
 #include <Networking/NetStructures.h>
 #include "../../ECS/Components/Rendering/ModelDisplayInfo.h"
 #include "../../ECS/Components/Singletons/NDBCSingleton.h"
+#include "../../ECS/Components/Singletons/MapSingleton.h"
+#include "../../Utils/MapUtils.h"
+#include "../../Utils/PhysicsUtils.h"
+#include "../../UI/ECS/Components/Singletons/UIDataSingleton.h"
+#include "../../UI/Utils/ColllisionUtils.h"
+#include "../../Rendering/ClientRenderer.h"
+#include "../../Rendering/CModelRenderer.h"
+
+#include <Utils/Timer.h>
+#include <Renderer/Renderers/Null/RendererNull.h>
 
 bool GameConsoleCommands::HandleHelp(GameConsole* gameConsole, std::vector<std::string> subCommands)
 {
@@ -161,3 +171,327 @@ bool GameConsoleCommands::HandleMorph(GameConsole* gameConsole, std::vector<std:
 
 	return true;
 }
+
+bool GameConsoleCommands::HandleMapBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	if (subCommands.size() > 1)
+	{
+		gameConsole->PrintError("Incorrect Usage! (mapbench ('InternalName'))");
+		return true;
+	}
+
+	entt::registry* registry = ServiceLocator::GetGameRegistry();
+	MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
+
+	// Default to the map we are on
+	std::string mapInternalName;
+	if (subCommands.size() == 1)
+	{
+		mapInternalName = subCommands[0];
+	}
+	else
+	{
+		Terrain::Map& currentMap = mapSingleton.GetCurrentMap();
+		if (!currentMap.IsLoadedMap())
+		{
+			gameConsole->PrintError("No map loaded, specify one (mapbench 'InternalName')");
+			return true;
+		}
+
+		mapInternalName = std::string(currentMap.name);
+	}
+
+	// The map is loaded twice into a scratch map, the first pass is cold (unless the chunks were just loaded) and the second pass warm
+	f32 loadTimesMS[2] = { 0.0f, 0.0f };
+	size_t numChunks = 0;
+
+	for (u32 i = 0; i < 2; i++)
+	{
+		Terrain::Map benchmarkMap;
+
+		std::string nmapPath;
+		if (!Terrain::MapUtils::FindMapFiles(mapInternalName, benchmarkMap, nmapPath))
+		{
+			gameConsole->PrintError("Failed to find map files for (%s)", mapInternalName.c_str());
+			return true;
+		}
+
+		std::vector<u16> chunkIDs;
+		chunkIDs.reserve(benchmarkMap.chunkPaths.size());
+
+		for (const auto& chunkPath : benchmarkMap.chunkPaths)
+		{
+			chunkIDs.push_back(chunkPath.first);
+		}
+
+		Timer timer;
+		if (!Terrain::MapUtils::LoadChunks(benchmarkMap, chunkIDs))
+		{
+			gameConsole->PrintError("Failed to load chunks for (%s)", mapInternalName.c_str());
+			return true;
+		}
+
+		loadTimesMS[i] = timer.GetLifeTime() * 1000.0f;
+		numChunks = benchmarkMap.chunks.size();
+
+		benchmarkMap.Clear();
+	}
+
+	gameConsole->PrintSuccess("Map (%s) %u chunks, cold load: %.2f ms, warm load: %.2f ms", mapInternalName.c_str(), static_cast<u32>(numChunks), loadTimesMS[0], loadTimesMS[1]);
+	return true;
+}
+
+bool GameConsoleCommands::HandleCollisionBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	if (subCommands.size() > 1)
+	{
+		gameConsole->PrintError("Incorrect Usage! (collisionbench (numQueries))");
+		return true;
+	}
+
+	u32 numQueries = 10000;
+	if (subCommands.size() == 1)
+	{
+		numQueries = std::stoi(subCommands[0]);
+	}
+
+	PhysicsUtils::CModelSweepBenchmarkResult result;
+	if (!PhysicsUtils::BenchmarkCModelSweeps(numQueries, result))
+	{
+		gameConsole->PrintError("No complex model instances with collision loaded");
+		return true;
+	}
+
+	f32 bruteForceTimeUS = (result.bruteForceTimeMS * 1000.0f) / result.numQueries;
+	f32 bvhTimeUS = (result.bvhTimeMS * 1000.0f) / result.numQueries;
+
+	gameConsole->PrintSuccess("%u sweeps against %u instances (%u hits), brute force: %.2f ms (%.3f us/sweep), BVH: %.2f ms (%.3f us/sweep)", result.numQueries, result.numInstances, result.numHits, result.bruteForceTimeMS, bruteForceTimeUS, result.bvhTimeMS, bvhTimeUS);
+
+	if (result.numMismatches > 0)
+	{
+		gameConsole->PrintError("%u sweeps returned a different result through the BVH", result.numMismatches);
+	}
+
+	return true;
+}
+
+bool GameConsoleCommands::HandleSweepTest(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	if (subCommands.size() > 1)
+	{
+		gameConsole->PrintError("Incorrect Usage! (sweeptest (numBatches))");
+		return true;
+	}
+
+	u32 numBatches = 100000;
+	if (subCommands.size() == 1)
+	{
+		numBatches = std::stoi(subCommands[0]);
+	}
+
+	f32 scalarTimeMS = 0.0f;
+	f32 batchTimeMS = 0.0f;
+	u32 numMismatches = PhysicsUtils::ValidateTriangleSweepBatch(numBatches, scalarTimeMS, batchTimeMS);
+
+	if (numMismatches > 0)
+	{
+		gameConsole->PrintError("%u of %u %s sweep batches did not match the scalar reference", numMismatches, numBatches, PhysicsUtils::GetTriangleSweepBatchPath());
+		return true;
+	}
+
+	gameConsole->PrintSuccess("%u %s sweep batches matched the scalar reference, scalar: %.2f ms, batched: %.2f ms", numBatches, PhysicsUtils::GetTriangleSweepBatchPath(), scalarTimeMS, batchTimeMS);
+	return true;
+}
+
+bool GameConsoleCommands::HandleUIHitTestBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	if (subCommands.size() > 2)
+	{
+		gameConsole->PrintError("Incorrect Usage! (uibench (numElements) (numQueries))");
+		return true;
+	}
+
+	u32 numElements = 10000;
+	if (subCommands.size() >= 1)
+	{
+		numElements = std::stoi(subCommands[0]);
+	}
+
+	u32 numQueries = 10000;
+	if (subCommands.size() == 2)
+	{
+		numQueries = std::stoi(subCommands[1]);
+	}
+
+	if (numQueries == 0)
+	{
+		gameConsole->PrintError("uibench needs at least one query");
+		return true;
+	}
+
+	const UISingleton::UIDataSingleton& dataSingleton = ServiceLocator::GetUIRegistry()->ctx<UISingleton::UIDataSingleton>();
+
+	UIUtils::Collision::HitTestBenchmarkResult result;
+	UIUtils::Collision::BenchmarkHitTesting(numElements, numQueries, vec2(dataSingleton.UIRESOLUTION), result);
+
+	f32 linearTimeUS = (result.linearTimeMS * 1000.0f) / result.numQueries;
+	f32 gridTimeUS = (result.gridTimeMS * 1000.0f) / result.numQueries;
+
+	gameConsole->PrintSuccess("%u hover/click queries against %u elements (%u hits), linear scan: %.2f ms (%.3f us/query), grid: %.2f ms (%.3f us/query), building the grid took %.2f ms", result.numQueries, result.numElements, result.numHits, result.linearTimeMS, linearTimeUS, result.gridTimeMS, gridTimeUS, result.gridBuildTimeMS);
+
+	if (result.numMismatches > 0)
+	{
+		gameConsole->PrintError("%u queries found a different element through the grid", result.numMismatches);
+	}
+
+	return true;
+}
+
+bool GameConsoleCommands::HandleTextureStreaming(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	if (subCommands.size() > 1)
+	{
+		gameConsole->PrintError("Incorrect Usage! (texstream (budgetMB))");
+		return true;
+	}
+
+	Renderer::Renderer* renderer = ServiceLocator::GetRenderer();
+
+	// Software drivers (for example lavapipe through VK_ICD_FILENAMES) report the whole system memory as budget, forcing a small one makes streaming evict and upgrade mips there too
+	if (subCommands.size() == 1)
+	{
+		size_t budgetMB = std::stoull(subCommands[0]);
+		renderer->SetTextureStreamingBudget(budgetMB * 1024 * 1024);
+
+		if (budgetMB == 0)
+		{
+			gameConsole->PrintSuccess("Texture streaming uses the device budget again");
+		}
+		else
+		{
+			gameConsole->PrintSuccess("Texture streaming budget forced to %llu MB", static_cast<u64>(budgetMB));
+		}
+		return true;
+	}
+
+	Renderer::TextureStreamingStats stats = renderer->GetTextureStreamingStats();
+	f32 residentMB = static_cast<f32>(stats.residentBytes) / (1024.0f * 1024.0f);
+	f32 budgetMB = static_cast<f32>(stats.budget) / (1024.0f * 1024.0f);
+	f32 usageMB = static_cast<f32>(renderer->GetVRAMUsage()) / (1024.0f * 1024.0f);
+
+	gameConsole->PrintSuccess("%u streamed textures (%.2f MB resident), %u at full detail, %u at lowest detail, %u loading, %u images waiting to be retired", stats.numStreamedTextures, residentMB, stats.numAtFullDetail, stats.numAtLowestDetail, stats.numLoading, stats.numRetiredImages);
+	gameConsole->PrintSuccess("VRAM usage %.2f MB, streaming budget %.2f MB", usageMB, budgetMB);
+	return true;
+}
+
+bool GameConsoleCommands::HandleTextureLookupBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	if (subCommands.size() > 1)
+	{
+		gameConsole->PrintError("Incorrect Usage! (texbench (numQueries))");
+		return true;
+	}
+
+	u32 numQueries = 10000;
+	if (subCommands.size() == 1)
+	{
+		numQueries = std::stoi(subCommands[0]);
+	}
+
+	Renderer::TextureLookupBenchmarkResult result = ServiceLocator::GetRenderer()->BenchmarkTextureLookups(numQueries);
+	if (result.numTextures == 0 || result.numQueries == 0)
+	{
+		gameConsole->PrintError("No textures loaded, load a map first");
+		return true;
+	}
+
+	auto PerQueryUS = [&](f32 timeMS) { return (timeMS * 1000.0f) / result.numQueries; };
+
+	gameConsole->PrintSuccess("%u lookups among %u loaded textures, linear: %.2f ms (%.3f us/lookup), hash: %.2f ms (%.3f us/lookup)", result.numQueries, result.numTextures, result.linearTimeMS, PerQueryUS(result.linearTimeMS), result.hashTimeMS, PerQueryUS(result.hashTimeMS));
+
+	if (result.numArrayTextures > 0)
+	{
+		gameConsole->PrintSuccess("%u lookups among %u textures in arrays, linear: %.2f ms (%.3f us/lookup), hash: %.2f ms (%.3f us/lookup)", result.numQueries, result.numArrayTextures, result.arrayLinearTimeMS, PerQueryUS(result.arrayLinearTimeMS), result.arrayHashTimeMS, PerQueryUS(result.arrayHashTimeMS));
+		gameConsole->PrintSuccess("%u LoadTextureIntoArray of already loaded textures, linear: %.2f ms (%.3f us/load), hash: %.2f ms (%.3f us/load)", result.numQueries, result.loadIntoArrayLinearTimeMS, PerQueryUS(result.loadIntoArrayLinearTimeMS), result.loadIntoArrayHashTimeMS, PerQueryUS(result.loadIntoArrayHashTimeMS));
+	}
+
+	if (result.numMismatches > 0)
+	{
+		gameConsole->PrintError("%u lookups found a different texture through the hash index", result.numMismatches);
+	}
+
+	return true;
+}
+
+bool GameConsoleCommands::HandleCModelLoadBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	if (subCommands.size() > 1)
+	{
+		gameConsole->PrintError("Incorrect Usage! (cmodelbench (numModels))");
+		return true;
+	}
+
+	u32 numModels = 500;
+	if (subCommands.size() == 1)
+	{
+		numModels = std::stoi(subCommands[0]);
+	}
+
+	CModelRenderer* cModelRenderer = ServiceLocator::GetClientRenderer()->GetCModelRenderer();
+
+	CModelRenderer::LoadBenchmarkResult result;
+	if (!cModelRenderer->BenchmarkLoad(numModels, result))
+	{
+		gameConsole->PrintError("No complex models loaded, load a map first");
+		return true;
+	}
+
+	gameConsole->PrintSuccess("%u complex models, old locking (lower bound): %.2f ms, staged: %.2f ms (commit %.2f ms)", result.numModels, result.lockedTimeMS, result.stagedTimeMS, result.stagedCommitTimeMS);
+
+	if (result.numFailed > 0)
+	{
+		gameConsole->PrintError("%u complex models failed to decode", result.numFailed);
+	}
+
+	return true;
+}
+
+bool GameConsoleCommands::HandleRenderStats(GameConsole* gameConsole, std::vector<std::string> subCommands)
+{
+	if (subCommands.size() > 1 || (subCommands.size() == 1 && subCommands[0] != "record"))
+	{
+		gameConsole->PrintError("Incorrect Usage! (renderstats (record))");
+		return true;
+	}
+
+	Renderer::RendererNull* rendererNull = dynamic_cast<Renderer::RendererNull*>(ServiceLocator::GetRenderer());
+	if (!rendererNull)
+	{
+		gameConsole->PrintError("renderstats needs the null renderer, enable render.nullBackend and restart");
+		return true;
+	}
+
+	if (subCommands.size() == 1)
+	{
+		bool recordCommands = !rendererNull->IsRecordingCommands();
+		rendererNull->SetRecordCommands(recordCommands);
+
+		gameConsole->PrintSuccess("Command recording %s", recordCommands ? "enabled" : "disabled");
+		return true;
+	}
+
+	const Renderer::RendererNull::Stats& frame = rendererNull->GetFrameStats();
+	gameConsole->PrintSuccess("Last frame: %u command lists, %u commands, %u draws (%u indirect), %llu vertices, %llu indices, %llu instances", frame.numCommandLists, frame.numCommands, frame.numDraws, frame.numIndirectDraws, frame.numVertices, frame.numIndices, frame.numInstances);
+	gameConsole->PrintSuccess("Last frame: %u dispatches (%llu thread groups), %u pipeline binds, %u descriptor set binds (%u descriptors), %u barriers, %u copies", frame.numDispatches, frame.numThreadGroups, frame.numPipelineBinds, frame.numDescriptorSetBinds, frame.numDescriptors, frame.numBarriers, frame.numCopies);
+	gameConsole->PrintSuccess("Last frame: %u uploads (%llu bytes), %llu bytes pushed, %u buffers created (%llu bytes)", frame.numUploads, frame.numBytesUploaded, frame.numBytesPushed, frame.numBuffersCreated, frame.numBufferBytesCreated);
+
+	const Renderer::RendererNull::Stats& total = rendererNull->GetTotalStats();
+	gameConsole->PrintSuccess("Total: %u command lists, %u draws, %u dispatches, %u uploads (%llu bytes)", total.numCommandLists, total.numDraws, total.numDispatches, total.numUploads, total.numBytesUploaded);
+
+	if (rendererNull->IsRecordingCommands())
+	{
+		gameConsole->PrintSuccess("%u commands recorded last frame", static_cast<u32>(rendererNull->GetFrameCommands().size()));
+	}
+
+	return true;
+}
@@ -12,4 +12,12 @@ public:
 	static bool HandleGoto(GameConsole* gameConsole, std::vector<std::string> subCommands);
 	static bool HandleStoreLoc(GameConsole* gameConsole, std::vector<std::string> subCommands);
 	static bool HandleMorph(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleMapBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleCollisionBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleSweepTest(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleUIHitTestBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleTextureStreaming(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleTextureLookupBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleCModelLoadBenchmark(GameConsole* gameConsole, std::vector<std::string> subCommands);
+	static bool HandleRenderStats(GameConsole* gameConsole, std::vector<std::string> subCommands);
 };
\ No newline at end of file
@@ -1,14 +1,74 @@
 #include "Chunk.h"
+#include "../../Utils/MemoryMappedFile.h"
 
 #include <Utils/ByteBuffer.h>
-#include <Utils/FileReader.h>
 
-bool Terrain::Chunk::Read(FileReader& reader, Terrain::Chunk& chunk, StringTable& stringTable)
+namespace Terrain
 {
-    Bytebuffer buffer(nullptr, reader.Length());
-    reader.Read(&buffer, buffer.size);
+    Chunk::Chunk() {}
+    Chunk::~Chunk() {}
 
-    buffer.Get<Terrain::ChunkHeader>(chunk.chunkHeader);
+    // Hands out views into the mapped file, every chunk struct is packed so the views don't have to be aligned
+    class ChunkFileCursor
+    {
+    public:
+        ChunkFileCursor(u8* data, size_t size) : _data(data), _size(size) {}
+
+        template <typename T>
+        bool Get(T& value)
+        {
+            if (_offset + sizeof(T) > _size)
+                return false;
+
+            std::memcpy(&value, &_data[_offset], sizeof(T));
+            _offset += sizeof(T);
+            return true;
+        }
+
+        template <typename T>
+        bool GetView(T*& view, size_t count)
+        {
+            size_t numBytes = sizeof(T) * count;
+            if (_offset + numBytes > _size)
+                return false;
+
+            view = reinterpret_cast<T*>(&_data[_offset]);
+            _offset += numBytes;
+            return true;
+        }
+
+        template <typename T>
+        bool GetView(ArrayView<T>& view)
+        {
+            u32 count;
+            if (!Get<u32>(count))
+                return false;
+
+            view.count = count;
+            return count == 0 || GetView(view.data, count);
+        }
+
+        size_t GetOffset() const { return _offset; }
+
+    private:
+        u8* _data = nullptr;
+        size_t _size = 0;
+        size_t _offset = 0;
+    };
+}
+
+bool Terrain::Chunk::Read(const std::string& path, Terrain::Chunk& chunk, StringTable& stringTable)
+{
+    chunk.file = std::make_unique<MemoryMappedFile>();
+    if (!chunk.file->Open(path))
+        return false;
+
+    u8* data = chunk.file->GetData();
+    size_t size = chunk.file->GetSize();
+
+    ChunkFileCursor cursor(data, size);
+    if (!cursor.Get<Terrain::ChunkHeader>(chunk.chunkHeader))
+        return false;
 
     if (chunk.chunkHeader.token != Terrain::MAP_CHUNK_TOKEN)
     {
@@ -27,43 +87,33 @@ bool Terrain::Chunk::Read(FileReader& reader, Terrain::Chunk& chunk, StringTable
         }
     }
 
-    buffer.Get<Terrain::HeightHeader>(chunk.heightHeader);
-    buffer.Get<Terrain::HeightBox>(chunk.heightBox);
-
-    buffer.GetBytes(reinterpret_cast<u8*>(&chunk.cells[0]), sizeof(Terrain::Cell) * Terrain::MAP_CELLS_PER_CHUNK);
+    if (!cursor.Get<Terrain::HeightHeader>(chunk.heightHeader))
+        return false;
 
-    buffer.Get<u32>(chunk.alphaMapStringID);
+    if (!cursor.Get<Terrain::HeightBox>(chunk.heightBox))
+        return false;
 
-    u32 numMapObjectPlacements;
-    buffer.Get<u32>(numMapObjectPlacements);
+    if (!cursor.GetView(chunk.cells, Terrain::MAP_CELLS_PER_CHUNK))
+        return false;
 
-    if (numMapObjectPlacements > 0)
-    {
-        chunk.mapObjectPlacements.resize(numMapObjectPlacements);
-        buffer.GetBytes(reinterpret_cast<u8*>(&chunk.mapObjectPlacements[0]), sizeof(Terrain::Placement) * numMapObjectPlacements);
-    }
+    if (!cursor.Get<u32>(chunk.alphaMapStringID))
+        return false;
 
-    u32 numComplexModelPlacements;
-    buffer.Get<u32>(numComplexModelPlacements);
+    if (!cursor.GetView(chunk.mapObjectPlacements))
+        return false;
 
-    if (numComplexModelPlacements > 0)
-    {
-        chunk.complexModelPlacements.resize(numComplexModelPlacements);
-        buffer.GetBytes(reinterpret_cast<u8*>(&chunk.complexModelPlacements[0]), sizeof(Terrain::Placement) * numComplexModelPlacements);
-    }
+    if (!cursor.GetView(chunk.complexModelPlacements))
+        return false;
 
-    // Read Liquid Bytes
+    // Liquid Bytes
     {
-        u32 numLiquidBytes;
-        buffer.Get<u32>(numLiquidBytes);
+        if (!cursor.GetView(chunk.liquidBytes))
+            return false;
 
-        if (numLiquidBytes > 0)
+        if (chunk.liquidBytes.size() > 0)
         {
-            chunk.liquidBytes.resize(numLiquidBytes);
-            buffer.GetBytes(chunk.liquidBytes.data(), sizeof(u8) * numLiquidBytes);
-
-            chunk.liquidHeaders.resize(Terrain::MAP_CELLS_PER_CHUNK);
-            std::memcpy(chunk.liquidHeaders.data(), chunk.liquidBytes.data(), Terrain::MAP_CELLS_PER_CHUNK * sizeof(Terrain::CellLiquidHeader));
+            chunk.liquidHeaders.data = reinterpret_cast<Terrain::CellLiquidHeader*>(chunk.liquidBytes.data);
+            chunk.liquidHeaders.count = Terrain::MAP_CELLS_PER_CHUNK;
 
             u32 numInstances = 0;
             u32 firstInstanceOffset = std::numeric_limits<u32>().max();
@@ -84,13 +134,19 @@ bool Terrain::Chunk::Read(FileReader& reader, Terrain::Chunk& chunk, StringTable
 
             if (numInstances > 0)
             {
-                chunk.liquidInstances.resize(numInstances);
-                std::memcpy(chunk.liquidInstances.data(), &chunk.liquidBytes.data()[firstInstanceOffset], sizeof(Terrain::CellLiquidInstance) * numInstances);
+                chunk.liquidInstances.data = reinterpret_cast<Terrain::CellLiquidInstance*>(&chunk.liquidBytes[firstInstanceOffset]);
+                chunk.liquidInstances.count = numInstances;
             }
         }
     }
 
-    stringTable.Deserialize(&buffer);
+    // The string table is the only part that is copied out of the file
+    size_t stringTableOffset = cursor.GetOffset();
+    Bytebuffer stringTableBuffer(&data[stringTableOffset], size - stringTableOffset);
+    stringTableBuffer.writtenData = size - stringTableOffset;
+
+    stringTable.Deserialize(&stringTableBuffer);
     assert(stringTable.GetNumStrings() > 0); // We always expect to have at least 1 string in our stringtable, a path for the base texture
+
     return true;
 }
@@ -25,6 +25,7 @@
 #include <NovusTypes.h>
 #include <robin_hood.h>
 #include <limits>
+#include <memory>
 
 #include "Cell.h"
 #include <Containers/StringTable.h>
@@ -34,7 +35,7 @@
 // A Chunk consists of 16x16 Cells which are all being used.
 // A Cell consists of two interlapping grids. There is the 9*9 OUTER grid and the 8*8 INNER grid.
 
-class FileReader;
+class MemoryMappedFile;
 namespace Terrain
 {
     constexpr i32 MAP_CHUNK_TOKEN = 1128812107; // UTF8 -> Binary -> Decimal for "chnk"
@@ -47,6 +48,21 @@ namespace Terrain
     constexpr f32 MAP_CHUNK_SIZE = 533.33333f; // yards
     constexpr f32 MAP_CHUNK_HALF_SIZE = MAP_CHUNK_SIZE / 2.0f; // yards
 
+    // A view into memory owned by someone else, used to point into the mapped chunk file instead of copying out of it
+    template <typename T>
+    struct ArrayView
+    {
+        T* data = nullptr;
+        u32 count = 0;
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        T& operator[](size_t index) const { return data[index]; }
+        T* begin() const { return data; }
+        T* end() const { return data + count; }
+    };
+
 #pragma pack(push, 1)
     struct ChunkHeader
     {
@@ -180,26 +196,29 @@ namespace Terrain
 
     struct Chunk
     {
+        Chunk();
+        ~Chunk();
+
         ChunkHeader chunkHeader;
 
         HeightHeader heightHeader;
         HeightBox heightBox;
 
-        Cell cells[MAP_CELLS_PER_CHUNK];
+        // Every view below points into the mapped chunk file, pages are copy-on-write so border alignment can still write to cells
+        Cell* cells = nullptr;
         u32 alphaMapStringID;
 
-        std::vector<Placement> mapObjectPlacements;
-        std::vector<Placement> complexModelPlacements;
+        ArrayView<Placement> mapObjectPlacements;
+        ArrayView<Placement> complexModelPlacements;
+
+        ArrayView<u8> liquidBytes;
 
-        std::vector<u8> liquidBytes;
+        ArrayView<CellLiquidHeader> liquidHeaders;
+        ArrayView<CellLiquidInstance> liquidInstances;
 
-        std::vector<CellLiquidHeader> liquidHeaders;
-        std::vector<CellLiquidInstance> liquidInstances;
-        std::vector<CellLiquidAttributes> liquidAttributes;
-        std::vector<u8> liquidBitMaskForPatchesData;
-        std::vector<u8> liquidvertexData;
+        std::unique_ptr<MemoryMappedFile> file;
 
-        static bool Read(FileReader& reader, Terrain::Chunk& chunk, StringTable& stringTable);
+        static bool Read(const std::string& path, Terrain::Chunk& chunk, StringTable& stringTable);
     };
 #pragma pack(pop)
 }
\ No newline at end of file
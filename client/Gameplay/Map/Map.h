@@ -26,9 +26,12 @@
 #include <robin_hood.h>
 #include <entity/fwd.hpp>
 #include <limits>
+#include <atomic>
+#include <mutex>
 #include <Containers/StringTable.h>
 #include <Utils/SafeVector.h>
 #include "Chunk.h"
+#include "../../Utils/BoundingVolumeHierarchy.h"
 
 // First of all, forget every naming convention wowdev.wiki uses, it's extremely confusing.
 // A Map (e.g. Eastern Kingdoms) consists of 64x64 Chunks which may or may not be used.
@@ -65,6 +68,17 @@ namespace Terrain
         u32 instanceIndex = 0;
     };
 
+    // Broadphase over the collidable entities of a chunk, rebuilt lazily by PhysicsUtils::CheckCollisionForCModels
+    struct ChunkCollisionBroadphase
+    {
+        BoundingVolumeHierarchy staticBVH; // Over the world space collision bounds of staticEntities
+        std::vector<entt::entity> staticEntities;
+        std::vector<entt::entity> dynamicEntities; // These move every frame so they are tested linearly instead
+
+        std::atomic<bool> isDirty = true; // Set whenever the collidable entity list of the chunk changes
+        std::mutex mutex;
+    };
+
     struct Map
     {
         Map() {}
@@ -76,7 +90,9 @@ namespace Terrain
         robin_hood::unordered_map<u16, Chunk> chunks;
         robin_hood::unordered_map<u16, SafeVector<entt::entity>> chunksEntityList;
         robin_hood::unordered_map<u16, SafeVector<entt::entity>> chunksCollidableEntityList;
+        robin_hood::unordered_map<u16, ChunkCollisionBroadphase> chunksCollisionBroadphase;
         robin_hood::unordered_map<u16, StringTable> stringTables;
+        robin_hood::unordered_map<u16, std::string> chunkPaths; // Every chunk file of the map, including the ones that are not loaded
 
         bool IsLoadedMap() { return id != std::numeric_limits<u16>().max(); }
         bool IsMapLoaded(u16 newId) { return id == newId; }
@@ -105,6 +121,14 @@ namespace Terrain
 
             return &itr->second;
         }
+        ChunkCollisionBroadphase* GetCollisionBroadphaseByChunkID(u16 chunkID)
+        {
+            auto itr = chunksCollisionBroadphase.find(chunkID);
+            if (itr == chunksCollisionBroadphase.end())
+                return nullptr;
+
+            return &itr->second;
+        }
 
         void GetChunkPositionFromChunkId(u16 chunkId, u16& x, u16& y) const;
         bool GetChunkIdFromChunkPosition(u16 x, u16 y, u16& chunkId) const;
@@ -133,12 +157,15 @@ namespace Terrain
                 pair.second.Clear();
             }
             chunksCollidableEntityList.clear();
+            chunksCollisionBroadphase.clear();
 
             for (auto& pair : stringTables)
             {
                 pair.second.Clear();
             }
             stringTables.clear();
+
+            chunkPaths.clear();
         }
     };
 }
\ No newline at end of file
@@ -8,12 +8,15 @@
 class ConfigLoader : Loader
 {
 public:
-    ConfigLoader() : Loader("ConfigLoader", 1000) { }
+    ConfigLoader() : Loader("ConfigLoader") { }
 
     bool Init()
     {
         entt::registry* registry = ServiceLocator::GetGameRegistry();
+
+        std::unique_lock registryLock(LoaderSystem::Get()->GetRegistryContextMutex());
         ConfigSingleton& configSingleton = registry->set<ConfigSingleton>();
+        registryLock.unlock();
 
         if (!fs::exists(ConfigUtils::configFolderPath))
             fs::create_directory(ConfigUtils::configFolderPath);
@@ -1,8 +1,14 @@
 #include "LoaderSystem.h"
 
-Loader::Loader(StringUtils::StringHash hash, u32 priority)
+#include <Utils/DebugHandler.h>
+#include <Utils/Timer.h>
+#include <atomic>
+
+Loader::Loader(const std::string& name, std::vector<std::string> dependencies)
 {
-    _priority = priority;
+    _hash = StringUtils::fnv1a_32(name.c_str(), name.length());
+    _name = name;
+    _dependencies = std::move(dependencies);
 
     LoaderSystem* loaderSystem = LoaderSystem::Get();
     loaderSystem->AddLoader(this);
@@ -25,9 +31,78 @@ void LoaderSystem::Init()
     assert(_isInitialized == false);
     _isInitialized = true;
 
-    // Sort Loaders by Priority
-    std::sort(_loaders.begin(), _loaders.end(), [](Loader* lhs, Loader* rhs)
+    for (Loader* loader : _loaders)
     {
-        return lhs->GetPriority() > rhs->GetPriority();
-    });
+        for (const std::string& dependency : loader->GetDependencies())
+        {
+            u32 dependencyHash = StringUtils::fnv1a_32(dependency.c_str(), dependency.length());
+            if (_hashToLoader.find(dependencyHash) == _hashToLoader.end())
+            {
+                DebugHandler::PrintFatal("%s depends on %s which doesn't exist", loader->GetName().c_str(), dependency.c_str());
+            }
+        }
+    }
+}
+
+bool LoaderSystem::Load()
+{
+    assert(_isInitialized == true);
+
+    size_t numLoaders = _loaders.size();
+    std::vector<f32> loaderTimesMS(numLoaders, 0.0f);
+    std::atomic<bool> failedToLoad = false;
+
+    Timer totalTimer;
+
+    tf::Taskflow tf;
+    robin_hood::unordered_map<u32, tf::Task> hashToTask;
+
+    for (size_t i = 0; i < numLoaders; i++)
+    {
+        Loader* loader = _loaders[i];
+
+        tf::Task task = tf.emplace([&, loader, i]()
+        {
+            // Loaders depending on a failed loader would only fail as well
+            if (failedToLoad)
+                return;
+
+            Timer timer;
+            if (!loader->Init())
+            {
+                DebugHandler::PrintError("%s failed", loader->GetName().c_str());
+                failedToLoad = true;
+            }
+
+            loaderTimesMS[i] = timer.GetLifeTime() * 1000.0f;
+        });
+        task.name(loader->GetName());
+
+        hashToTask[loader->GetHash()] = task;
+    }
+
+    for (Loader* loader : _loaders)
+    {
+        tf::Task& task = hashToTask[loader->GetHash()];
+
+        for (const std::string& dependency : loader->GetDependencies())
+        {
+            u32 dependencyHash = StringUtils::fnv1a_32(dependency.c_str(), dependency.length());
+            task.gather(hashToTask[dependencyHash]);
+        }
+    }
+
+    tf.wait_for_all();
+
+    f32 totalTimeMS = totalTimer.GetLifeTime() * 1000.0f;
+    f32 sequentialTimeMS = 0.0f;
+
+    for (size_t i = 0; i < numLoaders; i++)
+    {
+        DebugHandler::Print("Startup: %s took %.2f ms", _loaders[i]->GetName().c_str(), loaderTimesMS[i]);
+        sequentialTimeMS += loaderTimesMS[i];
+    }
+    DebugHandler::Print("Startup: Loaders finished in %.2f ms (%.2f ms if run one after another)", totalTimeMS, sequentialTimeMS);
+
+    return !failedToLoad;
 }
@@ -2,20 +2,24 @@
 #include <NovusTypes.h>
 #include <Utils/StringUtils.h>
 #include <robin_hood.h>
+#include <mutex>
 
 class Loader
 {
 public:
-    Loader(StringUtils::StringHash hash, u32 priority);
+    // Loaders run concurrently, a loader only starts once every loader it names as a dependency has finished successfully
+    Loader(const std::string& name, std::vector<std::string> dependencies = {});
 
     u32 GetHash() { return _hash; }
-    u32 GetPriority() { return _priority; }
+    const std::string& GetName() { return _name; }
+    const std::vector<std::string>& GetDependencies() { return _dependencies; }
 
     virtual bool Init() = 0;
 
 private:
     u32 _hash;
-    u32 _priority;
+    std::string _name;
+    std::vector<std::string> _dependencies;
 };
 
 class LoaderSystem
@@ -24,12 +28,20 @@ public:
     static LoaderSystem* Get();
     void Init();
 
+    // Runs every loader and prints how long each of them took, returns false if any of them failed
+    bool Load();
+
     std::vector<Loader*>& GetLoaders() { return _loaders; }
     void AddLoader(Loader* loader);
 
+    // Creating or looking up registry context variables isn't thread safe, loaders have to hold this while they do
+    std::mutex& GetRegistryContextMutex() { return _registryContextMutex; }
+
 private:
     bool _isInitialized = false;
 
     robin_hood::unordered_map<u32, Loader*> _hashToLoader;
     std::vector<Loader*> _loaders;
-};
\ No newline at end of file
+
+    std::mutex _registryContextMutex;
+};
@@ -19,7 +19,7 @@ namespace fs = std::filesystem;
 class MapLoader : Loader
 {
 public:
-    MapLoader() : Loader("MapLoader", 997) { }
+    MapLoader() : Loader("MapLoader", { "NDBCLoader" }) { }
 
     bool Init()
     {
@@ -31,8 +31,11 @@ public:
         }
 
         entt::registry* registry = ServiceLocator::GetGameRegistry();
+
+        std::unique_lock registryLock(LoaderSystem::Get()->GetRegistryContextMutex());
         MapSingleton& mapSingleton = registry->set<MapSingleton>();
         NDBCSingleton& ndbcSingleton = registry->ctx<NDBCSingleton>();
+        registryLock.unlock();
 
         if (!InitNDBC(mapSingleton, ndbcSingleton))
             return false;
@@ -64,7 +67,11 @@ public:
             return false;
         }
 
+        // Each table only writes its own lookup tables in the MapSingleton, so they are built concurrently
+        tf::Taskflow tf;
+
         // Add Lookup Table(s) for Maps.ndbc
+        tf.emplace([&]()
         {
             for (u32 i = 0; i < mapsNDBC->GetNumRows(); i++)
             {
@@ -72,25 +79,29 @@ public:
 
                 mapSingleton.AddMapNDBC(mapsNDBC, map);
             }
-        }
+        });
 
         // Add Lookup Table(s) for AreaTable.ndbc
+        tf.emplace([&]()
         {
             for (u32 i = 0; i < areaTableNDBC->GetNumRows(); i++)
             {
                 NDBC::AreaTable* areaTable = areaTableNDBC->GetRowByIndex<NDBC::AreaTable>(i);
                 mapSingleton.AddAreaTableNDBC(areaTableNDBC, areaTable);
             }
-        }
+        });
 
         // Add Lookup Table(s) for Light.ndbc
+        tf.emplace([&]()
         {
             for (u32 i = 0; i < lightNDBC->GetNumRows(); i++)
             {
                 NDBC::Light* light = lightNDBC->GetRowByIndex<NDBC::Light>(i);
                 mapSingleton.AddLightNDBC(light);
             }
-        }
+        });
+
+        tf.wait_for_all();
 
         return true;
     }
@@ -0,0 +1,146 @@
+#include "NDBC.h"
+#include "../../Utils/MemoryMappedFile.h"
+
+namespace NDBC
+{
+    File::File() { }
+    File::File(File&& other) noexcept = default;
+    File& File::operator=(File&& other) noexcept = default;
+    File::~File() { }
+
+    void File::SetRowIndexOffset(size_t rowIndexOffset)
+    {
+        _builtRowIndex.clear();
+        _builtRowIndex.shrink_to_fit();
+
+        SetRowIndex(reinterpret_cast<const u32*>(&_data[rowIndexOffset]));
+    }
+
+    void File::BuildRowIndex()
+    {
+        CreateRowIndex(GetFirstRow<u8>(), _numRows, _rowSize, _builtRowIndex);
+        SetRowIndex(_builtRowIndex.data());
+    }
+
+    bool File::IsRowIndexValid() const
+    {
+        if (_rowIndexHeader == nullptr)
+            return false;
+
+        for (u32 i = 0; i < _rowIndexHeader->numEntries; i++)
+        {
+            // Dense indices mark the ids in between rows as invalid, sparse ones only contain ids that exist
+            u32 row = _rowIndexRows[i];
+            if (row >= _numRows && (_rowIndexHeader->isSparse || row != NDBC_INVALID_ROW))
+                return false;
+
+            if (_rowIndexHeader->isSparse && i > 0 && _rowIndexIds[i - 1] >= _rowIndexIds[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    void File::SetRowIndex(const u32* rowIndex)
+    {
+        _rowIndexHeader = reinterpret_cast<const NDBCRowIndexHeader*>(rowIndex);
+
+        const u32* entries = reinterpret_cast<const u32*>(_rowIndexHeader + 1);
+        if (_rowIndexHeader->isSparse)
+        {
+            _rowIndexIds = entries;
+            _rowIndexRows = entries + _rowIndexHeader->numEntries;
+        }
+        else
+        {
+            _rowIndexIds = nullptr;
+            _rowIndexRows = entries;
+        }
+    }
+
+    void File::WriteRowIndex(DynamicBytebuffer* buffer, const u8* rows, u32 numRows, u32 rowSize)
+    {
+        std::vector<u32> rowIndex;
+        CreateRowIndex(rows, numRows, rowSize, rowIndex);
+
+        buffer->PutBytes(reinterpret_cast<u8*>(rowIndex.data()), rowIndex.size() * sizeof(u32));
+    }
+
+    void File::CreateRowIndex(const u8* rows, u32 numRows, u32 rowSize, std::vector<u32>& rowIndex)
+    {
+        NDBCRowIndexHeader header;
+        constexpr size_t headerWords = sizeof(NDBCRowIndexHeader) / sizeof(u32);
+
+        // Rows without an id column can't be looked up by id
+        if (rowSize < sizeof(u32))
+        {
+            numRows = 0;
+        }
+
+        u32 minId = std::numeric_limits<u32>().max();
+        u32 maxId = 0;
+        for (u32 i = 0; i < numRows; i++)
+        {
+            u32 id = *reinterpret_cast<const u32*>(&rows[i * rowSize]);
+
+            minId = std::min(minId, id);
+            maxId = std::max(maxId, id);
+        }
+
+        u64 idRange = numRows > 0 ? static_cast<u64>(maxId) - minId + 1 : 0;
+        header.minId = numRows > 0 ? minId : 0;
+
+        if (idRange <= static_cast<u64>(numRows) * NDBC_DENSE_INDEX_MAX_IDS_PER_ROW)
+        {
+            header.numEntries = static_cast<u32>(idRange);
+            header.isSparse = 0;
+
+            rowIndex.assign(headerWords + idRange, NDBC_INVALID_ROW);
+            memcpy(rowIndex.data(), &header, sizeof(header));
+
+            u32* rowIndices = &rowIndex[headerWords];
+            for (u32 i = 0; i < numRows; i++)
+            {
+                u32 id = *reinterpret_cast<const u32*>(&rows[i * rowSize]);
+                rowIndices[id - minId] = i; // Duplicate ids resolve to the last row
+            }
+        }
+        else
+        {
+            std::vector<std::pair<u32, u32>> idToRows;
+            idToRows.reserve(numRows);
+
+            for (u32 i = 0; i < numRows; i++)
+            {
+                u32 id = *reinterpret_cast<const u32*>(&rows[i * rowSize]);
+                idToRows.emplace_back(id, i);
+            }
+
+            std::stable_sort(idToRows.begin(), idToRows.end(), [](const std::pair<u32, u32>& a, const std::pair<u32, u32>& b) { return a.first < b.first; });
+
+            std::vector<u32> ids;
+            std::vector<u32> rowIndices;
+            ids.reserve(idToRows.size());
+            rowIndices.reserve(idToRows.size());
+
+            for (size_t i = 0; i < idToRows.size(); i++)
+            {
+                // Duplicate ids resolve to the last row
+                if (i + 1 < idToRows.size() && idToRows[i + 1].first == idToRows[i].first)
+                    continue;
+
+                ids.push_back(idToRows[i].first);
+                rowIndices.push_back(idToRows[i].second);
+            }
+
+            header.numEntries = static_cast<u32>(ids.size());
+            header.isSparse = 1;
+
+            rowIndex.resize(headerWords);
+            memcpy(rowIndex.data(), &header, sizeof(header));
+
+            rowIndex.insert(rowIndex.end(), ids.begin(), ids.end());
+            rowIndex.insert(rowIndex.end(), rowIndices.begin(), rowIndices.end());
+        }
+    }
+}
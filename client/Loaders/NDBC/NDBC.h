@@ -3,12 +3,20 @@
 #include <Utils/DynamicBytebuffer.h>
 #include <Containers/StringTable.h>
 #include <vector>
-#include <robin_hood.h>
+#include <memory>
+#include <limits>
+#include <algorithm>
+
+class MemoryMappedFile;
 
 namespace NDBC
 {
     constexpr i32 NDBC_TOKEN = 1313096259;
-    constexpr i32 NDBC_VERSION = 4;
+    constexpr i32 NDBC_VERSION = 5;
+    constexpr i32 NDBC_UNINDEXED_VERSION = 4; // Rows aren't aligned and there is no row index, it gets built at load time instead
+
+    constexpr u32 NDBC_INVALID_ROW = std::numeric_limits<u32>().max();
+    constexpr u32 NDBC_DENSE_INDEX_MAX_IDS_PER_ROW = 4; // Tables whose id range is larger than this many ids per row get a sparse index instead
 
     struct NDBCColumn
     {
@@ -22,29 +30,62 @@ namespace NDBC
         u32 version = NDBC::NDBC_VERSION;
     };
 
+    // Baked after the rows, a dense index is an array of row indices for every id from minId, a sparse one is the sorted ids followed by their row indices
+    struct NDBCRowIndexHeader
+    {
+        u32 minId = 0;
+        u32 numEntries = 0;
+        u32 isSparse = 0;
+    };
+
     struct File
     {
     public:
+        File();
+        File(File&& other) noexcept;
+        File& operator=(File&& other) noexcept;
+        ~File();
+
         template<typename NDBCStruct>
         NDBCStruct* GetFirstRow()
         {
-            return reinterpret_cast<NDBCStruct*>(&_buffer->GetDataPointer()[_bufferOffsetToRowData]);
+            return reinterpret_cast<NDBCStruct*>(&_data[_bufferOffsetToRowData]);
         }
 
         template<typename NDBCStruct>
         NDBCStruct* GetRowByIndex(u32 index)
         {
-            return &reinterpret_cast<NDBCStruct*>(&_buffer->GetDataPointer()[_bufferOffsetToRowData])[index];
+            return &reinterpret_cast<NDBCStruct*>(&_data[_bufferOffsetToRowData])[index];
         }
 
         template<typename NDBCStruct>
         NDBCStruct* GetRowById(u32 id)
         {
-            auto& itr = _rowIdToRow.find(id);
-            if (itr == _rowIdToRow.end())
+            u32 rowIndex = GetRowIndexById(id);
+            if (rowIndex == NDBC_INVALID_ROW)
                 return nullptr;
 
-            return reinterpret_cast<NDBCStruct*>(itr->second);
+            return GetRowByIndex<NDBCStruct>(rowIndex);
+        }
+
+        u32 GetRowIndexById(u32 id) const
+        {
+            if (_rowIndexHeader == nullptr)
+                return NDBC_INVALID_ROW;
+
+            if (!_rowIndexHeader->isSparse)
+            {
+                // Ids below minId wrap around and fail the bounds check as well
+                u32 slot = id - _rowIndexHeader->minId;
+                return slot < _rowIndexHeader->numEntries ? _rowIndexRows[slot] : NDBC_INVALID_ROW;
+            }
+
+            const u32* end = _rowIndexIds + _rowIndexHeader->numEntries;
+            const u32* itr = std::lower_bound(_rowIndexIds, end, id);
+            if (itr == end || *itr != id)
+                return NDBC_INVALID_ROW;
+
+            return _rowIndexRows[itr - _rowIndexIds];
         }
 
         NDBCHeader& GetHeader() { return _header; }
@@ -59,10 +100,30 @@ namespace NDBC
         size_t GetBufferOffsetToRowData() { return _bufferOffsetToRowData; }
         void SetBufferOffsetToRowData(size_t bufferOffsetToRowData) { _bufferOffsetToRowData = bufferOffsetToRowData; }
 
+        // The rows and the row index are used in place, this points either into the mapped file or into the buffer the editor last saved into
+        u8* GetData() { return _data; }
+        void SetData(u8* data) { _data = data; }
+
+        // Must be called after SetData, the index is expected to have been validated against the size of the data
+        void SetRowIndexOffset(size_t rowIndexOffset);
+
+        // For files without a baked index, builds one from the rows and keeps it in memory
+        void BuildRowIndex();
+
+        // Every row in the index has to point at one of the numRows rows, and sparse ids have to be sorted for the binary search
+        bool IsRowIndexValid() const;
+
         DynamicBytebuffer*& GetBuffer() { return _buffer; }
+        std::unique_ptr<MemoryMappedFile>& GetMappedFile() { return _mappedFile; }
         StringTable*& GetStringTable() { return _stringTable; }
 
-        robin_hood::unordered_map<u32, void*>& GetRowIdToRowMap() { return _rowIdToRow; }
+        // Writes the index for numRows rows of rowSize bytes each, the first column of every row is its id
+        static void WriteRowIndex(DynamicBytebuffer* buffer, const u8* rows, u32 numRows, u32 rowSize);
+
+    private:
+        // The index as it is laid out in the file, an NDBCRowIndexHeader followed by its entries
+        static void CreateRowIndex(const u8* rows, u32 numRows, u32 rowSize, std::vector<u32>& rowIndex);
+        void SetRowIndex(const u32* rowIndex);
 
     private:
         NDBCHeader _header;
@@ -72,10 +133,15 @@ namespace NDBC
         u32 _rowSize = 0;
         size_t _bufferOffsetToRowData = 0;
 
+        u8* _data = nullptr;
         DynamicBytebuffer* _buffer = nullptr;
+        std::unique_ptr<MemoryMappedFile> _mappedFile;
         StringTable* _stringTable = nullptr;
 
-        robin_hood::unordered_map<u32, void*> _rowIdToRow;
+        const NDBCRowIndexHeader* _rowIndexHeader = nullptr;
+        const u32* _rowIndexIds = nullptr; // Only set for sparse indices
+        const u32* _rowIndexRows = nullptr;
+        std::vector<u32> _builtRowIndex; // Only used by files that didn't have a baked index
     };
 
     struct TeleportLocation
@@ -1,17 +1,20 @@
 #include "../LoaderSystem.h"
 #include "../../Utils/ServiceLocator.h"
 #include "../../ECS/Components/Singletons/NDBCSingleton.h"
+#include "../../Utils/MemoryMappedFile.h"
 
 #include <NovusTypes.h>
 #include <entt.hpp>
-#include <Utils/FileReader.h>
+#include <Utils/ByteBuffer.h>
+#include <Utils/Timer.h>
+#include <atomic>
 #include <filesystem>
 namespace fs = std::filesystem;
 
 class NDBCLoader : Loader
 {
 public:
-    NDBCLoader() : Loader("NDBCLoader", 998) { }
+    NDBCLoader() : Loader("NDBCLoader", { "ConfigLoader" }) { }
 
     bool Init()
     {
@@ -23,52 +26,83 @@ public:
         }
 
         entt::registry* registry = ServiceLocator::GetGameRegistry();
+
+        std::unique_lock registryLock(LoaderSystem::Get()->GetRegistryContextMutex());
         NDBCSingleton& ndbcSingleton = registry->set<NDBCSingleton>();
+        registryLock.unlock();
+
+        Timer timer;
+
+        // The files are added up front since the singleton isn't thread safe, each one is then mapped and read on its own thread
+        struct NDBCLoadJob
+        {
+            std::string path;
+            std::string fileName;
+            NDBC::File* file;
+        };
+        std::vector<NDBCLoadJob> loadJobs;
 
-        size_t loadedDBCs = 0;
         for (const auto& entry : std::filesystem::recursive_directory_iterator(absolutePath))
         {
             auto filePath = std::filesystem::path(entry.path());
             if (filePath.extension() != ".ndbc")
                 continue;
 
-            std::string filePathStr = filePath.filename().string();
+            std::string dbcName = filePath.filename().replace_extension("").string();
+
+            NDBCLoadJob& loadJob = loadJobs.emplace_back();
+            loadJob.path = entry.path().string();
+            loadJob.fileName = filePath.filename().string();
+            loadJob.file = &ndbcSingleton.AddNDBCFile(dbcName, 0);
+        }
+
+        if (loadJobs.size() == 0)
+        {
+            DebugHandler::PrintError("0 ndbcs found in (%s)", absolutePath.string().c_str());
+            return false;
+        }
+
+        std::atomic<bool> failedToLoad = false;
 
-            FileReader dbcFile(entry.path().string(), filePathStr);
-            if (!dbcFile.Open())
+        tf::Taskflow tf;
+        tf.parallel_for(loadJobs.begin(), loadJobs.end(), [&](NDBCLoadJob& loadJob)
+        {
+            // The rows and the row index are used straight from the mapping, only the column names and the StringTable are copied out
+            std::unique_ptr<MemoryMappedFile> mappedFile = std::make_unique<MemoryMappedFile>();
+            if (!mappedFile->Open(loadJob.path))
             {
-                DebugHandler::PrintError("Failed to load %s", filePathStr.c_str());
-                return false;
+                DebugHandler::PrintError("Failed to load %s", loadJob.fileName.c_str());
+                failedToLoad = true;
+                return;
             }
 
-            std::string dbcName = filePath.filename().replace_extension("").string();
-            NDBC::File& file = ndbcSingleton.AddNDBCFile(dbcName, dbcFile.Length());
+            loadJob.file->GetMappedFile() = std::move(mappedFile);
 
-            if (!LoadNDBC(dbcFile, file))
+            if (!LoadNDBC(loadJob.fileName, *loadJob.file))
             {
-                DebugHandler::PrintError("Failed to read %s", filePathStr.c_str());
-                return false;
+                DebugHandler::PrintError("Failed to read %s", loadJob.fileName.c_str());
+                failedToLoad = true;
             }
+        });
+        tf.wait_for_all();
 
-            loadedDBCs++;
-        }
-
-        if (loadedDBCs == 0)
-        {
-            DebugHandler::PrintError("0 ndbcs found in (%s)", absolutePath.string().c_str());
+        if (failedToLoad)
             return false;
-        }
 
-        DebugHandler::PrintSuccess("Loaded %u ndbcs", loadedDBCs);
+        DebugHandler::PrintSuccess("Loaded %u ndbcs in %.2f ms", static_cast<u32>(loadJobs.size()), timer.GetLifeTime() * 1000.0f);
         return true;
     }
-    bool LoadNDBC(FileReader& reader, NDBC::File& file)
+    bool LoadNDBC(const std::string& fileName, NDBC::File& file)
     {
         NDBC::NDBCHeader& header = file.GetHeader();
         std::vector<NDBC::NDBCColumn>& columns = file.GetColumns();
-        DynamicBytebuffer*& fileBuffer = file.GetBuffer();
+        MemoryMappedFile& mappedFile = *file.GetMappedFile();
+
+        Bytebuffer view(mappedFile.GetData(), mappedFile.GetSize());
+        view.writtenData = mappedFile.GetSize();
 
-        reader.Read(fileBuffer, fileBuffer->size);
+        Bytebuffer* fileBuffer = &view;
+        file.SetData(mappedFile.GetData());
 
         bool readHeaderSuccessfully = false;
 
@@ -80,25 +114,26 @@ public:
 
         if (!readHeaderSuccessfully)
         {
-            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with no header, try reextracting your data", reader.FileName().c_str());
+            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with no header, try reextracting your data", fileName.c_str());
             return false;
         }
 
         if (header.token != NDBC::NDBC_TOKEN)
         {
-            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with the wrong token, try reextracting your data", reader.FileName().c_str());
+            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with the wrong token, try reextracting your data", fileName.c_str());
             return false;
         }
 
-        if (header.version != NDBC::NDBC_VERSION)
+        bool hasRowIndex = header.version == NDBC::NDBC_VERSION;
+        if (!hasRowIndex && header.version != NDBC::NDBC_UNINDEXED_VERSION)
         {
             if (header.version < NDBC::NDBC_VERSION)
             {
-                DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with older version of %u instead of expected version of %u, try reextracting your data", reader.FileName().c_str(), header.version, NDBC::NDBC_VERSION);
+                DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with older version of %u instead of expected version of %u, try reextracting your data", fileName.c_str(), header.version, NDBC::NDBC_VERSION);
             }
             else
             {
-                DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with newer version of %u instead of expected version of %u, try updating your client", reader.FileName().c_str(), header.version, NDBC::NDBC_VERSION);
+                DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with newer version of %u instead of expected version of %u, try updating your client", fileName.c_str(), header.version, NDBC::NDBC_VERSION);
             }
 
             return false;
@@ -117,7 +152,7 @@ public:
 
                 if (!fileBuffer->GetU32(column.dataType))
                 {
-                    DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt column header data, try reextracting your data", reader.FileName().c_str());
+                    DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt column header data, try reextracting your data", fileName.c_str());
                     return false;
                 }
             }
@@ -130,31 +165,55 @@ public:
         u32 numRows = 0;
         if (!fileBuffer->GetU32(numRows))
         {
-            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt row data, try reextracting your data", reader.FileName().c_str());
+            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt row data, try reextracting your data", fileName.c_str());
             return false;
         }
 
-        file.SetNumRows(numRows);
-        file.SetBufferOffsetToRowData(fileBuffer->readData);
+        // Rows are 4 byte aligned so they can be used in place, older files have them right after the row count
+        size_t rowDataOffset = hasRowIndex ? (fileBuffer->readData + 3) & ~static_cast<size_t>(3) : fileBuffer->readData;
+        size_t rowDataBytes = static_cast<size_t>(numRows) * rowSize;
+        size_t rowIndexOffset = rowDataOffset + rowDataBytes;
+        size_t rowIndexHeaderBytes = hasRowIndex ? sizeof(NDBC::NDBCRowIndexHeader) : 0;
+
+        if (rowIndexOffset + rowIndexHeaderBytes > fileBuffer->writtenData)
+        {
+            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt row data, try reextracting your data", fileName.c_str());
+            return false;
+        }
 
-        // Setup Row Id to Row unordered map
-        robin_hood::unordered_map<u32, void*>& rowIdToRowMap = file.GetRowIdToRowMap();
+        file.SetNumRows(numRows);
+        file.SetBufferOffsetToRowData(rowDataOffset);
 
-        for (u32 i = 0; i < numRows; i++)
+        if (hasRowIndex)
         {
-            void* rowPtr = &fileBuffer->GetReadPointer()[i * rowSize];
-            u32 id = *reinterpret_cast<u32*>(rowPtr);
+            const NDBC::NDBCRowIndexHeader* rowIndexHeader = reinterpret_cast<const NDBC::NDBCRowIndexHeader*>(&fileBuffer->GetDataPointer()[rowIndexOffset]);
+            size_t rowIndexBytes = sizeof(NDBC::NDBCRowIndexHeader) + static_cast<size_t>(rowIndexHeader->numEntries) * sizeof(u32) * (rowIndexHeader->isSparse ? 2 : 1);
 
-            rowIdToRowMap[id] = rowPtr;
-        }
+            if (rowIndexOffset + rowIndexBytes > fileBuffer->writtenData)
+            {
+                DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt row index data, try reextracting your data", fileName.c_str());
+                return false;
+            }
+
+            file.SetRowIndexOffset(rowIndexOffset);
+            if (!file.IsRowIndexValid())
+            {
+                DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt row index data, try reextracting your data", fileName.c_str());
+                return false;
+            }
 
-        u32 rowDataBytes = numRows * rowSize;
-        fileBuffer->SkipRead(rowDataBytes);
+            fileBuffer->readData = rowIndexOffset + rowIndexBytes;
+        }
+        else
+        {
+            file.BuildRowIndex();
+            fileBuffer->readData = rowIndexOffset;
+        }
 
         StringTable*& stringTable = file.GetStringTable();
         if (!stringTable->Deserialize(fileBuffer))
         {
-            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt StringTable data, try reextracting your data", reader.FileName().c_str());
+            DebugHandler::PrintFatal("Attempted to load NDBC file (%s) with corrupt StringTable data, try reextracting your data", fileName.c_str());
             return false;
         }
 
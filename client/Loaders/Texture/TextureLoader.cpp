@@ -8,72 +8,110 @@
 #include <filesystem>
 namespace fs = std::filesystem;
 
-struct TexturePair
-{
-    u32 hash;
-    std::string path;
-};
-
 class TextureLoader : Loader
 {
 public:
-    TextureLoader() : Loader("TextureLoader", 999) { }
+    TextureLoader() : Loader("TextureLoader", { "ConfigLoader" }) { }
 
     bool Init()
     {
         entt::registry* registry = ServiceLocator::GetGameRegistry();
+
+        std::unique_lock registryLock(LoaderSystem::Get()->GetRegistryContextMutex());
         TextureSingleton& textureSingleton = registry->set<TextureSingleton>();
+        registryLock.unlock();
 
         fs::path relativeParentPath = "Data/extracted/Textures";
         fs::path absolutePath = std::filesystem::absolute(relativeParentPath).make_preferred();
 
-        std::string absolutePathStr = absolutePath.string();
-        size_t subStrIndex = absolutePathStr.length() + 1; // + 1 here for folder seperator
-
         if (!fs::is_directory(absolutePath))
         {
             DebugHandler::PrintError("Failed to find Textures folder");
             return false;
         }
 
+        std::string manifestPath = std::filesystem::absolute("Data/extracted/Textures.manifest").make_preferred().string();
+        u64 directoryStamp = GetDirectoryStamp(absolutePath);
+
+        if (!textureSingleton.textureManifest.Open(manifestPath, directoryStamp))
+        {
+            DebugHandler::Print("Texture manifest is missing or outdated, rebuilding it");
+
+            std::vector<TextureManifest::TexturePath> texturePaths = CrawlTextures(relativeParentPath, absolutePath);
+            if (!TextureManifest::Write(manifestPath, directoryStamp, texturePaths) || !textureSingleton.textureManifest.Open(manifestPath, directoryStamp))
+            {
+                DebugHandler::PrintError("Failed to build texture manifest (%s)", manifestPath.c_str());
+                return false;
+            }
+        }
+
+        DebugHandler::PrintSuccess("Loaded Texture %u entries", textureSingleton.textureManifest.GetNumEntries());
+        return true;
+    }
+
+private:
+    // Adding or removing files only touches the write time of the folder they are in, extracted textures are a couple of folders deep so we look at the first two levels
+    u64 GetDirectoryStamp(const fs::path& absolutePath)
+    {
+        std::error_code errorCode;
+        u64 stamp = static_cast<u64>(fs::last_write_time(absolutePath, errorCode).time_since_epoch().count());
+
+        for (const fs::directory_entry& entry : fs::directory_iterator(absolutePath, errorCode))
+        {
+            if (!entry.is_directory(errorCode))
+                continue;
+
+            stamp = std::max(stamp, static_cast<u64>(entry.last_write_time(errorCode).time_since_epoch().count()));
+
+            for (const fs::directory_entry& subEntry : fs::directory_iterator(entry.path(), errorCode))
+            {
+                if (subEntry.is_directory(errorCode))
+                {
+                    stamp = std::max(stamp, static_cast<u64>(subEntry.last_write_time(errorCode).time_since_epoch().count()));
+                }
+            }
+        }
+
+        return stamp;
+    }
+
+    std::vector<TextureManifest::TexturePath> CrawlTextures(const fs::path& relativeParentPath, const fs::path& absolutePath)
+    {
+        std::string absolutePathStr = absolutePath.string();
+        size_t subStrIndex = absolutePathStr.length() + 1; // + 1 here for folder seperator
+
         static const fs::path fileExtension = ".dds";
 
         std::vector<std::filesystem::path> paths;
-        moodycamel::ConcurrentQueue<TexturePair> texturePairs;
+        moodycamel::ConcurrentQueue<TextureManifest::TexturePath> texturePathQueue;
 
         std::filesystem::recursive_directory_iterator dirpos{ absolutePath };
         std::copy(begin(dirpos), end(dirpos), std::back_inserter(paths));
 
-        std::for_each(std::execution::par, std::begin(paths), std::end(paths), [&subStrIndex, &relativeParentPath, &texturePairs](const std::filesystem::path& path)
+        std::for_each(std::execution::par, std::begin(paths), std::end(paths), [&subStrIndex, &relativeParentPath, &texturePathQueue](const std::filesystem::path& path)
         {
             if (!path.has_extension() || path.extension().compare(fileExtension) != 0)
                 return;
 
             std::string texturePath = path.string().substr(subStrIndex);
 
-            TexturePair texturePair;
-            texturePair.path = texturePath;
+            TextureManifest::TexturePath texturePair;
             texturePair.hash = StringUtils::fnv1a_32(texturePath.c_str(), texturePath.length());
+            texturePair.path = (relativeParentPath / texturePath).string();
 
-            texturePairs.enqueue(texturePair);
+            texturePathQueue.enqueue(texturePair);
         });
 
-        textureSingleton.textureHashToPath.reserve(texturePairs.size_approx());
+        std::vector<TextureManifest::TexturePath> texturePaths;
+        texturePaths.reserve(texturePathQueue.size_approx());
 
-        TexturePair texturePair;
-        while (texturePairs.try_dequeue(texturePair))
+        TextureManifest::TexturePath texturePair;
+        while (texturePathQueue.try_dequeue(texturePair))
         {
-            auto itr = textureSingleton.textureHashToPath.find(texturePair.hash);
-            if (itr != textureSingleton.textureHashToPath.end())
-            {
-                DebugHandler::PrintError("Found duplicate texture hash (%u) for Path (%s)", texturePair.hash, texturePair.path.c_str()); // This error cannot be more specific when loading in parallel unless we copy more data.
-            }
-
-            textureSingleton.textureHashToPath[texturePair.hash] = (relativeParentPath / texturePair.path).string();
+            texturePaths.push_back(std::move(texturePair));
         }
 
-        DebugHandler::PrintSuccess("Loaded Texture %u entries", textureSingleton.textureHashToPath.size());
-        return true;
+        return texturePaths;
     }
 };
 
@@ -0,0 +1,101 @@
+#include "TextureManifest.h"
+#include "../../Utils/MemoryMappedFile.h"
+
+#include <Utils/DebugHandler.h>
+#include <algorithm>
+#include <fstream>
+
+TextureManifest::TextureManifest() { }
+TextureManifest::~TextureManifest() { }
+
+bool TextureManifest::Open(const std::string& manifestPath, u64 directoryStamp)
+{
+    std::unique_ptr<MemoryMappedFile> file = std::make_unique<MemoryMappedFile>();
+    if (!file->Open(manifestPath))
+        return false;
+
+    if (file->GetSize() < sizeof(Header))
+        return false;
+
+    const Header* header = reinterpret_cast<const Header*>(file->GetData());
+    if (header->token != MANIFEST_TOKEN || header->version != MANIFEST_VERSION || header->directoryStamp != directoryStamp)
+        return false;
+
+    size_t expectedSize = sizeof(Header) + static_cast<size_t>(header->numEntries) * sizeof(Entry) + header->stringBlobSize;
+    if (file->GetSize() != expectedSize)
+    {
+        DebugHandler::PrintWarning("Texture manifest (%s) has the wrong size, it will be rebuilt", manifestPath.c_str());
+        return false;
+    }
+
+    _file = std::move(file);
+    _header = header;
+    _entries = reinterpret_cast<const Entry*>(_file->GetData() + sizeof(Header));
+    _stringBlob = reinterpret_cast<const char*>(_entries + _header->numEntries);
+
+    return true;
+}
+
+bool TextureManifest::Write(const std::string& manifestPath, u64 directoryStamp, std::vector<TexturePath>& texturePaths)
+{
+    std::sort(texturePaths.begin(), texturePaths.end(), [](const TexturePath& a, const TexturePath& b)
+    {
+        return a.hash < b.hash;
+    });
+
+    std::vector<Entry> entries;
+    entries.reserve(texturePaths.size());
+
+    std::string stringBlob;
+    for (const TexturePath& texturePath : texturePaths)
+    {
+        if (!entries.empty() && entries.back().hash == texturePath.hash)
+        {
+            DebugHandler::PrintError("Found duplicate texture hash (%u) for Path (%s)", texturePath.hash, texturePath.path.c_str());
+            continue;
+        }
+
+        Entry& entry = entries.emplace_back();
+        entry.hash = texturePath.hash;
+        entry.pathOffset = static_cast<u32>(stringBlob.size());
+
+        stringBlob.append(texturePath.path);
+        stringBlob.push_back('\0');
+    }
+
+    Header header;
+    header.directoryStamp = directoryStamp;
+    header.numEntries = static_cast<u32>(entries.size());
+    header.stringBlobSize = static_cast<u32>(stringBlob.size());
+
+    std::ofstream output(manifestPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!output)
+    {
+        DebugHandler::PrintError("Failed to create texture manifest (%s)", manifestPath.c_str());
+        return false;
+    }
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    output.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+    output.write(stringBlob.data(), stringBlob.size());
+    output.close();
+
+    return true;
+}
+
+const char* TextureManifest::GetPath(u32 hash) const
+{
+    if (_header == nullptr)
+        return "";
+
+    const Entry* entriesEnd = _entries + _header->numEntries;
+    const Entry* entry = std::lower_bound(_entries, entriesEnd, hash, [](const Entry& entry, u32 hash)
+    {
+        return entry.hash < hash;
+    });
+
+    if (entry == entriesEnd || entry->hash != hash)
+        return "";
+
+    return _stringBlob + entry->pathOffset;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <NovusTypes.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MemoryMappedFile;
+
+// Maps texture path hashes (fnv1a_32 of the path relative to the Textures folder) to paths
+// The file is a header, an array of entries sorted by hash and a blob of null terminated paths, it is mapped as is and lookups binary search the entries
+class TextureManifest
+{
+public:
+    static constexpr u32 MANIFEST_TOKEN = 20;
+    static constexpr u32 MANIFEST_VERSION = 1;
+
+    struct Header
+    {
+        u32 token = MANIFEST_TOKEN;
+        u32 version = MANIFEST_VERSION;
+        u64 directoryStamp = 0;
+
+        u32 numEntries = 0;
+        u32 stringBlobSize = 0;
+    };
+
+    struct Entry
+    {
+        u32 hash = 0;
+        u32 pathOffset = 0; // Into the string blob
+    };
+
+    struct TexturePath
+    {
+        u32 hash;
+        std::string path;
+    };
+
+public:
+    TextureManifest();
+    ~TextureManifest();
+
+    // Maps the manifest at manifestPath, fails if it is missing, broken or was built for a different directoryStamp
+    bool Open(const std::string& manifestPath, u64 directoryStamp);
+    static bool Write(const std::string& manifestPath, u64 directoryStamp, std::vector<TexturePath>& texturePaths);
+
+    // Returns an empty string for unknown hashes
+    const char* GetPath(u32 hash) const;
+    u32 GetNumEntries() const { return _header != nullptr ? _header->numEntries : 0; }
+
+private:
+    std::unique_ptr<MemoryMappedFile> _file;
+
+    const Header* _header = nullptr;
+    const Entry* _entries = nullptr;
+    const char* _stringBlob = nullptr;
+};
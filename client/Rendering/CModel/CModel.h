@@ -3,12 +3,15 @@
 #include <NovusTypeHeader.h>
 #include <Math/Geometry.h>
 #include <vector>
+#include <cstring>
+#include <type_traits>
 
 #pragma pack(push, 1)
 namespace CModel
 {
     constexpr u32 COMPLEX_MODEL_TOKEN = 10;
-    constexpr u32 COMPLEX_MODEL_VERSION = 6;
+    constexpr u32 COMPLEX_MODEL_VERSION = 7;
+    constexpr u32 COMPLEX_MODEL_LEGACY_TRACK_VERSION = 6; // Stores tracks per bone channel, flattened into the v7 layout on load
 
     struct ComplexVertex
     {
@@ -81,54 +84,30 @@ namespace CModel
         CUBIC_HERMIT_SPLINE // Only used for M2SplineKey tracks (WowDev.Wiki states Bezier/Hermit might be in the wrong order)
     };
 
-    template <typename T>
+    // All tracks of a model live in ComplexModel::animationTracks, and their keys in the flat animationTrackTimestamps/animationTrackValues arrays
     struct ComplexAnimationTrack
     {
-        u32 sequenceId;
-        std::vector<u32> timestamps;
-        std::vector<T> values;
+        u32 sequenceId = 0;
+
+        u32 timestampOffset = 0;
+        u32 numTimestamps = 0;
+
+        u32 valueOffset = 0;
+        u32 numValues = 0;
     };
 
-    template <typename T>
     struct ComplexAnimationData
     {
-        ComplexAnimationData() { }
-
         AnimationTrackInterpolationType interpolationType = AnimationTrackInterpolationType::NONE;
         bool isGlobalSequence = false;
 
-        std::vector<ComplexAnimationTrack<T>> tracks;
-
-        void Serialize(std::ofstream& stream) const
-        {
-            stream.write(reinterpret_cast<char const*>(&interpolationType), sizeof(interpolationType));
-            stream.write(reinterpret_cast<char const*>(&isGlobalSequence), sizeof(isGlobalSequence));
-
-            u32 numTracks = static_cast<u32>(tracks.size());
-            {
-                stream.write(reinterpret_cast<char const*>(&numTracks), sizeof(numTracks));
-
-                for (u32 i = 0; i < numTracks; i++)
-                {
-                    const ComplexAnimationTrack<T>& track = tracks[i];
+        // Range in ComplexModel::animationTracks
+        u32 trackOffset = 0;
+        u32 numTracks = 0;
 
-                    stream.write(reinterpret_cast<char const*>(&track.sequenceId), sizeof(track.sequenceId));
-
-                    u32 numTimestamps = static_cast<u32>(track.timestamps.size());
-                    {
-                        stream.write(reinterpret_cast<char const*>(&numTimestamps), sizeof(numTimestamps));
-                        stream.write(reinterpret_cast<char const*>(track.timestamps.data()), numTimestamps * sizeof(u32));
-                    }
-
-                    u32 numValues = static_cast<u32>(track.values.size());
-                    {
-                        stream.write(reinterpret_cast<char const*>(&numValues), sizeof(numValues));
-                        stream.write(reinterpret_cast<char const*>(track.values.data()), numTimestamps * sizeof(T));
-                    }
-                }
-            }
-        }
-        bool Deserialize(Bytebuffer* buffer)
+        // Reads a version 6 channel and appends its tracks and keys to the flat arrays, translation and scale keys are vec3, rotation keys are quaternions
+        template <typename T>
+        bool DeserializeLegacy(Bytebuffer* buffer, std::vector<ComplexAnimationTrack>& tracks, std::vector<u32>& timestamps, std::vector<vec4>& values)
         {
             if (!buffer->Get(interpolationType))
                 return false;
@@ -136,40 +115,51 @@ namespace CModel
             if (!buffer->Get(isGlobalSequence))
                 return false;
 
-            u32 numTracks = 0;
+            if (!buffer->GetU32(numTracks))
+                return false;
+
+            trackOffset = static_cast<u32>(tracks.size());
+            tracks.resize(trackOffset + numTracks);
+
+            for (u32 i = 0; i < numTracks; i++)
             {
-                if (!buffer->GetU32(numTracks))
+                ComplexAnimationTrack& track = tracks[trackOffset + i];
+
+                if (!buffer->GetU32(track.sequenceId))
                     return false;
 
-                tracks.resize(numTracks);
+                if (!buffer->GetU32(track.numTimestamps))
+                    return false;
 
-                for (u32 i = 0; i < numTracks; i++)
+                track.timestampOffset = static_cast<u32>(timestamps.size());
+                if (track.numTimestamps > 0)
                 {
-                    ComplexAnimationTrack<T>& track = tracks[i];
-
-                    if (!buffer->GetU32(track.sequenceId))
+                    timestamps.resize(track.timestampOffset + track.numTimestamps);
+                    if (!buffer->GetBytes(reinterpret_cast<u8*>(&timestamps[track.timestampOffset]), track.numTimestamps * sizeof(u32)))
                         return false;
+                }
 
-                    u32 numTimestamps = 0;
-                    if (!buffer->GetU32(numTimestamps))
-                        return false;
+                if (!buffer->GetU32(track.numValues))
+                    return false;
 
-                    if (numTimestamps > 0)
+                track.valueOffset = static_cast<u32>(values.size());
+                if (track.numValues > 0)
+                {
+                    values.resize(track.valueOffset + track.numValues);
+                    for (u32 j = 0; j < track.numValues; j++)
                     {
-                        track.timestamps.resize(numTimestamps);
-                        if (!buffer->GetBytes(reinterpret_cast<u8*>(track.timestamps.data()), numTimestamps * sizeof(u32)))
+                        T value;
+                        if (!buffer->Get(value))
                             return false;
-                    }
-
-                    u32 numValues = 0;
-                    if (!buffer->GetU32(numValues))
-                        return false;
 
-                    if (numValues > 0)
-                    {
-                        track.values.resize(numValues);
-                        if (!buffer->GetBytes(reinterpret_cast<u8*>(track.values.data()), numValues * sizeof(T)))
-                            return false;
+                        if constexpr (std::is_same_v<T, vec3>)
+                        {
+                            values[track.valueOffset + j] = vec4(value, 0.0f);
+                        }
+                        else
+                        {
+                            memcpy(&values[track.valueOffset + j], &value, sizeof(vec4));
+                        }
                     }
                 }
             }
@@ -231,9 +221,9 @@ namespace CModel
         i16 parentBoneId = -1;
         u16 submeshId = 0;
 
-        ComplexAnimationData<vec3> translation;
-        ComplexAnimationData<quaternion> rotation;
-        ComplexAnimationData<vec3> scale;
+        ComplexAnimationData translation;
+        ComplexAnimationData rotation;
+        ComplexAnimationData scale;
 
         vec3 pivot;
     };
@@ -318,7 +308,7 @@ namespace CModel
     struct ComplexModel
     {
     public:
-        NovusTypeHeader header = NovusTypeHeader(10, 6);
+        NovusTypeHeader header = NovusTypeHeader(10, 7);
 
         char* name;
         ComplexModelFlag flags;
@@ -327,6 +317,10 @@ namespace CModel
         std::vector<ComplexAnimationSequence> sequences;
         std::vector<ComplexBone> bones;
 
+        std::vector<ComplexAnimationTrack> animationTracks;
+        std::vector<u32> animationTrackTimestamps;
+        std::vector<vec4> animationTrackValues; // Translation and scale are stored as (x, y, z, 0), rotation as a quaternion (x, y, z, w)
+
         std::vector<ComplexVertex> vertices;
         std::vector<ComplexTexture> textures;
         std::vector<ComplexMaterial> materials;
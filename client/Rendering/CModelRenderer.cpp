@@ -8,6 +8,7 @@
 #include "../Editor/Editor.h"
 #include "SortUtils.h"
 #include "RenderUtils.h"
+#include "FrameSnapshot.h"
 
 #include <filesystem>
 #include <GLFW/glfw3.h>
@@ -21,13 +22,13 @@
 #include <Utils/FileReader.h>
 #include <Utils/ByteBuffer.h>
 #include <Utils/SafeVector.h>
+#include <Utils/Timer.h>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtx/quaternion.hpp>
 
 #include <entt.hpp>
-#include "../ECS/Components/Singletons/TimeSingleton.h"
 #include "../ECS/Components/Singletons/NDBCSingleton.h"
 #include "../ECS/Components/Singletons/TextureSingleton.h"
 
@@ -50,6 +51,10 @@ AutoCVar_Int CVAR_ComplexModelLockCullingFrustum("complexModels.lockCullingFrust
 AutoCVar_Int CVAR_ComplexModelDrawBoundingBoxes("complexModels.drawBoundingBoxes", "draw bounding boxes for complex models", 0, CVarFlags::EditCheckbox);
 AutoCVar_Int CVAR_ComplexModelOcclusionCullEnabled("complexModels.occlusionCullEnable", "enable culling of complex models", 1, CVarFlags::EditCheckbox);
 AutoCVar_Int CVAR_ComplexModelDrawCollisionMeshEnabled("complexModels.drawCollisionMesh", "enable collision mesh drawing of complex models (Requires Restart)", 0, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_ComplexModelCollisionEnabled("complexModels.collisionEnable", "register complex models as collidable and collide the local player against them (Requires Restart)", 0, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_ComplexModelCPUAnimation("complexModels.animation.cpuEvaluate", "evaluate bone animation on the CPU instead of in the animation prepass", 0, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_ComplexModelLogLoadTimes("complexModels.logLoadTimes", "print how long every ExecuteLoad spent decoding, committing and adding instances", 0, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_ComplexModelAsyncCommitsPerFrame("complexModels.asyncCommitsPerFrame", "max number of asynchronously loaded models committed to the renderer per frame", 4);
 AutoCVar_VecFloat CVAR_ComplexModelWireframeColor("complexModels.wireframeColor", "set the wireframe color for complex models", vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
 CModelRenderer::CModelRenderer(Renderer::Renderer* renderer, DebugRenderer* debugRenderer)
@@ -70,17 +75,34 @@ CModelRenderer::CModelRenderer(Renderer::Renderer* renderer, DebugRenderer* debu
     
     auto invisibleModelSink = registry->on_destroy<VisibleModel>();
     invisibleModelSink.connect<&CModelRenderer::OnModelInvisible>(this);
+
+    _modelLoadThread = std::thread(&CModelRenderer::ModelLoadThreadMain, this);
 }
 
 CModelRenderer::~CModelRenderer()
 {
+    {
+        std::unique_lock lock(_modelLoadMutex);
+        _modelLoadThreadShouldExit = true;
+    }
+    _modelLoadCondition.notify_all();
+    _modelLoadThread.join();
+
+    for (AsyncComplexModelLoad* asyncLoad : _modelLoadRequests)
+    {
+        delete asyncLoad;
+    }
 
+    AsyncComplexModelLoad* asyncLoad = nullptr;
+    while (_finishedModelLoads.try_dequeue(asyncLoad))
+    {
+        delete asyncLoad;
+    }
 }
 
 void CModelRenderer::OnModelCreated(entt::registry& registry, entt::entity entity)
 {
     ModelDisplayInfo& modelDisplayInfo = registry.get<ModelDisplayInfo>(entity);
-    registry.emplace<ModelCreatedThisFrame>(entity);
 
     NDBCSingleton& ndbcSingleton = registry.ctx<NDBCSingleton>();
     NDBC::File* creatureDisplayInfoFile = ndbcSingleton.GetNDBCFile("CreatureDisplayInfo");
@@ -139,33 +161,66 @@ void CModelRenderer::OnModelCreated(entt::registry& registry, entt::entity entit
         }
     });
 
-    std::scoped_lock lock(complexModel->mutex);
+    // The entity counts as visible right away, OnModelVisible skips it until it has an instance
+    registry.emplace_or_replace<VisibleModel>(entity);
 
-    static Terrain::Placement* defaultPlacement = new Terrain::Placement();
-    defaultPlacement->position = vec3(0, 0, 0);
-    defaultPlacement->rotation = quaternion(0, 0, 0, 1);
-    defaultPlacement->scale = static_cast<u16>(1024);
-
-    ComplexModelToBeLoaded modelToBeLoaded;
-    modelToBeLoaded.placement = defaultPlacement;
-    modelToBeLoaded.name = &modelPath;
-    modelToBeLoaded.nameHash = modelPathHash;
-    modelToBeLoaded.entityID = entity;
+    // Someone else already asked for this model, wait for the same load
+    auto waitingIt = _entitiesWaitingForModel.find(modelID);
+    if (waitingIt != _entitiesWaitingForModel.end())
+    {
+        waitingIt->second.push_back(entity);
+        return;
+    }
 
     if (shouldLoad)
     {
         _nameHashToCreatureDisplayInfo.Add(modelPathHash, creatureDisplayInfo);
         _nameHashToCreatureModelData.Add(modelPathHash, creatureModelData);
 
-        complexModel->modelID = modelID;
-        if (!LoadComplexModel(modelToBeLoaded, *complexModel))
+        _entitiesWaitingForModel[modelID].push_back(entity);
+
+        // Loading the file and its textures takes long enough to hitch the frame, so it happens on _modelLoadThread
+        AsyncComplexModelLoad* asyncLoad = new AsyncComplexModelLoad();
+        asyncLoad->modelID = modelID;
+        asyncLoad->generation = _modelLoadGeneration;
+
+        ComplexModelToBeLoaded& modelToBeLoaded = asyncLoad->toBeLoaded;
+        modelToBeLoaded.name = &modelPath;
+        modelToBeLoaded.nameHash = modelPathHash;
+        modelToBeLoaded.entityID = entity;
+        modelToBeLoaded.creatureDisplayInfo = creatureDisplayInfo;
+
+        asyncLoad->load.toBeLoaded = &asyncLoad->toBeLoaded;
+        asyncLoad->load.complexModel = &asyncLoad->complexModel;
+
         {
-            complexModel->failedToLoad = true;
-            DebugHandler::PrintError("Failed to load Complex Model: %s", complexModel->debugName.c_str());
+            std::unique_lock lock(_modelLoadMutex);
+            _modelLoadRequests.push_back(asyncLoad);
         }
-        complexModel->isStaticModel = false;
+        _modelLoadCondition.notify_one();
+        return;
     }
 
+    // An earlier load of this model failed, there is nothing to instance
+    if (complexModel->failedToLoad)
+        return;
+
+    CreateModelInstance(registry, entity, *complexModel);
+}
+
+void CModelRenderer::CreateModelInstance(entt::registry& registry, entt::entity entity, LoadedComplexModel& complexModel)
+{
+    ModelDisplayInfo& modelDisplayInfo = registry.get<ModelDisplayInfo>(entity);
+    registry.emplace_or_replace<ModelCreatedThisFrame>(entity);
+
+    u32 modelID = complexModel.modelID;
+    std::scoped_lock lock(complexModel.mutex);
+
+    static Terrain::Placement* defaultPlacement = new Terrain::Placement();
+    defaultPlacement->position = vec3(0, 0, 0);
+    defaultPlacement->rotation = quaternion(0, 0, 0, 1);
+    defaultPlacement->scale = static_cast<u16>(1024);
+
     // Check if we have a freed instance we can reuse
     bool reusedInstance = false;
     u32 instanceId = std::numeric_limits<u32>().max();
@@ -185,10 +240,10 @@ void CModelRenderer::OnModelCreated(entt::registry& registry, entt::entity entit
                 entt::registry* registry = ServiceLocator::GetGameRegistry();
                 CModelInfo& cmodelInfo = registry->get_or_emplace<CModelInfo>(entity, modelDisplayInfo.instanceID, false);
             
-                //if (complexModel->numCollisionTriangles > 0)
-                //{
-                //    registry->emplace_or_replace<Collidable>(entity);
-                //}
+                if (CVAR_ComplexModelCollisionEnabled.Get() && complexModel.numCollisionTriangles > 0)
+                {
+                    registry->emplace_or_replace<Collidable>(entity);
+                }
             
                 instanceIDToEntityID[modelDisplayInfo.instanceID] = entity;
             });
@@ -201,7 +256,7 @@ void CModelRenderer::OnModelCreated(entt::registry& registry, entt::entity entit
         size_t numTransparentDrawCallsBefore = _transparentDrawCalls.Size();
 
         // Add placement as an instance
-        AddInstance(*complexModel, *modelToBeLoaded.placement, modelToBeLoaded.entityID, modelDisplayInfo.instanceID);
+        AddInstance(complexModel, *defaultPlacement, entity, modelDisplayInfo.instanceID);
 
         size_t numOpaqueDrawCallsAfter = _opaqueDrawCalls.Size();
         size_t numTransparentDrawCallsAfter = _transparentDrawCalls.Size();
@@ -274,16 +329,16 @@ void CModelRenderer::OnModelCreated(entt::registry& registry, entt::entity entit
     {
         registry.emplace_or_replace<ModelIsReusedInstance>(entity);
 
-        if (complexModel->isAnimated)
+        if (complexModel.isAnimated)
         {
             AnimationSystem* animationSystem = ServiceLocator::GetAnimationSystem();
-            if (animationSystem->AddInstance(modelDisplayInfo.instanceID, *complexModel))
+            if (animationSystem->AddInstance(modelDisplayInfo.instanceID, complexModel))
             {
                 _animationSequences.ReadLock([&](const std::vector<AnimationSequence>& animationSequences)
                 {
-                    for (u32 i = 0; i < complexModel->numSequences; i++)
+                    for (u32 i = 0; i < complexModel.numSequences; i++)
                     {
-                        const AnimationSequence& animationSequence = animationSequences[complexModel->sequenceOffset + i];
+                        const AnimationSequence& animationSequence = animationSequences[complexModel.sequenceOffset + i];
 
                         if (animationSequence.flags.isAlwaysPlaying)
                         {
@@ -305,16 +360,129 @@ void CModelRenderer::OnModelCreated(entt::registry& registry, entt::entity entit
             // Play Stand By Default
             //if (!animationSystem->TryPlayAnimationID(modelDisplayInfo.instanceID, 0, true, true))
             //{
-            //    DebugHandler::PrintError("CModelRenderer : Failed to play animation 'Stand' for '%s'", complexModel->debugName.c_str());
+            //    DebugHandler::PrintError("CModelRenderer : Failed to play animation 'Stand' for '%s'", complexModel.debugName.c_str());
             //}
         }
     }
 
-    registry.remove<VisibleModel>(entity);
-    registry.emplace<VisibleModel>(entity);
+    // Let OnModelVisible pick up the new instance, unless the model was hidden while it was loading
+    if (registry.all_of<VisibleModel>(entity))
+    {
+        registry.remove<VisibleModel>(entity);
+        registry.emplace<VisibleModel>(entity);
+    }
     _loadingIsDirty = true;
 }
 
+void CModelRenderer::ModelLoadThreadMain()
+{
+    tracy::SetThreadName("ModelLoadThread");
+
+    while (true)
+    {
+        AsyncComplexModelLoad* asyncLoad = nullptr;
+        {
+            std::unique_lock lock(_modelLoadMutex);
+            _modelLoadCondition.wait(lock, [this]() { return !_modelLoadRequests.empty() || _modelLoadThreadShouldExit; });
+
+            if (_modelLoadThreadShouldExit)
+                break;
+
+            asyncLoad = _modelLoadRequests.front();
+            _modelLoadRequests.pop_front();
+        }
+
+        ZoneScopedN("CModelRenderer::ModelLoadThreadMain()::Decode");
+        ZoneText(asyncLoad->toBeLoaded.name->c_str(), asyncLoad->toBeLoaded.name->length());
+
+        // Clear has thrown away the model this was loading for, don't bother
+        if (asyncLoad->generation == _modelLoadGeneration)
+        {
+            if (!DecodeComplexModel(asyncLoad->load))
+            {
+                asyncLoad->complexModel.failedToLoad = true;
+                DebugHandler::PrintError("Failed to load Complex Model: %s", asyncLoad->complexModel.debugName.c_str());
+            }
+        }
+
+        _finishedModelLoads.enqueue(asyncLoad);
+    }
+}
+
+void CModelRenderer::CommitFinishedModelLoads()
+{
+    if (_finishedModelLoads.size_approx() == 0)
+        return;
+
+    ZoneScopedN("CModelRenderer::CommitFinishedModelLoads()");
+
+    // Committing grows every GPUVector the model touches, keep the number of models per frame down so a crowd spawning doesn't hitch
+    u32 commitBudget = static_cast<u32>(CVAR_ComplexModelAsyncCommitsPerFrame.Get());
+
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+
+    AsyncComplexModelLoad* asyncLoad = nullptr;
+    for (u32 i = 0; i < commitBudget && _finishedModelLoads.try_dequeue(asyncLoad); i++)
+    {
+        if (asyncLoad->generation != _modelLoadGeneration)
+        {
+            delete asyncLoad;
+            continue;
+        }
+
+        u32 modelID = asyncLoad->modelID;
+        LoadedComplexModel* complexModel = nullptr;
+        {
+            auto loadedComplexModelsWriteLock = SafeVectorScopedWriteLock(_loadedComplexModels);
+            std::vector<LoadedComplexModel>& loadedComplexModels = loadedComplexModelsWriteLock.Get();
+
+            asyncLoad->complexModel.modelID = modelID;
+            asyncLoad->complexModel.isStaticModel = false;
+
+            // Move the load over to its real slot before committing, so the offsets and the file data name end up pointing at it
+            complexModel = &loadedComplexModels[modelID];
+            *complexModel = asyncLoad->complexModel;
+            asyncLoad->load.complexModel = complexModel;
+            asyncLoad->load.cModel.name = complexModel->debugName.data();
+
+            if (!complexModel->failedToLoad)
+            {
+                std::vector<ComplexModelLoad> loads(1);
+                loads[0] = std::move(asyncLoad->load);
+
+                CommitComplexModels(loads, nullptr);
+            }
+        }
+
+        auto waitingIt = _entitiesWaitingForModel.find(modelID);
+        if (waitingIt != _entitiesWaitingForModel.end())
+        {
+            std::vector<entt::entity> waitingEntities = std::move(waitingIt->second);
+            _entitiesWaitingForModel.erase(waitingIt);
+
+            // Nothing was committed for a failed model, the waiting entities keep going without an instance
+            if (!complexModel->failedToLoad)
+            {
+                for (entt::entity entity : waitingEntities)
+                {
+                    // The entity might have been destroyed or lost its model while we were loading
+                    if (!registry->valid(entity) || !registry->all_of<ModelDisplayInfo>(entity))
+                        continue;
+
+                    CreateModelInstance(*registry, entity, *complexModel);
+
+                    if (registry->all_of<Transform>(entity))
+                    {
+                        registry->emplace_or_replace<TransformIsDirty>(entity);
+                    }
+                }
+            }
+        }
+
+        delete asyncLoad;
+    }
+}
+
 void CModelRenderer::OnModelDestroyed(entt::registry& registry, entt::entity entity)
 {
     OnModelInvisible(registry, entity);
@@ -322,6 +490,16 @@ void CModelRenderer::OnModelDestroyed(entt::registry& registry, entt::entity ent
     ModelDisplayInfo& modelDisplayInfo = registry.get<ModelDisplayInfo>(entity);
     u32 instanceID = modelDisplayInfo.instanceID;
 
+    // Still waiting for its model, make sure it doesn't get an instance when the model arrives
+    if (instanceID == std::numeric_limits<u32>().max())
+    {
+        for (auto& [modelID, waitingEntities] : _entitiesWaitingForModel)
+        {
+            waitingEntities.erase(std::remove(waitingEntities.begin(), waitingEntities.end(), entity), waitingEntities.end());
+        }
+        return;
+    }
+
     const ModelInstanceData& modelInstanceData = _modelInstanceDatas.ReadGet(instanceID);
 
     AnimationSystem* animationSystem = ServiceLocator::GetAnimationSystem();
@@ -349,6 +527,10 @@ void CModelRenderer::OnModelVisible(entt::registry& registry, entt::entity entit
     ModelDisplayInfo& modelDisplayInfo = registry.get<ModelDisplayInfo>(entity);
     u32 instanceID = modelDisplayInfo.instanceID;
 
+    // The model is still loading
+    if (instanceID == std::numeric_limits<u32>().max())
+        return;
+
     bool isCreatedThisFrame = registry.all_of<ModelCreatedThisFrame>(entity);
     bool isReusedInstance = registry.all_of<ModelIsReusedInstance>(entity);
 
@@ -400,6 +582,10 @@ void CModelRenderer::OnModelInvisible(entt::registry& registry, entt::entity ent
     ModelDisplayInfo& modelDisplayInfo = registry.get<ModelDisplayInfo>(entity);
     u32 instanceID = modelDisplayInfo.instanceID;
 
+    // The model is still loading
+    if (instanceID == std::numeric_limits<u32>().max())
+        return;
+
     bool isCreatedThisFrame = registry.all_of<ModelCreatedThisFrame>(entity);
     bool isReusedInstance = registry.all_of<ModelIsReusedInstance>(entity);
 
@@ -450,6 +636,9 @@ void CModelRenderer::Update(f32 deltaTime)
 
     SyncBuffers();
 
+    // After SyncBuffers so models committed here are uploaded as new elements next frame, like the ones created by OnModelCreated
+    CommitFinishedModelLoads();
+
     /*bool drawBoundingBoxes = CVAR_ComplexModelDrawBoundingBoxes.Get() == 1;
     if (drawBoundingBoxes)
     {
@@ -530,6 +719,13 @@ void CModelRenderer::Update(f32 deltaTime)
         }
     }
 
+    if (CVAR_ComplexModelCPUAnimation.Get() == 1)
+    {
+        UpdateAnimationsCPU(deltaTime);
+    }
+
+    RequestTextureDetail();
+
     // Read back from the culling counters
     u32 numOpaqueDrawCalls = static_cast<u32>(_opaqueDrawCalls.Size());
     u32 numTransparentDrawCalls = static_cast<u32>(_transparentDrawCalls.Size());
@@ -602,6 +798,264 @@ void CModelRenderer::Update(f32 deltaTime)
     }
 }
 
+void CModelRenderer::UpdateAnimationsCPU(f32 deltaTime)
+{
+    ZoneScopedN("CModelRenderer::UpdateAnimationsCPU()");
+
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+
+    auto boneInfoReadLock = SafeVectorScopedReadLock(_animationBoneInfo);
+    auto trackInfoReadLock = SafeVectorScopedReadLock(_animationTrackInfo);
+    auto trackTimestampReadLock = SafeVectorScopedReadLock(_animationTrackTimestamps);
+    auto trackValuesReadLock = SafeVectorScopedReadLock(_animationTrackValues);
+    auto sequencesReadLock = SafeVectorScopedReadLock(_animationSequences);
+    auto modelInfoReadLock = SafeVectorScopedReadLock(_animationModelInfo);
+    auto instanceDatasReadLock = SafeVectorScopedReadLock(_modelInstanceDatas);
+    auto instanceIDToEntityIDReadLock = SafeVectorScopedReadLock(_instanceIDToEntityID);
+    auto boneDeformMatricesWriteLock = SafeVectorScopedWriteLock(_animationBoneDeformMatrices);
+    auto boneInstancesWriteLock = SafeVectorScopedWriteLock(_animationBoneInstances);
+
+    const std::vector<AnimationBoneInfo>& animationBoneInfos = boneInfoReadLock.Get();
+    const std::vector<AnimationTrackInfo>& animationTrackInfos = trackInfoReadLock.Get();
+    const std::vector<u32>& animationTrackTimestamps = trackTimestampReadLock.Get();
+    const std::vector<vec4>& animationTrackValues = trackValuesReadLock.Get();
+    const std::vector<AnimationSequence>& animationSequences = sequencesReadLock.Get();
+    const std::vector<AnimationModelInfo>& animationModelInfos = modelInfoReadLock.Get();
+    const std::vector<ModelInstanceData>& modelInstanceDatas = instanceDatasReadLock.Get();
+    const std::vector<entt::entity>& instanceIDToEntityID = instanceIDToEntityIDReadLock.Get();
+    std::vector<mat4x4>& animationBoneDeformMatrices = boneDeformMatricesWriteLock.Get();
+    std::vector<AnimationBoneInstance>& animationBoneInstances = boneInstancesWriteLock.Get();
+
+    // Static placements have no entity and are always animated, like in the prepass
+    std::vector<u32> animatedInstanceIDs;
+    for (u32 instanceID = 0; instanceID < modelInstanceDatas.size(); instanceID++)
+    {
+        const ModelInstanceData& instanceData = modelInstanceDatas[instanceID];
+        if (instanceData.boneDeformOffset == std::numeric_limits<u32>().max())
+            continue;
+
+        if (animationModelInfos[instanceData.modelID].isAnimated == 0)
+            continue;
+
+        entt::entity entity = instanceIDToEntityID[instanceID];
+        if (entity != entt::null && !registry->all_of<VisibleModel>(entity))
+            continue;
+
+        animatedInstanceIDs.push_back(instanceID);
+    }
+
+    if (animatedInstanceIDs.empty())
+        return;
+
+    // Instances of the same model end up next to each other, so they share the bone infos and tracks in cache
+    std::sort(animatedInstanceIDs.begin(), animatedInstanceIDs.end(), [&](u32 a, u32 b)
+    {
+        return modelInstanceDatas[a].modelID < modelInstanceDatas[b].modelID;
+    });
+
+    // Mirrors the track sampling in cModelAnimation.inc.hlsl, including falling back to the default value past the last timestamp
+    auto sampleTrack = [&](const AnimationTrackInfo& trackInfo, f32 animationProgress, const vec4& defaultValue, bool isRotation) -> vec4
+    {
+        const u32* timestampsBegin = &animationTrackTimestamps[trackInfo.timestampOffset];
+        const u32* timestampsEnd = timestampsBegin + trackInfo.numTimestamps;
+
+        // Timestamps are sorted, so the first key after the current progress is a binary search away
+        const u32* nextTimestamp = std::upper_bound(timestampsBegin, timestampsEnd, animationProgress, [](f32 progress, u32 timestamp)
+        {
+            return progress < static_cast<f32>(timestamp) / 1000.f;
+        });
+
+        if (nextTimestamp == timestampsEnd)
+            return defaultValue;
+
+        u32 j = static_cast<u32>(nextTimestamp - timestampsBegin);
+
+        f32 prevTime = 0.f;
+        vec4 prevValue = defaultValue;
+        if (j > 0)
+        {
+            prevTime = static_cast<f32>(timestampsBegin[j - 1]) / 1000.f;
+            prevValue = animationTrackValues[trackInfo.valueOffset + (j - 1)];
+        }
+
+        f32 nextTime = static_cast<f32>(timestampsBegin[j]) / 1000.f;
+        vec4 nextValue = animationTrackValues[trackInfo.valueOffset + j];
+
+        f32 t = (animationProgress - prevTime) / (nextTime - prevTime);
+
+        if (isRotation)
+        {
+            prevValue = glm::normalize(prevValue);
+            nextValue = glm::normalize(nextValue);
+
+            if (glm::dot(prevValue, nextValue) < 0.0f)
+            {
+                nextValue = -nextValue;
+            }
+
+            return glm::normalize(prevValue - t * (prevValue - nextValue));
+        }
+
+        return glm::mix(prevValue, nextValue, t);
+    };
+
+    // Instances only get uploaded when their pose changed, stopped and unanimated ones settle after their first evaluation
+    std::vector<u8> poseChanged(modelInstanceDatas.size(), 0);
+
+    auto animateInstance = [&](u32 instanceID)
+    {
+        const ModelInstanceData& instanceData = modelInstanceDatas[instanceID];
+        const AnimationModelInfo& modelInfo = animationModelInfos[instanceData.modelID];
+
+        bool changed = false;
+        for (u32 i = 0; i < modelInfo.numBones; i++)
+        {
+            AnimationBoneInstance& boneInstance = animationBoneInstances[instanceData.boneInstanceDataOffset + i];
+            const AnimationBoneInfo& boneInfo = animationBoneInfos[modelInfo.boneInfoOffset + i];
+
+            u32 sequenceIndex = boneInstance.sequenceIndex;
+
+            if (boneInstance.animateState != AnimationBoneInstance::AnimateState::STOPPED)
+            {
+                const AnimationSequence& sequence = animationSequences[modelInfo.sequenceOffset + sequenceIndex];
+
+                boneInstance.animationProgress += deltaTime;
+                changed = true;
+
+                if (boneInstance.animationProgress >= sequence.duration)
+                {
+                    if (boneInstance.animateState == AnimationBoneInstance::AnimateState::PLAY_LOOP)
+                    {
+                        boneInstance.animationProgress -= sequence.duration;
+                    }
+                    else
+                    {
+                        boneInstance.animateState = AnimationBoneInstance::AnimateState::STOPPED;
+                        boneInstance.animationProgress = sequence.duration - 0.01f;
+                    }
+                }
+            }
+
+            mat4x4 parentBoneMatrix = mat4x4(1.0f);
+            if (boneInfo.parentBoneId >= 0)
+            {
+                parentBoneMatrix = animationBoneDeformMatrices[instanceData.boneDeformOffset + boneInfo.parentBoneId];
+            }
+
+            mat4x4& boneMatrix = animationBoneDeformMatrices[instanceData.boneDeformOffset + i];
+            if (!boneInfo.flags.animate)
+            {
+                changed |= boneMatrix != parentBoneMatrix;
+                boneMatrix = parentBoneMatrix;
+                continue;
+            }
+
+            vec4 translationValue = vec4(0.f, 0.f, 0.f, 0.f);
+            vec4 rotationValue = vec4(0.f, 0.f, 0.f, 1.f);
+            vec4 scaleValue = vec4(1.f, 1.f, 1.f, 0.f);
+
+            if (sequenceIndex != std::numeric_limits<u16>().max())
+            {
+                f32 animationProgress = boneInstance.animationProgress;
+
+                if (sequenceIndex < boneInfo.numScaleSequences)
+                {
+                    const AnimationTrackInfo& trackInfo = animationTrackInfos[boneInfo.scaleSequenceOffset + sequenceIndex];
+                    scaleValue = sampleTrack(trackInfo, animationProgress, scaleValue, false);
+                }
+
+                if (sequenceIndex < boneInfo.numRotationSequences)
+                {
+                    const AnimationTrackInfo& trackInfo = animationTrackInfos[boneInfo.rotationSequenceOffset + sequenceIndex];
+                    rotationValue = sampleTrack(trackInfo, animationProgress, rotationValue, true);
+                }
+
+                if (sequenceIndex < boneInfo.numTranslationSequences)
+                {
+                    const AnimationTrackInfo& trackInfo = animationTrackInfos[boneInfo.translationSequenceOffset + sequenceIndex];
+                    translationValue = sampleTrack(trackInfo, animationProgress, translationValue, false);
+                }
+            }
+
+            // The shader builds the same matrix for row vectors, the buffer layout ends up identical
+            vec3 pivotPoint = vec3(boneInfo.pivotPointX, boneInfo.pivotPointY, boneInfo.pivotPointZ);
+            quaternion rotation = quaternion(rotationValue.w, rotationValue.x, rotationValue.y, rotationValue.z);
+
+            mat4x4 localMatrix = glm::translate(mat4x4(1.0f), pivotPoint);
+            localMatrix = glm::translate(localMatrix, vec3(translationValue));
+            localMatrix = localMatrix * glm::toMat4(rotation);
+            localMatrix = glm::scale(localMatrix, vec3(scaleValue));
+            localMatrix = glm::translate(localMatrix, -pivotPoint);
+
+            mat4x4 newBoneMatrix = parentBoneMatrix * localMatrix;
+            changed |= boneMatrix != newBoneMatrix;
+            boneMatrix = newBoneMatrix;
+        }
+
+        poseChanged[instanceID] = changed;
+    };
+
+    tf::Taskflow tf(ServiceLocator::GetJobExecutor());
+    tf.parallel_for(animatedInstanceIDs.begin(), animatedInstanceIDs.end(), animateInstance);
+    tf.wait_for_all();
+
+    for (u32 instanceID : animatedInstanceIDs)
+    {
+        if (!poseChanged[instanceID])
+            continue;
+
+        const ModelInstanceData& instanceData = modelInstanceDatas[instanceID];
+        const AnimationModelInfo& modelInfo = animationModelInfos[instanceData.modelID];
+
+        _animationBoneDeformMatrices.SetDirtyElements(instanceData.boneDeformOffset, modelInfo.numBones);
+        _animationBoneInstances.SetDirtyElements(instanceData.boneInstanceDataOffset, modelInfo.numBones);
+    }
+}
+
+void CModelRenderer::RequestTextureDetail()
+{
+    ZoneScopedN("CModelRenderer::RequestTextureDetail()");
+
+    const vec3 cameraPosition = ServiceLocator::GetCamera()->GetPosition();
+
+    // A model's textures are shared by all of its instances, so the closest instance decides the detail
+    std::vector<f32> modelDistances(_loadedComplexModels.Size(), std::numeric_limits<f32>().max());
+
+    _modelInstanceDatas.ReadLock([&](const std::vector<ModelInstanceData>& modelInstanceDatas)
+    {
+        _modelInstanceMatrices.ReadLock([&](const std::vector<mat4x4>& modelInstanceMatrices)
+        {
+            const size_t numInstances = glm::min(modelInstanceDatas.size(), modelInstanceMatrices.size());
+            for (size_t i = 0; i < numInstances; i++)
+            {
+                u32 modelID = modelInstanceDatas[i].modelID;
+                if (modelID >= modelDistances.size())
+                    continue;
+
+                f32 distance = glm::distance(cameraPosition, vec3(modelInstanceMatrices[i][3]));
+                modelDistances[modelID] = glm::min(modelDistances[modelID], distance);
+            }
+        });
+    });
+
+    std::vector<Renderer::TextureStreamingRequest> requests;
+    _loadedComplexModels.ReadLock([&](const std::vector<LoadedComplexModel>& loadedComplexModels)
+    {
+        for (size_t i = 0; i < modelDistances.size(); i++)
+        {
+            if (modelDistances[i] == std::numeric_limits<f32>().max())
+                continue;
+
+            for (const Renderer::TextureID textureID : loadedComplexModels[i].textureIDs)
+            {
+                requests.push_back({ textureID, modelDistances[i] });
+            }
+        }
+    });
+
+    _renderer->RequestTextureDetail(requests);
+}
+
 void CModelRenderer::AddOccluderPass(Renderer::RenderGraph* renderGraph, RenderResources& resources, u8 frameIndex)
 {
     const u32 numInstances = static_cast<u32>(_modelInstanceDatas.Size());
@@ -626,6 +1080,8 @@ void CModelRenderer::AddOccluderPass(Renderer::RenderGraph* renderGraph, RenderR
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](CModelOccluderPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -768,6 +1224,8 @@ void CModelRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, RenderRe
         {
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](CModelCullingPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -776,9 +1234,9 @@ void CModelRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, RenderRe
 
             if (!lockFrustum)
             {
-                Camera* camera = ServiceLocator::GetCamera();
-                memcpy(_cullConstants.frustumPlanes, camera->GetFrustumPlanes(), sizeof(vec4[6]));
-                _cullConstants.cameraPos = camera->GetPosition();
+                const FrameSnapshot::CameraData& camera = resources.frameSnapshot->camera;
+                memcpy(_cullConstants.frustumPlanes, camera.frustumPlanes, sizeof(vec4[6]));
+                _cullConstants.cameraPos = camera.position;
             }
 
             Renderer::ComputePipelineDesc cullingPipelineDesc;
@@ -971,6 +1429,12 @@ void CModelRenderer::AddAnimationPass(Renderer::RenderGraph* renderGraph, Render
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
+            // The bone matrices were already evaluated in UpdateAnimationsCPU
+            if (CVAR_ComplexModelCPUAnimation.Get() == 1)
+                return false;
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](CModelAnimationPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -1015,9 +1479,6 @@ void CModelRenderer::AddAnimationPass(Renderer::RenderGraph* renderGraph, Render
                 Renderer::ComputePipelineID pipeline = _renderer->CreatePipeline(animationprepassPipelineDesc);
                 commandList.BeginPipeline(pipeline);
 
-                entt::registry* registry = ServiceLocator::GetGameRegistry();
-                TimeSingleton& timeSingleton = registry->ctx<TimeSingleton>();
-
                 struct AnimationConstants
                 {
                     u32 numInstances;
@@ -1027,7 +1488,7 @@ void CModelRenderer::AddAnimationPass(Renderer::RenderGraph* renderGraph, Render
                 AnimationConstants* deltaTimeConstant = graphResources.FrameNew<AnimationConstants>();
                 {
                     deltaTimeConstant->numInstances = numInstances;
-                    deltaTimeConstant->deltaTime = timeSingleton.deltaTime;
+                    deltaTimeConstant->deltaTime = resources.frameSnapshot->deltaTime;
                 
                     commandList.PushConstant(deltaTimeConstant, 0, sizeof(AnimationConstants));
                 }
@@ -1072,6 +1533,8 @@ void CModelRenderer::AddGeometryPass(Renderer::RenderGraph* renderGraph, RenderR
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](CModelGeometryPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -1200,6 +1663,8 @@ void CModelRenderer::AddEditorPass(Renderer::RenderGraph* renderGraph, RenderRes
             data.color = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](CModelPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -1315,6 +1780,8 @@ void CModelRenderer::AddTransparencyPass(Renderer::RenderGraph* renderGraph, Ren
             data.transparencyWeights = builder.Write(resources.transparencyWeights, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](CModelTransparencyPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -1425,7 +1892,7 @@ void CModelRenderer::RegisterLoadFromChunk(u16 chunkID, const Terrain::Chunk& ch
 
         {
             std::unique_lock lock(_uniqueIdCounterMutex);
-            if (_uniqueIdCounter[uniqueID]++ == 0)
+            if (_uniqueIdCounter.emplace(uniqueID, 1).second)
             {
                 _complexModelsToBeLoaded.WriteLock([&](std::vector<ComplexModelToBeLoaded>& complexModelsToBeLoaded)
                 {
@@ -1462,138 +1929,347 @@ void CModelRenderer::ExecuteLoad()
 {
     ZoneScopedN("CModelRenderer::ExecuteLoad()");
 
-    _numTotalAnimatedVertices = 0;
-    std::atomic<size_t> numComplexModelsToLoad = 0;
+    Timer loadTimer;
+
+    size_t numInstancesAdded = 0;
+    size_t numModelsLoaded = 0;
+    f32 decodeTimeMS = 0.0f;
+    f32 commitTimeMS = 0.0f;
+    f32 instanceTimeMS = 0.0f;
 
-    _complexModelsToBeLoaded.WriteLock([&](std::vector<ComplexModelToBeLoaded>& complexModelsToBeLoaded)
     {
-        size_t numComplexModelsToBeLoaded = complexModelsToBeLoaded.size();
+        auto complexModelsToBeLoadedWriteLock = SafeVectorScopedWriteLock(_complexModelsToBeLoaded);
+        std::vector<ComplexModelToBeLoaded>& complexModelsToBeLoaded = complexModelsToBeLoadedWriteLock.Get();
 
-        _loadedComplexModels.WriteLock([&](std::vector<LoadedComplexModel>& loadedComplexModels)
-        {
-            loadedComplexModels.reserve(numComplexModelsToBeLoaded);
-        });
+        size_t numComplexModelsToBeLoaded = complexModelsToBeLoaded.size();
+        if (numComplexModelsToBeLoaded == 0)
+            return;
 
-        _modelInstanceDatas.WriteLock([&](std::vector<ModelInstanceData>& modelInstanceDatas)
+        // Placements reference a path to a ComplexModel, several placements can reference the same object
+        // Because of this we resolve every placement to a model first, so each object is only loaded once no matter how many placements reference it
+        std::vector<ComplexModelLoad> loads;
+        std::vector<LoadedComplexModel*> placementModels(numComplexModelsToBeLoaded);
         {
-            modelInstanceDatas.reserve(numComplexModelsToBeLoaded);
-        });
+            ZoneScopedN("CModelRenderer::ExecuteLoad()::Deduplicate");
 
-        _instanceDisplayInfos.WriteLock([&](std::vector<InstanceDisplayInfo>& instanceDisplayInfos)
-        {
-            instanceDisplayInfos.reserve(numComplexModelsToBeLoaded);
-        });
+            std::vector<u32> placementModelIDs(numComplexModelsToBeLoaded);
+            size_t numLoadedComplexModels = 0;
 
-        _modelInstanceMatrices.WriteLock([&](std::vector<mat4x4>& modelInstanceMatrices)
-        {
-            modelInstanceMatrices.reserve(numComplexModelsToBeLoaded);
-        });
+            _nameHashToIndexMap.WriteLock([&](robin_hood::unordered_map<u32, u32>& nameHashToIndexMap)
+            {
+                auto loadedComplexModelsWriteLock = SafeVectorScopedWriteLock(_loadedComplexModels);
+                std::vector<LoadedComplexModel>& loadedComplexModels = loadedComplexModelsWriteLock.Get();
 
-        _animationModelInfo.WriteLock([&](std::vector<AnimationModelInfo>& animationModelInfo)
-        {
-            animationModelInfo.reserve(numComplexModelsToBeLoaded);
-        });
+                size_t firstModelID = loadedComplexModels.size();
 
-        _instanceIDToEntityID.WriteLock([&](std::vector<entt::entity>& instanceIDToEntityID)
-        {
-            instanceIDToEntityID.reserve(numComplexModelsToBeLoaded);
-        });
+                for (size_t i = 0; i < numComplexModelsToBeLoaded; i++)
+                {
+                    ComplexModelToBeLoaded& modelToBeLoaded = complexModelsToBeLoaded[i];
 
-#if PARALLEL_LOADING
-        tf::Taskflow tf;
-        tf.parallel_for(complexModelsToBeLoaded.begin(), complexModelsToBeLoaded.end(), [&](ComplexModelToBeLoaded& modelToBeLoaded)
-#else
-        for (ComplexModelToBeLoaded& modelToBeLoaded : complexModelsToBeLoaded)
-#endif // PARALLEL_LOAD
-        {
-            ZoneScoped;
-            ZoneText(modelToBeLoaded.name->c_str(), modelToBeLoaded.name->length());
+                    auto it = nameHashToIndexMap.find(modelToBeLoaded.nameHash);
+                    if (it == nameHashToIndexMap.end())
+                    {
+                        u32 modelID = static_cast<u32>(firstModelID + loads.size());
+                        nameHashToIndexMap[modelToBeLoaded.nameHash] = modelID;
 
-            // Placements reference a path to a ComplexModel, several placements can reference the same object
-            // Because of this we want only the first load to actually load the object, subsequent loads should reuse the loaded version
-            u32 modelID;
-            LoadedComplexModel* complexModel = nullptr;
+                        ComplexModelLoad& load = loads.emplace_back();
+                        load.toBeLoaded = &modelToBeLoaded;
 
-            bool shouldLoad = false;
-            _nameHashToIndexMap.WriteLock([&](robin_hood::unordered_map<u32, u32>& nameHashToIndexMap)
-            {
-                // See if anything has already loaded this one
-                auto it = nameHashToIndexMap.find(modelToBeLoaded.nameHash);
-                if (it == nameHashToIndexMap.end())
-                {
-                    // If it hasn't, we should load it
-                    shouldLoad = true;
-
-                    _loadedComplexModels.WriteLock([&](std::vector<LoadedComplexModel>& loadedComplexModels)
+                        placementModelIDs[i] = modelID;
+                    }
+                    else
                     {
-                        modelID = static_cast<u32>(loadedComplexModels.size());
-                        complexModel = &loadedComplexModels.emplace_back();
+                        placementModelIDs[i] = it->second;
+                    }
+                }
 
-                        // Create the CullingData
-                        _cullingDatas.WriteLock([&](std::vector<CModel::CullingData>& cullingDatas)
-                        {
-                            cullingDatas.push_back(CModel::CullingData());
-                        });
-                        
-                        // Create the AnimationModelInfo
-                        _animationModelInfo.WriteLock([&](std::vector<AnimationModelInfo>& animationModelInfo)
-                        {
-                            animationModelInfo.push_back(AnimationModelInfo());
-                        });
-                    });
+                // Grow once, so the pointers we hand out below stay valid for the rest of the load
+                loadedComplexModels.resize(firstModelID + loads.size());
+                numLoadedComplexModels = loadedComplexModels.size();
 
-                    nameHashToIndexMap[modelToBeLoaded.nameHash] = modelID;
+                for (size_t i = 0; i < loads.size(); i++)
+                {
+                    LoadedComplexModel& complexModel = loadedComplexModels[firstModelID + i];
+                    complexModel.modelID = static_cast<u32>(firstModelID + i);
+
+                    loads[i].complexModel = &complexModel;
                 }
-                else
+
+                for (size_t i = 0; i < numComplexModelsToBeLoaded; i++)
                 {
-                    _loadedComplexModels.WriteLock([&](std::vector<LoadedComplexModel>& loadedComplexModels)
-                    {
-                        modelID = it->second;
-                        complexModel = &loadedComplexModels[it->second];
-                    });
+                    placementModels[i] = &loadedComplexModels[placementModelIDs[i]];
                 }
             });
 
-            std::scoped_lock lock(complexModel->mutex);
+            _cullingDatas.WriteLock([&](std::vector<CModel::CullingData>& cullingDatas)
+            {
+                cullingDatas.resize(numLoadedComplexModels);
+            });
+
+            _animationModelInfo.WriteLock([&](std::vector<AnimationModelInfo>& animationModelInfo)
+            {
+                animationModelInfo.resize(numLoadedComplexModels);
+            });
+
+            numModelsLoaded = loads.size();
+        }
 
-            if (shouldLoad)
+        // Decode every new model into its own staging arrays, this is where the time goes and nothing in here is shared
+        {
+            ZoneScopedN("CModelRenderer::ExecuteLoad()::Decode");
+            Timer decodeTimer;
+
+#if PARALLEL_LOADING
+            tf::Taskflow tf(ServiceLocator::GetJobExecutor());
+            tf.parallel_for(loads.begin(), loads.end(), [&](ComplexModelLoad& load)
+#else
+            for (ComplexModelLoad& load : loads)
+#endif // PARALLEL_LOAD
             {
-                complexModel->modelID = modelID;
-                if (!LoadComplexModel(modelToBeLoaded, *complexModel))
+                ZoneScoped;
+                ZoneText(load.toBeLoaded->name->c_str(), load.toBeLoaded->name->length());
+
+                LoadedComplexModel& complexModel = *load.complexModel;
+                if (!DecodeComplexModel(load))
                 {
-                    complexModel->failedToLoad = true;
-                    DebugHandler::PrintError("Failed to load Complex Model: %s", complexModel->debugName.c_str());
+                    complexModel.failedToLoad = true;
+                    DebugHandler::PrintError("Failed to load Complex Model: %s", complexModel.debugName.c_str());
                 }
 
-                complexModel->isStaticModel = true;
+                complexModel.isStaticModel = true;
             }
+#if PARALLEL_LOADING
+            );
+            tf.wait_for_all();
+#endif // PARALLEL_LOADING
 
-            if (complexModel->failedToLoad)
-            {
-                //DebugHandler::PrintWarning("Failed to Add Instance of Complex Model: %s", complexModel->debugName.c_str());
+            decodeTimeMS = decodeTimer.GetLifeTime() * 1000.0f;
+        }
+
+        // Place the staged models in the shared arrays
+        {
+            ZoneScopedN("CModelRenderer::ExecuteLoad()::Commit");
+            Timer commitTimer;
 
 #if PARALLEL_LOADING
-                return;
-#else // PARALLEL_LOADING
-                continue;
+            tf::Taskflow tf(ServiceLocator::GetJobExecutor());
+            CommitComplexModels(loads, &tf);
+#else
+            CommitComplexModels(loads, nullptr);
 #endif // PARALLEL_LOADING
+
+            commitTimeMS = commitTimer.GetLifeTime() * 1000.0f;
+        }
+
+        // Add every placement as an instance, the offsets are handed out up front so the instances can be filled in without locking
+        {
+            ZoneScopedN("CModelRenderer::ExecuteLoad()::AddInstances");
+            Timer instanceTimer;
+
+            struct InstanceToAdd
+            {
+                const ComplexModelToBeLoaded* toBeLoaded = nullptr;
+                const LoadedComplexModel* complexModel = nullptr;
+
+                u32 instanceID = 0;
+                u32 opaqueDrawCallOffset = 0;
+                u32 transparentDrawCallOffset = 0;
+                u32 animatedVertexOffset = 0;
+                u32 boneDeformOffset = std::numeric_limits<u32>().max();
+                u32 boneInstanceDataOffset = std::numeric_limits<u32>().max();
+            };
+
+            std::vector<InstanceToAdd> instancesToAdd;
+            instancesToAdd.reserve(numComplexModelsToBeLoaded);
+
+            auto modelInstanceDatasWriteLock = SafeVectorScopedWriteLock(_modelInstanceDatas);
+            auto modelInstanceMatricesWriteLock = SafeVectorScopedWriteLock(_modelInstanceMatrices);
+            auto instanceDisplayInfosWriteLock = SafeVectorScopedWriteLock(_instanceDisplayInfos);
+            auto instanceIDToEntityIDWriteLock = SafeVectorScopedWriteLock(_instanceIDToEntityID);
+            auto boneDeformMatricesWriteLock = SafeVectorScopedWriteLock(_animationBoneDeformMatrices);
+            auto boneInstancesWriteLock = SafeVectorScopedWriteLock(_animationBoneInstances);
+            auto opaqueDrawCallsWriteLock = SafeVectorScopedWriteLock(_opaqueDrawCalls);
+            auto opaqueDrawCallDatasWriteLock = SafeVectorScopedWriteLock(_opaqueDrawCallDatas);
+            auto transparentDrawCallsWriteLock = SafeVectorScopedWriteLock(_transparentDrawCalls);
+            auto transparentDrawCallDatasWriteLock = SafeVectorScopedWriteLock(_transparentDrawCallDatas);
+
+            std::vector<ModelInstanceData>& modelInstanceDatas = modelInstanceDatasWriteLock.Get();
+            std::vector<mat4x4>& modelInstanceMatrices = modelInstanceMatricesWriteLock.Get();
+            std::vector<InstanceDisplayInfo>& instanceDisplayInfos = instanceDisplayInfosWriteLock.Get();
+            std::vector<entt::entity>& instanceIDToEntityID = instanceIDToEntityIDWriteLock.Get();
+            std::vector<mat4x4>& animationBoneDeformMatrices = boneDeformMatricesWriteLock.Get();
+            std::vector<AnimationBoneInstance>& animationBoneInstances = boneInstancesWriteLock.Get();
+            std::vector<DrawCall>& opaqueDrawCalls = opaqueDrawCallsWriteLock.Get();
+            std::vector<DrawCallData>& opaqueDrawCallDatas = opaqueDrawCallDatasWriteLock.Get();
+            std::vector<DrawCall>& transparentDrawCalls = transparentDrawCallsWriteLock.Get();
+            std::vector<DrawCallData>& transparentDrawCallDatas = transparentDrawCallDatasWriteLock.Get();
+
+            size_t numInstances = modelInstanceDatas.size();
+            size_t numOpaqueDrawCalls = opaqueDrawCalls.size();
+            size_t numTransparentDrawCalls = transparentDrawCalls.size();
+            size_t numBoneDeformMatrices = animationBoneDeformMatrices.size();
+            size_t numBoneInstances = animationBoneInstances.size();
+
+            for (size_t i = 0; i < numComplexModelsToBeLoaded; i++)
+            {
+                const LoadedComplexModel* complexModel = placementModels[i];
+                if (complexModel->failedToLoad)
+                    continue;
+
+                InstanceToAdd& instance = instancesToAdd.emplace_back();
+                instance.toBeLoaded = &complexModelsToBeLoaded[i];
+                instance.complexModel = complexModel;
+                instance.instanceID = static_cast<u32>(numInstances++);
+
+                instance.opaqueDrawCallOffset = static_cast<u32>(numOpaqueDrawCalls);
+                numOpaqueDrawCalls += complexModel->numOpaqueDrawCalls;
+
+                instance.transparentDrawCallOffset = static_cast<u32>(numTransparentDrawCalls);
+                numTransparentDrawCalls += complexModel->numTransparentDrawCalls;
+
+                if (complexModel->isAnimated)
+                {
+                    u32 numBones = complexModel->numBones;
+                    assert(numBones > 0);
+
+                    instance.animatedVertexOffset = _numTotalAnimatedVertices.fetch_add(complexModel->numVertices);
+
+                    instance.boneDeformOffset = static_cast<u32>(numBoneDeformMatrices);
+                    numBoneDeformMatrices += numBones;
+
+                    instance.boneInstanceDataOffset = static_cast<u32>(numBoneInstances);
+                    numBoneInstances += numBones;
+                }
             }
 
-            // Add placement as an instance
-            u32 instanceId = std::numeric_limits<u32>().max();
-            AddInstance(*complexModel, *modelToBeLoaded.placement, modelToBeLoaded.entityID, instanceId);
+            modelInstanceDatas.resize(numInstances);
+            modelInstanceMatrices.resize(numInstances);
+            instanceDisplayInfos.resize(numInstances);
+            instanceIDToEntityID.resize(numInstances);
+            animationBoneDeformMatrices.resize(numBoneDeformMatrices, mat4x4(1));
+            animationBoneInstances.resize(numBoneInstances);
+            opaqueDrawCalls.resize(numOpaqueDrawCalls);
+            opaqueDrawCallDatas.resize(numOpaqueDrawCalls);
+            transparentDrawCalls.resize(numTransparentDrawCalls);
+            transparentDrawCallDatas.resize(numTransparentDrawCalls);
+
+            auto fillInstance = [&](const InstanceToAdd& instance)
+            {
+                const LoadedComplexModel& complexModel = *instance.complexModel;
+                const Terrain::Placement& placement = *instance.toBeLoaded->placement;
+
+                vec3 pos = placement.position;
+                quaternion rot = placement.rotation;
+                vec3 scale = vec3(placement.scale) / 1024.0f;
+
+                mat4x4 rotationMatrix = glm::toMat4(rot);
+                mat4x4 scaleMatrix = glm::scale(mat4x4(1.0f), scale);
+                modelInstanceMatrices[instance.instanceID] = glm::translate(mat4x4(1.0f), pos) * rotationMatrix * scaleMatrix;
+
+                ModelInstanceData& modelInstanceData = modelInstanceDatas[instance.instanceID];
+                modelInstanceData.modelID = complexModel.modelID;
+                modelInstanceData.modelVertexOffset = complexModel.vertexOffset;
+                modelInstanceData.animatedVertexOffset = instance.animatedVertexOffset;
+                modelInstanceData.boneDeformOffset = instance.boneDeformOffset;
+                modelInstanceData.boneInstanceDataOffset = instance.boneInstanceDataOffset;
+
+                // Placements loaded through here never have an entity, see RegisterLoadFromChunk
+                instanceIDToEntityID[instance.instanceID] = instance.toBeLoaded->entityID;
+
+                InstanceDisplayInfo& instanceDisplayInfo = instanceDisplayInfos[instance.instanceID];
+                instanceDisplayInfo.opaqueDrawCallOffset = instance.opaqueDrawCallOffset;
+                instanceDisplayInfo.opaqueDrawCallCount = complexModel.numOpaqueDrawCalls;
+                instanceDisplayInfo.transparentDrawCallOffset = instance.transparentDrawCallOffset;
+                instanceDisplayInfo.transparentDrawCallCount = complexModel.numTransparentDrawCalls;
+
+                for (u32 i = 0; i < complexModel.numOpaqueDrawCalls; i++)
+                {
+                    const DrawCall& drawCallTemplate = complexModel.opaqueDrawCallTemplates[i];
+                    const DrawCallData& drawCallDataTemplate = complexModel.opaqueDrawCallDataTemplates[i];
+
+                    u32 drawCallID = instance.opaqueDrawCallOffset + i;
+                    DrawCall& drawCall = opaqueDrawCalls[drawCallID];
+                    DrawCallData& drawCallData = opaqueDrawCallDatas[drawCallID];
+
+                    drawCall = drawCallTemplate;
+                    drawCall.drawID = drawCallID; // This is used in the shader to retrieve the DrawCallData
+
+                    drawCallData = drawCallDataTemplate;
+                    drawCallData.instanceID = instance.instanceID;
+                }
+
+                for (u32 i = 0; i < complexModel.numTransparentDrawCalls; i++)
+                {
+                    const DrawCall& drawCallTemplate = complexModel.transparentDrawCallTemplates[i];
+                    const DrawCallData& drawCallDataTemplate = complexModel.transparentDrawCallDataTemplates[i];
+
+                    u32 drawCallID = instance.transparentDrawCallOffset + i;
+                    DrawCall& drawCall = transparentDrawCalls[drawCallID];
+                    DrawCallData& drawCallData = transparentDrawCallDatas[drawCallID];
+
+                    drawCall = drawCallTemplate;
+                    drawCall.drawID = drawCallID; // This is used in the shader to retrieve the DrawCallData
+
+                    drawCallData = drawCallDataTemplate;
+                    drawCallData.instanceID = instance.instanceID;
+                }
+            };
 
-            numComplexModelsToLoad++;
-        }
 #if PARALLEL_LOADING
-        );
-        tf.wait_for_all();
+            tf::Taskflow tf(ServiceLocator::GetJobExecutor());
+            tf.parallel_for(instancesToAdd.begin(), instancesToAdd.end(), fillInstance);
+            tf.wait_for_all();
+#else
+            for (const InstanceToAdd& instance : instancesToAdd)
+            {
+                fillInstance(instance);
+            }
 #endif // PARALLEL_LOADING
-    });
 
-    _complexModelsToBeLoaded.Clear();
+            // What's left touches maps and the AnimationSystem, neither of which we can fill in parallel
+            _opaqueDrawCallDataIndexToLoadedModelIndex.WriteLock([&](robin_hood::unordered_map<u32, u32>& opaqueDrawCallDataIndexToLoadedModelIndex)
+            {
+                _transparentDrawCallDataIndexToLoadedModelIndex.WriteLock([&](robin_hood::unordered_map<u32, u32>& transparentDrawCallDataIndexToLoadedModelIndex)
+                {
+                    for (const InstanceToAdd& instance : instancesToAdd)
+                    {
+                        const LoadedComplexModel& complexModel = *instance.complexModel;
+
+                        for (u32 i = 0; i < complexModel.numOpaqueDrawCalls; i++)
+                        {
+                            opaqueDrawCallDataIndexToLoadedModelIndex[instance.opaqueDrawCallOffset + i] = complexModel.modelID;
+                        }
+
+                        for (u32 i = 0; i < complexModel.numTransparentDrawCalls; i++)
+                        {
+                            transparentDrawCallDataIndexToLoadedModelIndex[instance.transparentDrawCallOffset + i] = complexModel.modelID;
+                        }
+                    }
+                });
+            });
 
-    if (numComplexModelsToLoad == 0)
+            AnimationSystem* animationSystem = ServiceLocator::GetAnimationSystem();
+            for (const InstanceToAdd& instance : instancesToAdd)
+            {
+                if (instance.complexModel->isAnimated)
+                {
+                    animationSystem->AddInstance(instance.instanceID, *instance.complexModel);
+                }
+            }
+
+            numInstancesAdded = instancesToAdd.size();
+            instanceTimeMS = instanceTimer.GetLifeTime() * 1000.0f;
+        }
+
+        complexModelsToBeLoaded.clear();
+    }
+
+    if (CVAR_ComplexModelLogLoadTimes.Get())
+    {
+        DebugHandler::Print("CModelRenderer: Loaded %u placements of %u new models in %.2fms (decode %.2fms, commit %.2fms, instances %.2fms)", static_cast<u32>(numInstancesAdded), static_cast<u32>(numModelsLoaded), loadTimer.GetLifeTime() * 1000.0f, decodeTimeMS, commitTimeMS, instanceTimeMS);
+    }
+
+    if (numInstancesAdded == 0)
         return;
 
     {
@@ -1622,6 +2298,238 @@ void CModelRenderer::ExecuteLoad()
     }
 }
 
+bool CModelRenderer::BenchmarkLoad(u32 numModels, LoadBenchmarkResult& result)
+{
+    ZoneScopedN("CModelRenderer::BenchmarkLoad()");
+
+    // Copy the names out, the loaded models might move while we decode
+    std::vector<std::string> modelPaths;
+    _loadedComplexModels.ReadLock([&](const std::vector<LoadedComplexModel>& loadedComplexModels)
+    {
+        for (const LoadedComplexModel& complexModel : loadedComplexModels)
+        {
+            if (modelPaths.size() >= numModels)
+                break;
+
+            if (!complexModel.failedToLoad && !complexModel.debugName.empty())
+            {
+                modelPaths.push_back(complexModel.debugName);
+            }
+        }
+    });
+
+    result.numModels = static_cast<u32>(modelPaths.size());
+    if (result.numModels == 0)
+        return false;
+
+    std::vector<ComplexModelToBeLoaded> modelsToBeLoaded(result.numModels);
+    for (u32 i = 0; i < result.numModels; i++)
+    {
+        modelsToBeLoaded[i].name = &modelPaths[i];
+    }
+
+    // Stand ins for the shared arrays ExecuteLoad places the models in
+    struct SharedArrays
+    {
+        std::vector<Geometry::Triangle> collisionTriangles;
+        std::vector<CModel::ComplexVertex> vertices;
+        std::vector<u16> indices;
+        std::vector<TextureUnit> textureUnits;
+        std::vector<AnimationSequence> animationSequences;
+        std::vector<AnimationBoneInfo> animationBoneInfos;
+        std::vector<AnimationTrackInfo> animationTrackInfos;
+        std::vector<u32> animationTrackTimestamps;
+        std::vector<vec4> animationTrackValues;
+    };
+
+    std::atomic<u32> numFailed = 0;
+    auto decode = [&](ComplexModelLoad& load)
+    {
+        if (!DecodeComplexModel(load))
+        {
+            load.complexModel->failedToLoad = true;
+            numFailed++;
+        }
+    };
+
+    // Locked, replays the lock traffic of the old ExecuteLoad. Every model takes the name map lock and grows the model arrays under it,
+    // then appends each of its sections to the shared array under that array's own lock.
+    // The old path also converted every section while holding its lock, here that already happened in decode,
+    // so this only gives a lower bound of what the old scheme cost
+    {
+        std::vector<LoadedComplexModel> complexModels(result.numModels);
+        std::vector<ComplexModelLoad> loads(result.numModels);
+        for (u32 i = 0; i < result.numModels; i++)
+        {
+            loads[i].toBeLoaded = &modelsToBeLoaded[i];
+            loads[i].complexModel = &complexModels[i];
+        }
+
+        SharedArrays arrays;
+        std::mutex arrayMutexes[9];
+
+        robin_hood::unordered_map<u32, u32> nameHashToIndexMap;
+        std::vector<u32> modelIDs;
+        std::vector<CModel::CullingData> cullingDatas;
+        std::vector<AnimationModelInfo> animationModelInfos;
+        std::mutex nameHashToIndexMutex;
+        std::mutex modelIDsMutex;
+        std::mutex cullingDatasMutex;
+        std::mutex animationModelInfosMutex;
+
+        auto append = [](auto& dst, const auto& src, std::mutex& mutex)
+        {
+            std::scoped_lock lock(mutex);
+            dst.insert(dst.end(), src.begin(), src.end());
+        };
+
+        Timer timer;
+
+        tf::Taskflow tf(ServiceLocator::GetJobExecutor());
+        tf.parallel_for(loads.begin(), loads.end(), [&](ComplexModelLoad& load)
+        {
+            // Every benchmarked model is a different one, so the index stands in for the name hash
+            u32 nameHash = static_cast<u32>(&load - loads.data());
+            u32 modelID = 0;
+            {
+                std::scoped_lock nameHashToIndexLock(nameHashToIndexMutex);
+
+                auto it = nameHashToIndexMap.find(nameHash);
+                if (it == nameHashToIndexMap.end())
+                {
+                    std::scoped_lock modelIDsLock(modelIDsMutex);
+
+                    modelID = static_cast<u32>(modelIDs.size());
+                    modelIDs.push_back(modelID);
+                    {
+                        std::scoped_lock cullingDatasLock(cullingDatasMutex);
+                        cullingDatas.push_back(CModel::CullingData());
+                    }
+                    {
+                        std::scoped_lock animationModelInfosLock(animationModelInfosMutex);
+                        animationModelInfos.push_back(AnimationModelInfo());
+                    }
+
+                    nameHashToIndexMap[nameHash] = modelID;
+                }
+                else
+                {
+                    modelID = it->second;
+                }
+            }
+
+            std::scoped_lock lock(load.complexModel->mutex);
+
+            decode(load);
+            if (load.complexModel->failedToLoad)
+                return;
+
+            {
+                std::scoped_lock cullingDatasLock(cullingDatasMutex);
+                cullingDatas[modelID] = load.cModel.cullingData;
+            }
+
+            append(arrays.collisionTriangles, load.collisionTriangles, arrayMutexes[0]);
+            append(arrays.vertices, load.vertices, arrayMutexes[1]);
+            append(arrays.indices, load.indices, arrayMutexes[2]);
+            append(arrays.textureUnits, load.textureUnits, arrayMutexes[3]);
+            append(arrays.animationSequences, load.animationSequences, arrayMutexes[4]);
+            append(arrays.animationBoneInfos, load.animationBoneInfos, arrayMutexes[5]);
+            append(arrays.animationTrackInfos, load.animationTrackInfos, arrayMutexes[6]);
+            append(arrays.animationTrackTimestamps, load.animationTrackTimestamps, arrayMutexes[7]);
+            append(arrays.animationTrackValues, load.animationTrackValues, arrayMutexes[8]);
+        });
+        tf.wait_for_all();
+
+        result.lockedTimeMS = timer.GetLifeTime() * 1000.0f;
+    }
+
+    // Both passes decode the same models, so only count the failures once
+    result.numFailed = numFailed;
+
+    // Staged, the same placement CommitComplexModels does
+    {
+        std::vector<LoadedComplexModel> complexModels(result.numModels);
+        std::vector<ComplexModelLoad> loads(result.numModels);
+        for (u32 i = 0; i < result.numModels; i++)
+        {
+            loads[i].toBeLoaded = &modelsToBeLoaded[i];
+            loads[i].complexModel = &complexModels[i];
+        }
+
+        SharedArrays arrays;
+
+        auto reserveRange = [](const auto& src, size_t& size, u32& offset)
+        {
+            offset = static_cast<u32>(size);
+            size += src.size();
+        };
+
+        auto copy = [](auto& dst, const auto& src, u32 offset)
+        {
+            std::copy(src.begin(), src.end(), dst.begin() + offset);
+        };
+
+        Timer timer;
+
+        tf::Taskflow tf(ServiceLocator::GetJobExecutor());
+        tf.parallel_for(loads.begin(), loads.end(), decode);
+        tf.wait_for_all();
+
+        Timer commitTimer;
+
+        size_t sizes[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        for (ComplexModelLoad& load : loads)
+        {
+            if (load.complexModel->failedToLoad)
+                continue;
+
+            reserveRange(load.collisionTriangles, sizes[0], load.collisionTriangleOffset);
+            reserveRange(load.vertices, sizes[1], load.vertexOffset);
+            reserveRange(load.indices, sizes[2], load.indexOffset);
+            reserveRange(load.textureUnits, sizes[3], load.textureUnitOffset);
+            reserveRange(load.animationSequences, sizes[4], load.sequenceOffset);
+            reserveRange(load.animationBoneInfos, sizes[5], load.boneInfoOffset);
+            reserveRange(load.animationTrackInfos, sizes[6], load.trackInfoOffset);
+            reserveRange(load.animationTrackTimestamps, sizes[7], load.trackTimestampOffset);
+            reserveRange(load.animationTrackValues, sizes[8], load.trackValueOffset);
+        }
+
+        arrays.collisionTriangles.resize(sizes[0]);
+        arrays.vertices.resize(sizes[1]);
+        arrays.indices.resize(sizes[2]);
+        arrays.textureUnits.resize(sizes[3]);
+        arrays.animationSequences.resize(sizes[4]);
+        arrays.animationBoneInfos.resize(sizes[5]);
+        arrays.animationTrackInfos.resize(sizes[6]);
+        arrays.animationTrackTimestamps.resize(sizes[7]);
+        arrays.animationTrackValues.resize(sizes[8]);
+
+        tf::Taskflow commitTF(ServiceLocator::GetJobExecutor());
+        commitTF.parallel_for(loads.begin(), loads.end(), [&](ComplexModelLoad& load)
+        {
+            if (load.complexModel->failedToLoad)
+                return;
+
+            copy(arrays.collisionTriangles, load.collisionTriangles, load.collisionTriangleOffset);
+            copy(arrays.vertices, load.vertices, load.vertexOffset);
+            copy(arrays.indices, load.indices, load.indexOffset);
+            copy(arrays.textureUnits, load.textureUnits, load.textureUnitOffset);
+            copy(arrays.animationSequences, load.animationSequences, load.sequenceOffset);
+            copy(arrays.animationBoneInfos, load.animationBoneInfos, load.boneInfoOffset);
+            copy(arrays.animationTrackInfos, load.animationTrackInfos, load.trackInfoOffset);
+            copy(arrays.animationTrackTimestamps, load.animationTrackTimestamps, load.trackTimestampOffset);
+            copy(arrays.animationTrackValues, load.animationTrackValues, load.trackValueOffset);
+        });
+        commitTF.wait_for_all();
+
+        result.stagedCommitTimeMS = commitTimer.GetLifeTime() * 1000.0f;
+        result.stagedTimeMS = timer.GetLifeTime() * 1000.0f;
+    }
+
+    return true;
+}
+
 void CModelRenderer::Clear()
 {
     {
@@ -1629,6 +2537,18 @@ void CModelRenderer::Clear()
         _uniqueIdCounter.clear();
     }
     
+    // Loads that are still in flight refer to model IDs we are about to throw away
+    _modelLoadGeneration++;
+    {
+        std::unique_lock lock(_modelLoadMutex);
+        for (AsyncComplexModelLoad* asyncLoad : _modelLoadRequests)
+        {
+            delete asyncLoad;
+        }
+        _modelLoadRequests.clear();
+    }
+    _entitiesWaitingForModel.clear();
+
     _loadedComplexModels.Clear();
     _loadedComplexModelFileData.Clear();
     _nameHashToIndexMap.Clear();
@@ -1653,6 +2573,7 @@ void CModelRenderer::Clear()
     _animationTrackValues.Clear();
     _animationBoneDeformMatrices.Clear();
     _animationBoneInstances.Clear();
+    _numTotalAnimatedVertices = 0;
 
     // This clears _animationRequests, stupid moodycamel :(
     AnimationRequest animationRequest;
@@ -1667,7 +2588,10 @@ void CModelRenderer::Clear()
     _transparentDrawCalls.Clear();
     _transparentDrawCallDatas.Clear();
 
-    _renderer->UnloadTexturesInArray(_cModelTextures, 0);
+    {
+        std::scoped_lock lock(_textureLoadMutex);
+        _renderer->UnloadTexturesInArray(_cModelTextures, 0);
+    }
 
     // Entity IDs are cleared in the registry when a new map is loaded in TerrainRenderer
     _instanceIDToEntityID.Clear();
@@ -1798,31 +2722,33 @@ void CModelRenderer::CreatePermanentResources()
 
 bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, LoadedComplexModel& complexModel)
 {
+    std::vector<ComplexModelLoad> loads(1);
+
+    ComplexModelLoad& load = loads[0];
+    load.toBeLoaded = &toBeLoaded;
+    load.complexModel = &complexModel;
+
+    if (!DecodeComplexModel(load))
+        return false;
+
+    CommitComplexModels(loads, nullptr);
+    return true;
+}
+
+bool CModelRenderer::DecodeComplexModel(ComplexModelLoad& load)
+{
+    ComplexModelToBeLoaded& toBeLoaded = *load.toBeLoaded;
+    LoadedComplexModel& complexModel = *load.complexModel;
+
     const std::string& modelPath = *toBeLoaded.name;
     complexModel.debugName = modelPath;
 
-    CModel::ComplexModel cModel;
+    CModel::ComplexModel& cModel = load.cModel;
     cModel.name = complexModel.debugName.data();
 
     if (!LoadFile(modelPath, cModel))
         return false;
 
-    _loadedComplexModelFileData.WriteLock([&](std::vector<CModel::ComplexModel>& complexModelsFileData)
-    {
-        size_t numComplexModelsFileData = complexModelsFileData.size();
-        if (numComplexModelsFileData <= complexModel.modelID)
-            complexModelsFileData.resize(complexModel.modelID + 1);
-
-        complexModelsFileData[complexModel.modelID] = cModel;
-    });
-
-    // Set the CullingData
-    _cullingDatas.WriteLock([&](std::vector<CModel::CullingData>& cullingDatas)
-    {
-        CModel::CullingData& cullingData = cullingDatas[complexModel.modelID];
-        cullingData = cModel.cullingData;
-    });
-
     complexModel.collisionAABB = cModel.collisionAABB;
 
     entt::registry* registry = ServiceLocator::GetGameRegistry();
@@ -1837,8 +2763,9 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
         size_t numCollisionTrianglesBeforeAdd = 0;
         size_t numCollisionTrianglesToAdd = 0;
 
-        _collisionTriangles.WriteLock([&](std::vector<Geometry::Triangle>& collisionTriangles)
         {
+            std::vector<Geometry::Triangle>& collisionTriangles = load.collisionTriangles;
+
             numCollisionTrianglesBeforeAdd = collisionTriangles.size();
             numCollisionTrianglesToAdd = cModel.collisionIndices.size() / 3;
 
@@ -1858,13 +2785,35 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
                 collisionTriangle.vert2 = cModel.collisionVertexPositions[vert2Index];
                 collisionTriangle.vert3 = cModel.collisionVertexPositions[vert3Index];
             }
-        });
+        }
 
         complexModel.collisionTriangleOffset = static_cast<u32>(numCollisionTrianglesBeforeAdd);
         complexModel.numCollisionTriangles = static_cast<u32>(numCollisionTrianglesToAdd);
+
+        // Build the collision BVH in model space, every instance of this model shares it
+        {
+            std::vector<Geometry::AABoundingBox> triangleBounds(numCollisionTrianglesToAdd);
+
+            for (u32 i = 0; i < numCollisionTrianglesToAdd; i++)
+            {
+                u32 indexOffset = i * 3;
+
+                const vec3& vert1 = cModel.collisionVertexPositions[cModel.collisionIndices[indexOffset]];
+                const vec3& vert2 = cModel.collisionVertexPositions[cModel.collisionIndices[indexOffset + 1]];
+                const vec3& vert3 = cModel.collisionVertexPositions[cModel.collisionIndices[indexOffset + 2]];
+
+                vec3 min = glm::min(glm::min(vert1, vert2), vert3);
+                vec3 max = glm::max(glm::max(vert1, vert2), vert3);
+
+                triangleBounds[i].center = (min + max) * 0.5f;
+                triangleBounds[i].extents = (max - min) * 0.5f;
+            }
+
+            complexModel.collisionBVH.Build(triangleBounds);
+        }
     }
 
-    AnimationModelInfo animationModelInfo;
+    AnimationModelInfo& animationModelInfo = load.animationModelInfo;
     if (drawCollisionMesh && hasCollisionMesh)
     {
         animationModelInfo.numBones = 0;
@@ -1879,8 +2828,9 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
 
         // Add vertices
         size_t numVerticesBeforeAdd = 0;
-        _vertices.WriteLock([&](std::vector<CModel::ComplexVertex>& vertices)
         {
+            std::vector<CModel::ComplexVertex>& vertices = load.vertices;
+
             numVerticesBeforeAdd = vertices.size();
             size_t numCollisionVerticesToAdd = cModel.collisionVertexPositions.size();
 
@@ -1891,7 +2841,7 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
                 CModel::ComplexVertex& vertex = vertices[numVerticesBeforeAdd + i];
                 vertex.position = cModel.collisionVertexPositions[i];
             }
-        });
+        }
 
         complexModel.numVertices = static_cast<u32>(cModel.vertices.size());
         complexModel.vertexOffset = static_cast<u32>(numVerticesBeforeAdd);
@@ -1909,14 +2859,15 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
         // Add indices
         size_t numIndicesBeforeAdd = 0;
         size_t numIndicesToAdd = 0;
-        _indices.WriteLock([&](std::vector<u16>& indices)
         {
+            std::vector<u16>& indices = load.indices;
+
             numIndicesBeforeAdd = indices.size();
             numIndicesToAdd = cModel.collisionIndices.size();
 
             indices.resize(numIndicesBeforeAdd + numIndicesToAdd);
             memcpy(&indices[numIndicesBeforeAdd], &cModel.collisionIndices[0], numIndicesToAdd * sizeof(u16));
-        });
+        }
 
         drawCallTemplate.firstIndex = static_cast<u32>(numIndicesBeforeAdd);
         drawCallTemplate.indexCount = static_cast<u32>(numIndicesToAdd);
@@ -1925,8 +2876,9 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
         size_t numTextureUnitsBeforeAdd = 0;
         size_t numTextureUnitsToAdd = 0;
         size_t numUnlitTextureUnits = 0;
-        _textureUnits.WriteLock([&](std::vector<TextureUnit>& textureUnits)
         {
+            std::vector<TextureUnit>& textureUnits = load.textureUnits;
+
             numTextureUnitsBeforeAdd = textureUnits.size();
             numTextureUnitsToAdd = 1;
 
@@ -1943,7 +2895,7 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
                 textureUnit.textureIds[0] = 0;
                 textureUnit.textureIds[1] = 0;
             }
-        });
+        }
 
         drawCallDataTemplate.textureUnitOffset = static_cast<u16>(numTextureUnitsBeforeAdd);
         drawCallDataTemplate.numTextureUnits = static_cast<u16>(numTextureUnitsToAdd);
@@ -1953,8 +2905,9 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
     {
         // Add Sequences
         {
-            _animationSequences.WriteLock([&](std::vector<AnimationSequence>& animationSequence)
             {
+                std::vector<AnimationSequence>& animationSequence = load.animationSequences;
+
                 size_t numSequenceInfoBefore = animationSequence.size();
                 size_t numSequencesToAdd = cModel.sequences.size();
 
@@ -1984,20 +2937,13 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
                     sequence.blendTimeStart = cmodelSequence.blendTimeStart;
                     sequence.blendTimeEnd = cmodelSequence.blendTimeEnd;
                 }
-            });
+            }
         }
 
         // Add Bones
         {
-            auto boneInfoWriteLock = SafeVectorScopedWriteLock(_animationBoneInfo);
-            auto trackInfoWriteLock = SafeVectorScopedWriteLock(_animationTrackInfo);
-            auto trackTimestampWriteLock = SafeVectorScopedWriteLock(_animationTrackTimestamps);
-            auto trackValuesWriteLock = SafeVectorScopedWriteLock(_animationTrackValues);
-
-            std::vector<AnimationBoneInfo>& animationBoneInfo = boneInfoWriteLock.Get();
-            std::vector<AnimationTrackInfo>& animationTrackInfo = trackInfoWriteLock.Get();
-            std::vector<u32>& animationTrackTimestamps = trackTimestampWriteLock.Get();
-            std::vector<vec4>& animationTrackValues = trackValuesWriteLock.Get();
+            std::vector<AnimationBoneInfo>& animationBoneInfo = load.animationBoneInfos;
+            std::vector<AnimationTrackInfo>& animationTrackInfo = load.animationTrackInfos;
             size_t numBoneInfoBefore = animationBoneInfo.size();
             size_t numBonesToAdd = cModel.bones.size();
 
@@ -2006,8 +2952,41 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
             animationModelInfo.numBones = static_cast<u16>(numBonesToAdd);
             animationModelInfo.boneInfoOffset = static_cast<u32>(numBoneInfoBefore);
 
+            // The tracks are already flattened in the file, so track i of the model becomes track info (trackInfoOffset + i)
+            size_t numTrackInfosBefore = animationTrackInfo.size();
+            size_t numTracksToAdd = cModel.animationTracks.size();
+
+            u32 timestampOffset = static_cast<u32>(load.animationTrackTimestamps.size());
+            u32 valueOffset = static_cast<u32>(load.animationTrackValues.size());
+
+            animationTrackInfo.resize(numTrackInfosBefore + numTracksToAdd);
+            for (size_t i = 0; i < numTracksToAdd; i++)
+            {
+                const CModel::ComplexAnimationTrack& track = cModel.animationTracks[i];
+                AnimationTrackInfo& trackInfo = animationTrackInfo[numTrackInfosBefore + i];
+
+                trackInfo.sequenceIndex = static_cast<u16>(track.sequenceId);
+
+                trackInfo.numTimestamps = static_cast<u16>(track.numTimestamps);
+                trackInfo.numValues = static_cast<u16>(track.numValues);
+
+                trackInfo.timestampOffset = timestampOffset + track.timestampOffset;
+                trackInfo.valueOffset = valueOffset + track.valueOffset;
+            }
+
+            if (load.animationTrackTimestamps.empty() && load.animationTrackValues.empty())
+            {
+                load.animationTrackTimestamps = std::move(cModel.animationTrackTimestamps);
+                load.animationTrackValues = std::move(cModel.animationTrackValues);
+            }
+            else
+            {
+                load.animationTrackTimestamps.insert(load.animationTrackTimestamps.end(), cModel.animationTrackTimestamps.begin(), cModel.animationTrackTimestamps.end());
+                load.animationTrackValues.insert(load.animationTrackValues.end(), cModel.animationTrackValues.begin(), cModel.animationTrackValues.end());
+            }
+
+            u32 trackInfoOffset = static_cast<u32>(numTrackInfosBefore);
             u32 numSequences = 0;
-            u32 numTracksWithValues = 0;
 
             animationBoneInfo.resize(numBoneInfoBefore + numBonesToAdd);
             complexModel.boneKeyId.resize(numBonesToAdd);
@@ -2017,130 +2996,14 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
                 complexModel.boneKeyId[i] = bone.primaryBoneIndex;
 
                 AnimationBoneInfo& boneInfo = animationBoneInfo[numBoneInfoBefore + i];
-                boneInfo.numTranslationSequences = static_cast<u16>(bone.translation.tracks.size());
-                if (boneInfo.numTranslationSequences > 0)
-                {
-                    boneInfo.translationSequenceOffset = static_cast<u32>(animationTrackInfo.size());
-                    for (u32 j = 0; j < boneInfo.numTranslationSequences; j++)
-                    {
-                        CModel::ComplexAnimationTrack<vec3>& track = bone.translation.tracks[j];
-                        AnimationTrackInfo& trackInfo = animationTrackInfo.emplace_back();
+                boneInfo.numTranslationSequences = static_cast<u16>(bone.translation.numTracks);
+                boneInfo.translationSequenceOffset = trackInfoOffset + bone.translation.trackOffset;
 
-                        trackInfo.sequenceIndex = track.sequenceId;
+                boneInfo.numRotationSequences = static_cast<u16>(bone.rotation.numTracks);
+                boneInfo.rotationSequenceOffset = trackInfoOffset + bone.rotation.trackOffset;
 
-                        trackInfo.numTimestamps = static_cast<u16>(track.timestamps.size());
-                        trackInfo.numValues = static_cast<u16>(track.values.size());
-
-                        trackInfo.timestampOffset = static_cast<u32>(animationTrackTimestamps.size());
-                        trackInfo.valueOffset = static_cast<u32>(animationTrackValues.size());
-
-                        // Add Timestamps
-                        {
-                            size_t numTimestampsBefore = animationTrackTimestamps.size();
-                            size_t numTimestampsToAdd = track.timestamps.size();
-
-                            animationTrackTimestamps.resize(numTimestampsBefore + numTimestampsToAdd);
-                            memcpy(&animationTrackTimestamps[numTimestampsBefore], track.timestamps.data(), numTimestampsToAdd * sizeof(u32));
-                        }
-
-                        // Add Values
-                        {
-                            size_t numValuesBefore = animationTrackValues.size();
-                            size_t numValuesToAdd = track.values.size();
-
-                            animationTrackValues.resize(numValuesBefore + numValuesToAdd);
-
-                            for (size_t x = numValuesBefore; x < numValuesBefore + numValuesToAdd; x++)
-                            {
-                                animationTrackValues[x] = vec4(track.values[x - numValuesBefore], 0.f);
-                            }
-                        }
-
-                        numTracksWithValues += trackInfo.numValues;
-                    }
-                }
-
-                boneInfo.numRotationSequences = static_cast<u16>(bone.rotation.tracks.size());
-                if (boneInfo.numRotationSequences > 0)
-                {
-                    boneInfo.rotationSequenceOffset = static_cast<u32>(animationTrackInfo.size());
-                    for (u32 j = 0; j < boneInfo.numRotationSequences; j++)
-                    {
-                        CModel::ComplexAnimationTrack<quaternion>& track = bone.rotation.tracks[j];
-                        AnimationTrackInfo& trackInfo = animationTrackInfo.emplace_back();
-
-                        trackInfo.sequenceIndex = track.sequenceId;
-
-                        trackInfo.numTimestamps = static_cast<u16>(track.timestamps.size());
-                        trackInfo.numValues = static_cast<u16>(track.values.size());
-
-                        trackInfo.timestampOffset = static_cast<u32>(animationTrackTimestamps.size());
-                        trackInfo.valueOffset = static_cast<u32>(animationTrackValues.size());
-
-                        // Add Timestamps
-                        {
-                            size_t numTimestampsBefore = animationTrackTimestamps.size();
-                            size_t numTimestampsToAdd = track.timestamps.size();
-
-                            animationTrackTimestamps.resize(numTimestampsBefore + numTimestampsToAdd);
-                            memcpy(&animationTrackTimestamps[numTimestampsBefore], track.timestamps.data(), numTimestampsToAdd * sizeof(u32));
-                        }
-
-                        // Add Values
-                        {
-                            size_t numValuesBefore = animationTrackValues.size();
-                            size_t numValuesToAdd = track.values.size();
-
-                            animationTrackValues.resize(numValuesBefore + numValuesToAdd);
-                            memcpy(&animationTrackValues[numValuesBefore], track.values.data(), numValuesToAdd * sizeof(quaternion));
-                        }
-
-                        numTracksWithValues += trackInfo.numValues;
-                    }
-                }
-
-                boneInfo.numScaleSequences = static_cast<u16>(bone.scale.tracks.size());
-                if (boneInfo.numScaleSequences > 0)
-                {
-                    boneInfo.scaleSequenceOffset = static_cast<u32>(animationTrackInfo.size());
-                    for (u32 j = 0; j < boneInfo.numScaleSequences; j++)
-                    {
-                        CModel::ComplexAnimationTrack<vec3>& track = bone.scale.tracks[j];
-                        AnimationTrackInfo& trackInfo = animationTrackInfo.emplace_back();
-
-                        trackInfo.sequenceIndex = track.sequenceId;
-
-                        trackInfo.numTimestamps = static_cast<u16>(track.timestamps.size());
-                        trackInfo.numValues = static_cast<u16>(track.values.size());
-
-                        trackInfo.timestampOffset = static_cast<u32>(animationTrackTimestamps.size());
-                        trackInfo.valueOffset = static_cast<u32>(animationTrackValues.size());
-
-                        // Add Timestamps
-                        {
-                            size_t numTimestampsBefore = animationTrackTimestamps.size();
-                            size_t numTimestampsToAdd = track.timestamps.size();
-
-                            animationTrackTimestamps.resize(numTimestampsBefore + numTimestampsToAdd);
-                            memcpy(&animationTrackTimestamps[numTimestampsBefore], track.timestamps.data(), numTimestampsToAdd * sizeof(u32));
-                        }
-
-                        // Add Values
-                        {
-                            size_t numValuesBefore = animationTrackValues.size();
-                            size_t numValuesToAdd = track.values.size();
-
-                            animationTrackValues.resize(numValuesBefore + numValuesToAdd);
-
-                            for (size_t x = numValuesBefore; x < numValuesBefore + numValuesToAdd; x++)
-                            {
-                                animationTrackValues[x] = vec4(track.values[x - numValuesBefore], 0.f);
-                            }
-                        }
-
-                        numTracksWithValues += trackInfo.numValues;
-                    }
-                }
+                boneInfo.numScaleSequences = static_cast<u16>(bone.scale.numTracks);
+                boneInfo.scaleSequenceOffset = trackInfoOffset + bone.scale.trackOffset;
 
                 numSequences += boneInfo.numTranslationSequences + boneInfo.numRotationSequences + boneInfo.numScaleSequences;
 
@@ -2158,20 +3021,21 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
                 boneInfo.pivotPointZ = bone.pivot.z;
             }
 
-            complexModel.isAnimated = complexModel.numBones > 0 && numSequences > 0 && numTracksWithValues > 0;
+            complexModel.isAnimated = complexModel.numBones > 0 && numSequences > 0 && valueOffset < load.animationTrackValues.size();
             animationModelInfo.isAnimated = complexModel.isAnimated;
         }
 
         // Add vertices
         size_t numVerticesBeforeAdd = 0;
-        _vertices.WriteLock([&](std::vector<CModel::ComplexVertex>& vertices)
         {
+            std::vector<CModel::ComplexVertex>& vertices = load.vertices;
+
             numVerticesBeforeAdd = vertices.size();
             size_t numVerticesToAdd = cModel.vertices.size();
 
             vertices.resize(numVerticesBeforeAdd + numVerticesToAdd);
             memcpy(&vertices[numVerticesBeforeAdd], cModel.vertices.data(), numVerticesToAdd * sizeof(CModel::ComplexVertex));
-        });
+        }
 
         complexModel.numVertices = static_cast<u32>(cModel.vertices.size());
         complexModel.vertexOffset = static_cast<u32>(numVerticesBeforeAdd);
@@ -2182,8 +3046,7 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
 
         fs::path modelTexturePath = "Data/extracted/Textures/" + modelPath;
 
-        NDBC::CreatureDisplayInfo* creatureDisplayInfo = nullptr;
-        _nameHashToCreatureDisplayInfo.TryGetUnsafe(toBeLoaded.nameHash, creatureDisplayInfo);
+        const NDBC::CreatureDisplayInfo* creatureDisplayInfo = toBeLoaded.creatureDisplayInfo;
 
         // Handle this models renderbatches
         size_t numRenderBatches = static_cast<u32>(cModel.modelData.renderBatches.size());
@@ -2214,14 +3077,15 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
             // Add indices
             size_t numIndicesBeforeAdd = 0;
             size_t numIndicesToAdd = 0;
-            _indices.WriteLock([&](std::vector<u16>& indices)
             {
+                std::vector<u16>& indices = load.indices;
+
                 numIndicesBeforeAdd = indices.size();
                 numIndicesToAdd = renderBatch.indexCount;
 
                 indices.resize(numIndicesBeforeAdd + numIndicesToAdd);
                 memcpy(&indices[numIndicesBeforeAdd], &cModel.modelData.indices[renderBatch.indexStart], numIndicesToAdd * sizeof(u16));
-            });
+            }
 
             drawCallTemplate.firstIndex = static_cast<u32>(numIndicesBeforeAdd);
             drawCallTemplate.indexCount = static_cast<u32>(numIndicesToAdd);
@@ -2230,8 +3094,9 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
             size_t numTextureUnitsBeforeAdd = 0;
             size_t numTextureUnitsToAdd = 0;
             size_t numUnlitTextureUnits = 0;
-            _textureUnits.WriteLock([&](std::vector<TextureUnit>& textureUnits)
             {
+                std::vector<TextureUnit>& textureUnits = load.textureUnits;
+
                 numTextureUnitsBeforeAdd = textureUnits.size();
                 numTextureUnitsToAdd = renderBatch.textureUnits.size();
 
@@ -2254,6 +3119,8 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
 
                     // Load Textures into Texture Array
                     {
+                        std::scoped_lock lock(_textureLoadMutex);
+
                         // TODO: Wotlk only supports 2 textures, when we upgrade to cata+ this might need to be reworked
                         for (u32 t = 0; t < complexTextureUnit.textureCount; t++)
                         {
@@ -2263,8 +3130,12 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
                             if (complexTexture.type == CModel::ComplexTextureType::NONE)
                             {
                                 Renderer::TextureDesc textureDesc;
-                                textureDesc.path = textureSingleton.textureHashToPath[complexTexture.textureNameIndex];
-                                _renderer->LoadTextureIntoArray(textureDesc, _cModelTextures, textureUnit.textureIds[t]);
+                                textureDesc.path = textureSingleton.textureManifest.GetPath(complexTexture.textureNameIndex);
+                                Renderer::TextureID textureID = _renderer->LoadTextureIntoArray(textureDesc, _cModelTextures, textureUnit.textureIds[t]);
+                                if (std::find(complexModel.textureIDs.begin(), complexModel.textureIDs.end(), textureID) == complexModel.textureIDs.end())
+                                {
+                                    complexModel.textureIDs.push_back(textureID);
+                                }
                             }
                             else if (creatureDisplayInfo != nullptr)
                             {
@@ -2279,7 +3150,11 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
 
                                     Renderer::TextureDesc textureDesc;
                                     textureDesc.path = modelTexturePath.string();
-                                    _renderer->LoadTextureIntoArray(textureDesc, _cModelTextures, textureUnit.textureIds[t]);
+                                    Renderer::TextureID textureID = _renderer->LoadTextureIntoArray(textureDesc, _cModelTextures, textureUnit.textureIds[t]);
+                                    if (std::find(complexModel.textureIDs.begin(), complexModel.textureIDs.end(), textureID) == complexModel.textureIDs.end())
+                                    {
+                                        complexModel.textureIDs.push_back(textureID);
+                                    }
                                 }
                                 else if (complexTexture.type == CModel::ComplexTextureType::COMPONENT_MONSTER_SKIN_2)
                                 {
@@ -2292,7 +3167,11 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
 
                                     Renderer::TextureDesc textureDesc;
                                     textureDesc.path = modelTexturePath.string();
-                                    _renderer->LoadTextureIntoArray(textureDesc, _cModelTextures, textureUnit.textureIds[t]);
+                                    Renderer::TextureID textureID = _renderer->LoadTextureIntoArray(textureDesc, _cModelTextures, textureUnit.textureIds[t]);
+                                    if (std::find(complexModel.textureIDs.begin(), complexModel.textureIDs.end(), textureID) == complexModel.textureIDs.end())
+                                    {
+                                        complexModel.textureIDs.push_back(textureID);
+                                    }
                                 }
                                 else if (complexTexture.type == CModel::ComplexTextureType::COMPONENT_MONSTER_SKIN_3)
                                 {
@@ -2305,7 +3184,11 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
 
                                     Renderer::TextureDesc textureDesc;
                                     textureDesc.path = modelTexturePath.string();
-                                    _renderer->LoadTextureIntoArray(textureDesc, _cModelTextures, textureUnit.textureIds[t]);
+                                    Renderer::TextureID textureID = _renderer->LoadTextureIntoArray(textureDesc, _cModelTextures, textureUnit.textureIds[t]);
+                                    if (std::find(complexModel.textureIDs.begin(), complexModel.textureIDs.end(), textureID) == complexModel.textureIDs.end())
+                                    {
+                                        complexModel.textureIDs.push_back(textureID);
+                                    }
                                 }
                                 else
                                 {
@@ -2315,7 +3198,7 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
                         }
                     }
                 }
-            });
+            }
 
             drawCallDataTemplate.textureUnitOffset = static_cast<u16>(numTextureUnitsBeforeAdd);
             drawCallDataTemplate.numTextureUnits = static_cast<u16>(numTextureUnitsToAdd);
@@ -2323,13 +3206,165 @@ bool CModelRenderer::LoadComplexModel(ComplexModelToBeLoaded& toBeLoaded, Loaded
         }
     }
 
+    return true;
+}
+
+void CModelRenderer::CommitComplexModels(std::vector<ComplexModelLoad>& loads, tf::Taskflow* taskflow)
+{
+    ZoneScopedN("CModelRenderer::CommitComplexModels()");
+
+    auto boneInfoWriteLock = SafeVectorScopedWriteLock(_animationBoneInfo);
+    auto trackInfoWriteLock = SafeVectorScopedWriteLock(_animationTrackInfo);
+    auto trackTimestampWriteLock = SafeVectorScopedWriteLock(_animationTrackTimestamps);
+    auto trackValuesWriteLock = SafeVectorScopedWriteLock(_animationTrackValues);
+    auto sequencesWriteLock = SafeVectorScopedWriteLock(_animationSequences);
+    auto collisionTrianglesWriteLock = SafeVectorScopedWriteLock(_collisionTriangles);
+    auto verticesWriteLock = SafeVectorScopedWriteLock(_vertices);
+    auto indicesWriteLock = SafeVectorScopedWriteLock(_indices);
+    auto textureUnitsWriteLock = SafeVectorScopedWriteLock(_textureUnits);
+    auto cullingDatasWriteLock = SafeVectorScopedWriteLock(_cullingDatas);
+    auto animationModelInfoWriteLock = SafeVectorScopedWriteLock(_animationModelInfo);
+    auto fileDataWriteLock = SafeVectorScopedWriteLock(_loadedComplexModelFileData);
+
+    std::vector<AnimationBoneInfo>& animationBoneInfos = boneInfoWriteLock.Get();
+    std::vector<AnimationTrackInfo>& animationTrackInfos = trackInfoWriteLock.Get();
+    std::vector<u32>& animationTrackTimestamps = trackTimestampWriteLock.Get();
+    std::vector<vec4>& animationTrackValues = trackValuesWriteLock.Get();
+    std::vector<AnimationSequence>& animationSequences = sequencesWriteLock.Get();
+    std::vector<Geometry::Triangle>& collisionTriangles = collisionTrianglesWriteLock.Get();
+    std::vector<CModel::ComplexVertex>& vertices = verticesWriteLock.Get();
+    std::vector<u16>& indices = indicesWriteLock.Get();
+    std::vector<TextureUnit>& textureUnits = textureUnitsWriteLock.Get();
+    std::vector<CModel::CullingData>& cullingDatas = cullingDatasWriteLock.Get();
+    std::vector<AnimationModelInfo>& animationModelInfos = animationModelInfoWriteLock.Get();
+    std::vector<CModel::ComplexModel>& complexModelsFileData = fileDataWriteLock.Get();
+
+    // Give every load its own range in each array, then grow each array once
+    size_t numCollisionTriangles = collisionTriangles.size();
+    size_t numVertices = vertices.size();
+    size_t numIndices = indices.size();
+    size_t numTextureUnits = textureUnits.size();
+    size_t numSequences = animationSequences.size();
+    size_t numBoneInfos = animationBoneInfos.size();
+    size_t numTrackInfos = animationTrackInfos.size();
+    size_t numTrackTimestamps = animationTrackTimestamps.size();
+    size_t numTrackValues = animationTrackValues.size();
+    size_t numFileData = complexModelsFileData.size();
+
+    for (ComplexModelLoad& load : loads)
     {
-        SafeVectorScopedWriteLock animationModelInfoWriteLock(_animationModelInfo);
-        std::vector<AnimationModelInfo>& animationModelInfos = animationModelInfoWriteLock.Get();
-        animationModelInfos[complexModel.modelID] = animationModelInfo;
+        if (load.complexModel->failedToLoad)
+            continue;
+
+        load.collisionTriangleOffset = static_cast<u32>(numCollisionTriangles);
+        load.vertexOffset = static_cast<u32>(numVertices);
+        load.indexOffset = static_cast<u32>(numIndices);
+        load.textureUnitOffset = static_cast<u32>(numTextureUnits);
+        load.sequenceOffset = static_cast<u32>(numSequences);
+        load.boneInfoOffset = static_cast<u32>(numBoneInfos);
+        load.trackInfoOffset = static_cast<u32>(numTrackInfos);
+        load.trackTimestampOffset = static_cast<u32>(numTrackTimestamps);
+        load.trackValueOffset = static_cast<u32>(numTrackValues);
+
+        numCollisionTriangles += load.collisionTriangles.size();
+        numVertices += load.vertices.size();
+        numIndices += load.indices.size();
+        numTextureUnits += load.textureUnits.size();
+        numSequences += load.animationSequences.size();
+        numBoneInfos += load.animationBoneInfos.size();
+        numTrackInfos += load.animationTrackInfos.size();
+        numTrackTimestamps += load.animationTrackTimestamps.size();
+        numTrackValues += load.animationTrackValues.size();
+        numFileData = std::max(numFileData, static_cast<size_t>(load.complexModel->modelID) + 1);
     }
 
-    return true;
+    collisionTriangles.resize(numCollisionTriangles);
+    vertices.resize(numVertices);
+    indices.resize(numIndices);
+    textureUnits.resize(numTextureUnits);
+    animationSequences.resize(numSequences);
+    animationBoneInfos.resize(numBoneInfos);
+    animationTrackInfos.resize(numTrackInfos);
+    animationTrackTimestamps.resize(numTrackTimestamps);
+    animationTrackValues.resize(numTrackValues);
+    complexModelsFileData.resize(numFileData);
+
+    // The ranges don't overlap, so the loads can be copied into them at the same time
+    auto commitLoad = [&](ComplexModelLoad& load)
+    {
+        LoadedComplexModel& complexModel = *load.complexModel;
+        if (complexModel.failedToLoad)
+            return;
+
+        complexModel.collisionTriangleOffset += load.collisionTriangleOffset;
+        complexModel.vertexOffset += load.vertexOffset;
+        complexModel.sequenceOffset += load.sequenceOffset;
+
+        for (std::vector<DrawCall>* drawCallTemplates : { &complexModel.opaqueDrawCallTemplates, &complexModel.transparentDrawCallTemplates })
+        {
+            for (DrawCall& drawCallTemplate : *drawCallTemplates)
+            {
+                drawCallTemplate.vertexOffset += load.vertexOffset;
+                drawCallTemplate.firstIndex += load.indexOffset;
+            }
+        }
+
+        for (std::vector<DrawCallData>* drawCallDataTemplates : { &complexModel.opaqueDrawCallDataTemplates, &complexModel.transparentDrawCallDataTemplates })
+        {
+            for (DrawCallData& drawCallDataTemplate : *drawCallDataTemplates)
+            {
+                drawCallDataTemplate.textureUnitOffset += load.textureUnitOffset;
+            }
+        }
+
+        for (AnimationBoneInfo& boneInfo : load.animationBoneInfos)
+        {
+            if (boneInfo.numTranslationSequences > 0)
+                boneInfo.translationSequenceOffset += load.trackInfoOffset;
+
+            if (boneInfo.numRotationSequences > 0)
+                boneInfo.rotationSequenceOffset += load.trackInfoOffset;
+
+            if (boneInfo.numScaleSequences > 0)
+                boneInfo.scaleSequenceOffset += load.trackInfoOffset;
+        }
+
+        for (AnimationTrackInfo& trackInfo : load.animationTrackInfos)
+        {
+            trackInfo.timestampOffset += load.trackTimestampOffset;
+            trackInfo.valueOffset += load.trackValueOffset;
+        }
+
+        load.animationModelInfo.sequenceOffset += load.sequenceOffset;
+        load.animationModelInfo.boneInfoOffset += load.boneInfoOffset;
+
+        std::copy(load.collisionTriangles.begin(), load.collisionTriangles.end(), collisionTriangles.begin() + load.collisionTriangleOffset);
+        std::copy(load.vertices.begin(), load.vertices.end(), vertices.begin() + load.vertexOffset);
+        std::copy(load.indices.begin(), load.indices.end(), indices.begin() + load.indexOffset);
+        std::copy(load.textureUnits.begin(), load.textureUnits.end(), textureUnits.begin() + load.textureUnitOffset);
+        std::copy(load.animationSequences.begin(), load.animationSequences.end(), animationSequences.begin() + load.sequenceOffset);
+        std::copy(load.animationBoneInfos.begin(), load.animationBoneInfos.end(), animationBoneInfos.begin() + load.boneInfoOffset);
+        std::copy(load.animationTrackInfos.begin(), load.animationTrackInfos.end(), animationTrackInfos.begin() + load.trackInfoOffset);
+        std::copy(load.animationTrackTimestamps.begin(), load.animationTrackTimestamps.end(), animationTrackTimestamps.begin() + load.trackTimestampOffset);
+        std::copy(load.animationTrackValues.begin(), load.animationTrackValues.end(), animationTrackValues.begin() + load.trackValueOffset);
+
+        cullingDatas[complexModel.modelID] = load.cModel.cullingData;
+        animationModelInfos[complexModel.modelID] = load.animationModelInfo;
+        complexModelsFileData[complexModel.modelID] = std::move(load.cModel);
+    };
+
+    if (taskflow)
+    {
+        taskflow->parallel_for(loads.begin(), loads.end(), commitLoad);
+        taskflow->wait_for_all();
+    }
+    else
+    {
+        for (ComplexModelLoad& load : loads)
+        {
+            commitLoad(load);
+        }
+    }
 }
 
 bool CModelRenderer::LoadFile(const std::string& cModelPathString, CModel::ComplexModel& cModel)
@@ -2366,7 +3401,8 @@ bool CModelRenderer::LoadFile(const std::string& cModelPathString, CModel::Compl
         DebugHandler::PrintFatal("We opened ComplexModel file (%s) with invalid token %u instead of expected token %u", cModelPath.string().c_str(), cModel.header.typeID, CModel::COMPLEX_MODEL_TOKEN);
     }
 
-    if (cModel.header.typeVersion != CModel::COMPLEX_MODEL_VERSION)
+    bool isLegacyTrackLayout = cModel.header.typeVersion == CModel::COMPLEX_MODEL_LEGACY_TRACK_VERSION;
+    if (cModel.header.typeVersion != CModel::COMPLEX_MODEL_VERSION && !isLegacyTrackLayout)
     {
         if (cModel.header.typeVersion < CModel::COMPLEX_MODEL_VERSION)
         {
@@ -2412,56 +3448,130 @@ bool CModelRenderer::LoadFile(const std::string& cModelPathString, CModel::Compl
         if (numBones > 0)
         {
             cModel.bones.resize(numBones);
-            
-            for (u32 i = 0; i < numBones; i++)
-            {
-                CModel::ComplexBone& bone = cModel.bones[i];
 
-                if (!cModelBuffer.GetI32(bone.primaryBoneIndex))
+            if (isLegacyTrackLayout)
+            {
+                for (u32 i = 0; i < numBones; i++)
                 {
-                    DebugHandler::PrintError("Failed to load Primary Bone Index for Complex Model: %s", cModel.name);
-                    return false;
-                }
+                    CModel::ComplexBone& bone = cModel.bones[i];
 
-                if (!cModelBuffer.Get(bone.flags))
-                {
-                    DebugHandler::PrintError("Failed to load Bone Flags for Complex Model: %s", cModel.name);
-                    return false;
-                }
+                    if (!cModelBuffer.GetI32(bone.primaryBoneIndex) || !cModelBuffer.Get(bone.flags) || !cModelBuffer.GetI16(bone.parentBoneId) || !cModelBuffer.GetU16(bone.submeshId))
+                    {
+                        DebugHandler::PrintError("Failed to load Bones for Complex Model: %s", cModel.name);
+                        return false;
+                    }
 
-                if (!cModelBuffer.GetI16(bone.parentBoneId))
-                {
-                    DebugHandler::PrintError("Failed to load Parent Bone Id for Complex Model: %s", cModel.name);
-                    return false;
-                }
+                    if (!bone.translation.DeserializeLegacy<vec3>(&cModelBuffer, cModel.animationTracks, cModel.animationTrackTimestamps, cModel.animationTrackValues))
+                    {
+                        DebugHandler::PrintError("Failed to load Bone Translation Track for Complex Model: %s", cModel.name);
+                        return false;
+                    }
 
-                if (!cModelBuffer.GetU16(bone.submeshId))
-                {
-                    DebugHandler::PrintError("Failed to load Bone Submesh Id for Complex Model: %s", cModel.name);
-                    return false;
-                }
+                    if (!bone.rotation.DeserializeLegacy<quaternion>(&cModelBuffer, cModel.animationTracks, cModel.animationTrackTimestamps, cModel.animationTrackValues))
+                    {
+                        DebugHandler::PrintError("Failed to load Bone Rotation Track for Complex Model: %s", cModel.name);
+                        return false;
+                    }
 
-                if (!bone.translation.Deserialize(&cModelBuffer))
-                {
-                    DebugHandler::PrintError("Failed to load Bone Translation Track for Complex Model: %s", cModel.name);
-                    return false;
-                }
+                    if (!bone.scale.DeserializeLegacy<vec3>(&cModelBuffer, cModel.animationTracks, cModel.animationTrackTimestamps, cModel.animationTrackValues))
+                    {
+                        DebugHandler::PrintError("Failed to load Bone Scale Track for Complex Model: %s", cModel.name);
+                        return false;
+                    }
 
-                if (!bone.rotation.Deserialize(&cModelBuffer))
-                {
-                    DebugHandler::PrintError("Failed to load Bone Rotation Track for Complex Model: %s", cModel.name);
-                    return false;
+                    if (!cModelBuffer.Get(bone.pivot))
+                    {
+                        DebugHandler::PrintError("Failed to load Bone Pivot for Complex Model: %s", cModel.name);
+                        return false;
+                    }
                 }
+            }
+            else if (!cModelBuffer.GetBytes(reinterpret_cast<u8*>(cModel.bones.data()), numBones * sizeof(CModel::ComplexBone)))
+            {
+                DebugHandler::PrintError("Failed to load Bones for Complex Model: %s", cModel.name);
+                return false;
+            }
+        }
+    }
 
-                if (!bone.scale.Deserialize(&cModelBuffer))
-                {
-                    DebugHandler::PrintError("Failed to load Bone Scale Track for Complex Model: %s", cModel.name);
-                    return false;
-                }
+    // Read Animation Tracks, version 6 files had them inline with the bones
+    if (!isLegacyTrackLayout)
+    {
+        u32 numTracks = 0;
+        if (!cModelBuffer.GetU32(numTracks))
+        {
+            DebugHandler::PrintError("Failed to load Animation Tracks for Complex Model: %s", cModel.name);
+            return false;
+        }
+
+        if (numTracks > 0)
+        {
+            cModel.animationTracks.resize(numTracks);
+            if (!cModelBuffer.GetBytes(reinterpret_cast<u8*>(cModel.animationTracks.data()), numTracks * sizeof(CModel::ComplexAnimationTrack)))
+            {
+                DebugHandler::PrintError("Failed to load Animation Tracks for Complex Model: %s", cModel.name);
+                return false;
+            }
+        }
 
-                if (!cModelBuffer.Get(bone.pivot))
+        u32 numTimestamps = 0;
+        if (!cModelBuffer.GetU32(numTimestamps))
+        {
+            DebugHandler::PrintError("Failed to load Animation Track Timestamps for Complex Model: %s", cModel.name);
+            return false;
+        }
+
+        if (numTimestamps > 0)
+        {
+            cModel.animationTrackTimestamps.resize(numTimestamps);
+            if (!cModelBuffer.GetBytes(reinterpret_cast<u8*>(cModel.animationTrackTimestamps.data()), numTimestamps * sizeof(u32)))
+            {
+                DebugHandler::PrintError("Failed to load Animation Track Timestamps for Complex Model: %s", cModel.name);
+                return false;
+            }
+        }
+
+        u32 numValues = 0;
+        if (!cModelBuffer.GetU32(numValues))
+        {
+            DebugHandler::PrintError("Failed to load Animation Track Values for Complex Model: %s", cModel.name);
+            return false;
+        }
+
+        if (numValues > 0)
+        {
+            cModel.animationTrackValues.resize(numValues);
+            if (!cModelBuffer.GetBytes(reinterpret_cast<u8*>(cModel.animationTrackValues.data()), numValues * sizeof(vec4)))
+            {
+                DebugHandler::PrintError("Failed to load Animation Track Values for Complex Model: %s", cModel.name);
+                return false;
+            }
+        }
+    }
+
+    // The ranges come straight from disk, make sure a truncated or corrupt file can't index past the arrays we just read
+    {
+        const size_t numTracks = cModel.animationTracks.size();
+        const size_t numTimestamps = cModel.animationTrackTimestamps.size();
+        const size_t numValues = cModel.animationTrackValues.size();
+
+        for (const CModel::ComplexAnimationTrack& track : cModel.animationTracks)
+        {
+            if (static_cast<size_t>(track.timestampOffset) + track.numTimestamps > numTimestamps || static_cast<size_t>(track.valueOffset) + track.numValues > numValues)
+            {
+                DebugHandler::PrintError("Animation Track is out of range for Complex Model: %s", cModel.name);
+                return false;
+            }
+        }
+
+        for (const CModel::ComplexBone& bone : cModel.bones)
+        {
+            const CModel::ComplexAnimationData* channels[] = { &bone.translation, &bone.rotation, &bone.scale };
+            for (const CModel::ComplexAnimationData* channel : channels)
+            {
+                if (static_cast<size_t>(channel->trackOffset) + channel->numTracks > numTracks)
                 {
-                    DebugHandler::PrintError("Failed to load Bone Pivot for Complex Model: %s", cModel.name);
+                    DebugHandler::PrintError("Bone Animation Tracks are out of range for Complex Model: %s", cModel.name);
                     return false;
                 }
             }
@@ -2855,10 +3965,10 @@ void CModelRenderer::AddInstance(LoadedComplexModel& complexModel, const Terrain
                 registry->emplace_or_replace<TransformIsDirty>(entityID);
             }
 
-            //if (cmodelInfo.isStaticModel && complexModel.numCollisionTriangles > 0)
-            //{
-            //    registry->emplace_or_replace<Collidable>(entityID);
-            //}
+            if (CVAR_ComplexModelCollisionEnabled.Get() && cmodelInfo.isStaticModel && complexModel.numCollisionTriangles > 0)
+            {
+                registry->emplace_or_replace<Collidable>(entityID);
+            }
         }
     });
 
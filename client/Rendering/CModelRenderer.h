@@ -2,6 +2,9 @@
 #include <NovusTypes.h>
 #include <mutex>
 #include <queue>
+#include <deque>
+#include <thread>
+#include <condition_variable>
 
 #include <Utils/StringUtils.h>
 #include <Utils/ConcurrentQueue.h>
@@ -22,6 +25,7 @@
 #include <Renderer/DescriptorSet.h>
 
 #include "../Gameplay/Map/Chunk.h"
+#include "../Utils/BoundingVolumeHierarchy.h"
 #include "CModel/CModel.h"
 #include "ViewConstantBuffer.h"
 
@@ -43,6 +47,11 @@ namespace NDBC
     struct CreatureModelData;
 }
 
+namespace tf
+{
+    class Taskflow;
+}
+
 class CameraFreeLook;
 class DebugRenderer;
 class MapObjectRenderer;
@@ -92,21 +101,37 @@ public:
     {
         LoadedComplexModel() {}
 
-        // We have to manually implement a copy constructor because std::mutex is not copyable
+        // We have to manually implement copying because std::mutex is not copyable
         LoadedComplexModel(const LoadedComplexModel& other)
+        {
+            *this = other;
+        }
+
+        LoadedComplexModel& operator=(const LoadedComplexModel& other)
         {
             modelID = other.modelID;
             debugName = other.debugName;
+            failedToLoad = other.failedToLoad;
+            isStaticModel = other.isStaticModel;
             numVertices = other.numVertices;
             vertexOffset = other.vertexOffset;
+            numCollisionTriangles = other.numCollisionTriangles;
+            collisionTriangleOffset = other.collisionTriangleOffset;
+            collisionAABB = other.collisionAABB;
+            collisionBVH = other.collisionBVH;
             numBones = other.numBones;
+            numSequences = other.numSequences;
+            sequenceOffset = other.sequenceOffset;
             isAnimated = other.isAnimated;
+            boneKeyId = other.boneKeyId;
             numOpaqueDrawCalls = other.numOpaqueDrawCalls;
             opaqueDrawCallTemplates = other.opaqueDrawCallTemplates;
             opaqueDrawCallDataTemplates = other.opaqueDrawCallDataTemplates;
             numTransparentDrawCalls = other.numTransparentDrawCalls;
             transparentDrawCallTemplates = other.transparentDrawCallTemplates;
             transparentDrawCallDataTemplates = other.transparentDrawCallDataTemplates;
+            textureIDs = other.textureIDs;
+            return *this;
         };
 
         u32 modelID;
@@ -120,6 +145,7 @@ public:
         u32 numCollisionTriangles = 0;
         u32 collisionTriangleOffset = 0;
         Geometry::AABoundingBox collisionAABB;
+        BoundingVolumeHierarchy collisionBVH; // Over the model space collision triangles, primitive indices are relative to collisionTriangleOffset
 
         u32 numBones = 0;
         u32 numSequences = 0;
@@ -135,6 +161,8 @@ public:
         std::vector<DrawCall> transparentDrawCallTemplates;
         std::vector<DrawCallData> transparentDrawCallDataTemplates;
 
+        std::vector<Renderer::TextureID> textureIDs; // Every texture the model uses, for texture streaming requests
+
         std::mutex mutex;
     };
 
@@ -246,6 +274,15 @@ public:
         u32 valueOffset = 0;
     };
 
+    struct LoadBenchmarkResult
+    {
+        u32 numModels = 0;
+        u32 numFailed = 0;
+        f32 lockedTimeMS = 0.0f; // The lock traffic of the old ExecuteLoad, but without converting sections while holding the array locks, so a lower bound
+        f32 stagedTimeMS = 0.0f; // Every model is decoded into its own staging arrays first, then copied into place after one resize per array
+        f32 stagedCommitTimeMS = 0.0f;
+    };
+
 public:
     CModelRenderer(Renderer::Renderer* renderer, DebugRenderer* debugRenderer);
     ~CModelRenderer();
@@ -268,6 +305,9 @@ public:
     void RegisterLoadFromDecoration(const std::string& modelPath, const u32& modelPathHash, vec3 position, quaternion rotation, f32 scale);
     void ExecuteLoad();
 
+    // Decodes up to numModels of the loaded models again into scratch arrays, once per strategy in LoadBenchmarkResult, nothing the renderer uses is touched
+    bool BenchmarkLoad(u32 numModels, LoadBenchmarkResult& result);
+
     void Clear();
 
     SafeVector<DrawCallData>& GetOpaqueDrawCallData() { return _opaqueDrawCallDatas; }
@@ -352,6 +392,7 @@ private:
         const std::string* name = nullptr;
         u32 nameHash = 0;
         entt::entity entityID = entt::null;
+        const NDBC::CreatureDisplayInfo* creatureDisplayInfo = nullptr; // Creatures get their skin textures from here
     };
 
     struct TextureUnit
@@ -361,6 +402,50 @@ private:
         u32 textureIds[2] = { CMODEL_INVALID_TEXTURE_ID, CMODEL_INVALID_TEXTURE_ID };
         u32 pad;
     };
+
+    // Everything loading a ComplexModel adds to the shared arrays, decoded on its own so several models can be decoded at the same time
+    // Until CommitComplexModels places it, offsets in here and in the LoadedComplexModel are relative to the start of these arrays
+    struct ComplexModelLoad
+    {
+        ComplexModelToBeLoaded* toBeLoaded = nullptr;
+        LoadedComplexModel* complexModel = nullptr;
+
+        CModel::ComplexModel cModel;
+        AnimationModelInfo animationModelInfo;
+
+        std::vector<Geometry::Triangle> collisionTriangles;
+        std::vector<CModel::ComplexVertex> vertices;
+        std::vector<u16> indices;
+        std::vector<TextureUnit> textureUnits;
+
+        std::vector<AnimationSequence> animationSequences;
+        std::vector<AnimationBoneInfo> animationBoneInfos;
+        std::vector<AnimationTrackInfo> animationTrackInfos;
+        std::vector<u32> animationTrackTimestamps;
+        std::vector<vec4> animationTrackValues;
+
+        // Where CommitComplexModels placed the arrays above
+        u32 collisionTriangleOffset = 0;
+        u32 vertexOffset = 0;
+        u32 indexOffset = 0;
+        u32 textureUnitOffset = 0;
+        u32 sequenceOffset = 0;
+        u32 boneInfoOffset = 0;
+        u32 trackInfoOffset = 0;
+        u32 trackTimestampOffset = 0;
+        u32 trackValueOffset = 0;
+    };
+
+    // A creature model loading on _modelLoadThread, it owns everything the load points to so the game thread can't move it away
+    struct AsyncComplexModelLoad
+    {
+        ComplexModelToBeLoaded toBeLoaded;
+        LoadedComplexModel complexModel;
+        ComplexModelLoad load;
+
+        u32 modelID = 0;
+        u32 generation = 0;
+    };
     
     struct PackedAnimatedVertexPositions
     {
@@ -407,11 +492,20 @@ private:
     void CreatePermanentResources();
 
     bool LoadComplexModel(ComplexModelToBeLoaded& complexModelToBeLoaded, LoadedComplexModel& complexModel);
+    bool DecodeComplexModel(ComplexModelLoad& load);
+    void CommitComplexModels(std::vector<ComplexModelLoad>& loads, tf::Taskflow* taskflow); // Copies happen on the taskflow if there is one
     bool LoadFile(const std::string& cModelPathString, CModel::ComplexModel& cModel);
 
+    void UpdateAnimationsCPU(f32 deltaTime);
+    void RequestTextureDetail();
+
     bool IsRenderBatchTransparent(const CModel::ComplexRenderBatch& renderBatch, const CModel::ComplexModel& cModel);
 
     void AddInstance(LoadedComplexModel& complexModel, const Terrain::Placement& placement, entt::entity entityID, u32& instanceId);
+    void CreateModelInstance(entt::registry& registry, entt::entity entity, LoadedComplexModel& complexModel);
+
+    void ModelLoadThreadMain();
+    void CommitFinishedModelLoads();
 
     void CreateBuffers();
     void SyncBuffers();
@@ -434,6 +528,8 @@ private:
     Renderer::DescriptorSet _materialPassDescriptorSet;
     Renderer::DescriptorSet _transparencyPassDescriptorSet;
 
+    std::mutex _textureLoadMutex; // The renderer can't load textures from several threads at once
+
     robin_hood::unordered_map<u32, u8> _uniqueIdCounter;
     std::shared_mutex _uniqueIdCounterMutex;
 
@@ -452,6 +548,17 @@ private:
 
     moodycamel::ConcurrentQueue<AnimationRequest> _animationRequests;
 
+    // Creature models are decoded on _modelLoadThread, their entities have no instance until Update commits the model
+    std::thread _modelLoadThread;
+    std::mutex _modelLoadMutex;
+    std::condition_variable _modelLoadCondition;
+    std::deque<AsyncComplexModelLoad*> _modelLoadRequests;
+    bool _modelLoadThreadShouldExit = false;
+    moodycamel::ConcurrentQueue<AsyncComplexModelLoad*> _finishedModelLoads;
+    std::atomic<u32> _modelLoadGeneration = 0; // Bumped by Clear, loads from before that are thrown away
+
+    robin_hood::unordered_map<u32, std::vector<entt::entity>> _entitiesWaitingForModel; // Key is ModelID, never touched by _modelLoadThread
+
     Renderer::GPUVector<CModel::ComplexVertex> _vertices;
     Renderer::GPUVector<u16> _indices;
     Renderer::GPUVector<TextureUnit> _textureUnits;
@@ -506,7 +613,7 @@ private:
 
     Renderer::TextureArrayID _cModelTextures;
 
-    std::atomic<u32> _numTotalAnimatedVertices;
+    std::atomic<u32> _numTotalAnimatedVertices = 0;
     u32 _numOccluderSurvivingDrawCalls;
     u32 _numOpaqueSurvivingDrawCalls;
     u32 _numTransparentSurvivingDrawCalls;
@@ -16,10 +16,12 @@
 #include "../ECS/Components/Singletons/AreaUpdateSingleton.h"
 
 #include <Memory/StackAllocator.h>
+#include <Utils/DebugHandler.h>
 #include <Renderer/Renderer.h>
 #include <Renderer/RenderSettings.h>
 #include <Renderer/RenderGraph.h>
 #include <Renderer/Renderers/Vulkan/RendererVK.h>
+#include <Renderer/Renderers/Null/RendererNull.h>
 #include <Window/Window.h>
 #include <InputManager.h>
 #include <GLFW/glfw3.h>
@@ -36,8 +38,11 @@
 
 AutoCVar_Int CVAR_LightLockEnabled("lights.lock", "lock the light", 0, CVarFlags::EditCheckbox);
 AutoCVar_Int CVAR_LightUseDefaultEnabled("lights.useDefault", "Use the map's default light", 0, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_RenderNullBackend("render.nullBackend", "use the headless null renderer instead of Vulkan, takes effect on restart", 0, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_RenderParallelPassRecording("render.parallelPassRecording", "record render passes into their own commandlists on several threads", 0, CVarFlags::EditCheckbox);
 
 const size_t FRAME_ALLOCATOR_SIZE = 16 * 1024 * 1024; // 16 MB
+const size_t PASS_ALLOCATOR_SIZE = 2 * 1024 * 1024; // 2 MB
 u32 MAIN_RENDER_LAYER = "MainLayer"_h; // _h will compiletime hash the string into a u32
 u32 DEPTH_PREPASS_RENDER_LAYER = "DepthPrepass"_h; // _h will compiletime hash the string into a u32
 
@@ -88,7 +93,15 @@ ClientRenderer::ClientRenderer()
     glfwSetScrollCallback(_window->GetWindow(), ScrollCallback);
     glfwSetWindowIconifyCallback(_window->GetWindow(), WindowIconifyCallback);
     
-    _renderer = new Renderer::RendererVK();
+    if (CVAR_RenderNullBackend.Get())
+    {
+        DebugHandler::Print("[ClientRenderer] Using the null renderer, nothing will be drawn");
+        _renderer = new Renderer::RendererNull();
+    }
+    else
+    {
+        _renderer = new Renderer::RendererVK();
+    }
     _renderer->InitWindow(_window);
 
     InitImgui();
@@ -122,6 +135,10 @@ void ClientRenderer::Update(f32 deltaTime)
 {
     // Reset the memory in the frameAllocator
     _frameAllocator->Reset();
+    for (Memory::StackAllocator* passAllocator : _passAllocators)
+    {
+        passAllocator->Reset();
+    }
 
     _terrainRenderer->Update(deltaTime);
     _waterRenderer->Update(deltaTime);
@@ -139,6 +156,59 @@ void ClientRenderer::Update(f32 deltaTime)
     _debugRenderer->Update(deltaTime);
 }
 
+void ClientRenderer::CaptureFrameSnapshot(f32 deltaTime)
+{
+    ZoneScopedNC("ClientRenderer::CaptureFrameSnapshot", tracy::Color::Red2);
+
+    // Render always reads the latest snapshot, so we write into the other one
+    u8 snapshotIndex = !_frameSnapshotIndex;
+    FrameSnapshot& frameSnapshot = _frameSnapshots.Get(snapshotIndex);
+
+    Camera* camera = ServiceLocator::GetCamera();
+    FrameSnapshot::CameraData& cameraData = frameSnapshot.camera;
+    cameraData.viewMatrix = camera->GetViewMatrix();
+    cameraData.projectionMatrix = camera->GetProjectionMatrix();
+    cameraData.viewProjectionMatrix = camera->GetViewProjectionMatrix();
+    memcpy(cameraData.frustumPlanes, camera->GetFrustumPlanes(), sizeof(cameraData.frustumPlanes));
+    cameraData.position = camera->GetPosition();
+    cameraData.rotation = camera->GetRotation();
+    cameraData.nearClip = camera->GetNearClip();
+    cameraData.farClip = camera->GetFarClip();
+    cameraData.fovInDegrees = camera->GetFOVInDegrees();
+
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+    MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
+    frameSnapshot.lightColor = mapSingleton.GetLightColorData();
+    frameSnapshot.lightDirection = mapSingleton.GetLightDirection();
+
+    frameSnapshot.deltaTime = deltaTime;
+
+    // Clone the ImGui draw lists, the originals are reset by the next ImGui::NewFrame
+    {
+        for (ImDrawList* drawList : frameSnapshot.imguiDrawLists)
+        {
+            IM_DELETE(drawList);
+        }
+        frameSnapshot.imguiDrawLists.clear();
+        frameSnapshot.imguiDrawData.Clear();
+
+        ImDrawData* drawData = ImGui::GetDrawData();
+        if (drawData && drawData->Valid)
+        {
+            frameSnapshot.imguiDrawLists.reserve(drawData->CmdListsCount);
+            for (i32 i = 0; i < drawData->CmdListsCount; i++)
+            {
+                frameSnapshot.imguiDrawLists.push_back(drawData->CmdLists[i]->CloneOutput());
+            }
+
+            frameSnapshot.imguiDrawData = *drawData;
+            frameSnapshot.imguiDrawData.CmdLists = frameSnapshot.imguiDrawLists.data();
+        }
+    }
+
+    _frameSnapshotIndex = snapshotIndex;
+}
+
 void ClientRenderer::Render()
 {
     ZoneScopedNC("ClientRenderer::Render", tracy::Color::Red2);
@@ -147,11 +217,39 @@ void ClientRenderer::Render()
     if (_window->IsMinimized())
         return;
 
-    Camera* camera = ServiceLocator::GetCamera();
+    FrameSnapshot& frameSnapshot = _frameSnapshots.Get(_frameSnapshotIndex);
+    _resources.frameSnapshot = &frameSnapshot;
 
     // Create rendergraph
     Renderer::RenderGraphDesc renderGraphDesc;
     renderGraphDesc.allocator = _frameAllocator; // We need to give our rendergraph an allocator to use
+
+    _wasRecordedInParallel = CVAR_RenderParallelPassRecording.Get() == 1;
+    if (_wasRecordedInParallel)
+    {
+        renderGraphDesc.getPassAllocator = [this](u32 passIndex)
+        {
+            while (passIndex >= _passAllocators.size())
+            {
+                Memory::StackAllocator* passAllocator = new Memory::StackAllocator();
+                passAllocator->Init(PASS_ALLOCATOR_SIZE);
+
+                _passAllocators.push_back(passAllocator);
+            }
+
+            return _passAllocators[passIndex];
+        };
+
+        renderGraphDesc.parallelFor = [this](u32 count, const std::function<void(u32)>& func)
+        {
+            _passRecordingTaskflow.parallel_for(0u, count, 1u, [&func](u32 index)
+            {
+                func(index);
+            });
+            _passRecordingTaskflow.wait_for_all();
+        };
+    }
+
     Renderer::RenderGraph renderGraph = _renderer->CreateRenderGraph(renderGraphDesc);
 
     _renderer->FlipFrame(_frameIndex);
@@ -169,21 +267,18 @@ void ClientRenderer::Render()
 
     // Update the view matrix to match the new camera position
     _resources.viewConstantBuffer->resource.lastViewProjectionMatrix = _resources.viewConstantBuffer->resource.viewProjectionMatrix;
-    _resources.viewConstantBuffer->resource.viewProjectionMatrix = camera->GetProjectionMatrix() * (axisFlipMatrix * camera->GetViewMatrix());
-    _resources.viewConstantBuffer->resource.viewMatrix = axisFlipMatrix * camera->GetViewMatrix();
-    _resources.viewConstantBuffer->resource.eyePosition = vec4(camera->GetPosition(), 0.0f);
-    _resources.viewConstantBuffer->resource.eyeRotation = vec4(camera->GetRotation(), 0.0f);
+    _resources.viewConstantBuffer->resource.viewProjectionMatrix = frameSnapshot.camera.projectionMatrix * (axisFlipMatrix * frameSnapshot.camera.viewMatrix);
+    _resources.viewConstantBuffer->resource.viewMatrix = axisFlipMatrix * frameSnapshot.camera.viewMatrix;
+    _resources.viewConstantBuffer->resource.eyePosition = vec4(frameSnapshot.camera.position, 0.0f);
+    _resources.viewConstantBuffer->resource.eyeRotation = vec4(frameSnapshot.camera.rotation, 0.0f);
     _resources.viewConstantBuffer->Apply(_frameIndex);
 
-    entt::registry* registry = ServiceLocator::GetGameRegistry();
-    MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
-
     if (!CVAR_LightLockEnabled.Get())
     {
-        AreaUpdateLightColorData lightColor = mapSingleton.GetLightColorData();
+        const AreaUpdateLightColorData& lightColor = frameSnapshot.lightColor;
         _resources.lightConstantBuffer->resource.ambientColor = vec4(lightColor.ambientColor, 1.0f);
         _resources.lightConstantBuffer->resource.lightColor = vec4(lightColor.diffuseColor, 1.0f);
-        _resources.lightConstantBuffer->resource.lightDir = vec4(mapSingleton.GetLightDirection(), 1.0f);
+        _resources.lightConstantBuffer->resource.lightDir = vec4(frameSnapshot.lightDirection, 1.0f);
         _resources.lightConstantBuffer->Apply(_frameIndex);
     }
 
@@ -208,6 +303,8 @@ void ClientRenderer::Render()
             data.transparencyWeights = builder.Write(_resources.transparencyWeights, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::CLEAR);
             data.depth = builder.Write(_resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::CLEAR);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
             [&](StartFramePassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -240,6 +337,8 @@ void ClientRenderer::Render()
         {
             data.depth = builder.Read(_resources.depth, Renderer::RenderGraphBuilder::ShaderStage::PIXEL);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](PyramidPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -315,6 +414,16 @@ void ClientRenderer::Render()
 
     renderGraph.Setup();
     renderGraph.Execute();
+
+    // Pass names live in the frame allocator, so copy them out
+    const DynamicArray<Renderer::RenderGraph::PassRecordTiming>& passRecordTimings = renderGraph.GetPassRecordTimings();
+    _passRecordTimings.resize(passRecordTimings.Count());
+    for (u32 i = 0; i < passRecordTimings.Count(); i++)
+    {
+        _passRecordTimings[i].name = passRecordTimings[i].name;
+        _passRecordTimings[i].recordTime = passRecordTimings[i].recordTime;
+        _passRecordTimings[i].isExecuting = passRecordTimings[i].isExecuting;
+    }
     
     {
         ZoneScopedNC("Present", tracy::Color::Red2);
@@ -359,6 +468,21 @@ size_t ClientRenderer::GetVRAMBudget()
     return _renderer->GetVRAMBudget();
 }
 
+u32 ClientRenderer::GetNumDescriptorSetCacheHits()
+{
+    return _renderer->GetNumDescriptorSetCacheHits();
+}
+
+u32 ClientRenderer::GetNumDescriptorSetCacheMisses()
+{
+    return _renderer->GetNumDescriptorSetCacheMisses();
+}
+
+u32 ClientRenderer::GetNumCachedDescriptorSets()
+{
+    return _renderer->GetNumCachedDescriptorSets();
+}
+
 void ClientRenderer::CreatePermanentResources()
 {
     // Visibility Buffer rendertarget
@@ -7,6 +7,9 @@
 #include <Renderer/FrameResource.h>
 
 #include "RenderResources.h"
+#include "FrameSnapshot.h"
+
+#include <taskflow/taskflow.hpp>
 
 namespace Renderer
 {
@@ -36,10 +39,20 @@ class PixelQuery;
 class ClientRenderer
 {
 public:
+    struct PassRecordTiming
+    {
+        std::string name;
+        f32 recordTime; // In seconds
+        bool isExecuting; // False for passes that were disabled in Setup
+    };
+
     ClientRenderer();
 
     bool UpdateWindow(f32 deltaTime);
     void Update(f32 deltaTime);
+
+    // Copies everything Render needs from the game side, call this after ImGui::Render once the game frame is done
+    void CaptureFrameSnapshot(f32 deltaTime);
     void Render();
 
     u8 GetFrameIndex() { return _frameIndex; }
@@ -62,6 +75,14 @@ public:
     size_t GetVRAMUsage();
     size_t GetVRAMBudget();
 
+    u32 GetNumDescriptorSetCacheHits();
+    u32 GetNumDescriptorSetCacheMisses();
+    u32 GetNumCachedDescriptorSets();
+
+    // From the last rendered frame, only read this while the render thread is idle
+    const std::vector<PassRecordTiming>& GetPassRecordTimings() { return _passRecordTimings; }
+    bool WasRecordedInParallel() { return _wasRecordedInParallel; }
+
 private:
     void CreatePermanentResources();
 
@@ -71,10 +92,21 @@ private:
     Renderer::Renderer* _renderer;
     Memory::StackAllocator* _frameAllocator;
 
+    // Every pass gets its own allocator when passes are recorded in parallel, these grow with the number of passes
+    std::vector<Memory::StackAllocator*> _passAllocators;
+    tf::Taskflow _passRecordingTaskflow;
+
+    std::vector<PassRecordTiming> _passRecordTimings;
+    bool _wasRecordedInParallel = false;
+
     u8 _frameIndex = 0;
 
     RenderResources _resources;
 
+    // Double buffered so the game thread can capture the next frame while the render thread still reads the current one
+    FrameResource<FrameSnapshot, 2> _frameSnapshots;
+    u8 _frameSnapshotIndex = 0;
+
     Renderer::SemaphoreID _sceneRenderedSemaphore; // This semaphore tells the present function when the scene is ready to be blitted and presented
     FrameResource<Renderer::SemaphoreID, 2> _frameSyncSemaphores; // This semaphore makes sure the GPU handles frames in order
 
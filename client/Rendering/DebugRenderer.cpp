@@ -36,6 +36,13 @@ void DebugRenderer::Update(f32 deltaTime)
 	{
 		_draw3DDescriptorSet.Bind("_vertices", _debugVertices3D.GetBuffer());
 	}
+
+	// The vertices are on the GPU now, so we can start collecting the next frame while this one is rendered
+	_numVertices2D = static_cast<u32>(_debugVertices2D.Size());
+	_numVertices3D = static_cast<u32>(_debugVertices3D.Size());
+
+	_debugVertices2D.Clear(false);
+	_debugVertices3D.Clear(false);
 }
 
 void DebugRenderer::Add2DPass(Renderer::RenderGraph* renderGraph, RenderResources& resources, u8 frameIndex)
@@ -49,6 +56,8 @@ void DebugRenderer::Add2DPass(Renderer::RenderGraph* renderGraph, RenderResource
 		{
 			data.color = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+			builder.ShareRecordingState(this);
+
 			return true;// Return true from setup to enable this pass, return false to disable it
 		},
 		[=](Debug2DPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -84,10 +93,9 @@ void DebugRenderer::Add2DPass(Renderer::RenderGraph* renderGraph, RenderResource
 			commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_PASS, &_draw2DDescriptorSet, frameIndex);
 
 			// Draw
-			commandList.Draw(static_cast<u32>(_debugVertices2D.Size()), 1, 0, 0);
+			commandList.Draw(_numVertices2D, 1, 0, 0);
 
 			commandList.EndPipeline(pipeline);
-			_debugVertices2D.Clear(false);
 		});
 }
 
@@ -104,6 +112,8 @@ void DebugRenderer::Add3DPass(Renderer::RenderGraph* renderGraph, RenderResource
 			data.color = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 			data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+			builder.ShareRecordingState(this);
+
 			return true;// Return true from setup to enable this pass, return false to disable it
 		},
 		[=](Debug3DPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -146,10 +156,9 @@ void DebugRenderer::Add3DPass(Renderer::RenderGraph* renderGraph, RenderResource
 			commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_PASS, &_draw3DDescriptorSet, frameIndex);
 
 			// Draw
-			commandList.Draw(static_cast<u32>(_debugVertices3D.Size()), 1, 0, 0);
+			commandList.Draw(_numVertices3D, 1, 0, 0);
 
 			commandList.EndPipeline(pipeline);
-			_debugVertices3D.Clear(false);
 		});
 }
 
@@ -64,6 +64,10 @@ private:
 
 	Renderer::GPUVector<DebugVertex2D> _debugVertices2D;
 	Renderer::GPUVector<DebugVertex3D> _debugVertices3D;
+
+	// Number of vertices synced to the GPU in Update, the passes draw these while new lines are being added for the next frame
+	u32 _numVertices2D = 0;
+	u32 _numVertices3D = 0;
 	
 	Renderer::DescriptorSet _draw2DDescriptorSet;
 	Renderer::DescriptorSet _draw3DDescriptorSet;
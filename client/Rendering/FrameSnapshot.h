@@ -0,0 +1,37 @@
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+#include <imgui/imgui.h>
+
+#include "../ECS/Components/Singletons/AreaUpdateSingleton.h"
+
+// Everything the render passes need from the game side of a frame, captured by ClientRenderer::CaptureFrameSnapshot once the game frame is done
+// With the render thread enabled the next game frame keeps moving the camera and touching the singletons and ImGui while this one renders
+struct FrameSnapshot
+{
+    struct CameraData
+    {
+        mat4x4 viewMatrix = mat4x4(1.0f);
+        mat4x4 projectionMatrix = mat4x4(1.0f);
+        mat4x4 viewProjectionMatrix = mat4x4(1.0f);
+        vec4 frustumPlanes[6] = { };
+
+        vec3 position = vec3(0.0f);
+        vec3 rotation = vec3(0.0f);
+
+        f32 nearClip = 1.0f;
+        f32 farClip = 100000.0f;
+        f32 fovInDegrees = 75.0f;
+    };
+
+    CameraData camera;
+
+    AreaUpdateLightColorData lightColor;
+    vec3 lightDirection = vec3(0.0f, 0.0f, 1.0f);
+
+    f32 deltaTime = 0.0f;
+
+    // ImGui owns the draw lists in ImGui::GetDrawData() and resets them in ImGui::NewFrame, so we keep our own copies
+    ImDrawData imguiDrawData;
+    std::vector<ImDrawList*> imguiDrawLists;
+};
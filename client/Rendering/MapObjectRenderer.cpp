@@ -5,6 +5,7 @@
 #include "PixelQuery.h"
 #include "SortUtils.h"
 #include "RenderUtils.h"
+#include "FrameSnapshot.h"
 #include "../Editor/Editor.h"
 
 #include <filesystem>
@@ -88,6 +89,8 @@ void MapObjectRenderer::Update(f32 deltaTime)
         });
     }
 
+    RequestTextureDetail();
+
     // Read back from the culling counters
     u32 numDrawCalls = static_cast<u32>(_drawCalls.Size());
     _numSurvivingOccluderDrawCalls = numDrawCalls;
@@ -161,6 +164,7 @@ void MapObjectRenderer::AddOccluderPass(Renderer::RenderGraph* renderGraph, Rend
         {
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
+            builder.ShareRecordingState(this);
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](MapObjectOccluderPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -296,6 +300,7 @@ void MapObjectRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, Rende
         {
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
+            builder.ShareRecordingState(this);
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](MapObjectCullingPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -326,9 +331,9 @@ void MapObjectRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, Rende
 
                 if (!lockFrustum)
                 {
-                    Camera* camera = ServiceLocator::GetCamera();
-                    memcpy(_cullingConstantBuffer->resource.frustumPlanes, camera->GetFrustumPlanes(), sizeof(vec4[6]));
-                    _cullingConstantBuffer->resource.cameraPos = camera->GetPosition();
+                    const FrameSnapshot::CameraData& camera = resources.frameSnapshot->camera;
+                    memcpy(_cullingConstantBuffer->resource.frustumPlanes, camera.frustumPlanes, sizeof(vec4[6]));
+                    _cullingConstantBuffer->resource.cameraPos = camera.position;
                     _cullingConstantBuffer->resource.maxDrawCount = drawCount;
                     _cullingConstantBuffer->resource.occlusionEnabled = CVAR_MapObjectOcclusionCullEnabled.Get();
                     _cullingConstantBuffer->Apply(frameIndex);
@@ -422,6 +427,7 @@ void MapObjectRenderer::AddGeometryPass(Renderer::RenderGraph* renderGraph, Rend
         {
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
+            builder.ShareRecordingState(this);
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](MapObjectGeometryPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -549,6 +555,8 @@ void MapObjectRenderer::AddEditorPass(Renderer::RenderGraph* renderGraph, Render
             data.color = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](MapObjectEditorPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -648,7 +656,7 @@ void MapObjectRenderer::RegisterMapObjectToBeLoaded(const std::string& mapObject
 
     _uniqueIdCounter.WriteLock([&](robin_hood::unordered_map<u32, u8>& uniqueIdCounter)
     {
-        if (uniqueIdCounter[uniqueID]++ == 0)
+        if (uniqueIdCounter.emplace(uniqueID, 1).second)
         {
             MapObjectToBeLoaded mapObjectToBeLoaded;
             mapObjectToBeLoaded.placement = &mapObjectPlacement;
@@ -670,7 +678,7 @@ void MapObjectRenderer::RegisterMapObjectsToBeLoaded(u16 chunkID, const Terrain:
 
         _uniqueIdCounter.WriteLock([&](robin_hood::unordered_map<u32, u8>& uniqueIdCounter)
         {
-            if (uniqueIdCounter[uniqueID]++ == 0)
+            if (uniqueIdCounter.emplace(uniqueID, 1).second)
             {
                 MapObjectToBeLoaded mapObjectToBeLoaded;
                 mapObjectToBeLoaded.placement = &mapObjectPlacement;
@@ -693,19 +701,21 @@ void MapObjectRenderer::ExecuteLoad()
     {
         size_t numMapObjectsToBeLoaded = mapObjectsToBeLoaded.size();
 
+        // Streaming calls this once per step, so reserve on top of what is already loaded
+        // The loads below hold pointers into _loadedMapObjects while other loads emplace into it, it must not reallocate
         _loadedMapObjects.WriteLock([&](std::vector<LoadedMapObject>& loadedMapObjects)
         {
-            loadedMapObjects.reserve(numMapObjectsToBeLoaded);
+            loadedMapObjects.reserve(loadedMapObjects.size() + numMapObjectsToBeLoaded);
         });
 
         _instances.WriteLock([&](std::vector<InstanceData>& instances)
         {
-            instances.reserve(numMapObjectsToBeLoaded);
+            instances.reserve(instances.size() + numMapObjectsToBeLoaded);
         });
 
         _instanceLookupData.WriteLock([&](std::vector<InstanceLookupData>& instanceLookupData)
         {
-            instanceLookupData.reserve(numMapObjectsToBeLoaded);
+            instanceLookupData.reserve(instanceLookupData.size() + numMapObjectsToBeLoaded);
         });
 
 #if PARALLEL_LOADING
@@ -804,6 +814,7 @@ void MapObjectRenderer::ExecuteLoad()
 void MapObjectRenderer::Clear()
 {
     _uniqueIdCounter.Clear();
+    _culledDrawCallCapacity = 0;
     _loadedMapObjects.Clear();
     _nameHashToIndexMap.Clear();
     _indices.Clear();
@@ -1087,10 +1098,14 @@ bool MapObjectRenderer::LoadRoot(std::filesystem::path nmorPath, MeshRoot& meshR
                 if (mapObjectMaterial.textureNameID[j] < std::numeric_limits<u32>().max())
                 {
                     Renderer::TextureDesc textureDesc;
-                    textureDesc.path = textureSingleton.textureHashToPath[mapObjectMaterial.textureNameID[j]];
+                    textureDesc.path = textureSingleton.textureManifest.GetPath(mapObjectMaterial.textureNameID[j]);
 
                     u32 textureID;
-                    _renderer->LoadTextureIntoArray(textureDesc, _mapObjectTextures, textureID);
+                    Renderer::TextureID streamingTextureID = _renderer->LoadTextureIntoArray(textureDesc, _mapObjectTextures, textureID);
+                    if (std::find(mapObject.textureIDs.begin(), mapObject.textureIDs.end(), streamingTextureID) == mapObject.textureIDs.end())
+                    {
+                        mapObject.textureIDs.push_back(streamingTextureID);
+                    }
 
                     material.textureIDs[j] = static_cast<u16>(textureID);
                 }
@@ -1442,6 +1457,69 @@ void MapObjectRenderer::AddInstance(LoadedMapObject& mapObject, const Terrain::P
     mapObject.instanceCount++;
 }
 
+void MapObjectRenderer::RequestTextureDetail()
+{
+    ZoneScopedN("MapObjectRenderer::RequestTextureDetail()");
+
+    const vec3 cameraPosition = ServiceLocator::GetCamera()->GetPosition();
+
+    std::vector<Renderer::TextureStreamingRequest> requests;
+
+    _loadedMapObjects.ReadLock([&](const std::vector<LoadedMapObject>& loadedMapObjects)
+    {
+        _instances.ReadLock([&](const std::vector<InstanceData>& instances)
+        {
+            for (const LoadedMapObject& mapObject : loadedMapObjects)
+            {
+                if (mapObject.textureIDs.empty() || mapObject.cullingData.empty())
+                    continue;
+
+                // Map objects are big enough to stand inside of, so measure to the bounds of all render batches instead of to the origin
+                vec3 boundsMin = vec3(std::numeric_limits<f32>().max());
+                vec3 boundsMax = vec3(std::numeric_limits<f32>().lowest());
+                for (const Terrain::CullingData& cullingData : mapObject.cullingData)
+                {
+                    vec3 center = cullingData.center;
+                    vec3 extents = cullingData.extents;
+
+                    boundsMin = glm::min(boundsMin, center - extents);
+                    boundsMax = glm::max(boundsMax, center + extents);
+                }
+
+                vec3 center = (boundsMin + boundsMax) * 0.5f;
+                vec3 extents = (boundsMax - boundsMin) * 0.5f;
+
+                // A map object's textures are shared by all of its instances, so the closest instance decides the detail
+                f32 distance = std::numeric_limits<f32>().max();
+                for (const u16 instanceID : mapObject.instanceIDs)
+                {
+                    if (instanceID >= instances.size())
+                        continue;
+
+                    const mat4x4& m = instances[instanceID].instanceMatrix;
+                    vec3 transformedCenter = vec3(m * vec4(center, 1.0f));
+
+                    glm::mat3x3 absMatrix = glm::mat3x3(glm::abs(vec3(m[0])), glm::abs(vec3(m[1])), glm::abs(vec3(m[2])));
+                    vec3 transformedExtents = absMatrix * extents;
+
+                    vec3 delta = glm::max(glm::abs(cameraPosition - transformedCenter) - transformedExtents, vec3(0.0f));
+                    distance = glm::min(distance, glm::length(delta));
+                }
+
+                if (distance == std::numeric_limits<f32>().max())
+                    continue;
+
+                for (const Renderer::TextureID textureID : mapObject.textureIDs)
+                {
+                    requests.push_back({ textureID, distance });
+                }
+            }
+        });
+    });
+
+    _renderer->RequestTextureDetail(requests);
+}
+
 void MapObjectRenderer::CreateBuffers()
 {
     {
@@ -1457,30 +1535,61 @@ void MapObjectRenderer::CreateBuffers()
 
         _drawCalls.WriteLock([&](std::vector<DrawCall>& drawCalls)
         {
+            // Streaming adds a few draw calls per step, so the work buffers are only recreated once they run out of room, and then with room to spare
+            size_t numDrawCalls = drawCalls.size();
+            if (numDrawCalls <= _culledDrawCallCapacity)
+                return;
+
+            _culledDrawCallCapacity = glm::max(numDrawCalls, _culledDrawCallCapacity * 2);
+
             // Create Culled Indirect Argument buffer
             {
                 Renderer::BufferDesc desc;
                 desc.name = "MapObjectCulledDrawCalls";
-                desc.size = sizeof(DrawCall) * drawCalls.size();
+                desc.size = sizeof(DrawCall) * _culledDrawCallCapacity;
                 desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION | Renderer::BufferUsage::INDIRECT_ARGUMENT_BUFFER;
 
-                _culledDrawCallsBuffer = _renderer->CreateAndFillBuffer(_culledDrawCallsBuffer, desc, drawCalls.data(), desc.size);
+                auto fillDrawCalls = [&](void* mappedMemory, size_t size)
+                {
+                    size_t drawCallsSize = sizeof(DrawCall) * numDrawCalls;
+
+                    memcpy(mappedMemory, drawCalls.data(), drawCallsSize);
+                    memset(static_cast<u8*>(mappedMemory) + drawCallsSize, 0, size - drawCallsSize);
+                };
+
+                _culledDrawCallsBuffer = _renderer->CreateAndFillBuffer(_culledDrawCallsBuffer, desc, fillDrawCalls);
                 _occluderFillDescriptorSet.Bind("_culledDraws"_h, _culledDrawCallsBuffer);
                 _sortingDescriptorSet.Bind("_culledDrawCalls"_h, _culledDrawCallsBuffer);
                 _cullingDescriptorSet.Bind("_culledDraws"_h, _culledDrawCallsBuffer);
 
                 // Create Culled Sorted Indirect Argument Buffer
                 desc.name = "MapObjectCulledSortedDrawCalls";
-                _culledSortedDrawCallsBuffer = _renderer->CreateAndFillBuffer(_culledSortedDrawCallsBuffer, desc, drawCalls.data(), desc.size);
+                _culledSortedDrawCallsBuffer = _renderer->CreateAndFillBuffer(_culledSortedDrawCallsBuffer, desc, fillDrawCalls);
 
                 _sortingDescriptorSet.Bind("_sortedCulledDrawCalls"_h, _culledSortedDrawCallsBuffer);
             }
 
+            // Create SortKeys and SortValues buffer
+            {
+                Renderer::BufferDesc desc;
+                desc.name = "MapObjectSortKeys";
+                desc.size = sizeof(u64) * _culledDrawCallCapacity;
+                desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_SOURCE | Renderer::BufferUsage::TRANSFER_DESTINATION;
+                _sortKeysBuffer = _renderer->CreateBuffer(_sortKeysBuffer, desc);
+                _cullingDescriptorSet.Bind("_sortKeys"_h, _sortKeysBuffer);
+
+                desc.name = "MapObjectSortValues";
+                desc.size = sizeof(u32) * _culledDrawCallCapacity;
+                _sortValuesBuffer = _renderer->CreateBuffer(_sortValuesBuffer, desc);
+                _cullingDescriptorSet.Bind("_sortValues"_h, _sortValuesBuffer);
+                _sortingDescriptorSet.Bind("_sortValues"_h, _sortValuesBuffer);
+            }
+
             // Create Culled DrawCall Bitmask buffer
             {
                 Renderer::BufferDesc desc;
                 desc.name = "MapObjectCulledDrawCallBitMaskBuffer";
-                desc.size = RenderUtils::CalcCullingBitmaskSize(drawCalls.size());
+                desc.size = RenderUtils::CalcCullingBitmaskSize(_culledDrawCallCapacity);
                 desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
 
                 for (u32 i = 0; i < _culledDrawCallsBitMaskBuffer.Num; i++)
@@ -1564,24 +1673,4 @@ void MapObjectRenderer::CreateBuffers()
 
         _cullingDescriptorSet.Bind("_packedCullingData"_h, _cullingData.GetBuffer());
     }
-
-    // Create SortKeys and SortValues buffer
-    {
-        u32 numDrawCalls = static_cast<u32>(_drawCalls.Size());
-        u32 keysSize = sizeof(u64) * numDrawCalls;
-        u32 valuesSize = sizeof(u32) * numDrawCalls;
-
-        Renderer::BufferDesc desc;
-        desc.name = "MapObjectSortKeys";
-        desc.size = keysSize;
-        desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_SOURCE | Renderer::BufferUsage::TRANSFER_DESTINATION;
-        _sortKeysBuffer = _renderer->CreateBuffer(_sortKeysBuffer, desc);
-        _cullingDescriptorSet.Bind("_sortKeys"_h, _sortKeysBuffer);
-
-        desc.name = "MapObjectSortValues";
-        desc.size = valuesSize;
-        _sortValuesBuffer = _renderer->CreateBuffer(_sortValuesBuffer, desc);
-        _cullingDescriptorSet.Bind("_sortValues"_h, _sortValuesBuffer);
-        _sortingDescriptorSet.Bind("_sortValues"_h, _sortValuesBuffer);
-    }
 }
@@ -132,6 +132,7 @@ public:
             vertexColors[1] = other.vertexColors[1];
             vertexColorTextureIDs[0] = other.vertexColorTextureIDs[0];
             vertexColorTextureIDs[1] = other.vertexColorTextureIDs[1];
+            textureIDs = other.textureIDs;
             instanceCount = other.instanceCount;
             baseMaterialOffset = other.baseMaterialOffset;
             baseCullingDataOffset = other.baseCullingDataOffset;
@@ -152,6 +153,7 @@ public:
         std::vector<u32> vertexColors[2];
 
         u32 vertexColorTextureIDs[2] = { 0, 0 };
+        std::vector<Renderer::TextureID> textureIDs; // The textures its materials use, for streaming
         u32 instanceCount;
 
         u32 baseMaterialOffset = 0;
@@ -241,6 +243,8 @@ private:
 
     void CreateBuffers();
 
+    void RequestTextureDetail();
+
     struct Material
     {
         u16 textureIDs[3] = { 0,0,0 };
@@ -299,6 +303,7 @@ private:
     Renderer::BufferID _culledSortedDrawCallsBuffer;
     Renderer::BufferID _sortKeysBuffer;
     Renderer::BufferID _sortValuesBuffer;
+    size_t _culledDrawCallCapacity = 0; // Number of draw calls the work buffers above have room for
 
     Renderer::BufferID _drawCountBuffer;
     Renderer::BufferID _occluderDrawCountReadBackBuffer;
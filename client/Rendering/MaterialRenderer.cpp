@@ -52,17 +52,15 @@ void MaterialRenderer::AddMaterialPass(Renderer::RenderGraph* renderGraph, Rende
             data.transparencyWeights = builder.Write(resources.transparencyWeights, Renderer::RenderGraphBuilder::WriteMode::UAV, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.resolvedColor = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::UAV, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+            builder.ShareRecordingState(_terrainRenderer); // The terrain geometry pass binds into the terrain material DescriptorSet
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](MaterialPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
         {
             GPU_SCOPED_PROFILER_ZONE(commandList, MaterialPass);
 
-            commandList.ImageBarrier(resources.visibilityBuffer);
-            commandList.ImageBarrier(resources.transparency);
-            commandList.ImageBarrier(resources.transparencyWeights);
-            commandList.ImageBarrier(resources.resolvedColor);
-
             Renderer::ComputePipelineDesc pipelineDesc;
             graphResources.InitializePipelineDesc(pipelineDesc);
 
@@ -62,13 +62,16 @@ void PixelQuery::AddPixelQueryPass(Renderer::RenderGraph* renderGraph, RenderRes
     {
         struct PixelQueryPassData
         {
-            Renderer::RenderPassMutableResource visibilityBuffer;
+            Renderer::RenderPassResource visibilityBuffer;
         };
 
         renderGraph->AddPass<PixelQueryPassData>("Query Pass",
             [=](PixelQueryPassData& data, Renderer::RenderGraphBuilder& builder) // Setup
             {
-                data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
+                data.visibilityBuffer = builder.Read(resources.visibilityBuffer, Renderer::RenderGraphBuilder::ShaderStage::COMPUTE);
+
+                builder.ShareRecordingState(this);
+                builder.ShareRecordingState(ServiceLocator::GetClientRenderer()->GetTerrainRenderer()); // The terrain geometry pass binds into the terrain material DescriptorSet
 
                 return true; // Return true from setup to enable this pass, return false to disable it
             },
@@ -82,10 +85,6 @@ void PixelQuery::AddPixelQueryPass(Renderer::RenderGraph* renderGraph, RenderRes
                     std::string frameIndexStr = "FrameIndex: " + std::to_string(_frameIndex);
                     TracyMessage(frameIndexStr.c_str(), frameIndexStr.length());
 
-                    {
-                        ZoneScopedN("PixelQuery::ImageBarrier");
-                        commandList.ImageBarrier(resources.visibilityBuffer);
-                    }
                     commandList.PushMarker("Pixel Queries " + std::to_string(numRequests), Color::White);
                     Renderer::ComputePipelineDesc queryPipelineDesc;
                     graphResources.InitializePipelineDesc(queryPipelineDesc);
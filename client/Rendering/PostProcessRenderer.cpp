@@ -2,7 +2,7 @@
 #include "RenderUtils.h"
 #include "PostProcess/SAO.h"
 #include "../Utils/ServiceLocator.h"
-#include "Camera.h"
+#include "FrameSnapshot.h"
 
 #include <Renderer/Renderer.h>
 #include <Renderer/RenderGraph.h>
@@ -32,11 +32,9 @@ void PostProcessRenderer::Update(f32 deltaTime)
 
 }
 
-f32 CalculateProjScale(Camera* camera, vec2 resolution)
+f32 CalculateProjScale(const FrameSnapshot::CameraData& camera, vec2 resolution)
 {
-    float fov = 75.0f; // TODO: Don't hardcode FOV
-
-    float scale = -2.0f * tan(glm::radians(fov) * 0.5f);
+    float scale = -2.0f * tan(glm::radians(camera.fovInDegrees) * 0.5f);
 
     return resolution.y / scale;
 }
@@ -52,28 +50,30 @@ void PostProcessRenderer::AddCalculateSAOPass(Renderer::RenderGraph* renderGraph
     renderGraph->AddPass<CalculateSAOPassData>("Calculate SAO",
         [=](CalculateSAOPassData& data, Renderer::RenderGraphBuilder& builder) // Setup
     {
+        builder.ShareRecordingState(this);
+
         return true; // Return true from setup to enable this pass, return false to disable it
     },
         [=](CalculateSAOPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
     {
         if (saoEnabled)
         {
-            Camera* camera = ServiceLocator::GetCamera();
+            const FrameSnapshot::CameraData& camera = resources.frameSnapshot->camera;
 
             PostProcess::SAO::Params params;
             params.depth = resources.depth;
 
             vec2 resolution = _renderer->GetImageDimension(resources.resolvedColor, 0);
 
-            params.nearPlane = camera->GetNearClip();
-            params.farPlane = camera->GetFarClip();
+            params.nearPlane = camera.nearClip;
+            params.farPlane = camera.farClip;
 
             params.projScale = CalculateProjScale(camera, resolution);
             params.radius = CVAR_SAORadius.GetFloat();
             params.bias = CVAR_SAOBias.GetFloat();
             params.intensity = CVAR_SAOIntensity.GetFloat();
-            params.viewMatrix = camera->GetViewMatrix();
-            params.invProjMatrix = glm::inverse(camera->GetProjectionMatrix());
+            params.viewMatrix = camera.viewMatrix;
+            params.invProjMatrix = glm::inverse(camera.projectionMatrix);
 
             params.output = _aoImage;
 
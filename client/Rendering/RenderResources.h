@@ -7,6 +7,8 @@
 #include <Renderer/DescriptorSet.h>
 #include <Renderer/Buffer.h>
 
+struct FrameSnapshot;
+
 struct RenderResources
 {
     Renderer::Buffer<ViewConstantBuffer>* viewConstantBuffer;
@@ -25,4 +27,7 @@ struct RenderResources
     Renderer::ImageID depthColorCopy;
 
     Renderer::DepthImageID depth;
+
+    // Game side data of the frame being rendered, passes should read the camera and lighting from here instead of the live objects
+    FrameSnapshot* frameSnapshot = nullptr;
 };
\ No newline at end of file
@@ -321,8 +321,36 @@ void RendertargetVisualizer::AddVisualizerPass(Renderer::RenderGraph* renderGrap
     renderGraph->AddPass<RTVisualizerData>("RTVisualizer",
         [=](RTVisualizerData& data, Renderer::RenderGraphBuilder& builder)
         {
+            bool isOverriding = _overridingImageID != Renderer::ImageID::Invalid() || _overridingDepthImageID != Renderer::DepthImageID::Invalid();
+            bool isOverlaying = _overlayingImageID != Renderer::ImageID::Invalid() || _overlayingDepthImageID != Renderer::DepthImageID::Invalid();
+
+            // Nothing to visualize, skip the pass entirely
+            if (!isOverriding && !isOverlaying)
+                return false;
+
             data.target = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            // Declare what we sample so the RenderGraph puts a barrier in front of us if it was just written
+            if (_overridingImageID != Renderer::ImageID::Invalid())
+            {
+                builder.Read(_overridingImageID, Renderer::RenderGraphBuilder::ShaderStage::PIXEL);
+            }
+            else if (_overridingDepthImageID != Renderer::DepthImageID::Invalid())
+            {
+                builder.Read(_overridingDepthImageID, Renderer::RenderGraphBuilder::ShaderStage::PIXEL);
+            }
+
+            if (_overlayingImageID != Renderer::ImageID::Invalid())
+            {
+                builder.Read(_overlayingImageID, Renderer::RenderGraphBuilder::ShaderStage::PIXEL);
+            }
+            else if (_overlayingDepthImageID != Renderer::DepthImageID::Invalid())
+            {
+                builder.Read(_overlayingDepthImageID, Renderer::RenderGraphBuilder::ShaderStage::PIXEL);
+            }
+
+            builder.ShareRecordingState(this);
+
             return true;
         },
         [=](RTVisualizerData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -15,6 +15,7 @@
 
 #include "CameraFreelook.h"
 #include "RenderResources.h"
+#include "FrameSnapshot.h"
 
 SkyboxRenderer::SkyboxRenderer(Renderer::Renderer* renderer, DebugRenderer* debugRenderer)
     : _renderer(renderer)
@@ -47,6 +48,8 @@ void SkyboxRenderer::AddSkyboxPass(Renderer::RenderGraph* renderGraph, RenderRes
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         }, 
         [=](SkyboxPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -89,13 +92,10 @@ void SkyboxRenderer::AddSkyboxPass(Renderer::RenderGraph* renderGraph, RenderRes
 
             // Skyband Color Push Constant
             {
-                entt::registry* registry = ServiceLocator::GetGameRegistry();
-                MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
-
                 i32 lockLight = *CVarSystem::Get()->GetIntCVar("lights.lock");
                 if (!lockLight)
                 {
-                    const AreaUpdateLightColorData& lightColor = mapSingleton.GetLightColorData();
+                    const AreaUpdateLightColorData& lightColor = resources.frameSnapshot->lightColor;
                     _skybandColors.top = vec4(lightColor.skybandTopColor, 0.0f);
                     _skybandColors.middle = vec4(lightColor.skybandMiddleColor, 0.0f);
                     _skybandColors.bottom = vec4(lightColor.skybandBottomColor, 0.0f);
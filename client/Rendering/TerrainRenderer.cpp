@@ -6,6 +6,7 @@
 #include "WaterRenderer.h"
 #include "PixelQuery.h"
 #include "RenderUtils.h"
+#include "FrameSnapshot.h"
 #include "CameraOrbital.h"
 #include "../Utils/ServiceLocator.h"
 #include "../Utils/MapUtils.h"
@@ -34,6 +35,7 @@
 #include <GLFW/glfw3.h>
 #include <tracy/Tracy.hpp>
 #include <entt.hpp>
+#include <future>
 
 #include "Camera.h"
 #include "CVar/CVarSystem.h"
@@ -51,6 +53,10 @@ AutoCVar_Float CVAR_HeightBoxScale("terrain.heightBox.Scale", "size of the heigh
 AutoCVar_VecFloat CVAR_HeightBoxPosition("terrain.heightBox.Position", "position of the height box", vec4(0, 0, 0, 0), CVarFlags::Noedit);
 AutoCVar_Int CVAR_HeightBoxLockPosition("terrain.heightBox.LockPosition", "lock height box position", 0, CVarFlags::EditCheckbox);
 
+AutoCVar_Int CVAR_TerrainStreamingEnabled("terrain.streaming.Enable", "stream chunks in a ring around the camera instead of loading the whole map, applied on map load", 0, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_TerrainStreamingRadius("terrain.streaming.Radius", "radius in chunks of the ring kept resident around the camera, applied on map load", 4);
+AutoCVar_Int CVAR_TerrainStreamingMaxLoadsPerFrame("terrain.streaming.MaxLoadsPerFrame", "max number of chunks streamed in per frame", 2);
+
 AutoCVar_Int CVAR_DrawCellGrid("terrain.cellGrid.Enable", "draw debug grid for displaying cells", 1, CVarFlags::EditCheckbox);
 AutoCVar_VecFloat CVAR_TerrainWireframeColor("terrain.wireframeColor", "set the wireframe color for terrain", vec4(1.0f, 1.0f, 1.0f, 1.0f));
 
@@ -96,44 +102,30 @@ void TerrainRenderer::Update(f32 deltaTime)
     entt::registry* registry = ServiceLocator::GetGameRegistry();
     MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
 
+    // Maps queued while another map is still loading are picked up once it finishes
     NDBC::Map* mapToBeLoaded = mapSingleton.GetMapToBeLoaded();
-    if (mapToBeLoaded != nullptr)
+    if (mapToBeLoaded != nullptr && !IsLoadingMap())
     {
         ServiceLocator::GetEditor()->ClearSelection();
         registry->clear();
+        registry->ctx_or_set<LocalplayerSingleton>().entity = entt::null;
         ServiceLocator::GetRenderer()->ClearUploadBuffers();
         LoadMap(mapToBeLoaded);
         mapSingleton.ResetMapToBeLoaded();
 
-        // This allows us to move around in the world "offline" (The server will automatically override this when connecting
+        if (!IsLoadingMap())
         {
-            ConnectionSingleton& connectionSingleton = registry->ctx<ConnectionSingleton>();
-            LocalplayerSingleton& localplayerSingleton = registry->ctx_or_set<LocalplayerSingleton>();
-
-            if (!connectionSingleton.gameConnection->IsConnected())
-            {
-                localplayerSingleton.entity = registry->create();
-
-                //registry->emplace<DebugBox>(localplayerSingleton.entity);
-                Transform& transform = registry->emplace<Transform>(localplayerSingleton.entity);
-                transform.position = vec3(-9249.f, 87.f, 79.f);
-                transform.scale = vec3(1.0f, 1.0f, 1.0f);
-
-                registry->emplace<TransformIsDirty>(localplayerSingleton.entity);
-                registry->emplace<Movement>(localplayerSingleton.entity);
-
-                ModelDisplayInfo& modelDisplayInfo = registry->emplace<ModelDisplayInfo>(localplayerSingleton.entity, ModelType::Creature, 517);
-
-                if (ServiceLocator::GetCameraFreeLook()->IsActive())
-                    registry->remove<VisibleModel>(localplayerSingleton.entity);
-            }
-            else
-            {
-                localplayerSingleton.entity = entt::null;
-            }
+            CreateOfflineLocalplayer();
         }
     }
 
+    // Chunks are decoded on worker threads, once they are done we move them into the current map and upload them
+    if (IsLoadingMap() && _mapLoadJob->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        FinishLoadMap();
+        CreateOfflineLocalplayer();
+    }
+
     // Check if we should load a default map specified by Config
     {
         const Terrain::Map& currentMap = mapSingleton.GetCurrentMap();
@@ -159,6 +151,16 @@ void TerrainRenderer::Update(f32 deltaTime)
 
     Camera* camera = ServiceLocator::GetCamera();
 
+    if (_isStreaming)
+    {
+        UpdateStreaming(camera->GetPosition());
+    }
+
+    if (mapSingleton.GetCurrentMap().IsLoadedMap() && !IsLoadingMap())
+    {
+        RequestTextureDetail(camera->GetPosition());
+    }
+
     if (CVAR_HeightBoxEnable.Get())
     {
         if (!CVAR_HeightBoxLockPosition.Get())
@@ -206,6 +208,37 @@ void TerrainRenderer::Update(f32 deltaTime)
     }
 }
 
+void TerrainRenderer::CreateOfflineLocalplayer()
+{
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+
+    // This allows us to move around in the world "offline" (The server will automatically override this when connecting
+    ConnectionSingleton& connectionSingleton = registry->ctx<ConnectionSingleton>();
+    LocalplayerSingleton& localplayerSingleton = registry->ctx_or_set<LocalplayerSingleton>();
+
+    if (!connectionSingleton.gameConnection->IsConnected())
+    {
+        localplayerSingleton.entity = registry->create();
+
+        //registry->emplace<DebugBox>(localplayerSingleton.entity);
+        Transform& transform = registry->emplace<Transform>(localplayerSingleton.entity);
+        transform.position = vec3(-9249.f, 87.f, 79.f);
+        transform.scale = vec3(1.0f, 1.0f, 1.0f);
+
+        registry->emplace<TransformIsDirty>(localplayerSingleton.entity);
+        registry->emplace<Movement>(localplayerSingleton.entity);
+
+        ModelDisplayInfo& modelDisplayInfo = registry->emplace<ModelDisplayInfo>(localplayerSingleton.entity, ModelType::Creature, 517);
+
+        if (ServiceLocator::GetCameraFreeLook()->IsActive())
+            registry->remove<VisibleModel>(localplayerSingleton.entity);
+    }
+    else
+    {
+        localplayerSingleton.entity = entt::null;
+    }
+}
+
 void TerrainRenderer::DebugRenderCellTriangles(const Camera* camera)
 {
     std::vector<Geometry::Triangle> triangles = Terrain::MapUtils::GetCellTrianglesFromWorldPosition(camera->GetPosition());
@@ -255,6 +288,8 @@ void TerrainRenderer::AddOccluderPass(Renderer::RenderGraph* renderGraph, Render
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](TerrainOccluderPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -388,6 +423,8 @@ void TerrainRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, RenderR
     renderGraph->AddPass<TerrainCullingPassData>("Terrain Culling",
         [=](TerrainCullingPassData& data, Renderer::RenderGraphBuilder& builder) // Setup
         {
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](TerrainCullingPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -441,8 +478,7 @@ void TerrainRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, RenderR
 
             if (!lockFrustum)
             {
-                Camera* camera = ServiceLocator::GetCamera();
-                memcpy(_cullingConstants.frustumPlanes, camera->GetFrustumPlanes(), sizeof(_cullingConstants.frustumPlanes));
+                memcpy(_cullingConstants.frustumPlanes, resources.frameSnapshot->camera.frustumPlanes, sizeof(_cullingConstants.frustumPlanes));
             }
             _cullingConstants.occlusionEnabled = CVAR_OcclusionCullingEnabled.Get();
 
@@ -498,6 +534,8 @@ void TerrainRenderer::AddGeometryPass(Renderer::RenderGraph* renderGraph, Render
             data.visibilityBuffer = builder.Write(resources.visibilityBuffer, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](TerrainGeometryPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -629,6 +667,8 @@ void TerrainRenderer::AddEditorPass(Renderer::RenderGraph* renderGraph, RenderRe
             data.color = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](TerrainPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -861,7 +901,7 @@ void TerrainRenderer::CreatePermanentResources()
         }
     }
 
-    ExecuteLoad(); // We have to ExecuteLoad to create buffers and bind descriptors, the buffers will be empty though
+    CreateChunkSlotBuffers(0); // We have to create the buffers to bind descriptors, the buffers will be empty though
 }
 
 void TerrainRenderer::RegisterChunksToBeLoaded(Terrain::Map& map, ivec2 middleChunk, u16 drawDistance)
@@ -903,7 +943,16 @@ void TerrainRenderer::RegisterChunkToBeLoaded(Terrain::Map& map, u16 chunkPosX,
         return;
     }
 
+    if (_freeChunkSlots.empty())
+    {
+        DebugHandler::PrintError("TerrainRenderer : Ran out of chunk slots, could not load chunk %u", chunkID);
+        return;
+    }
+
     ChunkToBeLoaded& chunkToBeLoaded = _chunksToBeLoaded.emplace_back();
+    chunkToBeLoaded.slot = _freeChunkSlots.back();
+    _freeChunkSlots.pop_back();
+
     chunkToBeLoaded.map = &map;
     chunkToBeLoaded.chunk = &chunkIt->second;
     chunkToBeLoaded.chunkPosX = chunkPosX;
@@ -911,16 +960,28 @@ void TerrainRenderer::RegisterChunkToBeLoaded(Terrain::Map& map, u16 chunkPosX,
     chunkToBeLoaded.chunkID = chunkID;
 }
 
-void TerrainRenderer::ExecuteLoad()
+void TerrainRenderer::CreateChunkSlotBuffers(u32 numChunkSlots)
 {
-    ZoneScopedN("TerrainRenderer::ExecuteLoad()");
+    ZoneScopedN("TerrainRenderer::CreateChunkSlotBuffers()");
 
-    size_t numChunksToLoad = _chunksToBeLoaded.size();
+    _numChunkSlots = numChunkSlots;
+
+    // Slots are handed out from the back, so make slot 0 the first one we use
+    _freeChunkSlots.resize(numChunkSlots);
+    for (u32 i = 0; i < numChunkSlots; i++)
+    {
+        _freeChunkSlots[i] = numChunkSlots - 1 - i;
+    }
+
+    _cellBoundingBoxes.WriteLock([&](std::vector<Geometry::AABoundingBox>& cellBoundingBoxes)
+    {
+        cellBoundingBoxes.resize(Terrain::MAP_CELLS_PER_CHUNK * numChunkSlots);
+    });
 
     {
         Renderer::BufferDesc desc;
         desc.name = "TerrainInstanceBuffer";
-        desc.size = sizeof(CellInstance) * Terrain::MAP_CELLS_PER_CHUNK * numChunksToLoad;
+        desc.size = sizeof(CellInstance) * Terrain::MAP_CELLS_PER_CHUNK * numChunkSlots;
         desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::VERTEX_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
         _instanceBuffer = _renderer->CreateBuffer(_instanceBuffer, desc);
 
@@ -934,7 +995,7 @@ void TerrainRenderer::ExecuteLoad()
     {
         Renderer::BufferDesc desc;
         desc.name = "TerrainCulledInstanceBuffer";
-        desc.size = sizeof(CellInstance) * Terrain::MAP_CELLS_PER_CHUNK * numChunksToLoad;
+        desc.size = sizeof(CellInstance) * Terrain::MAP_CELLS_PER_CHUNK * numChunkSlots;
         desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::VERTEX_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
         _culledInstanceBuffer = _renderer->CreateBuffer(_culledInstanceBuffer, desc);
 
@@ -946,7 +1007,7 @@ void TerrainRenderer::ExecuteLoad()
     {
         Renderer::BufferDesc desc;
         desc.name = "TerrainCulledInstanceBitMaskBuffer";
-        desc.size = RenderUtils::CalcCullingBitmaskSize(Terrain::MAP_CELLS_PER_CHUNK * numChunksToLoad);
+        desc.size = RenderUtils::CalcCullingBitmaskSize(Terrain::MAP_CELLS_PER_CHUNK * numChunkSlots);
         desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
 
         for (u32 i = 0; i < _culledInstanceBitMaskBuffer.Num; i++)
@@ -961,7 +1022,7 @@ void TerrainRenderer::ExecuteLoad()
     {
         Renderer::BufferDesc desc;
         desc.name = "TerrainChunkBuffer";
-        desc.size = sizeof(TerrainChunkData) * numChunksToLoad;
+        desc.size = sizeof(TerrainChunkData) * numChunkSlots;
         desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
         _chunkBuffer = _renderer->CreateBuffer(_chunkBuffer, desc);
 
@@ -971,7 +1032,7 @@ void TerrainRenderer::ExecuteLoad()
     {
         Renderer::BufferDesc desc;
         desc.name = "TerrainCellBuffer";
-        desc.size = sizeof(TerrainCellData) * Terrain::MAP_CELLS_PER_CHUNK * numChunksToLoad;
+        desc.size = sizeof(TerrainCellData) * Terrain::MAP_CELLS_PER_CHUNK * numChunkSlots;
         desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
         _cellBuffer = _renderer->CreateBuffer(_cellBuffer, desc);
 
@@ -984,7 +1045,7 @@ void TerrainRenderer::ExecuteLoad()
     {
         Renderer::BufferDesc desc;
         desc.name = "TerrainVertexBuffer";
-        desc.size = sizeof(TerrainVertex) * Terrain::NUM_VERTICES_PER_CHUNK * numChunksToLoad;
+        desc.size = sizeof(TerrainVertex) * Terrain::NUM_VERTICES_PER_CHUNK * numChunkSlots;
         desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
         _vertexBuffer = _renderer->CreateBuffer(_vertexBuffer, desc);
 
@@ -997,12 +1058,17 @@ void TerrainRenderer::ExecuteLoad()
     {
         Renderer::BufferDesc desc;
         desc.name = "CellHeightRangeBuffer";
-        desc.size = sizeof(TerrainCellHeightRange) * Terrain::MAP_CELLS_PER_CHUNK * numChunksToLoad;
+        desc.size = sizeof(TerrainCellHeightRange) * Terrain::MAP_CELLS_PER_CHUNK * numChunkSlots;
         desc.usage = Renderer::BufferUsage::STORAGE_BUFFER | Renderer::BufferUsage::TRANSFER_DESTINATION;
         _cellHeightRangeBuffer = _renderer->CreateBuffer(_cellHeightRangeBuffer, desc);
 
         _cullingPassDescriptorSet.Bind("_heightRanges"_h, _cellHeightRangeBuffer);
     }
+}
+
+void TerrainRenderer::ExecuteLoad()
+{
+    ZoneScopedN("TerrainRenderer::ExecuteLoad()");
 
 #if PARALLEL_LOADING
     tf::Taskflow tf;
@@ -1036,7 +1102,8 @@ bool TerrainRenderer::LoadMap(const NDBC::Map* map)
     entt::registry* registry = ServiceLocator::GetGameRegistry();
     MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
 
-    if (!Terrain::MapUtils::LoadMap(registry, map))
+    // Only the header is loaded and the chunks are indexed here, the chunks themselves are either decoded by a MapLoadJob or streamed in by UpdateStreaming
+    if (!Terrain::MapUtils::LoadMap(registry, map, false))
         return false;
 
     Terrain::Map& currentMap = mapSingleton.GetCurrentMap();
@@ -1044,6 +1111,10 @@ bool TerrainRenderer::LoadMap(const NDBC::Map* map)
     // Clear Terrain, WMOs and Water
     _loadedChunks.Clear();
     _cellBoundingBoxes.Clear();
+    _chunkIDToInstanceID.clear();
+    _chunkIDToTextureIDs.clear();
+    _chunksWithLoadedWater.clear();
+    _isStreaming = false;
     _mapObjectRenderer->Clear();
     _cModelRenderer->Clear();
     _waterRenderer->Clear();
@@ -1058,8 +1129,73 @@ bool TerrainRenderer::LoadMap(const NDBC::Map* map)
     {
         _mapObjectRenderer->RegisterMapObjectToBeLoaded(currentMap.header.mapObjectName, currentMap.header.mapObjectPlacement);
     }
+    else if (CVAR_TerrainStreamingEnabled.Get())
+    {
+        _isStreaming = true;
+        _streamingRadius = glm::clamp(CVAR_TerrainStreamingRadius.Get(), 1, 32);
+
+        const u32 ringSideLength = (_streamingRadius * 2) + 1;
+        CreateChunkSlotBuffers(ringSideLength * ringSideLength);
+    }
     else
     {
+        // Decode every chunk of the map on worker threads into a staging map so the game loop keeps ticking (and reading the current map) meanwhile
+        _mapLoadJob = std::make_unique<MapLoadJob>();
+        _mapLoadJob->stagingMap.chunkPaths = currentMap.chunkPaths;
+
+        _mapLoadJob->chunkIDs.reserve(currentMap.chunkPaths.size());
+        for (const auto& chunkPath : currentMap.chunkPaths)
+        {
+            _mapLoadJob->chunkIDs.push_back(chunkPath.first);
+        }
+
+        MapLoadJob* mapLoadJob = _mapLoadJob.get();
+        _mapLoadJob->result = std::async(std::launch::async, [mapLoadJob]()
+        {
+            tracy::SetThreadName("MapLoadJob");
+            return Terrain::MapUtils::LoadChunks(mapLoadJob->stagingMap, mapLoadJob->chunkIDs, &mapLoadJob->numChunksLoaded);
+        });
+
+        return true;
+    }
+
+    FinishLoadMap();
+    return true;
+}
+
+void TerrainRenderer::FinishLoadMap()
+{
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+    MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
+    Terrain::Map& currentMap = mapSingleton.GetCurrentMap();
+
+    if (_mapLoadJob != nullptr)
+    {
+        bool didLoadChunks = _mapLoadJob->result.get();
+        f32 loadTimeMS = _mapLoadJob->timer.GetLifeTime() * 1000.0f;
+
+        if (didLoadChunks)
+        {
+            // Moving the maps hands over the chunk nodes, the chunks themselves are not copied
+            Terrain::Map& stagingMap = _mapLoadJob->stagingMap;
+            currentMap.chunks = std::move(stagingMap.chunks);
+            currentMap.stringTables = std::move(stagingMap.stringTables);
+            currentMap.chunksEntityList = std::move(stagingMap.chunksEntityList);
+            currentMap.chunksCollidableEntityList = std::move(stagingMap.chunksCollidableEntityList);
+            currentMap.chunksCollisionBroadphase = std::move(stagingMap.chunksCollisionBroadphase);
+
+            DebugHandler::PrintSuccess("Loaded %u chunks for (%s) in %.2f ms", static_cast<u32>(currentMap.chunks.size()), currentMap.name.data(), loadTimeMS);
+        }
+        _mapLoadJob.reset();
+
+        if (!didLoadChunks)
+        {
+            DebugHandler::PrintError("Failed to load chunks for (%s)", currentMap.name.data());
+            return;
+        }
+
+        CreateChunkSlotBuffers(static_cast<u32>(currentMap.chunks.size()));
+
         RegisterChunksToBeLoaded(currentMap, ivec2(32, 32), 32); // Load everything
         //RegisterChunksToBeLoaded(currentMap, ivec2(31, 49), 1); // bugged terrain
         //RegisterChunksToBeLoaded(mapSingleton.currentMap, ivec2(31, 49), 1); // Goldshire
@@ -1067,41 +1203,265 @@ bool TerrainRenderer::LoadMap(const NDBC::Map* map)
         //RegisterChunksToBeLoaded(map, ivec2(22, 25), 8); // Borean Tundra
 
         ExecuteLoad();
-    
-        // Upload instance data
-        {
-            const size_t cellCount = Terrain::MAP_CELLS_PER_CHUNK * _loadedChunks.Size();
+        UploadInstanceData();
+    }
+
+    _mapObjectRenderer->ExecuteLoad();
+    _cModelRenderer->ExecuteLoad();
+
+    // Load Water
+    _waterRenderer->LoadWater(_loadedChunks);
+    _loadedChunks.ReadLock([&](const std::vector<u16>& loadedChunks)
+    {
+        _chunksWithLoadedWater.insert(loadedChunks.begin(), loadedChunks.end());
+    });
+}
+
+f32 TerrainRenderer::GetMapLoadProgress()
+{
+    if (_mapLoadJob == nullptr || _mapLoadJob->chunkIDs.empty())
+        return 1.0f;
+
+    return static_cast<f32>(_mapLoadJob->numChunksLoaded.load()) / static_cast<f32>(_mapLoadJob->chunkIDs.size());
+}
+
+void TerrainRenderer::UploadInstanceData()
+{
+    ZoneScopedN("TerrainRenderer::UploadInstanceData()");
+
+    const size_t cellCount = Terrain::MAP_CELLS_PER_CHUNK * _loadedChunks.Size();
+    if (cellCount == 0)
+        return;
+
+    // The instances are tightly packed in the order of _loadedChunks, but point into the chunk slot the data was loaded into
+    size_t size = sizeof(CellInstance) * cellCount;
+    auto uploadBuffer = _renderer->CreateUploadBuffer(_instanceBuffer, 0, size);
 
-            size_t size = sizeof(CellInstance) * cellCount;
-            auto uploadBuffer = _renderer->CreateUploadBuffer(_instanceBuffer, 0, size);
+    CellInstance* instanceData = static_cast<CellInstance*>(uploadBuffer->mappedMemory);
+    u32 instanceDataIndex = 0;
 
-            CellInstance* instanceData = static_cast<CellInstance*>(uploadBuffer->mappedMemory);
-            u32 instanceDataIndex = 0;
+    _loadedChunks.ReadLock(
+        [&](const std::vector<u16>& loadedChunks)
+        {
+            for (const u16 chunkID : loadedChunks)
+            {
+                const u32 slotCellOffset = _chunkIDToInstanceID[chunkID] * Terrain::MAP_CELLS_PER_CHUNK;
 
-            _loadedChunks.ReadLock(
-                [&](std::vector<u16> loadedChunks)
+                for (u32 cellID = 0; cellID < Terrain::MAP_CELLS_PER_CHUNK; ++cellID)
                 {
-                    for (const u16 chunkID : loadedChunks)
-                    {
-                        for (u32 cellID = 0; cellID < Terrain::MAP_CELLS_PER_CHUNK; ++cellID)
-                        {
-                            instanceData[instanceDataIndex].packedChunkCellID = (chunkID << 16) | (cellID & 0xffff);
-                            instanceData[instanceDataIndex++].instanceID = instanceDataIndex;
-                        }
-                    }
-                });
+                    instanceData[instanceDataIndex].packedChunkCellID = (chunkID << 16) | (cellID & 0xffff);
+                    instanceData[instanceDataIndex++].instanceID = slotCellOffset + cellID;
+                }
+            }
+        });
+
+    assert(instanceDataIndex == cellCount);
+}
+
+void TerrainRenderer::UpdateStreaming(const vec3& position)
+{
+    ZoneScopedN("TerrainRenderer::UpdateStreaming()");
+
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+    MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
+    Terrain::Map& currentMap = mapSingleton.GetCurrentMap();
+
+    if (!currentMap.IsLoadedMap())
+        return;
 
-            assert(instanceDataIndex == cellCount);
+    vec2 adtPos = Terrain::MapUtils::WorldPositionToADTCoordinates(position);
+    vec2 chunkPos = Terrain::MapUtils::GetChunkFromAdtPosition(adtPos);
+
+    constexpr i32 maxChunkPos = Terrain::MAP_CHUNKS_PER_MAP_STRIDE - 1;
+    ivec2 middleChunk = glm::clamp(ivec2(Math::FloorToInt(chunkPos.x), Math::FloorToInt(chunkPos.y)), ivec2(0, 0), ivec2(maxChunkPos, maxChunkPos));
+
+    // Evict every chunk that has left the ring
+    std::vector<u16> chunksToEvict;
+    _loadedChunks.ReadLock([&](const std::vector<u16>& loadedChunks)
+    {
+        for (const u16 chunkID : loadedChunks)
+        {
+            const i32 chunkX = chunkID % Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
+            const i32 chunkY = chunkID / Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
+
+            if (glm::abs(chunkX - middleChunk.x) > _streamingRadius || glm::abs(chunkY - middleChunk.y) > _streamingRadius)
+            {
+                chunksToEvict.push_back(chunkID);
+            }
+        }
+    });
+
+    for (const u16 chunkID : chunksToEvict)
+    {
+        EvictChunk(currentMap, chunkID);
+    }
+
+    // Find the chunks within the ring that are missing, closest first
+    struct MissingChunk
+    {
+        i32 distance;
+        u16 chunkPosX;
+        u16 chunkPosY;
+    };
+    std::vector<MissingChunk> missingChunks;
+
+    ivec2 startPos = glm::max(middleChunk - _streamingRadius, ivec2(0, 0));
+    ivec2 endPos = glm::min(middleChunk + _streamingRadius, ivec2(maxChunkPos, maxChunkPos));
+
+    for (i32 y = startPos.y; y <= endPos.y; y++)
+    {
+        for (i32 x = startPos.x; x <= endPos.x; x++)
+        {
+            u16 chunkID = x + (y * Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+
+            if (currentMap.chunkPaths.find(chunkID) == currentMap.chunkPaths.end())
+                continue;
+
+            if (_chunkIDToInstanceID.find(chunkID) != _chunkIDToInstanceID.end())
+                continue;
+
+            MissingChunk& missingChunk = missingChunks.emplace_back();
+            missingChunk.distance = glm::max(glm::abs(x - middleChunk.x), glm::abs(y - middleChunk.y));
+            missingChunk.chunkPosX = x;
+            missingChunk.chunkPosY = y;
+        }
+    }
+
+    if (missingChunks.empty())
+    {
+        if (!chunksToEvict.empty())
+        {
+            UploadInstanceData();
+        }
+        return;
+    }
+
+    std::sort(missingChunks.begin(), missingChunks.end(), [](const MissingChunk& a, const MissingChunk& b) { return a.distance < b.distance; });
+
+    const size_t maxLoadsPerFrame = static_cast<size_t>(glm::max(CVAR_TerrainStreamingMaxLoadsPerFrame.Get(), 1));
+    const size_t numChunksToLoad = glm::min(missingChunks.size(), maxLoadsPerFrame);
+
+    std::vector<u16> realignedChunkIDs;
+    for (size_t i = 0; i < numChunksToLoad; i++)
+    {
+        const MissingChunk& missingChunk = missingChunks[i];
+        u16 chunkID = missingChunk.chunkPosX + (missingChunk.chunkPosY * Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+
+        if (!Terrain::MapUtils::LoadChunk(currentMap, chunkID))
+            continue;
+
+        RegisterChunkToBeLoaded(currentMap, missingChunk.chunkPosX, missingChunk.chunkPosY);
+
+        // Loading this chunk realigned the borders of the resident chunks below and to the right of it
+        if (missingChunk.chunkPosY < maxChunkPos)
+            realignedChunkIDs.push_back(chunkID + Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+
+        if (missingChunk.chunkPosX < maxChunkPos)
+            realignedChunkIDs.push_back(chunkID + 1);
+    }
+
+    ExecuteLoad();
+    UploadInstanceData();
+
+    for (const u16 chunkID : realignedChunkIDs)
+    {
+        auto slotItr = _chunkIDToInstanceID.find(chunkID);
+        Terrain::Chunk* chunk = currentMap.GetChunkById(chunkID);
+
+        if (slotItr != _chunkIDToInstanceID.end() && chunk != nullptr)
+        {
+            UploadChunkVertices(slotItr->second, *chunk);
         }
     }
 
+    // Placements are deduplicated by uniqueID inside of the MapObject and CModel renderers, so chunks that stream back in won't load them twice
     _mapObjectRenderer->ExecuteLoad();
     _cModelRenderer->ExecuteLoad();
 
-    // Load Water
-    _waterRenderer->LoadWater(_loadedChunks);
+    SafeVector<u16> waterChunkIDs;
+    for (size_t i = 0; i < numChunksToLoad; i++)
+    {
+        const MissingChunk& missingChunk = missingChunks[i];
+        u16 chunkID = missingChunk.chunkPosX + (missingChunk.chunkPosY * Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
 
-    return true;
+        if (_chunkIDToInstanceID.find(chunkID) == _chunkIDToInstanceID.end())
+            continue;
+
+        if (_chunksWithLoadedWater.insert(chunkID).second)
+        {
+            waterChunkIDs.PushBack(chunkID);
+        }
+    }
+
+    if (waterChunkIDs.Size() > 0)
+    {
+        _waterRenderer->LoadWater(waterChunkIDs);
+    }
+}
+
+void TerrainRenderer::EvictChunk(Terrain::Map& map, u16 chunkID)
+{
+    auto slotItr = _chunkIDToInstanceID.find(chunkID);
+    if (slotItr == _chunkIDToInstanceID.end())
+        return;
+
+    _freeChunkSlots.push_back(slotItr->second);
+    _chunkIDToInstanceID.erase(slotItr);
+
+    _loadedChunks.WriteLock([&](std::vector<u16>& loadedChunks)
+    {
+        auto itr = std::find(loadedChunks.begin(), loadedChunks.end(), chunkID);
+        if (itr != loadedChunks.end())
+        {
+            loadedChunks.erase(itr);
+        }
+
+        _chunkIDToTextureIDs.erase(chunkID);
+    });
+
+    // The GPU slot is reused by the next chunk that streams in, MapObjects, CModels, Water and textures stay resident
+    // None of those renderers can remove single instances yet, so they keep growing with every new chunk the camera passes until the map is cleared
+    Terrain::MapUtils::UnloadChunk(map, chunkID);
+}
+
+void TerrainRenderer::RequestTextureDetail(const vec3& position)
+{
+    ZoneScopedN("TerrainRenderer::RequestTextureDetail()");
+
+    std::vector<Renderer::TextureStreamingRequest> requests;
+
+    _loadedChunks.ReadLock([&](const std::vector<u16>& loadedChunks)
+    {
+        _cellBoundingBoxes.ReadLock([&](const std::vector<Geometry::AABoundingBox>& cellBoundingBoxes)
+        {
+            for (const u16 chunkID : loadedChunks)
+            {
+                auto textureItr = _chunkIDToTextureIDs.find(chunkID);
+                auto slotItr = _chunkIDToInstanceID.find(chunkID);
+                if (textureItr == _chunkIDToTextureIDs.end() || slotItr == _chunkIDToInstanceID.end())
+                    continue;
+
+                // The textures of a chunk are shared between its cells, so the closest cell decides the detail
+                f32 distance = std::numeric_limits<f32>().max();
+                const size_t cellOffset = slotItr->second * Terrain::MAP_CELLS_PER_CHUNK;
+
+                for (u32 i = 0; i < Terrain::MAP_CELLS_PER_CHUNK; i++)
+                {
+                    const Geometry::AABoundingBox& boundingBox = cellBoundingBoxes[cellOffset + i];
+
+                    vec3 delta = glm::max(glm::abs(position - boundingBox.center) - glm::abs(boundingBox.extents), vec3(0.0f));
+                    distance = glm::min(distance, glm::length(delta));
+                }
+
+                for (const Renderer::TextureID textureID : textureItr->second)
+                {
+                    requests.push_back({ textureID, distance });
+                }
+            }
+        });
+    });
+
+    _renderer->RequestTextureDetail(requests);
 }
 
 void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
@@ -1116,14 +1476,15 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
     entt::registry* registry = ServiceLocator::GetGameRegistry();     
     TextureSingleton& textureSingleton = registry->ctx<TextureSingleton>();
 
-    size_t currentChunkIndex = 0;
+    const size_t currentChunkIndex = chunkToBeLoaded.slot;
+    std::vector<Renderer::TextureID> textureIDs;
+
     _loadedChunks.WriteLock(
-        [this, &currentChunkIndex, chunkID](std::vector<u16>& loadedChunks)
+        [this, &chunkToBeLoaded, chunkID](std::vector<u16>& loadedChunks)
         {
-            currentChunkIndex = loadedChunks.size();
             loadedChunks.push_back(chunkID);
 
-            _chunkIDToInstanceID[chunkID] = static_cast<u32>(currentChunkIndex);
+            _chunkIDToInstanceID[chunkID] = chunkToBeLoaded.slot;
         }
     );
 
@@ -1159,7 +1520,7 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
                     break;
                 }
 
-                const std::string& texturePath = textureSingleton.textureHashToPath[layer.textureId];
+                const char* texturePath = textureSingleton.textureManifest.GetPath(layer.textureId);
 
                 Renderer::TextureDesc textureDesc;
                 textureDesc.path = texturePath;
@@ -1167,7 +1528,12 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
                 u32 diffuseID = 0;
                 {
                     ZoneScopedN("LoadTexture");
-                    _renderer->LoadTextureIntoArray(textureDesc, _terrainColorTextureArray, diffuseID);
+                    Renderer::TextureID textureID = _renderer->LoadTextureIntoArray(textureDesc, _terrainColorTextureArray, diffuseID);
+
+                    if (std::find(textureIDs.begin(), textureIDs.end(), textureID) == textureIDs.end())
+                    {
+                        textureIDs.push_back(textureID);
+                    }
                 }
 
                 if (diffuseID > 4096)
@@ -1189,10 +1555,18 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
         chunkAlphaMapDesc.path = "Data/extracted/" + stringTable.GetString(alphaMapStringID);
 
         {
-            _renderer->LoadTextureIntoArray(chunkAlphaMapDesc, _terrainAlphaTextureArray, alphaID);
+            Renderer::TextureID textureID = _renderer->LoadTextureIntoArray(chunkAlphaMapDesc, _terrainAlphaTextureArray, alphaID);
+            textureIDs.push_back(textureID);
         }
     }
 
+    _loadedChunks.WriteLock(
+        [&](std::vector<u16>& loadedChunks)
+        {
+            _chunkIDToTextureIDs[chunkID] = std::move(textureIDs);
+        }
+    );
+
     // Upload chunk data.
     {
         ZoneScopedN("Upload ChunkData");
@@ -1206,41 +1580,7 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
     }
 
     // Upload height data.
-    {
-        ZoneScopedN("Upload HeightData");
-
-        size_t size = sizeof(TerrainVertex) * Terrain::NUM_VERTICES_PER_CHUNK;
-        const u64 chunkVertexBufferOffset = currentChunkIndex * sizeof(TerrainVertex) * Terrain::NUM_VERTICES_PER_CHUNK;
-        auto uploadBuffer = _renderer->CreateUploadBuffer(_vertexBuffer, chunkVertexBufferOffset, size);
-
-        TerrainVertex* vertexBufferMemory = reinterpret_cast<TerrainVertex*>(uploadBuffer->mappedMemory);
-        for (size_t i = 0; i < Terrain::MAP_CELLS_PER_CHUNK; i++)
-        {
-            size_t cellOffset = i * Terrain::MAP_CELL_TOTAL_GRID_SIZE;
-            for (size_t j = 0; j < Terrain::MAP_CELL_TOTAL_GRID_SIZE; j++)
-            {
-                size_t offset = cellOffset + j;
-
-                // Set height
-                f32 height = chunk.cells[i].heightData[j];
-                vertexBufferMemory[offset].height = height;
-
-                u8 x = chunk.cells[i].normalData[j][0];
-                u8 y = chunk.cells[i].normalData[j][1];
-                u8 z = chunk.cells[i].normalData[j][2];
-
-                // Set normal
-                vertexBufferMemory[offset].normal[0] = x;
-                vertexBufferMemory[offset].normal[1] = y;
-                vertexBufferMemory[offset].normal[2] = z;
-
-                // Set color
-                vertexBufferMemory[offset].color[0] = chunk.cells[i].colorData[j][0];
-                vertexBufferMemory[offset].color[1] = chunk.cells[i].colorData[j][1];
-                vertexBufferMemory[offset].color[2] = chunk.cells[i].colorData[j][2];
-            }
-        }
-    }
+    UploadChunkVertices(static_cast<u32>(currentChunkIndex), chunk);
 
     // Calculate bounding boxes and upload height ranges
     {
@@ -1255,6 +1595,8 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
         std::vector<TerrainCellHeightRange> heightRanges;
         heightRanges.reserve(Terrain::MAP_CELLS_PER_CHUNK);
 
+        std::array<Geometry::AABoundingBox, Terrain::MAP_CELLS_PER_CHUNK> boundingBoxes;
+
         for (u32 cellIndex = 0; cellIndex < Terrain::MAP_CELLS_PER_CHUNK; cellIndex++)
         {
             const Terrain::Cell& cell = chunk.cells[cellIndex];
@@ -1284,7 +1626,7 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
             boundingBox.center = (aabbMin + aabbMax) * 0.5f;
             boundingBox.extents = aabbMax - boundingBox.center;
 
-            _cellBoundingBoxes.PushBack(boundingBox);
+            boundingBoxes[cellIndex] = boundingBox;
 
             TerrainCellHeightRange heightRange;
 #if USE_PACKED_HEIGHT_RANGE
@@ -1298,6 +1640,11 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
             heightRanges.push_back(heightRange);
         }
 
+        _cellBoundingBoxes.WriteLock([&](std::vector<Geometry::AABoundingBox>& cellBoundingBoxes)
+        {
+            std::copy(boundingBoxes.begin(), boundingBoxes.end(), cellBoundingBoxes.begin() + (currentChunkIndex * Terrain::MAP_CELLS_PER_CHUNK));
+        });
+
         // Upload height ranges
         {
             size_t size = sizeof(TerrainCellHeightRange) * Terrain::MAP_CELLS_PER_CHUNK;
@@ -1311,3 +1658,40 @@ void TerrainRenderer::LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded)
     _mapObjectRenderer->RegisterMapObjectsToBeLoaded(chunkID, chunk, stringTable);
     _cModelRenderer->RegisterLoadFromChunk(chunkID, chunk, stringTable);
 }
+
+void TerrainRenderer::UploadChunkVertices(u32 slot, const Terrain::Chunk& chunk)
+{
+    ZoneScopedN("Upload HeightData");
+
+    size_t size = sizeof(TerrainVertex) * Terrain::NUM_VERTICES_PER_CHUNK;
+    const u64 chunkVertexBufferOffset = static_cast<u64>(slot) * sizeof(TerrainVertex) * Terrain::NUM_VERTICES_PER_CHUNK;
+    auto uploadBuffer = _renderer->CreateUploadBuffer(_vertexBuffer, chunkVertexBufferOffset, size);
+
+    TerrainVertex* vertexBufferMemory = reinterpret_cast<TerrainVertex*>(uploadBuffer->mappedMemory);
+    for (size_t i = 0; i < Terrain::MAP_CELLS_PER_CHUNK; i++)
+    {
+        size_t cellOffset = i * Terrain::MAP_CELL_TOTAL_GRID_SIZE;
+        for (size_t j = 0; j < Terrain::MAP_CELL_TOTAL_GRID_SIZE; j++)
+        {
+            size_t offset = cellOffset + j;
+
+            // Set height
+            f32 height = chunk.cells[i].heightData[j];
+            vertexBufferMemory[offset].height = height;
+
+            u8 x = chunk.cells[i].normalData[j][0];
+            u8 y = chunk.cells[i].normalData[j][1];
+            u8 z = chunk.cells[i].normalData[j][2];
+
+            // Set normal
+            vertexBufferMemory[offset].normal[0] = x;
+            vertexBufferMemory[offset].normal[1] = y;
+            vertexBufferMemory[offset].normal[2] = z;
+
+            // Set color
+            vertexBufferMemory[offset].color[0] = chunk.cells[i].colorData[j][0];
+            vertexBufferMemory[offset].color[1] = chunk.cells[i].colorData[j][1];
+            vertexBufferMemory[offset].color[2] = chunk.cells[i].colorData[j][2];
+        }
+    }
+}
@@ -2,9 +2,12 @@
 #include <NovusTypes.h>
 
 #include <array>
+#include <atomic>
+#include <future>
 
 #include <Utils/StringUtils.h>
 #include <Utils/SafeVector.h>
+#include <Utils/Timer.h>
 #include <Math/Geometry.h>
 #include <Renderer/Descriptors/ImageDesc.h>
 #include <Renderer/Descriptors/DepthImageDesc.h>
@@ -15,12 +18,10 @@
 #include <Renderer/Buffer.h>
 #include <Renderer/DescriptorSet.h>
 
-#include "../Gameplay/Map/Chunk.h"
+#include "../Gameplay/Map/Map.h"
 
 namespace Terrain
 {
-    struct Map;
-
     constexpr u32 NUM_VERTICES_PER_CHUNK = Terrain::MAP_CELL_TOTAL_GRID_SIZE * Terrain::MAP_CELLS_PER_CHUNK;
     constexpr u32 NUM_INDICES_PER_CELL = 768;
     constexpr u32 NUM_TRIANGLES_PER_CELL = NUM_INDICES_PER_CELL / 3;
@@ -53,6 +54,7 @@ class TerrainRenderer
         u16 chunkPosX;
         u16 chunkPosY;
         u16 chunkID;
+        u32 slot; // Which chunk slot of the instance, cell, vertex and height range buffers this chunk is loaded into
     };
 
     struct CullingConstants
@@ -68,6 +70,16 @@ class TerrainRenderer
         u32 instanceID;
     };
 
+    struct MapLoadJob
+    {
+        Terrain::Map stagingMap;
+        std::vector<u16> chunkIDs;
+
+        std::atomic<u32> numChunksLoaded = 0;
+        std::future<bool> result;
+        Timer timer;
+    };
+
 #pragma pack(push, 1)
     struct TerrainVertex
     {
@@ -89,6 +101,8 @@ public:
     void AddEditorPass(Renderer::RenderGraph* renderGraph, RenderResources& resources, u8 frameIndex);
 
     bool LoadMap(const NDBC::Map* map);
+    bool IsLoadingMap() { return _mapLoadJob != nullptr; }
+    f32 GetMapLoadProgress();
 
     const SafeVector<Geometry::AABoundingBox>& GetBoundingBoxes() { return _cellBoundingBoxes; }
 
@@ -108,12 +122,22 @@ public:
     
 private:
     void CreatePermanentResources();
+    void CreateChunkSlotBuffers(u32 numChunkSlots);
+    void CreateOfflineLocalplayer();
+
+    void FinishLoadMap();
 
     void RegisterChunksToBeLoaded(Terrain::Map& map, ivec2 middleChunk, u16 drawDistance);
     void RegisterChunkToBeLoaded(Terrain::Map& map, u16 chunkPosX, u16 chunkPosY);
     void ExecuteLoad();
+    void UploadInstanceData();
 
     void LoadChunk(const ChunkToBeLoaded& chunkToBeLoaded);
+    void UploadChunkVertices(u32 slot, const Terrain::Chunk& chunk);
+
+    void UpdateStreaming(const vec3& position);
+    void EvictChunk(Terrain::Map& map, u16 chunkID);
+    void RequestTextureDetail(const vec3& position);
     //void LoadChunksAround(Terrain::Map& map, ivec2 middleChunk, u16 drawDistance);
 
     void DebugRenderCellTriangles(const Camera* camera);
@@ -162,12 +186,22 @@ private:
     std::vector<CellInstance> _culledInstances;
     std::vector<ChunkToBeLoaded> _chunksToBeLoaded;
 
+    u32 _numChunkSlots = 0;
+    std::vector<u32> _freeChunkSlots;
+
+    std::unique_ptr<MapLoadJob> _mapLoadJob;
+
+    bool _isStreaming = false;
+    i32 _streamingRadius = 0;
+    robin_hood::unordered_set<u16> _chunksWithLoadedWater;
+
     std::mutex _subLoadMutex;
 
     u32 _numOccluderDrawCalls;
     u32 _numSurvivingDrawCalls;
     
     robin_hood::unordered_map<u32, u32> _chunkIDToInstanceID;
+    robin_hood::unordered_map<u16, std::vector<Renderer::TextureID>> _chunkIDToTextureIDs; // Written under the _loadedChunks lock like _chunkIDToInstanceID
 
     DebugRenderer* _debugRenderer = nullptr;
     MapObjectRenderer* _mapObjectRenderer = nullptr;
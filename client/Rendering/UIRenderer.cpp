@@ -3,10 +3,12 @@
 #include "GLFW/glfw3.h"
 #include "CVar/CVarSystem.h"
 #include "RenderResources.h"
+#include "FrameSnapshot.h"
 
 #include <Renderer/Renderer.h>
 #include <Renderer/RenderGraph.h>
 #include <Renderer/Descriptors/FontDesc.h>
+#include <Renderer/Font.h>
 #include <Renderer/Descriptors/TextureDesc.h>
 #include <Renderer/Descriptors/SamplerDesc.h>
 #include <Renderer/Buffer.h>
@@ -17,6 +19,7 @@
 #include "../Utils/ServiceLocator.h"
 
 #include "../UI/ECS/Components/Singletons/UIDataSingleton.h"
+#include "../UI/ECS/Components/Singletons/UICollisionGridSingleton.h"
 #include "../UI/ECS/Components/ElementInfo.h"
 #include "../UI/ECS/Components/Relation.h"
 #include "../UI/ECS/Components/Root.h"
@@ -62,6 +65,11 @@ UIRenderer::UIRenderer(Renderer::Renderer* renderer, DebugRenderer* debugRendere
     f32 aspectRatio = (static_cast<f32>(width) / static_cast<f32>(height));
     dataSingleton.UIRESOLUTION = hvec2(dataSingleton.referenceHeight * aspectRatio, dataSingleton.referenceHeight);
 
+    // Set up the collision grid over the UI resolution.
+    UISingleton::UICollisionGridSingleton& collisionGridSingleton = registry->set<UISingleton::UICollisionGridSingleton>();
+    collisionGridSingleton.size = uvec2(glm::ceil(vec2(dataSingleton.UIRESOLUTION) / UISingleton::UICollisionGridSingleton::CELL_SIZE));
+    collisionGridSingleton.cells.resize(collisionGridSingleton.size.x * collisionGridSingleton.size.y);
+
     //Reserve component space
     const int ENTITIES_TO_PREALLOCATE = 10000;
     registry->reserve(ENTITIES_TO_PREALLOCATE);
@@ -97,6 +105,89 @@ UIRenderer::UIRenderer(Renderer::Renderer* renderer, DebugRenderer* debugRendere
 
 void UIRenderer::Update(f32 deltaTime)
 {
+    ZoneScoped;
+
+    entt::registry* registry = ServiceLocator::GetUIRegistry();
+
+    // Glyphs that finished rasterizing since last frame need to be in the atlases before we draw them
+    Renderer::FontFace::SyncToGPU();
+
+    // Stream every visible quad in sort key order, merging consecutive elements that share a material into one draw
+    _quads.Clear(false);
+    _elementRenderDatas.Clear(false);
+    _drawBatches.clear();
+
+    _quads.WriteLock([&](std::vector<UI::Quad>& quads)
+    {
+        _elementRenderDatas.WriteLock([&](std::vector<UI::ElementRenderData>& elementRenderDatas)
+        {
+            auto addElement = [&](UI::RenderType renderType, Renderer::Font* font, const UI::Quad* elementQuads, size_t numQuads, const UI::ElementRenderData& renderData)
+            {
+                u32 elementIndex = static_cast<u32>(elementRenderDatas.size());
+                elementRenderDatas.push_back(renderData);
+
+                u32 firstQuad = static_cast<u32>(quads.size());
+                for (size_t i = 0; i < numQuads; i++)
+                {
+                    UI::Quad& quad = quads.emplace_back(elementQuads[i]);
+                    quad.elementIndex = elementIndex;
+                }
+
+                Renderer::TextureID fontAtlas = (font != nullptr) ? font->GetAtlasTexture() : Renderer::TextureID::Invalid();
+                if (!_drawBatches.empty() && _drawBatches.back().renderType == renderType && _drawBatches.back().fontAtlas == fontAtlas)
+                {
+                    _drawBatches.back().numQuads += static_cast<u32>(numQuads);
+                    return;
+                }
+
+                DrawBatch& drawBatch = _drawBatches.emplace_back();
+                drawBatch.renderType = renderType;
+                drawBatch.fontAtlas = fontAtlas;
+                drawBatch.glyphTexCoords = (font != nullptr) ? font->GetGlyphTexCoordBuffer() : Renderer::BufferID::Invalid();
+                drawBatch.firstQuad = firstQuad;
+                drawBatch.numQuads = static_cast<u32>(numQuads);
+            };
+
+            auto renderGroup = registry->group<UIComponent::SortKey>(entt::get<UIComponent::Renderable, UIComponent::Visible, UIComponent::NotCulled>);
+            renderGroup.sort<UIComponent::SortKey>([](UIComponent::SortKey& first, UIComponent::SortKey& second) { return first.key < second.key; });
+            renderGroup.each([&](const auto entity, UIComponent::SortKey& sortKey, UIComponent::Renderable& renderable)
+            {
+                switch (renderable.renderType)
+                {
+                    case UI::RenderType::Text:
+                    {
+                        UIComponent::Text& text = registry->get<UIComponent::Text>(entity);
+                        if (!text.font || text.glyphQuads.empty())
+                            break;
+
+                        addElement(UI::RenderType::Text, text.font, text.glyphQuads.data(), text.glyphQuads.size(), text.renderData);
+                        break;
+                    }
+                    case UI::RenderType::Image:
+                    {
+                        UIComponent::Image& image = registry->get<UIComponent::Image>(entity);
+                        if (image.textureID == Renderer::TextureID::Invalid())
+                            break;
+
+                        addElement(UI::RenderType::Image, nullptr, &image.quad, 1, image.renderData);
+                        break;
+                    }
+                    default:
+                        DebugHandler::PrintFatal("Renderable widget tried to render with invalid render type.");
+                }
+            });
+        });
+    });
+
+    if (_quads.SyncToGPU(_renderer))
+    {
+        _passDescriptorSet.Bind("_quads"_h, _quads.GetBuffer());
+    }
+    if (_elementRenderDatas.SyncToGPU(_renderer))
+    {
+        _passDescriptorSet.Bind("_elementRenderDatas"_h, _elementRenderDatas.GetBuffer());
+    }
+
     bool drawCollisionBoxes = CVAR_UICollisionBoundsEnabled.Get() == 1;
     if (drawCollisionBoxes)
     {
@@ -133,6 +224,8 @@ void UIRenderer::AddUIPass(Renderer::RenderGraph* renderGraph, RenderResources&
         {
             data.color = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](UIPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -177,93 +270,45 @@ void UIRenderer::AddUIPass(Renderer::RenderGraph* renderGraph, RenderResources&
 
             Renderer::GraphicsPipelineID textPipeline = _renderer->CreatePipeline(pipelineDesc); // This will compile the pipeline and return the ID, or just return ID of cached pipeline
 
-            // Set pipeline
-            commandList.BeginPipeline(imagePipeline);
-            Renderer::GraphicsPipelineID activePipeline = imagePipeline;
+            if (_drawBatches.empty())
+                return;
 
-            commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_PASS, &_passDescriptorSet, frameIndex);
+            Renderer::GraphicsPipelineID activePipeline = Renderer::GraphicsPipelineID::Invalid();
 
-            entt::registry* registry = ServiceLocator::GetUIRegistry();
-            auto renderGroup = registry->group<UIComponent::SortKey>(entt::get<UIComponent::Renderable, UIComponent::Visible, UIComponent::NotCulled>);
-            renderGroup.sort<UIComponent::SortKey>([](UIComponent::SortKey& first, UIComponent::SortKey& second) { return first.key < second.key; });
-            renderGroup.each([this, &commandList, frameIndex, &registry, &activePipeline, &textPipeline, &imagePipeline](const auto entity, UIComponent::SortKey& sortKey, UIComponent::Renderable& renderable)
+            for (const DrawBatch& drawBatch : _drawBatches)
             {
-                switch (renderable.renderType)
+                Renderer::GraphicsPipelineID pipeline = (drawBatch.renderType == UI::RenderType::Text) ? textPipeline : imagePipeline;
+                if (activePipeline != pipeline)
                 {
-                    case UI::RenderType::Text:
+                    if (activePipeline != Renderer::GraphicsPipelineID::Invalid())
                     {
-                        UIComponent::Text& text = registry->get<UIComponent::Text>(entity);
-                        if (!text.constantBuffer || text.vertexBufferID == Renderer::BufferID::Invalid())
-                            break;
-
-                        if (activePipeline != textPipeline)
-                        {
-                            commandList.EndPipeline(activePipeline);
-                            commandList.BeginPipeline(textPipeline);
-                            commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_PASS, &_passDescriptorSet, frameIndex);
-                            activePipeline = textPipeline;
-                        }
-
-                        commandList.PushMarker("Text", Color(0.0f, 0.1f, 0.0f));
-
-                        // Bind descriptors
-                        _drawTextDescriptorSet.Bind("_vertexData"_h, text.vertexBufferID);
-                        _drawTextDescriptorSet.Bind("_textData"_h, text.constantBuffer->GetBuffer(frameIndex));
-                        _drawTextDescriptorSet.Bind("_textureIDs"_h, text.textureIDBufferID);
-                        _drawTextDescriptorSet.Bind("_textures"_h, text.font->GetTextureArray());
-
-                        commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_DRAW, &_drawTextDescriptorSet, frameIndex);
-
-                        commandList.SetIndexBuffer(_indexBuffer, Renderer::IndexFormat::UInt16);
-
-                        commandList.DrawIndexed(6, static_cast<u32>(text.glyphCount), 0, 0, 0);
-
-                        commandList.PopMarker();
-                        break;
+                        commandList.EndPipeline(activePipeline);
                     }
-                    case UI::RenderType::Image:
-                    {
-                        UIComponent::Image& image = registry->get<UIComponent::Image>(entity);
-                        if (!image.constantBuffer)
-                            return;
-
-                        if (activePipeline != imagePipeline)
-                        {
-                            commandList.EndPipeline(activePipeline);
-                            commandList.BeginPipeline(imagePipeline);
-                            commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_PASS, &_passDescriptorSet, frameIndex);
-                            activePipeline = imagePipeline;
-                        }
-
-                        commandList.PushMarker("Image", Color(0.0f, 0.1f, 0.0f));
 
-                        // Bind descriptors
-                        _drawImageDescriptorSet.Bind("_vertices"_h, image.vertexBufferID);
-                        _drawImageDescriptorSet.Bind("_panelData"_h, image.constantBuffer->GetBuffer(frameIndex));
-                        _drawImageDescriptorSet.Bind("_texture"_h, image.textureID);
-
-                        if (image.borderID != Renderer::TextureID::Invalid())
-                        {
-                            _drawImageDescriptorSet.Bind("_border"_h, image.borderID);
-                        }
-                        else
-                        {
-                            _drawImageDescriptorSet.Bind("_border"_h, _emptyBorder);
-                        }
+                    commandList.BeginPipeline(pipeline);
+                    commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_PASS, &_passDescriptorSet, frameIndex);
+                    commandList.SetIndexBuffer(_indexBuffer, Renderer::IndexFormat::UInt16);
+                    activePipeline = pipeline;
+                }
 
-                        commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_DRAW, &_drawImageDescriptorSet, frameIndex);
+                if (drawBatch.renderType == UI::RenderType::Text)
+                {
+                    commandList.PushMarker("Text", Color(0.0f, 0.1f, 0.0f));
 
-                        commandList.SetIndexBuffer(_indexBuffer, Renderer::IndexFormat::UInt16);
+                    _drawTextDescriptorSet.Bind("_fontAtlas"_h, drawBatch.fontAtlas);
+                    _drawTextDescriptorSet.Bind("_glyphTexCoords"_h, drawBatch.glyphTexCoords);
+                    commandList.BindDescriptorSet(Renderer::DescriptorSetSlot::PER_DRAW, &_drawTextDescriptorSet, frameIndex);
+                }
+                else
+                {
+                    commandList.PushMarker("Image", Color(0.0f, 0.1f, 0.0f));
+                }
 
-                        commandList.DrawIndexed(6, 1, 0, 0, 0);
+                // One instance per quad, firstInstance offsets SV_InstanceID into the quad stream
+                commandList.DrawIndexed(6, drawBatch.numQuads, 0, 0, drawBatch.firstQuad);
 
-                        commandList.PopMarker();
-                        break;
-                    }
-                    default:
-                        DebugHandler::PrintFatal("Renderable widget tried to render with invalid render type.");
-                }
-            });
+                commandList.PopMarker();
+            }
 
             commandList.EndPipeline(activePipeline);
         });
@@ -282,6 +327,8 @@ void UIRenderer::AddImguiPass(Renderer::RenderGraph* renderGraph, RenderResource
         {
             data.color = builder.Write(resources.resolvedColor, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](UIPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList) // Execute
@@ -317,7 +364,7 @@ void UIRenderer::AddImguiPass(Renderer::RenderGraph* renderGraph, RenderResource
             Renderer::GraphicsPipelineID activePipeline = _renderer->CreatePipeline(pipelineDesc);
 
             commandList.BeginPipeline(activePipeline);
-            commandList.DrawImgui();
+            commandList.DrawImgui(&resources.frameSnapshot->imguiDrawData);
             commandList.EndPipeline(activePipeline);
         });
 }
@@ -367,6 +414,13 @@ void UIRenderer::CreatePermanentResources()
     _renderer->QueueDestroyBuffer(stagingBuffer);
     _renderer->CopyBuffer(_indexBuffer, 0, stagingBuffer, 0, indexBufferSize);
 
+    // Texture array
+    Renderer::TextureArrayDesc textureArrayDesc;
+    textureArrayDesc.size = 4096;
+
+    _textures = _renderer->CreateTextureArray(textureArrayDesc);
+    _passDescriptorSet.Bind("_textures"_h, _textures);
+
     // Create empty border texture
     Renderer::DataTextureDesc emptyBorderDesc;
     emptyBorderDesc.debugName = "EmptyBorder";
@@ -374,6 +428,25 @@ void UIRenderer::CreatePermanentResources()
     emptyBorderDesc.height = 1;
     emptyBorderDesc.format = Renderer::ImageFormat::R8G8B8A8_UNORM;
     emptyBorderDesc.data = new u8[4]{ 0, 0, 0, 0 };
-    
-    _emptyBorder = _renderer->CreateDataTexture(emptyBorderDesc);
+
+    _renderer->CreateDataTextureIntoArray(emptyBorderDesc, _textures, _emptyBorderIndex);
+
+    // Quad streams
+    _quads.SetDebugName("UIQuads");
+    _quads.SetUsage(Renderer::BufferUsage::TRANSFER_DESTINATION | Renderer::BufferUsage::STORAGE_BUFFER);
+    _quads.SyncToGPU(_renderer);
+    _passDescriptorSet.Bind("_quads"_h, _quads.GetBuffer());
+
+    _elementRenderDatas.SetDebugName("UIElementRenderDatas");
+    _elementRenderDatas.SetUsage(Renderer::BufferUsage::TRANSFER_DESTINATION | Renderer::BufferUsage::STORAGE_BUFFER);
+    _elementRenderDatas.SyncToGPU(_renderer);
+    _passDescriptorSet.Bind("_elementRenderDatas"_h, _elementRenderDatas.GetBuffer());
+}
+
+Renderer::TextureID UIRenderer::LoadTexture(const std::string& path, u32& textureIndex)
+{
+    Renderer::TextureDesc textureDesc;
+    textureDesc.path = path;
+
+    return _renderer->LoadTextureIntoArray(textureDesc, _textures, textureIndex);
 }
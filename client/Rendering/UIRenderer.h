@@ -3,6 +3,10 @@
 
 #include <Renderer/Descriptors/ImageDesc.h>
 #include <Renderer/DescriptorSet.h>
+#include <Renderer/GPUVector.h>
+
+#include "../UI/UITypes.h"
+#include "../UI/ECS/Components/Renderable.h"
 
 namespace Renderer
 {
@@ -24,20 +28,37 @@ public:
 
     void AddImguiPass(Renderer::RenderGraph* renderGraph, RenderResources& resources, u8 frameIndex);
 
+    Renderer::TextureID LoadTexture(const std::string& path, u32& textureIndex);
+    u32 GetEmptyBorderTextureIndex() { return _emptyBorderIndex; }
+
 private:
     void CreatePermanentResources();
 
+private:
+    // Consecutive elements sharing a material are drawn with a single instanced draw
+    struct DrawBatch
+    {
+        UI::RenderType renderType;
+        Renderer::TextureID fontAtlas; // Every font file has its own atlas, so text batches also break when the font file changes
+        Renderer::BufferID glyphTexCoords;
+        u32 firstQuad;
+        u32 numQuads;
+    };
+
 private:
     Renderer::Renderer* _renderer;
     DebugRenderer* _debugRenderer;
 
-    Renderer::TextureID _emptyBorder;
+    Renderer::TextureArrayID _textures;
+    u32 _emptyBorderIndex;
 
     Renderer::SamplerID _linearSampler;
     Renderer::BufferID _indexBuffer;
 
+    Renderer::GPUVector<UI::Quad> _quads;
+    Renderer::GPUVector<UI::ElementRenderData> _elementRenderDatas;
+    std::vector<DrawBatch> _drawBatches;
+
     Renderer::DescriptorSet _passDescriptorSet;
-    Renderer::DescriptorSet _drawImageDescriptorSet;
     Renderer::DescriptorSet _drawTextDescriptorSet;
-
 };
\ No newline at end of file
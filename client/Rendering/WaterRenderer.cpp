@@ -6,6 +6,7 @@
 #include "CVar/CVarSystem.h"
 #include "Camera.h"
 #include "RenderUtils.h"
+#include "FrameSnapshot.h"
 
 #include <filesystem>
 #include <GLFW/glfw3.h>
@@ -152,6 +153,8 @@ void WaterRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, RenderRes
         {
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
 
+            builder.ShareRecordingState(this);
+
             return true; // Return true from setup to enable this pass, return false to disable it
         },
         [=](WaterCullingPassData& data, Renderer::RenderGraphResources& graphResources, Renderer::CommandList& commandList)
@@ -161,9 +164,9 @@ void WaterRenderer::AddCullingPass(Renderer::RenderGraph* renderGraph, RenderRes
             // Update constants
             if (!lockFrustum)
             {
-                Camera* camera = ServiceLocator::GetCamera();
-                memcpy(_cullConstants.frustumPlanes, camera->GetFrustumPlanes(), sizeof(vec4[6]));
-                _cullConstants.cameraPos = camera->GetPosition();
+                const FrameSnapshot::CameraData& camera = resources.frameSnapshot->camera;
+                memcpy(_cullConstants.frustumPlanes, camera.frustumPlanes, sizeof(vec4[6]));
+                _cullConstants.cameraPos = camera.position;
             }
 
             // Reset the counters
@@ -214,6 +217,7 @@ void WaterRenderer::AddWaterPass(Renderer::RenderGraph* renderGraph, RenderResou
         Renderer::RenderPassMutableResource transparency;
         Renderer::RenderPassMutableResource transparencyWeights;
         Renderer::RenderPassMutableResource depth;
+        Renderer::RenderPassMutableResource depthColorCopy;
     };
 
     renderGraph->AddPass<WaterPassData>("Water OIT Pass", 
@@ -222,6 +226,10 @@ void WaterRenderer::AddWaterPass(Renderer::RenderGraph* renderGraph, RenderResou
             data.transparency = builder.Write(resources.transparency, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.transparencyWeights = builder.Write(resources.transparencyWeights, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
             data.depth = builder.Write(resources.depth, Renderer::RenderGraphBuilder::WriteMode::RENDERTARGET, Renderer::RenderGraphBuilder::LoadMode::LOAD);
+            builder.Read(resources.depth, Renderer::RenderGraphBuilder::ShaderStage::COMPUTE);
+            data.depthColorCopy = builder.Write(resources.depthColorCopy, Renderer::RenderGraphBuilder::WriteMode::UAV, Renderer::RenderGraphBuilder::LoadMode::DISCARD);
+
+            builder.ShareRecordingState(this);
 
             return true; // Return true from setup to enable this pass, return false to disable it
         }, 
@@ -233,8 +241,8 @@ void WaterRenderer::AddWaterPass(Renderer::RenderGraph* renderGraph, RenderResou
 
             RenderUtils::CopyDepthToColorRT(_renderer, graphResources, commandList, frameIndex, resources.depth, resources.depthColorCopy, 0);
 
-            commandList.ImageBarrier(resources.transparency);
-            commandList.ImageBarrier(resources.transparencyWeights);
+            // The copy is sampled further down in this same pass, the RenderGraph only places barriers between passes
+            commandList.ImageBarrier(resources.depthColorCopy);
 
             if (cullingEnabled)
             {
@@ -687,7 +695,7 @@ bool WaterRenderer::TryLoadTexture(const std::string& textureName, u32 textureHa
         entt::registry* registry = ServiceLocator::GetGameRegistry();
         TextureSingleton& textureSingleton = registry->ctx<TextureSingleton>();
 
-        desc.path = textureSingleton.textureHashToPath[tempTextureHash];
+        desc.path = textureSingleton.textureManifest.GetPath(tempTextureHash);
         _renderer->LoadTextureIntoArray(desc, _waterTextures, index);
     }
 
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace UIComponent
+{
+    // Set on elements whose transform changed, the layout of everything below them gets updated once per frame
+    struct LayoutDirty
+    {
+    };
+}
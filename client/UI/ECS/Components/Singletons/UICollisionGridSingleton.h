@@ -0,0 +1,37 @@
+#pragma once
+#include <NovusTypes.h>
+#include <entity/fwd.hpp>
+#include <robin_hood.h>
+#include <vector>
+
+namespace UISingleton
+{
+    // Screen space grid over the collision bounds of every element, hit testing only looks at the cell under the cursor
+    struct UICollisionGridSingleton
+    {
+    public:
+        UICollisionGridSingleton() { }
+
+        static constexpr f32 CELL_SIZE = 64.0f;
+
+        struct Cell
+        {
+            std::vector<entt::entity> entities; // Front to back when sortGeneration matches the one of the grid
+            u32 sortGeneration = 0;
+        };
+
+        struct CellRange
+        {
+            u16 minX = 0;
+            u16 minY = 0;
+            u16 maxX = 0;
+            u16 maxY = 0;
+        };
+
+        uvec2 size = uvec2(0, 0);
+        std::vector<Cell> cells;
+        robin_hood::unordered_map<entt::entity, CellRange> entityToCellRange;
+
+        u32 sortGeneration = 1; // Bumped when sort keys are rebuilt, cells get resorted the next time they are queried
+    };
+}
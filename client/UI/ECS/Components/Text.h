@@ -2,29 +2,27 @@
 #include <NovusTypes.h>
 #include "../../UITypes.h"
 #include <Renderer/Renderer.h>
-#include <Renderer/Buffer.h>
 #include <Renderer/Font.h>
 #include <vector>
 
+namespace UI
+{
+    struct ShapedGlyph
+    {
+        vec2 offset; // From the anchor position of the text within the element
+        vec2 size;
+        u32 glyphIndex;
+    };
+}
+
 namespace UIComponent
 {
     struct Text
     {
-    public:
-        struct TextConstantBuffer
-        {
-            Color textColor = Color(); // 16 bytes
-            Color outlineColor = Color(); // 16 bytes
-            f32 outlineWidth = 0.f; // 4 bytes
-
-            u8 padding[220] = {};
-        };
-
     public:
         Text() { }
 
         std::string text = "";
-        size_t glyphCount = 0;
         size_t pushback = 0;
 
         UI::TextStylesheet style;
@@ -35,9 +33,10 @@ namespace UIComponent
 
         Renderer::Font* font = nullptr;
 
-        size_t vertexBufferGlyphCount = 0;
-        Renderer::BufferID vertexBufferID = Renderer::BufferID::Invalid();
-        Renderer::BufferID textureIDBufferID = Renderer::BufferID::Invalid();
-        Renderer::Buffer<TextConstantBuffer>* constantBuffer = nullptr;
+        u64 shapingHash = 0; // Of everything the shaped glyphs depend on, moving the element doesn't reshape them
+        std::vector<UI::ShapedGlyph> shapedGlyphs;
+
+        std::vector<UI::Quad> glyphQuads;
+        UI::ElementRenderData renderData;
     };
 }
\ No newline at end of file
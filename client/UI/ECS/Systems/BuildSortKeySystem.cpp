@@ -5,6 +5,7 @@
 #include "../Components/Relation.h"
 #include "../Components/SortKey.h"
 #include "../Components/SortKeyDirty.h"
+#include "../Components/Singletons/UICollisionGridSingleton.h"
 
 #include "../../Utils/SortUtils.h"
 
@@ -21,5 +22,11 @@ namespace UISystem
             UIUtils::Sort::UpdateChildDepths(&registry, entity, compoundDepth);
         });
 
+        // The collision grid cells are kept in sort order, they need resorting after keys changed
+        if (sortView.size_hint() > 0)
+        {
+            registry.ctx<UISingleton::UICollisionGridSingleton>().sortGeneration++;
+        }
+
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "../Components/Singletons/UIDataSingleton.h"
 #include "../Components/Destroy.h"
+#include "../../Utils/ColllisionUtils.h"
 #include "../../angelscript/BaseElement.h"
 
 namespace UISystem
@@ -17,6 +18,8 @@ namespace UISystem
         {
             delete dataSingleton.entityToElement[entityId];
             dataSingleton.entityToElement.erase(entityId);
+
+            UIUtils::Collision::RemoveFromGrid(&registry, entityId);
         });
         registry.destroy(deleteView.begin(), deleteView.end());
 
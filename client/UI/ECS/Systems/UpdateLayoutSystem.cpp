@@ -0,0 +1,79 @@
+#include "UpdateLayoutSystem.h"
+#include <entity/registry.hpp>
+#include <tracy/Tracy.hpp>
+
+#include "../Components/Transform.h"
+#include "../Components/Relation.h"
+#include "../Components/LayoutDirty.h"
+#include "../Components/Dirty.h"
+#include "../Components/BoundsDirty.h"
+#include "../../Utils/TransformUtils.h"
+#include "../../Utils/ElementUtils.h"
+#include "../../Utils/ColllisionUtils.h"
+#include "../../../Utils/ServiceLocator.h"
+
+namespace UISystem
+{
+    // Below this the trees are laid out on the calling thread, handing them to the job executor would cost more than the layout
+    constexpr size_t MIN_TREES_FOR_PARALLEL_LAYOUT = 8;
+
+    void UpdateLayoutSystem::Update(entt::registry& registry)
+    {
+        auto layoutDirtyView = registry.view<UIComponent::LayoutDirty>();
+        if (layoutDirtyView.size() == 0)
+            return;
+
+        // Only the topmost dirty element of every tree gets laid out, the ones below it are laid out along with it
+        std::vector<entt::entity> layoutRoots;
+        layoutDirtyView.each([&](entt::entity entityId)
+        {
+            entt::entity parent = registry.get<UIComponent::Relation>(entityId).parent;
+            while (parent != entt::null)
+            {
+                if (registry.all_of<UIComponent::LayoutDirty>(parent))
+                    return;
+
+                parent = registry.get<UIComponent::Relation>(parent).parent;
+            }
+
+            layoutRoots.push_back(entityId);
+        });
+
+        // The trees don't overlap, so they can be laid out independently
+        std::vector<std::vector<entt::entity>> laidOutEntities(layoutRoots.size());
+        const auto layoutTree = [&](size_t index)
+        {
+            ZoneScopedNC("UpdateLayoutSystem::Update::LayoutTree", tracy::Color::Gainsboro);
+            UIUtils::Transform::UpdateChildTransforms(&registry, layoutRoots[index], laidOutEntities[index]);
+        };
+
+        if (layoutRoots.size() >= MIN_TREES_FOR_PARALLEL_LAYOUT)
+        {
+            // This runs inside the sync framework, the job executor has its own workers so waiting on it here can't starve the framework
+            tf::Taskflow tf(ServiceLocator::GetJobExecutor());
+            tf.parallel_for(size_t(0), layoutRoots.size(), size_t(1), layoutTree);
+            tf.wait_for_all();
+        }
+        else
+        {
+            for (size_t i = 0; i < layoutRoots.size(); i++)
+            {
+                layoutTree(i);
+            }
+        }
+
+        // Adding components isn't thread safe, so everything that moved gets marked afterwards
+        for (size_t i = 0; i < layoutRoots.size(); i++)
+        {
+            UIUtils::MarkDirty(&registry, layoutRoots[i]);
+            UIUtils::Collision::MarkBoundsDirty(&registry, layoutRoots[i]); // Bounds of children are updated along with it
+
+            for (entt::entity entityId : laidOutEntities[i])
+            {
+                UIUtils::MarkDirty(&registry, entityId);
+            }
+        }
+
+        registry.clear<UIComponent::LayoutDirty>();
+    }
+}
@@ -54,13 +54,16 @@ namespace UIInput
             return true;
         }
 
-        auto eventGroup = registry->group<>(entt::get<UIComponent::TransformEvents, UIComponent::ElementInfo, UIComponent::SortKey, UIComponent::Collision, UIComponent::Collidable, UIComponent::Visible, UIComponent::NotCulled>);
-        eventGroup.sort<UIComponent::SortKey>([](const UIComponent::SortKey& first, const UIComponent::SortKey& second) { return first.key > second.key; });
-        for (auto entity : eventGroup)
+        // The grid cell under the mouse is already sorted front to back.
+        const std::vector<entt::entity>& cellEntities = UIUtils::Collision::GetGridCell(registry, mouse);
+        for (entt::entity entity : cellEntities)
         {
-            UIComponent::TransformEvents& events = eventGroup.get<UIComponent::TransformEvents>(entity);
-            const UIComponent::ElementInfo& elementInfo = eventGroup.get<UIComponent::ElementInfo>(entity);
-            const UIComponent::Collision& collision = eventGroup.get<UIComponent::Collision>(entity);
+            if (!registry->all_of<UIComponent::TransformEvents, UIComponent::Collidable, UIComponent::Visible, UIComponent::NotCulled>(entity))
+                continue;
+
+            UIComponent::TransformEvents& events = registry->get<UIComponent::TransformEvents>(entity);
+            const UIComponent::ElementInfo& elementInfo = registry->get<UIComponent::ElementInfo>(entity);
+            const UIComponent::Collision& collision = registry->get<UIComponent::Collision>(entity);
 
             // Check so mouse if within widget bounds.
             if (mouse.x < collision.minBound.x || mouse.x > collision.maxBound.x || mouse.y < collision.minBound.y || mouse.y > collision.maxBound.y)
@@ -141,23 +144,23 @@ namespace UIInput
                 sliderHandle->OnDragged();
             }
 
-            UIUtils::MarkDirty(registry, dataSingleton.draggedWidget);
-            UIUtils::MarkChildrenDirty(registry, dataSingleton.draggedWidget);
-            UIUtils::Transform::UpdateChildPositions(registry, dataSingleton.draggedWidget);
-            UIUtils::Collision::MarkBoundsDirty(registry, dataSingleton.draggedWidget);
+            // Marks the widget, its children and its bounds dirty once they have been moved
+            UIUtils::Transform::MarkLayoutDirty(registry, dataSingleton.draggedWidget);
 
             return true;
         }
 
         // Handle hover.
-        auto eventGroup = registry->group<>(entt::get<UIComponent::TransformEvents, UIComponent::SortKey, UIComponent::Collision, UIComponent::Collidable, UIComponent::Visible, UIComponent::NotCulled>);
-        eventGroup.sort<UIComponent::SortKey>([](const UIComponent::SortKey& first, const UIComponent::SortKey& second) { return first.key > second.key; });
-        for (auto entity : eventGroup)
+        const std::vector<entt::entity>& cellEntities = UIUtils::Collision::GetGridCell(registry, mouse);
+        for (entt::entity entity : cellEntities)
         {
             if (dataSingleton.draggedWidget == entity)
                 continue;
 
-            const UIComponent::Collision& collision = eventGroup.get<UIComponent::Collision>(entity);
+            if (!registry->all_of<UIComponent::TransformEvents, UIComponent::Collidable, UIComponent::Visible, UIComponent::NotCulled>(entity))
+                continue;
+
+            const UIComponent::Collision& collision = registry->get<UIComponent::Collision>(entity);
             // Check so mouse if within widget bounds.
             if (mouse.x < collision.minBound.x || mouse.x > collision.maxBound.x || mouse.y < collision.minBound.y || mouse.y > collision.maxBound.y)
                 continue;
@@ -253,8 +256,5 @@ namespace UIInput
         keybindGroup->AddAnyKeyboardCallback("Keyboard Input", std::bind(&OnKeyboardInput, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
         keybindGroup->AddAnyUnicodeCallback(std::bind(&OnCharInput, std::placeholders::_1));
         keybindGroup->AddMousePositionCallback(std::bind(&OnMousePositionUpdate, std::placeholders::_1, std::placeholders::_2));
-
-        // Create mouse group upfront. Reduces hitching from first mouse input.
-        auto eventGroup = ServiceLocator::GetUIRegistry()->group<>(entt::get<UIComponent::TransformEvents, UIComponent::ElementInfo, UIComponent::SortKey, UIComponent::Collision, UIComponent::Collidable, UIComponent::Visible, UIComponent::NotCulled>);
     }
 }
\ No newline at end of file
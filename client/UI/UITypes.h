@@ -70,6 +70,30 @@ namespace UI
     };
 #pragma pack(pop)
 
+    // UIRenderer streams one of these per image and per glyph to the GPU every frame, in sort key order
+    struct Quad
+    {
+        vec4 rect = vec4(0.0f); // left, top, right, bottom in UV space
+        vec4 texCoord = vec4(0.0f); // left, top, right, bottom
+        u32 textureIndex = 0; // Images index the texture array of UIRenderer, glyphs index the glyph texcoords of their font
+        u32 elementIndex = 0; // Set by UIRenderer, indexes into the ElementRenderData of this frame
+
+        u32 padding[2] = {};
+    };
+
+    // Shared by all the quads of one element
+    struct ElementRenderData
+    {
+        Color color = Color(1, 1, 1, 1);
+        Color outlineColor = Color(0, 0, 0, 0);
+        Box borderSize;
+        Box borderInset;
+        Box slicingOffset;
+        vec2 size = vec2(0.0f);
+        f32 outlineWidth = 0.0f;
+        u32 borderTextureIndex = 0;
+    };
+
     struct TextStylesheet
     {
         Color color = Color(1, 1, 1, 1);
@@ -1,8 +1,17 @@
 #include "ColllisionUtils.h"
 #include <tracy/Tracy.hpp>
+#include <Utils/Timer.h>
+#include <algorithm>
+#include <random>
 #include "../ECS/Components/Collision.h"
+#include "../ECS/Components/Collidable.h"
+#include "../ECS/Components/Visible.h"
+#include "../ECS/Components/NotCulled.h"
+#include "../ECS/Components/TransformEvents.h"
 #include "../ECS/Components/Transform.h"
 #include "../ECS/Components/Relation.h"
+#include "../ECS/Components/SortKey.h"
+#include "../ECS/Components/Singletons/UICollisionGridSingleton.h"
 #include "TransformUtils.h"
 
 namespace UIUtils::Collision
@@ -35,6 +44,7 @@ namespace UIUtils::Collision
 
         collision.minBound = minBound;
         collision.maxBound = maxBound;
+        UpdateGridCells(registry, entityId);
 
         if (!updateParent || relation.parent == entt::null)
             return;
@@ -64,6 +74,7 @@ namespace UIUtils::Collision
                 if (childCollision->maxBound.y > collision.maxBound.y) { collision.maxBound.y = childCollision->maxBound.y; }
             }
         }
+        UpdateGridCells(registry, entityId);
 
         if (relation.parent == entt::null)
             return;
@@ -72,4 +83,199 @@ namespace UIUtils::Collision
         if (parentCollision->HasFlag(UI::CollisionFlags::INCLUDE_CHILDBOUNDS))
             ShallowUpdateBounds(registry, relation.parent);
     }
+
+    void UpdateGridCells(entt::registry* registry, entt::entity entityId)
+    {
+        UISingleton::UICollisionGridSingleton& grid = registry->ctx<UISingleton::UICollisionGridSingleton>();
+        const UIComponent::Collision& collision = registry->get<UIComponent::Collision>(entityId);
+
+        // Bounds outside of the screen get clamped to the edge cells
+        const vec2 maxCell = vec2(grid.size) - 1.0f;
+        const vec2 minCell = glm::clamp(glm::floor(vec2(collision.minBound) / UISingleton::UICollisionGridSingleton::CELL_SIZE), vec2(0.0f), maxCell);
+        const vec2 maxCellOfBounds = glm::clamp(glm::floor(vec2(collision.maxBound) / UISingleton::UICollisionGridSingleton::CELL_SIZE), vec2(0.0f), maxCell);
+
+        UISingleton::UICollisionGridSingleton::CellRange cellRange;
+        cellRange.minX = static_cast<u16>(minCell.x);
+        cellRange.minY = static_cast<u16>(minCell.y);
+        cellRange.maxX = static_cast<u16>(maxCellOfBounds.x);
+        cellRange.maxY = static_cast<u16>(maxCellOfBounds.y);
+
+        auto itr = grid.entityToCellRange.find(entityId);
+        if (itr != grid.entityToCellRange.end())
+        {
+            const UISingleton::UICollisionGridSingleton::CellRange& oldCellRange = itr->second;
+            if (oldCellRange.minX == cellRange.minX && oldCellRange.minY == cellRange.minY && oldCellRange.maxX == cellRange.maxX && oldCellRange.maxY == cellRange.maxY)
+                return;
+
+            RemoveFromGrid(registry, entityId);
+        }
+
+        for (u32 y = cellRange.minY; y <= cellRange.maxY; y++)
+        {
+            for (u32 x = cellRange.minX; x <= cellRange.maxX; x++)
+            {
+                UISingleton::UICollisionGridSingleton::Cell& cell = grid.cells[y * grid.size.x + x];
+                cell.entities.push_back(entityId);
+                cell.sortGeneration = 0;
+            }
+        }
+
+        grid.entityToCellRange[entityId] = cellRange;
+    }
+
+    void RemoveFromGrid(entt::registry* registry, entt::entity entityId)
+    {
+        UISingleton::UICollisionGridSingleton& grid = registry->ctx<UISingleton::UICollisionGridSingleton>();
+
+        auto itr = grid.entityToCellRange.find(entityId);
+        if (itr == grid.entityToCellRange.end())
+            return;
+
+        const UISingleton::UICollisionGridSingleton::CellRange& cellRange = itr->second;
+        for (u32 y = cellRange.minY; y <= cellRange.maxY; y++)
+        {
+            for (u32 x = cellRange.minX; x <= cellRange.maxX; x++)
+            {
+                // Removing keeps the order, so the cell stays sorted
+                std::vector<entt::entity>& entities = grid.cells[y * grid.size.x + x].entities;
+                entities.erase(std::remove(entities.begin(), entities.end(), entityId), entities.end());
+            }
+        }
+
+        grid.entityToCellRange.erase(itr);
+    }
+
+    const std::vector<entt::entity>& GetGridCell(entt::registry* registry, const hvec2& point)
+    {
+        ZoneScoped;
+        static const std::vector<entt::entity> emptyCell;
+
+        UISingleton::UICollisionGridSingleton& grid = registry->ctx<UISingleton::UICollisionGridSingleton>();
+
+        const vec2 cellPosition = glm::floor(vec2(point) / UISingleton::UICollisionGridSingleton::CELL_SIZE);
+        if (cellPosition.x < 0 || cellPosition.y < 0 || cellPosition.x >= grid.size.x || cellPosition.y >= grid.size.y)
+            return emptyCell;
+
+        UISingleton::UICollisionGridSingleton::Cell& cell = grid.cells[static_cast<u32>(cellPosition.y) * grid.size.x + static_cast<u32>(cellPosition.x)];
+        if (cell.sortGeneration != grid.sortGeneration)
+        {
+            std::sort(cell.entities.begin(), cell.entities.end(), [registry](entt::entity first, entt::entity second)
+            {
+                return registry->get<UIComponent::SortKey>(first).key > registry->get<UIComponent::SortKey>(second).key;
+            });
+            cell.sortGeneration = grid.sortGeneration;
+        }
+
+        return cell.entities;
+    }
+
+    void BenchmarkHitTesting(u32 numElements, u32 numQueries, const vec2& resolution, HitTestBenchmarkResult& result)
+    {
+        result = HitTestBenchmarkResult();
+        result.numElements = numElements;
+        result.numQueries = numQueries;
+
+        entt::registry registry;
+        UISingleton::UICollisionGridSingleton& grid = registry.set<UISingleton::UICollisionGridSingleton>();
+        grid.size = uvec2(glm::ceil(resolution / UISingleton::UICollisionGridSingleton::CELL_SIZE));
+        grid.cells.resize(static_cast<size_t>(grid.size.x) * grid.size.y);
+
+        // Fixed seed so runs are comparable, elements range from icons to large frames and some of them can't be hit
+        std::mt19937 randomEngine(1337);
+        std::uniform_real_distribution<f32> xDistribution(0.0f, resolution.x);
+        std::uniform_real_distribution<f32> yDistribution(0.0f, resolution.y);
+        std::uniform_real_distribution<f32> sizeDistribution(16.0f, 256.0f);
+
+        std::vector<entt::entity> entities(numElements);
+        registry.create(entities.begin(), entities.end());
+
+        for (entt::entity entity : entities)
+        {
+            UIComponent::Collision& collision = registry.emplace<UIComponent::Collision>(entity);
+            collision.minBound = hvec2(xDistribution(randomEngine), yDistribution(randomEngine));
+            collision.maxBound = collision.minBound + hvec2(sizeDistribution(randomEngine), sizeDistribution(randomEngine));
+
+            // Unique keys so both paths agree on which element is in front
+            UIComponent::SortKey& sortKey = registry.emplace<UIComponent::SortKey>(entity);
+            sortKey.key = (static_cast<u64>(randomEngine()) << 32) | static_cast<u64>(entt::to_integral(entity));
+
+            registry.emplace<UIComponent::TransformEvents>(entity);
+            registry.emplace<UIComponent::Visible>(entity);
+            registry.emplace<UIComponent::NotCulled>(entity);
+            if (randomEngine() % 10 != 0)
+                registry.emplace<UIComponent::Collidable>(entity);
+        }
+
+        {
+            Timer timer;
+            for (entt::entity entity : entities)
+            {
+                UpdateGridCells(&registry, entity);
+            }
+            result.gridBuildTimeMS = timer.GetLifeTime() * 1000.0f;
+        }
+
+        std::vector<hvec2> points(numQueries);
+        for (hvec2& point : points)
+        {
+            point = hvec2(xDistribution(randomEngine), yDistribution(randomEngine));
+        }
+
+        auto IsHit = [&](const UIComponent::Collision& collision, const hvec2& point)
+        {
+            return !(point.x < collision.minBound.x || point.x > collision.maxBound.x || point.y < collision.minBound.y || point.y > collision.maxBound.y);
+        };
+
+        std::vector<entt::entity> linearHits(numQueries, entt::null);
+        std::vector<entt::entity> gridHits(numQueries, entt::null);
+
+        // This is what hover and click did before the grid, sort every event target and test them front to back
+        {
+            auto eventGroup = registry.group<>(entt::get<UIComponent::TransformEvents, UIComponent::SortKey, UIComponent::Collision, UIComponent::Collidable, UIComponent::Visible, UIComponent::NotCulled>);
+
+            Timer timer;
+            for (u32 i = 0; i < numQueries; i++)
+            {
+                eventGroup.sort<UIComponent::SortKey>([](const UIComponent::SortKey& first, const UIComponent::SortKey& second) { return first.key > second.key; });
+                for (auto entity : eventGroup)
+                {
+                    if (!IsHit(eventGroup.get<UIComponent::Collision>(entity), points[i]))
+                        continue;
+
+                    linearHits[i] = entity;
+                    break;
+                }
+            }
+            result.linearTimeMS = timer.GetLifeTime() * 1000.0f;
+        }
+
+        {
+            Timer timer;
+            for (u32 i = 0; i < numQueries; i++)
+            {
+                const std::vector<entt::entity>& cellEntities = GetGridCell(&registry, points[i]);
+                for (entt::entity entity : cellEntities)
+                {
+                    if (!registry.all_of<UIComponent::TransformEvents, UIComponent::Collidable, UIComponent::Visible, UIComponent::NotCulled>(entity))
+                        continue;
+
+                    if (!IsHit(registry.get<UIComponent::Collision>(entity), points[i]))
+                        continue;
+
+                    gridHits[i] = entity;
+                    break;
+                }
+            }
+            result.gridTimeMS = timer.GetLifeTime() * 1000.0f;
+        }
+
+        for (u32 i = 0; i < numQueries; i++)
+        {
+            if (linearHits[i] != entt::null)
+                result.numHits++;
+
+            if (linearHits[i] != gridHits[i])
+                result.numMismatches++;
+        }
+    }
 }
\ No newline at end of file
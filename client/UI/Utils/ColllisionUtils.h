@@ -2,10 +2,23 @@
 #include <NovusTypes.h>
 #include <entity/fwd.hpp>
 #include <entity/registry.hpp>
+#include <vector>
 #include "../ECS/Components/BoundsDirty.h"
 
 namespace UIUtils::Collision
 {
+    struct HitTestBenchmarkResult
+    {
+        u32 numElements = 0;
+        u32 numQueries = 0;
+        u32 numHits = 0;
+        u32 numMismatches = 0; // Queries where the grid and the linear scan found a different element, should always be 0
+
+        f32 gridBuildTimeMS = 0.0f;
+        f32 linearTimeMS = 0.0f;
+        f32 gridTimeMS = 0.0f;
+    };
+
     /*
     *   Recursively updates bounds of children and self.
     *   registry: Pointer to UI Registry.
@@ -20,6 +33,34 @@ namespace UIUtils::Collision
     */
     void ShallowUpdateBounds(entt::registry* registry, entt::entity entityId);
 
+    /*
+    *   Moves the entity to the collision grid cells covered by its current bounds.
+    *   registry: Pointer to UI Registry.
+    *   entityId: entity whose bounds changed.
+    */
+    void UpdateGridCells(entt::registry* registry, entt::entity entityId);
+    /*
+    *   Removes the entity from the collision grid, has to be done before it is destroyed.
+    *   registry: Pointer to UI Registry.
+    *   entityId: entity to remove.
+    */
+    void RemoveFromGrid(entt::registry* registry, entt::entity entityId);
+    /*
+    *   Gets the elements whose bounds might contain the point, front to back.
+    *   They still need to be tested against their bounds, and might not be collidable, visible or culled.
+    *   registry: Pointer to UI Registry.
+    *   point: point in UI space.
+    */
+    const std::vector<entt::entity>& GetGridCell(entt::registry* registry, const hvec2& point);
+    /*
+    *   Finds the topmost element under random points like hover and click do, once by sorting and scanning every element and once through the grid.
+    *   Runs on its own registry so the live UI is left alone.
+    *   numElements: elements to scatter over the screen.
+    *   numQueries: points to test.
+    *   resolution: UI resolution the grid covers.
+    */
+    void BenchmarkHitTesting(u32 numElements, u32 numQueries, const vec2& resolution, HitTestBenchmarkResult& result);
+
     inline static void MarkBoundsDirty(entt::registry* registry, entt::entity entityId)
     {
         if (!registry->all_of<UIComponent::BoundsDirty>(entityId))
@@ -3,6 +3,84 @@
 
 namespace UIUtils::Text
 {
+    constexpr u32 REPLACEMENT_CHARACTER = 0xFFFD;
+
+    u32 DecodeUTF8(const std::string& text, size_t& index)
+    {
+        const u8 lead = static_cast<u8>(text[index]);
+        if (lead < 0x80)
+        {
+            index++;
+            return lead;
+        }
+
+        size_t length;
+        u32 codepoint;
+        u32 minCodepoint;
+        if ((lead & 0xE0) == 0xC0)
+        {
+            length = 2;
+            codepoint = lead & 0x1F;
+            minCodepoint = 0x80;
+        }
+        else if ((lead & 0xF0) == 0xE0)
+        {
+            length = 3;
+            codepoint = lead & 0x0F;
+            minCodepoint = 0x800;
+        }
+        else if ((lead & 0xF8) == 0xF0)
+        {
+            length = 4;
+            codepoint = lead & 0x07;
+            minCodepoint = 0x10000;
+        }
+        else
+        {
+            index++;
+            return REPLACEMENT_CHARACTER;
+        }
+
+        if (index + length > text.length())
+        {
+            index++;
+            return REPLACEMENT_CHARACTER;
+        }
+
+        for (size_t i = 1; i < length; i++)
+        {
+            const u8 continuation = static_cast<u8>(text[index + i]);
+            if ((continuation & 0xC0) != 0x80)
+            {
+                index++;
+                return REPLACEMENT_CHARACTER;
+            }
+
+            codepoint = (codepoint << 6) | (continuation & 0x3F);
+        }
+
+        // Overlong encodings, surrogates and anything past the last plane are not valid UTF-8
+        if (codepoint < minCodepoint || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+        {
+            index++;
+            return REPLACEMENT_CHARACTER;
+        }
+
+        index += length;
+        return codepoint;
+    }
+
+    size_t GetCharacterStart(const std::string& text, size_t index)
+    {
+        // At most three continuation bytes can follow a lead byte
+        for (size_t i = 0; i < 3 && index > 0 && (static_cast<u8>(text[index]) & 0xC0) == 0x80; i++)
+        {
+            index--;
+        }
+
+        return index;
+    }
+
     size_t CalculatePushback(const UIComponent::Text* text, size_t writeHead, f32 bufferDecimal, f32 maxWidth, f32 maxHeight)
     {     
         ZoneScoped;
@@ -21,22 +99,25 @@ namespace UIUtils::Text
         if (text->text.length() == 0)
             return 0;
 
-        auto GetAdvance = [&](char c) { return std::isspace(c) ? text->style.fontSize * 0.15f : text->font->GetChar(c).advance; };
+        auto GetAdvance = [&](u32 codepoint) { return IsWhitespace(codepoint) ? text->style.fontSize * 0.15f : text->font->GetChar(codepoint).advance; };
 
-        size_t oldPushback = Math::Min(text->pushback, text->text.length() - 1);
+        size_t oldPushback = GetCharacterStart(text->text, Math::Min(text->pushback, text->text.length() - 1));
         size_t finalCharacter = oldPushback;
 
         f32 lineLength = 0.f;
         bool overflowed = false;
-        for (; finalCharacter < text->text.length(); finalCharacter++)
+        while (finalCharacter < text->text.length())
         {
-            lineLength += GetAdvance(text->text[finalCharacter]);
+            size_t nextCharacter = finalCharacter;
+            lineLength += GetAdvance(DecodeUTF8(text->text, nextCharacter));
 
             if (lineLength >= maxWidth)
             {
                 overflowed = true;
                 break;
             }
+
+            finalCharacter = nextCharacter;
         }
 
         if (writeHead >= oldPushback && (!overflowed || writeHead <= finalCharacter))
@@ -46,12 +127,19 @@ namespace UIUtils::Text
         const f32 bufferSpace = maxWidth * (overflowed ? 1.f - bufferDecimal : bufferDecimal);
         lineLength = 0.f;
 
-        for (size_t i = writeHead - 1; i > 0; --i)
+        if (writeHead == 0)
+            return 0;
+
+        size_t nextCharacter = writeHead;
+        for (size_t i = GetCharacterStart(text->text, writeHead - 1); i > 0; i = GetCharacterStart(text->text, i - 1))
         {
-            lineLength += GetAdvance(text->text[i]);
+            size_t characterEnd = i;
+            lineLength += GetAdvance(DecodeUTF8(text->text, characterEnd));
 
             if (lineLength > bufferSpace)
-                return i + 1;
+                return nextCharacter;
+
+            nextCharacter = i;
         }
 
         return 0;
@@ -104,9 +192,9 @@ namespace UIUtils::Text
         f32 advance = 0.f;
 
         const auto IsLastLine = [&]() { return lineWidths.size() == MaxLines; };
-        const auto BreakWord = [&](size_t i)
+        const auto BreakWord = [&](size_t nextWordStart)
         {
-            wordStart = i + 1;
+            wordStart = nextWordStart;
             wordWidth = 0.f;
         };
         const auto BreakLine = [&](size_t i)
@@ -115,36 +203,40 @@ namespace UIUtils::Text
             lineBreakPoints.push_back(i);
         };
 
-        for (size_t i = text->pushback; i < text->text.length(); i++)
+        // Indices stay byte offsets into the text, they always point at the first byte of a character
+        for (size_t i = text->pushback; i < text->text.length();)
         {
-            if (text->text[i] == '\n')
+            const size_t characterStart = i;
+            const u32 codepoint = DecodeUTF8(text->text, i);
+
+            if (codepoint == '\n')
             {
                 if (IsLastLine())
-                    return i;
+                    return characterStart;
 
                 BreakWord(i);
-                BreakLine(i);
+                BreakLine(characterStart);
                 continue;
             }
 
-            if (std::isspace(text->text[i]))
+            if (IsWhitespace(codepoint))
             {
                 advance = text->style.fontSize * 0.15f;
                 BreakWord(i);
             }
             else
             {
-                advance = text->font->GetChar(text->text[i]).advance;
+                advance = text->font->GetChar(codepoint).advance;
                 wordWidth += advance;
             }
 
             if (lineWidths.back() + advance > maxWidth)
             {
                 if (IsLastLine())
-                    return i;
+                    return characterStart;
 
                 if (wordWidth > maxWidth)
-                    BreakLine(i);
+                    BreakLine(characterStart);
                 else
                 {
                     BreakLine(wordStart);
@@ -170,9 +262,9 @@ namespace UIUtils::Text
         f32 wordWidth = 0.f;
         f32 advance = 0.f;
 
-        const auto BreakWord = [&](size_t i)
+        const auto BreakWord = [&](size_t nextWordStart)
         {
-            wordStart = i + 1;
+            wordStart = nextWordStart;
             wordWidth = 0.f;
         };
         const auto BreakLine = [&](size_t i)
@@ -181,23 +273,26 @@ namespace UIUtils::Text
             lineBreakPoints.push_back(i);
         };
 
-        for (size_t i = 0; i < text->text.length(); i++)
+        for (size_t i = 0; i < text->text.length();)
         {
-            if (text->text[i] == '\n')
+            const size_t characterStart = i;
+            const u32 codepoint = DecodeUTF8(text->text, i);
+
+            if (codepoint == '\n')
             {
                 BreakWord(i);
-                BreakLine(i);
+                BreakLine(characterStart);
                 continue;
             }
 
-            if (std::isspace(text->text[i]))
+            if (IsWhitespace(codepoint))
             {
                 advance = text->style.fontSize * 0.15f;
                 BreakWord(i);
             }
             else
             {
-                advance = text->font->GetChar(text->text[i]).advance;
+                advance = text->font->GetChar(codepoint).advance;
                 wordWidth += advance;
             }
 
@@ -205,7 +300,7 @@ namespace UIUtils::Text
             {
 
                 if (wordWidth > maxWidth)
-                    BreakLine(i);
+                    BreakLine(characterStart);
                 else
                 {
                     BreakLine(wordStart);
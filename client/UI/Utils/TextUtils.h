@@ -41,6 +41,21 @@ namespace UIUtils::Text
         return vec2(GetHorizontalAlignment(text->horizontalAlignment), GetVerticalAlignment(text->verticalAlignment));
     }
 
+    inline static bool IsWhitespace(u32 codepoint)
+    {
+        return codepoint < 128 && std::isspace(static_cast<int>(codepoint));
+    }
+
+    /*
+    *   Decode the UTF-8 sequence starting at index and move index past it.
+    *   Malformed sequences decode to U+FFFD and only skip one byte.
+    */
+    u32 DecodeUTF8(const std::string& text, size_t& index);
+    /*
+    *   Move index back to the first byte of the UTF-8 sequence it points into.
+    */
+    size_t GetCharacterStart(const std::string& text, size_t index);
+
     /*
     *   Calculate Pushback index.
     *   text: Text to calculate pushback for.
@@ -28,47 +28,37 @@ namespace UIUtils::Transform
         return uiResolution * anchorPosition;
     }
 
-    void UpdateChildTransforms(entt::registry* registry, entt::entity entity)
+    void UpdateChildTransforms(entt::registry* registry, entt::entity entity, std::vector<entt::entity>& outEntities)
     {
-        auto [transform, relation] = registry->get<UIComponent::Transform, UIComponent::Relation>(entity);
+        // outEntities doubles as the queue, every parent is laid out before its children
+        size_t queueIndex = outEntities.size();
+        entt::entity parent = entity;
 
-        if (!relation.children.size())
-            return;
-        
-        const hvec2 minAnchorBound = GetMinBounds(&transform) + hvec2(transform.padding.left, transform.padding.top);
-        const hvec2 adjustedSize = transform.size - hvec2(transform.padding.right, transform.padding.bottom);
-
-        for (const UI::UIChild& child : relation.children)
+        while (true)
         {
-            UIComponent::Transform* childTransform = &registry->get<UIComponent::Transform>(child.entId);
+            auto [transform, relation] = registry->get<UIComponent::Transform, UIComponent::Relation>(parent);
 
-            childTransform->anchorPosition = minAnchorBound + adjustedSize * childTransform->anchor;
-            if (childTransform->HasFlag(UI::TransformFlags::FILL_PARENTSIZE))
-                childTransform->size = transform.size;
+            if (relation.children.size())
+            {
+                const hvec2 minAnchorBound = GetMinBounds(&transform) + hvec2(transform.padding.left, transform.padding.top);
+                const hvec2 adjustedSize = transform.size - hvec2(transform.padding.right, transform.padding.bottom);
 
-            UpdateChildTransforms(registry, child.entId);
-        }
-    }
+                for (const UI::UIChild& child : relation.children)
+                {
+                    UIComponent::Transform* childTransform = &registry->get<UIComponent::Transform>(child.entId);
 
-    void UpdateChildPositions(entt::registry* registry, entt::entity entity)
-    {
-        auto [transform, relation] = registry->get<UIComponent::Transform, UIComponent::Relation>(entity);
+                    childTransform->anchorPosition = minAnchorBound + adjustedSize * childTransform->anchor;
+                    if (childTransform->HasFlag(UI::TransformFlags::FILL_PARENTSIZE))
+                        childTransform->size = transform.size;
 
-        if (!relation.children.size())
-            return;
+                    outEntities.push_back(child.entId);
+                }
+            }
 
-        const hvec2 minAnchorBound = GetMinBounds(&transform) + hvec2(transform.padding.left, transform.padding.top);
-        const hvec2 adjustedSize = transform.size - hvec2(transform.padding.right, transform.padding.bottom);
+            if (queueIndex == outEntities.size())
+                break;
 
-        for (const UI::UIChild& child : relation.children)
-        {
-            UIComponent::Transform* childTransform = &registry->get<UIComponent::Transform>(child.entId);
-            childTransform->anchorPosition = minAnchorBound + adjustedSize * childTransform->anchor;
-        }
-
-        for (const UI::UIChild& child : relation.children)
-        {
-            UpdateChildPositions(registry, child.entId);
+            parent = outEntities[queueIndex++];
         }
     }
-}
\ No newline at end of file
+}
@@ -1,7 +1,10 @@
 #pragma once
 #include <NovusTypes.h>
 #include <entity/fwd.hpp>
+#include <entity/registry.hpp>
+#include <vector>
 #include "../ECS/Components/Transform.h"
+#include "../ECS/Components/LayoutDirty.h"
 
 namespace UIUtils::Transform
 {
@@ -42,7 +45,17 @@ namespace UIUtils::Transform
 
     hvec2 GetAnchorPositionOnScreen(hvec2 anchorPosition);
 
-    void UpdateChildTransforms(entt::registry* registry, entt::entity entity);
+    /*
+    *   Updates the transforms of every descendant of entity, breadth first.
+    *   registry: Pointer to UI Registry.
+    *   entity: entity whose transform changed.
+    *   outEntities: descendants that got laid out are appended to it.
+    */
+    void UpdateChildTransforms(entt::registry* registry, entt::entity entity, std::vector<entt::entity>& outEntities);
 
-    void UpdateChildPositions(entt::registry* registry, entt::entity entity);
+    inline static void MarkLayoutDirty(entt::registry* registry, entt::entity entityId)
+    {
+        if (!registry->all_of<UIComponent::LayoutDirty>(entityId))
+            registry->emplace<UIComponent::LayoutDirty>(entityId);
+    }
 };
\ No newline at end of file
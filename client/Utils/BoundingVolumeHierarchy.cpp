@@ -0,0 +1,106 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <Math/Geometry.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+void BoundingVolumeHierarchy::Build(const std::vector<Geometry::AABoundingBox>& primitiveBounds)
+{
+    Clear();
+
+    u32 numPrimitives = static_cast<u32>(primitiveBounds.size());
+    if (numPrimitives == 0)
+        return;
+
+    std::vector<vec3> primitiveMins(numPrimitives);
+    std::vector<vec3> primitiveMaxs(numPrimitives);
+    std::vector<vec3> primitiveCenters(numPrimitives);
+
+    for (u32 i = 0; i < numPrimitives; i++)
+    {
+        const Geometry::AABoundingBox& bounds = primitiveBounds[i];
+
+        primitiveMins[i] = bounds.center - bounds.extents;
+        primitiveMaxs[i] = bounds.center + bounds.extents;
+        primitiveCenters[i] = bounds.center;
+    }
+
+    _primitiveIndices.resize(numPrimitives);
+    std::iota(_primitiveIndices.begin(), _primitiveIndices.end(), 0);
+
+    // Rough guess at the number of nodes, a binary tree with n leaves has 2n - 1 nodes
+    _nodes.reserve((2 * ((numPrimitives + MAX_PRIMITIVES_PER_LEAF - 1) / MAX_PRIMITIVES_PER_LEAF)) - 1);
+
+    BuildNode(0, numPrimitives, primitiveMins, primitiveMaxs, primitiveCenters, 0);
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+    _nodes.clear();
+    _primitiveIndices.clear();
+}
+
+u32 BoundingVolumeHierarchy::BuildNode(u32 begin, u32 end, const std::vector<vec3>& primitiveMins, const std::vector<vec3>& primitiveMaxs, const std::vector<vec3>& primitiveCenters, u32 depth)
+{
+    u32 nodeIndex = static_cast<u32>(_nodes.size());
+    _nodes.emplace_back();
+
+    vec3 nodeMin = vec3(std::numeric_limits<f32>().max());
+    vec3 nodeMax = vec3(-std::numeric_limits<f32>().max());
+    vec3 centerMin = nodeMin;
+    vec3 centerMax = nodeMax;
+
+    for (u32 i = begin; i < end; i++)
+    {
+        u32 primitiveIndex = _primitiveIndices[i];
+
+        nodeMin = glm::min(nodeMin, primitiveMins[primitiveIndex]);
+        nodeMax = glm::max(nodeMax, primitiveMaxs[primitiveIndex]);
+        centerMin = glm::min(centerMin, primitiveCenters[primitiveIndex]);
+        centerMax = glm::max(centerMax, primitiveCenters[primitiveIndex]);
+    }
+
+    u32 numPrimitives = end - begin;
+
+    // Split along the axis where the primitive centers are spread out the most
+    vec3 centerExtents = centerMax - centerMin;
+    u32 splitAxis = 0;
+    if (centerExtents.y > centerExtents[splitAxis])
+        splitAxis = 1;
+    if (centerExtents.z > centerExtents[splitAxis])
+        splitAxis = 2;
+
+    // The stack used by Query is fixed size, so we make a leaf out of whatever is left if the tree ever grows that deep
+    bool isLeaf = numPrimitives <= MAX_PRIMITIVES_PER_LEAF || centerExtents[splitAxis] <= 0.0f || depth >= MAX_DEPTH - 2;
+
+    if (isLeaf)
+    {
+        Node& node = _nodes[nodeIndex];
+        node.min = nodeMin;
+        node.max = nodeMax;
+        node.offset = begin;
+        node.numPrimitives = numPrimitives;
+
+        return nodeIndex;
+    }
+
+    // Median split, this keeps the tree balanced which matters more than split quality for the small queries we do
+    u32 middle = begin + (numPrimitives / 2);
+    std::nth_element(_primitiveIndices.begin() + begin, _primitiveIndices.begin() + middle, _primitiveIndices.begin() + end, [&](u32 a, u32 b)
+    {
+        return primitiveCenters[a][splitAxis] < primitiveCenters[b][splitAxis];
+    });
+
+    BuildNode(begin, middle, primitiveMins, primitiveMaxs, primitiveCenters, depth + 1);
+    u32 rightChildIndex = BuildNode(middle, end, primitiveMins, primitiveMaxs, primitiveCenters, depth + 1);
+
+    // _nodes might have reallocated while building the children, don't hold on to a reference across the recursion
+    Node& node = _nodes[nodeIndex];
+    node.min = nodeMin;
+    node.max = nodeMax;
+    node.offset = rightChildIndex;
+    node.numPrimitives = 0;
+
+    return nodeIndex;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+
+namespace Geometry
+{
+    struct AABoundingBox;
+}
+
+// Static AABB tree over a set of primitives (triangles, model instances...), built once and then queried with boxes
+// Nodes are stored depth first, the left child of an inner node always directly follows its parent
+class BoundingVolumeHierarchy
+{
+public:
+    static constexpr u32 MAX_PRIMITIVES_PER_LEAF = 4;
+    static constexpr u32 MAX_DEPTH = 64;
+
+    struct Node
+    {
+        vec3 min;
+        u32 offset; // Inner node: index of the right child, Leaf: index of the first primitive in _primitiveIndices
+        vec3 max;
+        u32 numPrimitives; // 0 for inner nodes
+    };
+
+    void Build(const std::vector<Geometry::AABoundingBox>& primitiveBounds);
+    void Clear();
+
+    bool IsEmpty() const { return _nodes.empty(); }
+    size_t GetNumNodes() const { return _nodes.size(); }
+
+    // Calls callback(u32 primitiveIndex) for every primitive whose bounds overlap [min, max]
+    template <typename Func>
+    void Query(const vec3& min, const vec3& max, Func&& callback) const
+    {
+        if (_nodes.empty())
+            return;
+
+        u32 stack[MAX_DEPTH];
+        u32 stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const Node& node = _nodes[stack[--stackSize]];
+
+            if (node.min.x > max.x || node.max.x < min.x ||
+                node.min.y > max.y || node.max.y < min.y ||
+                node.min.z > max.z || node.max.z < min.z)
+                continue;
+
+            if (node.numPrimitives > 0)
+            {
+                for (u32 i = 0; i < node.numPrimitives; i++)
+                {
+                    callback(_primitiveIndices[node.offset + i]);
+                }
+            }
+            else
+            {
+                u32 nodeIndex = static_cast<u32>(&node - _nodes.data());
+
+                stack[stackSize++] = node.offset;
+                stack[stackSize++] = nodeIndex + 1;
+            }
+        }
+    }
+
+private:
+    u32 BuildNode(u32 begin, u32 end, const std::vector<vec3>& primitiveMins, const std::vector<vec3>& primitiveMaxs, const std::vector<vec3>& primitiveCenters, u32 depth);
+
+private:
+    std::vector<Node> _nodes;
+    std::vector<u32> _primitiveIndices;
+};
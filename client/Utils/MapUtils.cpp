@@ -2,10 +2,11 @@
 #include "../ECS/Components/Singletons/NDBCSingleton.h"
 
 #include <Utils/FileReader.h>
+#include <tracy/Tracy.hpp>
 #include <filesystem>
 namespace fs = std::filesystem;
 
-bool Terrain::MapUtils::LoadMap(entt::registry* registry, const NDBC::Map* map)
+bool Terrain::MapUtils::LoadMap(entt::registry* registry, const NDBC::Map* map, bool loadChunks)
 {
     MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
     NDBCSingleton& ndbcSingleton = registry->ctx<NDBCSingleton>();
@@ -34,105 +35,263 @@ bool Terrain::MapUtils::LoadMap(entt::registry* registry, const NDBC::Map* map)
     currentMap.id = map->id;
     currentMap.name = mapInternalName;
 
-    bool nmapFound = false;
-    for (const auto& entry : std::filesystem::recursive_directory_iterator(absolutePath))
-    {
-        auto file = std::filesystem::path(entry.path());
+    std::string nmapPath;
+    if (!FindMapFiles(mapInternalName, currentMap, nmapPath))
+        return false;
 
-        if (file.extension() != ".nmap")
-            continue;
+    FileReader mapHeaderFile(nmapPath, fs::path(nmapPath).filename().string());
+    if (!mapHeaderFile.Open())
+    {
+        DebugHandler::PrintError("Failed to read map (%s)", mapInternalName.c_str());
+        return false;
+    }
 
-        std::string fileName = file.filename().replace_extension("").string();
-        if (fileName != mapInternalName)
-            continue;
+    if (!Terrain::MapHeader::Read(mapHeaderFile, currentMap.header))
+    {
+        DebugHandler::PrintError("Failed to load map header for (%s)", mapInternalName.c_str());
+        return false;
+    }
 
-        FileReader mapHeaderFile(entry.path().string(), file.filename().string());
-        if (!mapHeaderFile.Open())
+    // Load Chunks if map does not use Map Object as base
+    if (!currentMap.header.flags.UseMapObjectInsteadOfTerrain)
+    {
+        if (currentMap.chunkPaths.size() == 0)
         {
-            DebugHandler::PrintError("Failed to read map (%s)", mapInternalName.c_str());
+            DebugHandler::PrintError("0 map chunks found in (%s)", absolutePath.string().c_str());
             return false;
         }
 
-        if (!Terrain::MapHeader::Read(mapHeaderFile, currentMap.header))
+        if (loadChunks)
         {
-            DebugHandler::PrintError("Failed to load map header for (%s)", mapInternalName.c_str());
-            return false;
+            std::vector<u16> chunkIDs;
+            chunkIDs.reserve(currentMap.chunkPaths.size());
+
+            for (const auto& chunkPath : currentMap.chunkPaths)
+            {
+                chunkIDs.push_back(chunkPath.first);
+            }
+
+            if (!LoadChunks(currentMap, chunkIDs))
+                return false;
+        }
+    }
+    else
+    {
+        currentMap.chunkPaths.clear();
+    }
+
+    DebugHandler::PrintSuccess("Loaded Map (%s)", mapInternalName.c_str());
+    return true;
+}
+
+bool Terrain::MapUtils::FindMapFiles(const std::string& mapInternalName, Terrain::Map& map, std::string& nmapPath)
+{
+    fs::path absolutePath = std::filesystem::absolute("Data/extracted/maps/" + mapInternalName);
+    if (!fs::is_directory(absolutePath))
+    {
+        DebugHandler::PrintError("Failed to find map folder for %s", mapInternalName.c_str());
+        return false;
+    }
+
+    // Walk the map folder once, finding the map header and indexing every chunk file
+    fs::path nmapPath;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(absolutePath))
+    {
+        const fs::path& file = entry.path();
+        const fs::path extension = file.extension();
+
+        if (extension == ".nmap")
+        {
+            if (file.stem().string() == mapInternalName)
+                nmapPath = file.string();
+
+            continue;
         }
 
-        nmapFound = true;
-        break;
+        if (extension != ".nchunk")
+            continue;
+
+        // Make sure filename is the same, multiple maps can have chunks in the same folder
+        std::string fileName = file.stem().string();
+        if (strncmp(fileName.c_str(), mapInternalName.c_str(), mapInternalName.length()) != 0)
+            continue;
+
+        // Chunk files are named {mapInternalName}_{x}_{y}.nchunk
+        size_t ySeparator = fileName.rfind('_');
+        if (ySeparator == std::string::npos || ySeparator == 0)
+            continue;
+
+        size_t xSeparator = fileName.rfind('_', ySeparator - 1);
+        if (xSeparator == std::string::npos)
+            continue;
+
+        u16 x = static_cast<u16>(std::strtoul(fileName.c_str() + xSeparator + 1, nullptr, 10));
+        u16 y = static_cast<u16>(std::strtoul(fileName.c_str() + ySeparator + 1, nullptr, 10));
+        u16 chunkId = x + (y * Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+
+        map.chunkPaths[chunkId] = file.string();
     }
 
-    if (!nmapFound)
+    if (nmapPath.empty())
     {
         DebugHandler::PrintError("Failed to find nmap file for map (%s)", mapInternalName.c_str());
         return false;
     }
 
-    // Load Chunks if map does not use Map Object as base
-    if (!currentMap.header.flags.UseMapObjectInsteadOfTerrain)
+    return true;
+}
+
+static bool ReadChunkFile(const std::string& path, Terrain::Chunk& chunk, StringTable& stringTable)
+{
+    if (!Terrain::Chunk::Read(path, chunk, stringTable))
     {
-        size_t loadedChunks = 0;
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(absolutePath))
-        {
-            auto file = std::filesystem::path(entry.path());
-            if (file.extension() != ".nchunk")
-                continue;
+        DebugHandler::PrintError("Failed to load map chunk (%s)", fs::path(path).filename().string().c_str());
+        return false;
+    }
 
-            // Make sure filename is the same, multiple maps can have chunks in the same folder
-            std::string fileName = file.filename().string();
-            if (strncmp(fileName.c_str(), mapInternalName.c_str(), mapInternalName.length()) != 0)
-                continue;
+    Terrain::MapUtils::AlignCellBorders(chunk);
+    return true;
+}
 
-            FileReader chunkFile(entry.path().string(), file.filename().string());
-            if (!chunkFile.Open())
-            {
-                DebugHandler::PrintError("Failed to load map chunk (%s)", file.filename().string().c_str());
-                return false;
-            }
+bool Terrain::MapUtils::LoadChunk(Terrain::Map& map, u16 chunkID)
+{
+    auto pathItr = map.chunkPaths.find(chunkID);
+    if (pathItr == map.chunkPaths.end())
+        return false;
 
-            Terrain::Chunk chunk;
-            StringTable chunkStringTable;
-            if (!Terrain::Chunk::Read(chunkFile, chunk, chunkStringTable))
-            {
-                DebugHandler::PrintError("Failed to load map chunk for (%s)", file.filename().string().c_str());
-                return false;
-            }
+    if (map.chunks.find(chunkID) != map.chunks.end())
+        return true;
+
+    Terrain::Chunk& chunk = map.chunks[chunkID];
+    StringTable& chunkStringTable = map.stringTables[chunkID];
+    if (!ReadChunkFile(pathItr->second, chunk, chunkStringTable))
+    {
+        map.chunks.erase(chunkID);
+        map.stringTables.erase(chunkID);
+        return false;
+    }
 
-            std::vector<std::string> splitName = StringUtils::SplitString(file.filename().string(), '_');
-            size_t numberOfSplits = splitName.size();
+    // Auto Create (SafeVector has no copy constructor, this is a way around that)
+    SafeVector<entt::entity>& chunkEntityList = map.chunksEntityList[chunkID];
+    SafeVector<entt::entity>& chunkCollidableEntityList = map.chunksCollidableEntityList[chunkID];
+    Terrain::ChunkCollisionBroadphase& chunkCollisionBroadphase = map.chunksCollisionBroadphase[chunkID];
 
-            std::string mapInternalName = splitName[0];
-            for (size_t i = 1; i < numberOfSplits - 2; i++)
-            {
-                mapInternalName += "_" + splitName[i];
-            }
+    Terrain::MapUtils::AlignChunkBorders(map, chunkID);
+
+    return true;
+}
+
+bool Terrain::MapUtils::LoadChunks(Terrain::Map& map, const std::vector<u16>& chunkIDs, std::atomic<u32>* numChunksLoaded)
+{
+    ZoneScopedN("MapUtils::LoadChunks()");
+
+    struct ChunkReadJob
+    {
+        const std::string* path = nullptr;
+        Terrain::Chunk* chunk = nullptr;
+        StringTable* stringTable = nullptr;
+    };
+
+    // Create the storage of every chunk up front, this way the workers decode straight into their own chunk and never modify the maps
+    std::vector<ChunkReadJob> chunkReadJobs;
+    chunkReadJobs.reserve(chunkIDs.size());
+
+    for (u16 chunkID : chunkIDs)
+    {
+        auto pathItr = map.chunkPaths.find(chunkID);
+        if (pathItr == map.chunkPaths.end() || map.chunks.find(chunkID) != map.chunks.end())
+            continue;
 
-            u16 x = std::stoi(splitName[numberOfSplits - 2]);
-            u16 y = std::stoi(splitName[numberOfSplits - 1]);
-            u16 chunkId = x + (y * Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+        ChunkReadJob& chunkReadJob = chunkReadJobs.emplace_back();
+        chunkReadJob.path = &pathItr->second;
+        chunkReadJob.chunk = &map.chunks[chunkID];
+        chunkReadJob.stringTable = &map.stringTables[chunkID];
 
-            currentMap.chunks[chunkId] = chunk;
-            currentMap.stringTables[chunkId].CopyFrom(chunkStringTable);
+        // Auto Create (SafeVector has no copy constructor, this is a way around that)
+        SafeVector<entt::entity>& chunkEntityList = map.chunksEntityList[chunkID];
+        SafeVector<entt::entity>& chunkCollidableEntityList = map.chunksCollidableEntityList[chunkID];
+        Terrain::ChunkCollisionBroadphase& chunkCollisionBroadphase = map.chunksCollisionBroadphase[chunkID];
+    }
 
-            // Auto Create (SafeVector has no copy constructor, this is a way around that)
-            SafeVector<entt::entity>& chunkEntityList = currentMap.chunksEntityList[chunkId];
-            SafeVector<entt::entity>& chunkCollidableEntityList = currentMap.chunksCollidableEntityList[chunkId];
+    std::atomic<bool> didFail = false;
 
-            Terrain::MapUtils::AlignCellBorders(currentMap.chunks[chunkId]);
+    tf::Taskflow tf;
+    tf.parallel_for(chunkReadJobs.begin(), chunkReadJobs.end(), [&](const ChunkReadJob& chunkReadJob)
+    {
+        ZoneScopedN("Read Chunk");
 
-            loadedChunks++;
+        if (!ReadChunkFile(*chunkReadJob.path, *chunkReadJob.chunk, *chunkReadJob.stringTable))
+        {
+            didFail = true;
         }
 
-        if (loadedChunks == 0)
+        if (numChunksLoaded != nullptr)
         {
-            DebugHandler::PrintError("0 map chunks found in (%s)", absolutePath.string().c_str());
-            return false;
+            (*numChunksLoaded)++;
         }
+    });
+    tf.wait_for_all();
 
-        Terrain::MapUtils::AlignChunkBorders(currentMap);
-    }
+    if (didFail)
+        return false;
 
-    DebugHandler::PrintSuccess("Loaded Map (%s)", mapInternalName.c_str());
+    Terrain::MapUtils::AlignChunkBorders(map);
     return true;
+}
+
+void Terrain::MapUtils::UnloadChunk(Terrain::Map& map, u16 chunkID)
+{
+    // Entity lists are kept, entities placed in this chunk outlive the terrain data
+    map.chunks.erase(chunkID);
+
+    auto stringTableItr = map.stringTables.find(chunkID);
+    if (stringTableItr != map.stringTables.end())
+    {
+        stringTableItr->second.Clear();
+        map.stringTables.erase(stringTableItr);
+    }
+}
+
+void Terrain::MapUtils::AlignChunkBorders(Terrain::Map& map)
+{
+    ZoneScopedN("MapUtils::AlignChunkBorders()");
+
+    struct ChunkNeighbours
+    {
+        Terrain::Chunk* chunk = nullptr;
+        const Terrain::Chunk* chunkAbove = nullptr;
+        const Terrain::Chunk* chunkLeft = nullptr;
+    };
+
+    std::vector<ChunkNeighbours> chunkNeighbours;
+    chunkNeighbours.reserve(map.chunks.size());
+
+    for (auto& chunkItr : map.chunks)
+    {
+        const u16 chunkID = chunkItr.first;
+
+        u16 chunkAboveID = chunkID - Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
+        u16 chunkLeftID = chunkID - 1;
+
+        ChunkNeighbours& neighbours = chunkNeighbours.emplace_back();
+        neighbours.chunk = &chunkItr.second;
+        neighbours.chunkAbove = map.GetChunkById(chunkAboveID);
+        neighbours.chunkLeft = map.GetChunkById(chunkLeftID);
+    }
+
+    // Aligning against the chunk above only writes the top row of a chunk and reads the bottom row of its neighbour,
+    // aligning against the chunk to the left only writes the left column and reads the right column.
+    // Running them as two separate passes means no chunk is ever read and written at the same time.
+    tf::Taskflow tf;
+    tf.parallel_for(chunkNeighbours.begin(), chunkNeighbours.end(), [&](const ChunkNeighbours& neighbours)
+    {
+        AlignChunkBorders(*neighbours.chunk, neighbours.chunkAbove, nullptr);
+    });
+    tf.wait_for_all();
+
+    tf.parallel_for(chunkNeighbours.begin(), chunkNeighbours.end(), [&](const ChunkNeighbours& neighbours)
+    {
+        AlignChunkBorders(*neighbours.chunk, nullptr, neighbours.chunkLeft);
+    });
+    tf.wait_for_all();
 }
\ No newline at end of file
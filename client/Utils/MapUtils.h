@@ -33,6 +33,7 @@
 #include <NovusTypes.h>
 #include <Math/Geometry.h>
 #include <entt.hpp>
+#include <atomic>
 #include "ServiceLocator.h"
 #include "../Gameplay/Map/Chunk.h"
 
@@ -44,7 +45,18 @@ namespace Terrain
     {
         constexpr f32 f32MaxValue = 3.40282346638528859812e+38F;
 
-        bool LoadMap(entt::registry* registry, const NDBC::Map* map);
+        // Loads the map header and indexes the chunk files of the map, if loadChunks is false the chunks are left for LoadChunk/LoadChunks
+        bool LoadMap(entt::registry* registry, const NDBC::Map* map, bool loadChunks = true);
+
+        // Walks the map folder once, returning the path of the map header and indexing every chunk file into map.chunkPaths
+        bool FindMapFiles(const std::string& mapInternalName, Terrain::Map& map, std::string& nmapPath);
+
+        // Loads and aligns a single chunk of the current map, returns false if the chunk does not exist or failed to load
+        bool LoadChunk(Terrain::Map& map, u16 chunkID);
+        void UnloadChunk(Terrain::Map& map, u16 chunkID);
+
+        // Decodes the given chunks across worker threads straight into map, numChunksLoaded is incremented as each chunk finishes
+        bool LoadChunks(Terrain::Map& map, const std::vector<u16>& chunkIDs, std::atomic<u32>* numChunksLoaded = nullptr);
 
         inline vec2 GetChunkPosition(u32 chunkID)
         {
@@ -118,61 +130,75 @@ namespace Terrain
             }
         }
 
-        inline void AlignChunkBorders(Terrain::Map& map)
+        // Copies the shared edge heights from the chunk above and the chunk to the left into chunk, either neighbour may be nullptr
+        inline void AlignChunkBorders(Terrain::Chunk& chunk, const Terrain::Chunk* chunkAbove, const Terrain::Chunk* chunkLeft)
         {
-            for (auto& chunkItr : map.chunks)
+            if (chunkAbove != nullptr)
             {
-                const u16& chunkID = chunkItr.first;
-                Terrain::Chunk& chunk = chunkItr.second;
-
-                u16 chunkX = chunkID % Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
-                u16 chunkY = chunkID / Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
-
-                u16 chunkAboveID = chunkID - Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
-                u16 chunkLeftID = chunkID - 1;
+                u32 aboveStartCellID = Terrain::MAP_CELLS_PER_CHUNK - Terrain::MAP_CELLS_PER_CHUNK_SIDE;
 
-                bool hasChunkAbove = map.chunks.find(chunkAboveID) != map.chunks.end();
-                bool hasChunkLeft = map.chunks.find(chunkLeftID) != map.chunks.end();
-
-                if (hasChunkAbove)
+                for (u32 i = 0; i < Terrain::MAP_CELLS_PER_CHUNK_SIDE; i++)
                 {
-                    Terrain::Chunk& chunkAbove = map.chunks[chunkAboveID];
-                    u32 aboveStartCellID = Terrain::MAP_CELLS_PER_CHUNK - Terrain::MAP_CELLS_PER_CHUNK_SIDE;
+                    Terrain::Cell& currentCell = chunk.cells[i];
+                    const Terrain::Cell& aboveCell = chunkAbove->cells[aboveStartCellID + i];
 
-                    for (u32 i = 0; i < Terrain::MAP_CELLS_PER_CHUNK_SIDE; i++)
+                    // Avoid fixing the very first height value within the cell grid (This is handled by "hasChunkLeft"
+                    for (u32 currentHeightID = 1; currentHeightID < Terrain::MAP_CELL_OUTER_GRID_STRIDE; currentHeightID++)
                     {
-                        Terrain::Cell& currentCell = chunk.cells[i];
-                        Terrain::Cell& aboveCell = chunkAbove.cells[aboveStartCellID + i];
-
-                        // Avoid fixing the very first height value within the cell grid (This is handled by "hasChunkLeft"
-                        for (u32 currentHeightID = 1; currentHeightID < Terrain::MAP_CELL_OUTER_GRID_STRIDE; currentHeightID++)
-                        {
-                            u32 aboveHeightID = currentHeightID + (Terrain::MAP_CELL_TOTAL_GRID_SIZE - Terrain::MAP_CELL_OUTER_GRID_STRIDE);
-                            currentCell.heightData[currentHeightID] = aboveCell.heightData[aboveHeightID];
-                        }
+                        u32 aboveHeightID = currentHeightID + (Terrain::MAP_CELL_TOTAL_GRID_SIZE - Terrain::MAP_CELL_OUTER_GRID_STRIDE);
+                        currentCell.heightData[currentHeightID] = aboveCell.heightData[aboveHeightID];
                     }
                 }
+            }
+
+            if (chunkLeft != nullptr)
+            {
+                u32 leftStartCellID = Terrain::MAP_CELLS_PER_CHUNK_SIDE - 1;
 
-                if (hasChunkLeft)
+                for (u32 i = 0; i < Terrain::MAP_CELLS_PER_CHUNK; i += Terrain::MAP_CELLS_PER_CHUNK_SIDE)
                 {
-                    Terrain::Chunk& chunkLeft = map.chunks[chunkLeftID];
-                    u32 leftStartCellID = Terrain::MAP_CELLS_PER_CHUNK_SIDE - 1;
+                    Terrain::Cell& currentCell = chunk.cells[i];
+                    const Terrain::Cell& leftCell = chunkLeft->cells[leftStartCellID + i];
 
-                    for (u32 i = 0; i < Terrain::MAP_CELLS_PER_CHUNK; i += Terrain::MAP_CELLS_PER_CHUNK_SIDE)
+                    for (u32 currentHeightID = 0; currentHeightID < Terrain::MAP_CELL_TOTAL_GRID_SIZE; currentHeightID += Terrain::MAP_CELL_TOTAL_GRID_STRIDE)
                     {
-                        Terrain::Cell& currentCell = chunk.cells[i];
-                        Terrain::Cell& leftCell = chunkLeft.cells[leftStartCellID + i];
-
-                        for (u32 currentHeightID = 0; currentHeightID < Terrain::MAP_CELL_TOTAL_GRID_SIZE; currentHeightID += Terrain::MAP_CELL_TOTAL_GRID_STRIDE)
-                        {
-                            u32 aboveHeightID = currentHeightID + (Terrain::MAP_CELL_OUTER_GRID_STRIDE - 1);
-                            currentCell.heightData[currentHeightID] = leftCell.heightData[aboveHeightID];
-                        }
+                        u32 aboveHeightID = currentHeightID + (Terrain::MAP_CELL_OUTER_GRID_STRIDE - 1);
+                        currentCell.heightData[currentHeightID] = leftCell.heightData[aboveHeightID];
                     }
                 }
             }
         }
 
+        // Aligns every loaded chunk of the map against its neighbours in parallel
+        void AlignChunkBorders(Terrain::Map& map);
+
+        // Aligns a single (newly loaded) chunk against its loaded neighbours, and the neighbours below and to the right against it
+        inline void AlignChunkBorders(Terrain::Map& map, u16 chunkID)
+        {
+            Terrain::Chunk* chunk = map.GetChunkById(chunkID);
+            if (chunk == nullptr)
+                return;
+
+            u16 chunkX = chunkID % Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
+            u16 chunkY = chunkID / Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
+
+            Terrain::Chunk* chunkAbove = chunkY > 0 ? map.GetChunkById(chunkID - Terrain::MAP_CHUNKS_PER_MAP_STRIDE) : nullptr;
+            Terrain::Chunk* chunkLeft = chunkX > 0 ? map.GetChunkById(chunkID - 1) : nullptr;
+            AlignChunkBorders(*chunk, chunkAbove, chunkLeft);
+
+            if (chunkY < Terrain::MAP_CHUNKS_PER_MAP_STRIDE - 1)
+            {
+                if (Terrain::Chunk* chunkBelow = map.GetChunkById(chunkID + Terrain::MAP_CHUNKS_PER_MAP_STRIDE))
+                    AlignChunkBorders(*chunkBelow, chunk, nullptr);
+            }
+
+            if (chunkX < Terrain::MAP_CHUNKS_PER_MAP_STRIDE - 1)
+            {
+                if (Terrain::Chunk* chunkRight = map.GetChunkById(chunkID + 1))
+                    AlignChunkBorders(*chunkRight, nullptr, chunk);
+            }
+        }
+
         inline vec2 WorldPositionToADTCoordinates(const vec3& position)
         {
             // This is translated to remap positions [-17066 .. 17066] to [0 ..  34132]
@@ -0,0 +1,90 @@
+#include "MemoryMappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MemoryMappedFile::Open(const std::string& path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mappingHandle == nullptr)
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    _fileHandle = fileHandle;
+    _mappingHandle = mappingHandle;
+    _data = static_cast<u8*>(data);
+    _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    i32 fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor); // The mapping keeps the file alive
+
+    if (data == MAP_FAILED)
+        return false;
+
+    _data = static_cast<u8*>(data);
+    _size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (_data == nullptr)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle(static_cast<HANDLE>(_mappingHandle));
+    CloseHandle(static_cast<HANDLE>(_fileHandle));
+
+    _fileHandle = nullptr;
+    _mappingHandle = nullptr;
+#else
+    munmap(_data, _size);
+#endif
+
+    _data = nullptr;
+    _size = 0;
+}
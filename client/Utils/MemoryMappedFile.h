@@ -0,0 +1,30 @@
+#pragma once
+#include <NovusTypes.h>
+#include <string>
+
+// Maps a whole file into memory, pages are copy-on-write so writes through GetData() stay private to this process and never reach the file
+class MemoryMappedFile
+{
+public:
+    MemoryMappedFile() {}
+    ~MemoryMappedFile() { Close(); }
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return _data != nullptr; }
+    u8* GetData() const { return _data; }
+    size_t GetSize() const { return _size; }
+
+private:
+    u8* _data = nullptr;
+    size_t _size = 0;
+
+#ifdef _WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#endif
+};
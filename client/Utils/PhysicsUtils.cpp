@@ -10,6 +10,13 @@
 #include "../ECS/Components/Singletons/TimeSingleton.h"
 
 #include <Math/Geometry.h>
+#include <CVar/CVarSystem.h>
+#include <Utils/Timer.h>
+#include <tracy/Tracy.hpp>
+#include <random>
+
+AutoCVar_Int CVAR_PhysicsUseCollisionBVH("physics.useCollisionBVH", "use the chunk broadphase and model BVHs for complex model collision", 1, CVarFlags::EditCheckbox);
+AutoCVar_Int CVAR_PhysicsDrawCModelCollision("physics.drawCModelCollision", "draw the bounds and closest triangle tested by complex model collision", 0, CVarFlags::EditCheckbox);
 
 namespace PhysicsUtils
 {
@@ -314,6 +321,10 @@ namespace PhysicsUtils
 
         outTimeToCollide = std::numeric_limits<f32>().max();
 
+        // Test all triangles under the box in one go, the batch returns the "shortest" collision and not just "any" collision
+        // (Not doing this causes issues when testing against multiple triangles)
+        TriangleSweepBatch triangleBatch;
+
         for (i32 i = 0; i < 5; i++)
         {
             vec3 pos = box.center + offsets[i];
@@ -328,17 +339,12 @@ namespace PhysicsUtils
                 tri.vert2 -= box.center;
                 tri.vert3 -= box.center;
 
-                // We need to find the "shortest" collision here and not just "any" collision (Not doing this causes issues when testing against multiple triangles
-                f32 tmpTimeToCollision = 0;
-                if (Intersect_AABB_TRIANGLE_SWEEP(box.extents, tri, direction, maxDist, tmpTimeToCollision, true))
-                {
-                    if (tmpTimeToCollision < outTimeToCollide)
-                        outTimeToCollide = tmpTimeToCollision;
-                }
+                triangleBatch.Add(tri, i);
             }
         }
 
-        return outTimeToCollide != std::numeric_limits<f32>().max();
+        u32 triangleIndex = 0;
+        return Intersect_AABB_TRIANGLE_SWEEP_BATCH(box.extents, triangleBatch, direction, maxDist, true, outTimeToCollide, triangleIndex);
     }
 
     bool Intersect_AABB_AABB(const Geometry::AABoundingBox& a, const Geometry::AABoundingBox& b)
@@ -429,15 +435,153 @@ namespace PhysicsUtils
         bool seperated = sep1 || sep2 || sep3 || sep4 || sep5 || sep6 || sep7;
         return !seperated;
     }
+    static Geometry::AABoundingBox TransformAABB(const Geometry::AABoundingBox& aabb, const mat4x4& m)
+    {
+        Geometry::AABoundingBox transformedAABB;
+        transformedAABB.center = vec3(m * vec4(aabb.center, 1.0f));
+
+        // Transform extents (take maximum)
+        glm::mat3x3 absMatrix = glm::mat3x3(glm::abs(vec3(m[0])), glm::abs(vec3(m[1])), glm::abs(vec3(m[2])));
+        transformedAABB.extents = absMatrix * aabb.extents;
+
+        return transformedAABB;
+    }
+
+    static Geometry::AABoundingBox GetSweptAABB(const Geometry::AABoundingBox& aabb, const vec3& velocity)
+    {
+        // Padded slightly so float error from transforming the box into model space never culls a touching triangle
+        constexpr f32 padding = 0.01f;
+
+        vec3 min = glm::min(aabb.center, aabb.center + velocity) - aabb.extents - padding;
+        vec3 max = glm::max(aabb.center, aabb.center + velocity) + aabb.extents + padding;
+
+        Geometry::AABoundingBox sweptAABB;
+        sweptAABB.center = (min + max) * 0.5f;
+        sweptAABB.extents = (max - min) * 0.5f;
+
+        return sweptAABB;
+    }
+
+    struct CModelSweepHit
+    {
+        f32 timeToCollide = std::numeric_limits<f32>().max();
+        Geometry::Triangle triangle;
+        Geometry::Triangle transformedTriangle; // World space, relative to the center of the swept box
+    };
+
+    // Sweeps srcAABB against the collision triangles of a single instance, keeping the closest hit in hit
+    static void SweepAABBAgainstCModel(const Geometry::AABoundingBox& srcAABB, const vec3& velocity, const CModelRenderer::LoadedComplexModel& loadedComplexModel, const mat4x4& instanceMatrix, const std::vector<Geometry::Triangle>& collisionTriangles, bool useBVH, CModelSweepHit& hit)
+    {
+        u32 triangleOffset = loadedComplexModel.collisionTriangleOffset;
+
+        auto transformTriangle = [&](const Geometry::Triangle& triangle)
+        {
+            Geometry::Triangle transformedTriangle;
+
+            // Transform Triangle using Instance Matrix
+            transformedTriangle.vert1 = vec3(instanceMatrix * vec4(triangle.vert1, 1.0f));
+            transformedTriangle.vert2 = vec3(instanceMatrix * vec4(triangle.vert2, 1.0f));
+            transformedTriangle.vert3 = vec3(instanceMatrix * vec4(triangle.vert3, 1.0f));
+
+            // Transform Triangle making it relative to srcAABB
+            transformedTriangle.vert1 -= srcAABB.center;
+            transformedTriangle.vert2 -= srcAABB.center;
+            transformedTriangle.vert3 -= srcAABB.center;
+
+            return transformedTriangle;
+        };
+
+        TriangleSweepBatch triangleBatch;
+
+        auto sweepTriangleBatch = [&]()
+        {
+            f32 tmpTimeToCollision = 0;
+            u32 triangleIndex = 0;
+
+            if (Intersect_AABB_TRIANGLE_SWEEP_BATCH(srcAABB.extents, triangleBatch, velocity, 1.0f, true, tmpTimeToCollision, triangleIndex))
+            {
+                if (tmpTimeToCollision < hit.timeToCollide)
+                {
+                    hit.timeToCollide = tmpTimeToCollision;
+                    hit.triangle = collisionTriangles[triangleOffset + triangleIndex];
+                    hit.transformedTriangle = transformTriangle(hit.triangle);
+                }
+            }
+
+            triangleBatch.Clear();
+        };
+
+        auto sweepTriangle = [&](u32 triangleIndex)
+        {
+            triangleBatch.Add(transformTriangle(collisionTriangles[triangleOffset + triangleIndex]), triangleIndex);
+
+            if (triangleBatch.IsFull())
+                sweepTriangleBatch();
+        };
+
+        if (useBVH && !loadedComplexModel.collisionBVH.IsEmpty())
+        {
+            // Bring the volume covered by the sweep into model space, only triangles overlapping it can be hit
+            Geometry::AABoundingBox modelSpaceSweptAABB = TransformAABB(GetSweptAABB(srcAABB, velocity), glm::inverse(instanceMatrix));
+
+            vec3 min = modelSpaceSweptAABB.center - modelSpaceSweptAABB.extents;
+            vec3 max = modelSpaceSweptAABB.center + modelSpaceSweptAABB.extents;
+
+            loadedComplexModel.collisionBVH.Query(min, max, sweepTriangle);
+        }
+        else
+        {
+            for (u32 i = 0; i < loadedComplexModel.numCollisionTriangles; i++)
+            {
+                sweepTriangle(i);
+            }
+        }
+
+        if (!triangleBatch.IsEmpty())
+            sweepTriangleBatch();
+    }
+
+    static void RebuildCollisionBroadphase(Terrain::ChunkCollisionBroadphase& broadphase, const std::vector<entt::entity>& collidableEntities, entt::registry* registry, const std::vector<CModelRenderer::LoadedComplexModel>& loadedComplexModels, const std::vector<CModelRenderer::ModelInstanceData>& cmodelInstanceDatas, const std::vector<mat4x4>& cmodelInstanceMatrices)
+    {
+        ZoneScopedN("PhysicsUtils::RebuildCollisionBroadphase()");
+
+        broadphase.staticEntities.clear();
+        broadphase.dynamicEntities.clear();
+
+        std::vector<Geometry::AABoundingBox> staticBounds;
+        staticBounds.reserve(collidableEntities.size());
+
+        for (entt::entity entityID : collidableEntities)
+        {
+            const CModelInfo& cmodelInfo = registry->get<CModelInfo>(entityID);
+            if (!cmodelInfo.isStaticModel)
+            {
+                broadphase.dynamicEntities.push_back(entityID);
+                continue;
+            }
+
+            const CModelRenderer::ModelInstanceData& instanceData = cmodelInstanceDatas[cmodelInfo.instanceID];
+            const CModelRenderer::LoadedComplexModel& loadedComplexModel = loadedComplexModels[instanceData.modelID];
+
+            broadphase.staticEntities.push_back(entityID);
+            staticBounds.push_back(TransformAABB(loadedComplexModel.collisionAABB, cmodelInstanceMatrices[cmodelInfo.instanceID]));
+        }
+
+        broadphase.staticBVH.Build(staticBounds);
+    }
+
     bool CheckCollisionForCModels(Terrain::Map& currentMap, const Movement& srcMovement, const CModelInfo& srcCModelInfo, vec3& triangleNormal, f32& triangleAngle, f32& timeToCollide)
     {
         if (srcMovement.velocity.x == 0.0f && srcMovement.velocity.y == 0.0f && srcMovement.velocity.z == 0.0f)
             return false;
 
         SafeVector<entt::entity>* collidableEntityList = currentMap.GetCollidableEntityListByChunkID(srcCModelInfo.currentChunkID);
-        if (!collidableEntityList)
+        Terrain::ChunkCollisionBroadphase* broadphase = currentMap.GetCollisionBroadphaseByChunkID(srcCModelInfo.currentChunkID);
+        if (!collidableEntityList || !broadphase)
             return false;
 
+        timeToCollide = std::numeric_limits<f32>().max();
+
         {
             entt::registry* registry = ServiceLocator::GetGameRegistry();
             TimeSingleton& timeSingleton = registry->ctx<TimeSingleton>();
@@ -467,119 +611,204 @@ namespace PhysicsUtils
             const CModelRenderer::LoadedComplexModel& srcLoadedComplexModel = loadedComplexModels[srcInstanceData.modelID];
 
             vec3 velocityThisFrame = static_cast<vec3>(srcMovement.velocity) * timeSingleton.deltaTime;
-            Geometry::AABoundingBox srcAABB;
-            {
-                vec3 center = srcLoadedComplexModel.collisionAABB.center;
-                vec3 extents = srcLoadedComplexModel.collisionAABB.extents;
-
-                const mat4x4& m = cmodelInstanceMatrices[srcCModelInfo.instanceID];
-                vec3 transformedCenter = vec3(m * vec4(center, 1.0f));
+            Geometry::AABoundingBox srcAABB = TransformAABB(srcLoadedComplexModel.collisionAABB, cmodelInstanceMatrices[srcCModelInfo.instanceID]);
 
-                // Transform extents (take maximum)
-                glm::mat3x3 absMatrix = glm::mat3x3(glm::abs(vec3(m[0])), glm::abs(vec3(m[1])), glm::abs(vec3(m[2])));
-                vec3 transformedExtents = absMatrix * extents;
+            bool useBVH = CVAR_PhysicsUseCollisionBVH.Get() == 1;
+            bool drawCollision = CVAR_PhysicsDrawCModelCollision.Get() == 1;
 
-                // Transform to min/max box representation
-                srcAABB.center = transformedCenter;
-                srcAABB.extents = transformedExtents;
+            if (drawCollision)
+            {
+                debugRenderer->DrawAABB3D(srcAABB.center, srcAABB.extents, 0xff00ff00);
             }
 
-            debugRenderer->DrawAABB3D(srcAABB.center, srcAABB.extents, 0xff00ff00);
-
             // Check for collision
-            timeToCollide = std::numeric_limits<f32>().max();
-            Geometry::Triangle closestTriangle;
-            Geometry::Triangle closestTransformedTriangle;
+            CModelSweepHit closestHit;
 
-            for (u32 i = 0; i < numCollidableEntities; i++)
+            auto sweepInstance = [&](entt::entity entityID)
             {
-                entt::entity entityID = collidableEntities[i];
-                CModelInfo& cmodelInfo = registry->get<CModelInfo>(entityID);
+                const CModelInfo& cmodelInfo = registry->get<CModelInfo>(entityID);
 
                 u32 instanceID = cmodelInfo.instanceID;
-                const CModelRenderer::ModelInstanceData& instanceData = cmodelInstanceDatas[cmodelInfo.instanceID];
+                if (instanceID == srcCModelInfo.instanceID)
+                    return;
+
+                const CModelRenderer::ModelInstanceData& instanceData = cmodelInstanceDatas[instanceID];
                 const CModelRenderer::LoadedComplexModel& loadedComplexModel = loadedComplexModels[instanceData.modelID];
                 const mat4x4& instanceMatrix = cmodelInstanceMatrices[instanceID];
 
-                Geometry::AABoundingBox cmodelAABB;
-                {
-                    vec3 center = loadedComplexModel.collisionAABB.center;
-                    vec3 extents = loadedComplexModel.collisionAABB.extents;
-
-                    vec3 transformedCenter = vec3(instanceMatrix * vec4(center, 1.0f));
-
-                    // Transform extents (take maximum)
-                    glm::mat3x3 absMatrix = glm::mat3x3(glm::abs(vec3(instanceMatrix[0])), glm::abs(vec3(instanceMatrix[1])), glm::abs(vec3(instanceMatrix[2])));
-                    vec3 transformedExtents = absMatrix * extents;
-
-                    // Transform to min/max box representation
-                    cmodelAABB.center = transformedCenter;
-                    cmodelAABB.extents = transformedExtents;
-                }
+                Geometry::AABoundingBox cmodelAABB = TransformAABB(loadedComplexModel.collisionAABB, instanceMatrix);
 
                 if (!Intersect_AABB_AABB(srcAABB, cmodelAABB))
                 {
                     f32 t = 0;
                     if (!Intersect_AABB_SWEEP(srcAABB, cmodelAABB, velocityThisFrame, t))
-                        continue;
+                        return;
                 }
 
-                debugRenderer->DrawAABB3D(cmodelAABB.center, cmodelAABB.extents, 0xff00ff00);
+                if (drawCollision)
+                {
+                    debugRenderer->DrawAABB3D(cmodelAABB.center, cmodelAABB.extents, 0xff00ff00);
+                }
 
-                u32 triangleOffset = loadedComplexModel.collisionTriangleOffset;
-                u32 numTriangles = loadedComplexModel.numCollisionTriangles;
+                SweepAABBAgainstCModel(srcAABB, velocityThisFrame, loadedComplexModel, instanceMatrix, collisionTriangles, useBVH, closestHit);
+            };
+
+            {
+                std::scoped_lock lock(broadphase->mutex);
 
-                for (u32 j = 0; j < numTriangles; j++)
+                if (broadphase->isDirty.exchange(false))
                 {
-                    u32 triangleID = j + triangleOffset;
-                    const Geometry::Triangle& triangle = collisionTriangles[triangleID];
+                    RebuildCollisionBroadphase(*broadphase, collidableEntities, registry, loadedComplexModels, cmodelInstanceDatas, cmodelInstanceMatrices);
+                }
+
+                if (useBVH)
+                {
+                    Geometry::AABoundingBox sweptAABB = GetSweptAABB(srcAABB, velocityThisFrame);
+
+                    vec3 min = sweptAABB.center - sweptAABB.extents;
+                    vec3 max = sweptAABB.center + sweptAABB.extents;
 
-                    Geometry::Triangle transformedTriangle;
+                    broadphase->staticBVH.Query(min, max, [&](u32 staticIndex)
                     {
-                        // Transform Triangle using Instance Matrix
-                        transformedTriangle.vert1 = vec3(instanceMatrix * vec4(triangle.vert1, 1.0f));
-                        transformedTriangle.vert2 = vec3(instanceMatrix * vec4(triangle.vert2, 1.0f));
-                        transformedTriangle.vert3 = vec3(instanceMatrix * vec4(triangle.vert3, 1.0f));
-
-                        // Transform Triangle making it relative to srcAABB
-                        transformedTriangle.vert1 -= srcAABB.center;
-                        transformedTriangle.vert2 -= srcAABB.center;
-                        transformedTriangle.vert3 -= srcAABB.center;
-                    }
+                        sweepInstance(broadphase->staticEntities[staticIndex]);
+                    });
 
-                    f32 tmpTimeToCollision = 0;
-                    if (Intersect_AABB_TRIANGLE_SWEEP(srcAABB.extents, transformedTriangle, velocityThisFrame, 1.0f, tmpTimeToCollision, true))
+                    for (entt::entity entityID : broadphase->dynamicEntities)
                     {
-                        if (tmpTimeToCollision < timeToCollide)
-                        {
-                            timeToCollide = tmpTimeToCollision;
-                            closestTriangle = triangle;
-                            closestTransformedTriangle = transformedTriangle;
-                        }
+                        sweepInstance(entityID);
+                    }
+                }
+                else
+                {
+                    for (entt::entity entityID : collidableEntities)
+                    {
+                        sweepInstance(entityID);
                     }
                 }
             }
 
+            timeToCollide = closestHit.timeToCollide;
+
             if (timeToCollide != std::numeric_limits<f32>().max())
             {
                 //timeToCollide -= std::numeric_limits<f32>().epsilon();
                 timeToCollide = glm::clamp(timeToCollide, 0.0f, 1.0f);
 
-                triangleNormal = closestTriangle.GetCollisionNormal();
-                triangleAngle = closestTriangle.GetCollisionSteepnessAngle();
+                triangleNormal = closestHit.triangle.GetCollisionNormal();
+                triangleAngle = closestHit.triangle.GetCollisionSteepnessAngle();
+
+                if (drawCollision)
+                {
+                    Geometry::Triangle closestTransformedTriangle = closestHit.transformedTriangle;
+                    closestTransformedTriangle.vert1 += srcAABB.center;
+                    closestTransformedTriangle.vert2 += srcAABB.center;
+                    closestTransformedTriangle.vert3 += srcAABB.center;
+
+                    debugRenderer->DrawLine3D(closestTransformedTriangle.vert1, closestTransformedTriangle.vert2, 0xff0000ff);
+                    debugRenderer->DrawLine3D(closestTransformedTriangle.vert2, closestTransformedTriangle.vert3, 0xff0000ff);
+                    debugRenderer->DrawLine3D(closestTransformedTriangle.vert3, closestTransformedTriangle.vert1, 0xff0000ff);
+                }
+            }
+        }
+
+        return timeToCollide != std::numeric_limits<f32>().max();
+    }
+
+    bool BenchmarkCModelSweeps(u32 numQueries, CModelSweepBenchmarkResult& result)
+    {
+        ClientRenderer* clientRenderer = ServiceLocator::GetClientRenderer();
+        CModelRenderer* cmodelRenderer = clientRenderer->GetCModelRenderer();
+
+        SafeVectorScopedReadLock<CModelRenderer::LoadedComplexModel> loadedComplexModelsReadLock(cmodelRenderer->GetLoadedComplexModels());
+        SafeVectorScopedReadLock<CModelRenderer::ModelInstanceData> cmodelInstanceDatasReadLock(cmodelRenderer->GetModelInstanceDatas());
+        SafeVectorScopedReadLock<mat4x4> cmodelInstanceMatricesReadLock(cmodelRenderer->GetModelInstanceMatrices());
+        SafeVectorScopedReadLock<Geometry::Triangle> collisionTriangleListReadLock(cmodelRenderer->GetCollisionTriangles());
+
+        const std::vector<CModelRenderer::LoadedComplexModel>& loadedComplexModels = loadedComplexModelsReadLock.Get();
+        const std::vector<CModelRenderer::ModelInstanceData>& cmodelInstanceDatas = cmodelInstanceDatasReadLock.Get();
+        const std::vector<mat4x4>& cmodelInstanceMatrices = cmodelInstanceMatricesReadLock.Get();
+        const std::vector<Geometry::Triangle>& collisionTriangles = collisionTriangleListReadLock.Get();
+
+        // Every loaded instance with a collision mesh is a candidate
+        std::vector<u32> instanceIDs;
+        for (u32 i = 0; i < cmodelInstanceDatas.size(); i++)
+        {
+            const CModelRenderer::LoadedComplexModel& loadedComplexModel = loadedComplexModels[cmodelInstanceDatas[i].modelID];
+            if (loadedComplexModel.numCollisionTriangles > 0)
+                instanceIDs.push_back(i);
+        }
+
+        result = CModelSweepBenchmarkResult();
+        result.numInstances = static_cast<u32>(instanceIDs.size());
+
+        if (instanceIDs.empty() || numQueries == 0)
+            return false;
+
+        struct SweepQuery
+        {
+            u32 instanceID;
+            Geometry::AABoundingBox aabb;
+            vec3 velocity;
+        };
+
+        // Fixed seed so runs are comparable, a roughly character sized box is swept from somewhere around the instance
+        std::mt19937 randomEngine(1337);
+        std::uniform_real_distribution<f32> unitDistribution(-1.0f, 1.0f);
+
+        std::vector<SweepQuery> sweepQueries(numQueries);
+        for (SweepQuery& sweepQuery : sweepQueries)
+        {
+            sweepQuery.instanceID = instanceIDs[randomEngine() % instanceIDs.size()];
 
-                closestTransformedTriangle.vert1 += srcAABB.center;
-                closestTransformedTriangle.vert2 += srcAABB.center;
-                closestTransformedTriangle.vert3 += srcAABB.center;
+            const CModelRenderer::LoadedComplexModel& loadedComplexModel = loadedComplexModels[cmodelInstanceDatas[sweepQuery.instanceID].modelID];
+            Geometry::AABoundingBox instanceAABB = TransformAABB(loadedComplexModel.collisionAABB, cmodelInstanceMatrices[sweepQuery.instanceID]);
 
-                debugRenderer->DrawLine3D(closestTransformedTriangle.vert1, closestTransformedTriangle.vert2, 0xff0000ff);
-                debugRenderer->DrawLine3D(closestTransformedTriangle.vert2, closestTransformedTriangle.vert3, 0xff0000ff);
-                debugRenderer->DrawLine3D(closestTransformedTriangle.vert3, closestTransformedTriangle.vert1, 0xff0000ff);
+            vec3 offset = vec3(unitDistribution(randomEngine), unitDistribution(randomEngine), unitDistribution(randomEngine));
+            vec3 direction = vec3(unitDistribution(randomEngine), unitDistribution(randomEngine), unitDistribution(randomEngine));
 
+            sweepQuery.aabb.center = instanceAABB.center + offset * (instanceAABB.extents + 2.0f);
+            sweepQuery.aabb.extents = vec3(0.5f, 0.5f, 1.0f);
+            sweepQuery.velocity = direction * 2.0f;
+        }
+
+        std::vector<f32> bruteForceTimes(numQueries);
+        std::vector<f32> bvhTimes(numQueries);
+
+        for (u32 pass = 0; pass < 2; pass++)
+        {
+            bool useBVH = pass == 1;
+            std::vector<f32>& timesToCollide = useBVH ? bvhTimes : bruteForceTimes;
+
+            Timer timer;
+            for (u32 i = 0; i < numQueries; i++)
+            {
+                const SweepQuery& sweepQuery = sweepQueries[i];
+                const CModelRenderer::LoadedComplexModel& loadedComplexModel = loadedComplexModels[cmodelInstanceDatas[sweepQuery.instanceID].modelID];
+
+                CModelSweepHit hit;
+                SweepAABBAgainstCModel(sweepQuery.aabb, sweepQuery.velocity, loadedComplexModel, cmodelInstanceMatrices[sweepQuery.instanceID], collisionTriangles, useBVH, hit);
+
+                timesToCollide[i] = hit.timeToCollide;
             }
+
+            f32 timeMS = timer.GetLifeTime() * 1000.0f;
+            if (useBVH)
+                result.bvhTimeMS = timeMS;
+            else
+                result.bruteForceTimeMS = timeMS;
         }
 
-        return timeToCollide != std::numeric_limits<f32>().max();
+        result.numQueries = numQueries;
+        for (u32 i = 0; i < numQueries; i++)
+        {
+            if (bruteForceTimes[i] != std::numeric_limits<f32>().max())
+                result.numHits++;
+
+            if (bruteForceTimes[i] != bvhTimes[i])
+                result.numMismatches++;
+        }
+
+        return true;
     }
 #pragma warning(pop)
 }
\ No newline at end of file
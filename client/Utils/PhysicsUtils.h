@@ -17,6 +17,48 @@ struct CModelInfo;
 
 namespace PhysicsUtils
 {
+    // Up to MAX_TRIANGLES triangles in structure of arrays layout, tested together by Intersect_AABB_TRIANGLE_SWEEP_BATCH
+    // Like Intersect_AABB_TRIANGLE_SWEEP the triangles are expected to be relative to the center of the swept box
+    struct TriangleSweepBatch
+    {
+        static constexpr u32 MAX_TRIANGLES = 8;
+
+        // The slots past numTriangles are still loaded by the SIMD kernel, they are zero initialized and masked out of the result
+
+        void Add(const Geometry::Triangle& triangle, u32 triangleIndex);
+        void Clear() { numTriangles = 0; }
+
+        bool IsEmpty() const { return numTriangles == 0; }
+        bool IsFull() const { return numTriangles == MAX_TRIANGLES; }
+
+        alignas(32) f32 vert1X[MAX_TRIANGLES] = {};
+        alignas(32) f32 vert1Y[MAX_TRIANGLES] = {};
+        alignas(32) f32 vert1Z[MAX_TRIANGLES] = {};
+        alignas(32) f32 vert2X[MAX_TRIANGLES] = {};
+        alignas(32) f32 vert2Y[MAX_TRIANGLES] = {};
+        alignas(32) f32 vert2Z[MAX_TRIANGLES] = {};
+        alignas(32) f32 vert3X[MAX_TRIANGLES] = {};
+        alignas(32) f32 vert3Y[MAX_TRIANGLES] = {};
+        alignas(32) f32 vert3Z[MAX_TRIANGLES] = {};
+        alignas(32) f32 normalX[MAX_TRIANGLES] = {}; // GetCollisionNormal() of the triangle, computed once when it is added
+        alignas(32) f32 normalY[MAX_TRIANGLES] = {};
+        alignas(32) f32 normalZ[MAX_TRIANGLES] = {};
+
+        u32 triangleIndices[MAX_TRIANGLES] = {}; // Whatever index the caller wants back for the triangle that was hit
+        u32 numTriangles = 0;
+    };
+
+    struct CModelSweepBenchmarkResult
+    {
+        u32 numInstances = 0;
+        u32 numQueries = 0;
+        u32 numHits = 0;
+        u32 numMismatches = 0; // Queries where the brute force and BVH sweep disagree, should always be 0
+
+        f32 bruteForceTimeMS = 0.0f;
+        f32 bvhTimeMS = 0.0f;
+    };
+
     void Project(const vec3& vertex, const vec3& axis, vec2& minMax);
     void ProjectTriangle(const Geometry::Triangle& triangle, const vec3& axis, vec2& minMax);
     void ProjectBox(const Geometry::AABoundingBox& box, const vec3& axis, vec2& minMax);
@@ -28,6 +70,8 @@ namespace PhysicsUtils
 
     bool Intersect_AABB_TRIANGLE(const Geometry::AABoundingBox& box, const Geometry::Triangle& triangle);
     bool Intersect_AABB_TRIANGLE_SWEEP(const vec3& boxScale, const Geometry::Triangle& triangle, const vec3& dir, f32 maxDist, f32& outDistToCollision, bool backFaceCulling);
+    // Returns the earliest hit of the batch (the lowest slot wins ties), results are bit identical to calling Intersect_AABB_TRIANGLE_SWEEP on each triangle
+    bool Intersect_AABB_TRIANGLE_SWEEP_BATCH(const vec3& boxScale, const TriangleSweepBatch& batch, const vec3& dir, f32 maxDist, bool backFaceCulling, f32& outDistToCollision, u32& outTriangleIndex);
     bool Intersect_AABB_TERRAIN(const vec3& position, const Geometry::AABoundingBox& box, Geometry::Triangle& triangle, f32& height);
     bool Intersect_AABB_TERRAIN_SWEEP(const Geometry::AABoundingBox& box, Geometry::Triangle& triangle, const vec3& direction, f32& height, f32 maxDist, f32& outTimeToCollide);
     bool Intersect_AABB_AABB(const Geometry::AABoundingBox& a, const Geometry::AABoundingBox& b);
@@ -35,4 +79,11 @@ namespace PhysicsUtils
     bool Intersect_SPHERE_TRIANGLE(const vec3& spherePos, const f32 sphereRadius, const Geometry::Triangle& triangle);
 
     bool CheckCollisionForCModels(Terrain::Map& currentMap, const Movement& srcTransform, const CModelInfo& srcCModelInfo, vec3& triangleNormal, f32& triangleAngle, f32& timeToCollide);
+
+    // Sweeps boxes against random loaded complex model instances, once by testing every collision triangle and once through the model BVH
+    bool BenchmarkCModelSweeps(u32 numQueries, CModelSweepBenchmarkResult& result);
+
+    // Compares Intersect_AABB_TRIANGLE_SWEEP_BATCH against the scalar Intersect_AABB_TRIANGLE_SWEEP on random batches, returns the number of batches that did not match bit for bit
+    u32 ValidateTriangleSweepBatch(u32 numBatches, f32& outScalarTimeMS, f32& outBatchTimeMS);
+    const char* GetTriangleSweepBatchPath();
 }
\ No newline at end of file
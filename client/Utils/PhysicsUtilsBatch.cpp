@@ -0,0 +1,487 @@
+#include "PhysicsUtils.h"
+
+#include <Math/Geometry.h>
+#include <Utils/Timer.h>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <random>
+
+// AVX2 is only used when the whole project is built for it (/arch:AVX2 or -mavx2), SSE2 is part of every x64 target
+#if defined(__AVX2__)
+#define PHYSICS_SWEEP_BATCH_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHYSICS_SWEEP_BATCH_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace PhysicsUtils
+{
+    void TriangleSweepBatch::Add(const Geometry::Triangle& triangle, u32 triangleIndex)
+    {
+        assert(numTriangles < MAX_TRIANGLES);
+        u32 slot = numTriangles++;
+
+        vert1X[slot] = triangle.vert1.x;
+        vert1Y[slot] = triangle.vert1.y;
+        vert1Z[slot] = triangle.vert1.z;
+        vert2X[slot] = triangle.vert2.x;
+        vert2Y[slot] = triangle.vert2.y;
+        vert2Z[slot] = triangle.vert2.z;
+        vert3X[slot] = triangle.vert3.x;
+        vert3Y[slot] = triangle.vert3.y;
+        vert3Z[slot] = triangle.vert3.z;
+
+        vec3 normal = triangle.GetCollisionNormal();
+        normalX[slot] = normal.x;
+        normalY[slot] = normal.y;
+        normalZ[slot] = normal.z;
+
+        triangleIndices[slot] = triangleIndex;
+    }
+
+    static Geometry::Triangle GetBatchTriangle(const TriangleSweepBatch& batch, u32 slot)
+    {
+        Geometry::Triangle triangle;
+        triangle.vert1 = vec3(batch.vert1X[slot], batch.vert1Y[slot], batch.vert1Z[slot]);
+        triangle.vert2 = vec3(batch.vert2X[slot], batch.vert2Y[slot], batch.vert2Z[slot]);
+        triangle.vert3 = vec3(batch.vert3X[slot], batch.vert3Y[slot], batch.vert3Z[slot]);
+
+        return triangle;
+    }
+
+    // The reference, and the fallback for targets without SSE2
+    static bool SweepBatchScalar(const vec3& boxScale, const TriangleSweepBatch& batch, const vec3& dir, f32 maxDist, bool backFaceCulling, f32& outDistToCollision, u32& outTriangleIndex)
+    {
+        bool didHit = false;
+
+        for (u32 i = 0; i < batch.numTriangles; i++)
+        {
+            f32 distToCollision = 0.0f;
+            if (!Intersect_AABB_TRIANGLE_SWEEP(boxScale, GetBatchTriangle(batch, i), dir, maxDist, distToCollision, backFaceCulling))
+                continue;
+
+            if (!didHit || distToCollision < outDistToCollision)
+            {
+                didHit = true;
+                outDistToCollision = distToCollision;
+                outTriangleIndex = batch.triangleIndices[i];
+            }
+        }
+
+        return didHit;
+    }
+
+#if defined(PHYSICS_SWEEP_BATCH_AVX2) || defined(PHYSICS_SWEEP_BATCH_SSE2)
+    // Thin wrappers so the kernel below is written once for both widths.
+    // Min, Max and Abs follow glm's scalar definitions exactly (including which operand wins for equal values and NaN),
+    // this together with doing every operation in the same order as the scalar code is what keeps the results bit identical
+#if defined(PHYSICS_SWEEP_BATCH_AVX2)
+    struct SweepLanes
+    {
+        static constexpr u32 WIDTH = 8;
+        using Float = __m256;
+
+        static Float Load(const f32* src) { return _mm256_load_ps(src); }
+        static void Store(f32* dst, Float a) { _mm256_store_ps(dst, a); }
+        static Float Set(f32 value) { return _mm256_set1_ps(value); }
+        static Float AllOnes() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+
+        static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+        static Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+        static Float Neg(Float a) { return _mm256_xor_ps(a, Set(-0.0f)); }
+
+        static Float And(Float a, Float b) { return _mm256_and_ps(a, b); }
+        static Float Or(Float a, Float b) { return _mm256_or_ps(a, b); }
+        static Float AndNot(Float a, Float b) { return _mm256_andnot_ps(a, b); } // ~a & b
+        static Float Select(Float mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+
+        static Float Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static Float LessEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        static Float Greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static Float GreaterEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static u32 MoveMask(Float mask) { return static_cast<u32>(_mm256_movemask_ps(mask)); }
+
+        static Float Min(Float a, Float b) { return _mm256_min_ps(b, a); } // glm::min(a, b) is (b < a) ? b : a
+        static Float Max(Float a, Float b) { return _mm256_max_ps(b, a); } // glm::max(a, b) is (a < b) ? b : a
+        static Float Abs(Float a) { return Select(GreaterEqual(a, Set(0.0f)), a, Neg(a)); } // glm::abs(a) is a >= 0 ? a : -a
+    };
+#else
+    struct SweepLanes
+    {
+        static constexpr u32 WIDTH = 4;
+        using Float = __m128;
+
+        static Float Load(const f32* src) { return _mm_load_ps(src); }
+        static void Store(f32* dst, Float a) { _mm_store_ps(dst, a); }
+        static Float Set(f32 value) { return _mm_set1_ps(value); }
+        static Float AllOnes() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+
+        static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+        static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+        static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+        static Float Div(Float a, Float b) { return _mm_div_ps(a, b); }
+        static Float Neg(Float a) { return _mm_xor_ps(a, Set(-0.0f)); }
+
+        static Float And(Float a, Float b) { return _mm_and_ps(a, b); }
+        static Float Or(Float a, Float b) { return _mm_or_ps(a, b); }
+        static Float AndNot(Float a, Float b) { return _mm_andnot_ps(a, b); } // ~a & b
+        static Float Select(Float mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+        static Float Less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+        static Float LessEqual(Float a, Float b) { return _mm_cmple_ps(a, b); }
+        static Float Greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+        static Float GreaterEqual(Float a, Float b) { return _mm_cmpge_ps(a, b); }
+        static u32 MoveMask(Float mask) { return static_cast<u32>(_mm_movemask_ps(mask)); }
+
+        static Float Min(Float a, Float b) { return _mm_min_ps(b, a); } // glm::min(a, b) is (b < a) ? b : a
+        static Float Max(Float a, Float b) { return _mm_max_ps(b, a); } // glm::max(a, b) is (a < b) ? b : a
+        static Float Abs(Float a) { return Select(GreaterEqual(a, Set(0.0f)), a, Neg(a)); } // glm::abs(a) is a >= 0 ? a : -a
+    };
+#endif
+
+    // Runs TestSeperationAxes for WIDTH triangles starting at offset, a lane that fails a test is dead but keeps being computed.
+    // Returns a bitmask of the lanes that hit, their distance is written to outDists
+    static u32 SweepLanesSIMD(const vec3& boxScale, const TriangleSweepBatch& batch, u32 offset, const vec3& dir, const vec3& oneOverDir, f32 maxDist, bool backFaceCulling, f32* outDists)
+    {
+        using L = SweepLanes;
+        using Float = L::Float;
+
+        const Float zero = L::Set(0.0f);
+        const Float allOnes = L::AllOnes();
+
+        const Float v1X = L::Load(&batch.vert1X[offset]);
+        const Float v1Y = L::Load(&batch.vert1Y[offset]);
+        const Float v1Z = L::Load(&batch.vert1Z[offset]);
+        const Float v2X = L::Load(&batch.vert2X[offset]);
+        const Float v2Y = L::Load(&batch.vert2Y[offset]);
+        const Float v2Z = L::Load(&batch.vert2Z[offset]);
+        const Float v3X = L::Load(&batch.vert3X[offset]);
+        const Float v3Y = L::Load(&batch.vert3Y[offset]);
+        const Float v3Z = L::Load(&batch.vert3Z[offset]);
+        const Float normalX = L::Load(&batch.normalX[offset]);
+        const Float normalY = L::Load(&batch.normalY[offset]);
+        const Float normalZ = L::Load(&batch.normalZ[offset]);
+
+        const Float boxX = L::Set(boxScale.x);
+        const Float boxY = L::Set(boxScale.y);
+        const Float boxZ = L::Set(boxScale.z);
+        const Float dirX = L::Set(dir.x);
+        const Float dirY = L::Set(dir.y);
+        const Float dirZ = L::Set(dir.z);
+
+        Float alive = allOnes;
+
+        if (backFaceCulling)
+        {
+            Float normalDotDir = L::Add(L::Add(L::Mul(normalX, dirX), L::Mul(normalY, dirY)), L::Mul(normalZ, dirZ));
+            alive = L::AndNot(L::LessEqual(normalDotDir, zero), alive);
+
+            if (L::MoveMask(alive) == 0)
+                return 0;
+        }
+
+        Float validMTD = allOnes;
+        Float tFirst = L::Set(-std::numeric_limits<f32>().max());
+        Float tLast = L::Set(std::numeric_limits<f32>().max());
+
+        // TestAxis, lanes where enabled is not set skip the axis entirely
+        auto testAxis = [&](Float axisX, Float axisY, Float axisZ, Float enabled)
+        {
+            Float d0t = L::Add(L::Add(L::Mul(v1X, axisX), L::Mul(v1Y, axisY)), L::Mul(v1Z, axisZ));
+            Float d1t = L::Add(L::Add(L::Mul(v2X, axisX), L::Mul(v2Y, axisY)), L::Mul(v2Z, axisZ));
+            Float d2t = L::Add(L::Add(L::Mul(v3X, axisX), L::Mul(v3Y, axisY)), L::Mul(v3Z, axisZ));
+
+            Float triMin = L::Min(d0t, d1t);
+            Float triMax = L::Max(d0t, d1t);
+
+            triMin = L::Min(triMin, d2t);
+            triMax = L::Max(triMax, d2t);
+
+            Float boxExt = L::Add(L::Add(L::Mul(L::Abs(axisX), boxX), L::Mul(L::Abs(axisY), boxY)), L::Mul(L::Abs(axisZ), boxZ));
+
+            // TestOverlap
+            Float d0 = L::Sub(L::Neg(boxExt), triMax);
+            Float d1 = L::Sub(boxExt, triMin);
+            Float intersects = L::And(L::LessEqual(d0, zero), L::GreaterEqual(d1, zero));
+            validMTD = L::Select(enabled, L::And(validMTD, intersects), validMTD);
+
+            Float v = L::Add(L::Add(L::Mul(dirX, axisX), L::Mul(dirY, axisY)), L::Mul(dirZ, axisZ));
+            Float isParallel = L::Less(L::Abs(v), L::Set(1.0E-6f));
+
+            Float oneOverV = L::Div(L::Set(-1.0f), v);
+            Float t0_ = L::Mul(d0, oneOverV);
+            Float t1_ = L::Mul(d1, oneOverV);
+
+            Float t0 = L::Min(t0_, t1_);
+            Float t1 = L::Max(t0_, t1_);
+
+            Float separated = L::Or(L::Greater(t0, tLast), L::Less(t1, tFirst));
+            Float passed = L::Select(isParallel, intersects, L::AndNot(separated, allOnes));
+
+            Float update = L::AndNot(isParallel, enabled);
+            tLast = L::Select(update, L::Min(t1, tLast), tLast);
+            tFirst = L::Select(update, L::Max(t0, tFirst), tFirst);
+
+            alive = L::And(alive, L::Or(passed, L::AndNot(enabled, allOnes)));
+        };
+
+        // TestAxisXYZ, the axis is the same for every lane
+        auto testAxisXYZ = [&](Float d0t, Float d1t, Float d2t, f32 boxExtent, f32 dirComponent, f32 oneOverDirComponent)
+        {
+            Float triMin = L::Min(d0t, d1t);
+            Float triMax = L::Max(d0t, d1t);
+
+            triMin = L::Min(triMin, d2t);
+            triMax = L::Max(triMax, d2t);
+
+            Float boxExt = L::Set(boxExtent);
+
+            Float d0 = L::Sub(L::Neg(boxExt), triMax);
+            Float d1 = L::Sub(boxExt, triMin);
+            Float intersects = L::And(L::LessEqual(d0, zero), L::GreaterEqual(d1, zero));
+            validMTD = L::And(validMTD, intersects);
+
+            if (glm::abs(dirComponent) < 1.0E-6f)
+            {
+                alive = L::And(alive, intersects);
+                return;
+            }
+
+            Float oneOverV = L::Set(-oneOverDirComponent);
+            Float t0_ = L::Mul(d0, oneOverV);
+            Float t1_ = L::Mul(d1, oneOverV);
+
+            Float t0 = L::Min(t0_, t1_);
+            Float t1 = L::Max(t0_, t1_);
+
+            Float separated = L::Or(L::Greater(t0, tLast), L::Less(t1, tFirst));
+            alive = L::AndNot(separated, alive);
+
+            tLast = L::Min(t1, tLast);
+            tFirst = L::Max(t0, tFirst);
+        };
+
+        // Test Triangle Normal
+        testAxis(normalX, normalY, normalZ, allOnes);
+        if (L::MoveMask(alive) == 0)
+            return 0;
+
+        // Test Box Normals
+        testAxisXYZ(v1X, v2X, v3X, boxScale.x, dir.x, oneOverDir.x);
+        testAxisXYZ(v1Y, v2Y, v3Y, boxScale.y, dir.y, oneOverDir.y);
+        testAxisXYZ(v1Z, v2Z, v3Z, boxScale.z, dir.z, oneOverDir.z);
+        if (L::MoveMask(alive) == 0)
+            return 0;
+
+        // Test the triangle edges crossed with the box normals
+        const Float edgesX[3] = { L::Sub(v2X, v1X), L::Sub(v3X, v2X), L::Sub(v1X, v3X) };
+        const Float edgesY[3] = { L::Sub(v2Y, v1Y), L::Sub(v3Y, v2Y), L::Sub(v1Y, v3Y) };
+        const Float edgesZ[3] = { L::Sub(v2Z, v1Z), L::Sub(v3Z, v2Z), L::Sub(v1Z, v3Z) };
+
+        const Float minSeparationLength = L::Set(1.0E-6f);
+
+        for (u32 i = 0; i < 3; i++)
+        {
+            const Float& edgeX = edgesX[i];
+            const Float& edgeY = edgesY[i];
+            const Float& edgeZ = edgesZ[i];
+
+            {
+                // Cross100
+                Float sepX = zero;
+                Float sepY = L::Neg(edgeZ);
+                Float sepZ = edgeY;
+
+                Float sepLength = L::Add(L::Add(L::Mul(sepX, sepX), L::Mul(sepY, sepY)), L::Mul(sepZ, sepZ));
+                testAxis(sepX, sepY, sepZ, L::GreaterEqual(sepLength, minSeparationLength));
+            }
+
+            {
+                // Cross010
+                Float sepX = edgeZ;
+                Float sepY = zero;
+                Float sepZ = L::Neg(edgeX);
+
+                Float sepLength = L::Add(L::Add(L::Mul(sepX, sepX), L::Mul(sepY, sepY)), L::Mul(sepZ, sepZ));
+                testAxis(sepX, sepY, sepZ, L::GreaterEqual(sepLength, minSeparationLength));
+            }
+
+            {
+                // Cross001
+                Float sepX = L::Neg(edgeY);
+                Float sepY = edgeX;
+                Float sepZ = zero;
+
+                Float sepLength = L::Add(L::Add(L::Mul(sepX, sepX), L::Mul(sepY, sepY)), L::Mul(sepZ, sepZ));
+                testAxis(sepX, sepY, sepZ, L::GreaterEqual(sepLength, minSeparationLength));
+            }
+
+            if (L::MoveMask(alive) == 0)
+                return 0;
+        }
+
+        Float outOfRange = L::Or(L::Greater(tFirst, L::Set(maxDist)), L::Less(tLast, zero));
+        alive = L::AndNot(outOfRange, alive);
+
+        Float isTouching = L::LessEqual(tFirst, zero);
+        alive = L::AndNot(L::AndNot(validMTD, isTouching), alive);
+
+        L::Store(outDists, L::Select(isTouching, zero, tFirst));
+        return L::MoveMask(alive);
+    }
+#endif
+
+    bool Intersect_AABB_TRIANGLE_SWEEP_BATCH(const vec3& boxScale, const TriangleSweepBatch& batch, const vec3& dir, f32 maxDist, bool backFaceCulling, f32& outDistToCollision, u32& outTriangleIndex)
+    {
+        if (batch.numTriangles == 0)
+            return false;
+
+#if defined(PHYSICS_SWEEP_BATCH_AVX2) || defined(PHYSICS_SWEEP_BATCH_SSE2)
+        const vec3 oneOverDir = 1.0f / dir;
+
+        alignas(32) f32 dists[TriangleSweepBatch::MAX_TRIANGLES];
+        bool didHit = false;
+
+        for (u32 offset = 0; offset < batch.numTriangles; offset += SweepLanes::WIDTH)
+        {
+            u32 numLanes = glm::min(SweepLanes::WIDTH, batch.numTriangles - offset);
+            u32 hitMask = SweepLanesSIMD(boxScale, batch, offset, dir, oneOverDir, maxDist, backFaceCulling, &dists[offset]);
+            hitMask &= (1u << numLanes) - 1;
+
+            // Lowest slot first, so ties resolve the same way as testing the triangles one by one
+            for (u32 lane = 0; lane < numLanes; lane++)
+            {
+                if ((hitMask & (1u << lane)) == 0)
+                    continue;
+
+                u32 slot = offset + lane;
+                if (!didHit || dists[slot] < outDistToCollision)
+                {
+                    didHit = true;
+                    outDistToCollision = dists[slot];
+                    outTriangleIndex = batch.triangleIndices[slot];
+                }
+            }
+        }
+
+        return didHit;
+#else
+        return SweepBatchScalar(boxScale, batch, dir, maxDist, backFaceCulling, outDistToCollision, outTriangleIndex);
+#endif
+    }
+
+    const char* GetTriangleSweepBatchPath()
+    {
+#if defined(PHYSICS_SWEEP_BATCH_AVX2)
+        return "AVX2";
+#elif defined(PHYSICS_SWEEP_BATCH_SSE2)
+        return "SSE2";
+#else
+        return "Scalar";
+#endif
+    }
+
+    u32 ValidateTriangleSweepBatch(u32 numBatches, f32& outScalarTimeMS, f32& outBatchTimeMS)
+    {
+        struct SweepCase
+        {
+            TriangleSweepBatch batch;
+            vec3 boxScale;
+            vec3 dir;
+            f32 maxDist;
+            bool backFaceCulling;
+        };
+
+        // Fixed seed so a mismatch can be reproduced
+        std::mt19937 randomEngine(1337);
+        std::uniform_real_distribution<f32> positionDistribution(-3.0f, 3.0f);
+        std::uniform_real_distribution<f32> scaleDistribution(0.1f, 1.5f);
+        std::uniform_real_distribution<f32> dirDistribution(-4.0f, 4.0f);
+
+        std::vector<SweepCase> sweepCases(numBatches);
+        for (SweepCase& sweepCase : sweepCases)
+        {
+            sweepCase.boxScale = vec3(scaleDistribution(randomEngine), scaleDistribution(randomEngine), scaleDistribution(randomEngine));
+            sweepCase.dir = vec3(dirDistribution(randomEngine), dirDistribution(randomEngine), dirDistribution(randomEngine));
+            sweepCase.maxDist = (randomEngine() % 2) ? 1.0f : 0.5f;
+            sweepCase.backFaceCulling = randomEngine() % 2;
+
+            // Axis aligned sweeps take the parallel paths in TestAxis and TestAxisXYZ
+            for (u32 i = 0; i < 3; i++)
+            {
+                if (randomEngine() % 8 == 0)
+                    sweepCase.dir[i] = 0.0f;
+            }
+
+            u32 numTriangles = 1 + (randomEngine() % TriangleSweepBatch::MAX_TRIANGLES);
+            for (u32 i = 0; i < numTriangles; i++)
+            {
+                Geometry::Triangle triangle;
+                triangle.vert1 = vec3(positionDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine));
+                triangle.vert2 = vec3(positionDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine));
+                triangle.vert3 = vec3(positionDistribution(randomEngine), positionDistribution(randomEngine), positionDistribution(randomEngine));
+
+                // Flat triangles give edges where some of the cross product axes are skipped
+                if (randomEngine() % 8 == 0)
+                {
+                    triangle.vert2.y = triangle.vert1.y;
+                    triangle.vert3.y = triangle.vert1.y;
+                }
+
+                sweepCase.batch.Add(triangle, i);
+            }
+        }
+
+        struct SweepResult
+        {
+            bool didHit = false;
+            f32 distToCollision = 0.0f;
+            u32 triangleIndex = 0;
+        };
+
+        std::vector<SweepResult> scalarResults(numBatches);
+        std::vector<SweepResult> batchResults(numBatches);
+
+        Timer scalarTimer;
+        for (u32 i = 0; i < numBatches; i++)
+        {
+            const SweepCase& sweepCase = sweepCases[i];
+            SweepResult& result = scalarResults[i];
+
+            result.didHit = SweepBatchScalar(sweepCase.boxScale, sweepCase.batch, sweepCase.dir, sweepCase.maxDist, sweepCase.backFaceCulling, result.distToCollision, result.triangleIndex);
+        }
+        outScalarTimeMS = scalarTimer.GetLifeTime() * 1000.0f;
+
+        Timer batchTimer;
+        for (u32 i = 0; i < numBatches; i++)
+        {
+            const SweepCase& sweepCase = sweepCases[i];
+            SweepResult& result = batchResults[i];
+
+            result.didHit = Intersect_AABB_TRIANGLE_SWEEP_BATCH(sweepCase.boxScale, sweepCase.batch, sweepCase.dir, sweepCase.maxDist, sweepCase.backFaceCulling, result.distToCollision, result.triangleIndex);
+        }
+        outBatchTimeMS = batchTimer.GetLifeTime() * 1000.0f;
+
+        u32 numMismatches = 0;
+        for (u32 i = 0; i < numBatches; i++)
+        {
+            const SweepResult& scalarResult = scalarResults[i];
+            const SweepResult& batchResult = batchResults[i];
+
+            bool matches = scalarResult.didHit == batchResult.didHit;
+            if (matches && scalarResult.didHit)
+            {
+                matches = memcmp(&scalarResult.distToCollision, &batchResult.distToCollision, sizeof(f32)) == 0 && scalarResult.triangleIndex == batchResult.triangleIndex;
+            }
+
+            if (!matches)
+                numMismatches++;
+        }
+
+        return numMismatches;
+    }
+}
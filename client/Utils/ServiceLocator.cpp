@@ -19,6 +19,7 @@ ScriptLoader* ServiceLocator::_scriptLoader = nullptr;
 ScriptAPI* ServiceLocator::_scriptAPI = nullptr;
 AnimationSystem* ServiceLocator::_animationSystem = nullptr;
 GameConsole* ServiceLocator::_gameConsole = nullptr;
+std::shared_ptr<tf::Taskflow::ExecutorType> ServiceLocator::_jobExecutor = nullptr;
 
 moodycamel::ConcurrentQueue<Message>* ServiceLocator::_mainInputQueue = nullptr;
 
@@ -130,3 +131,9 @@ void ServiceLocator::SetGameConsole(GameConsole* gameConsole)
     assert(_gameConsole == nullptr);
     _gameConsole = gameConsole;
 }
+
+void ServiceLocator::SetJobExecutor(std::shared_ptr<tf::Taskflow::ExecutorType> jobExecutor)
+{
+    assert(_jobExecutor == nullptr);
+    _jobExecutor = std::move(jobExecutor);
+}
\ No newline at end of file
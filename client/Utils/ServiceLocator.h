@@ -2,7 +2,9 @@
 #include <Utils/ConcurrentQueue.h>
 #include <Utils/Message.h>
 #include <entity/registry.hpp>
+#include <taskflow/taskflow.hpp>
 #include <cassert>
+#include <memory>
 
 class NetPacketHandler;
 class Window;
@@ -138,6 +140,13 @@ public:
         return _gameConsole;
     }
     static void SetGameConsole(GameConsole* gameConsole);
+    // Per frame parallel work builds its taskflows on this executor instead of starting a thread pool of its own
+    static const std::shared_ptr<tf::Taskflow::ExecutorType>& GetJobExecutor()
+    {
+        assert(_jobExecutor != nullptr);
+        return _jobExecutor;
+    }
+    static void SetJobExecutor(std::shared_ptr<tf::Taskflow::ExecutorType> jobExecutor);
 
 private:
     ServiceLocator() { }
@@ -159,4 +168,5 @@ private:
     static ScriptAPI* _scriptAPI;
     static AnimationSystem* _animationSystem;
     static GameConsole* _gameConsole;
+    static std::shared_ptr<tf::Taskflow::ExecutorType> _jobExecutor;
 };
\ No newline at end of file
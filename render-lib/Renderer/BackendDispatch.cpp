@@ -297,8 +297,8 @@ namespace Renderer
     void BackendDispatch::DrawImgui(Renderer* renderer, CommandListID commandList, const void* data)
     {
         ZoneScopedNC("Imgui Draw", tracy::Color::Red3);
-
-        renderer->DrawImgui(commandList);
+        const Commands::DrawImgui* actualData = static_cast<const Commands::DrawImgui*>(data);
+        renderer->DrawImgui(commandList, actualData->drawData);
     }
 
     void BackendDispatch::PushConstant(Renderer* renderer, CommandListID commandList, const void* data)
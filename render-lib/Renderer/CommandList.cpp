@@ -74,17 +74,19 @@ namespace Renderer
         assert(_markerScope == 0); // We need to pop all markers that we push
 
         CommandListID commandList = _renderer->BeginCommandList();
+        Replay(commandList);
+        _renderer->EndCommandList(commandList);
+#endif
+    }
 
+    void CommandList::Replay(CommandListID commandList)
+    {
+        ZoneScopedNC("Record commandlist", tracy::Color::Red2)
+        // Execute each command
+        for (int i = 0; i < _functions.Count(); i++)
         {
-            ZoneScopedNC("Record commandlist", tracy::Color::Red2)
-            // Execute each command
-            for (int i = 0; i < _functions.Count(); i++)
-            {
-                _functions[i](_renderer, commandList, _data[i]);
-            }
+            _functions[i](_renderer, commandList, _data[i]);
         }
-        _renderer->EndCommandList(commandList);
-#endif
     }
 
     CommandList::CommandList(Renderer* renderer, Memory::Allocator* allocator)
@@ -558,9 +560,11 @@ namespace Renderer
 #endif
     }
 
-    void CommandList::DrawImgui()
+    void CommandList::DrawImgui(ImDrawData* drawData)
     {
+        assert(drawData != nullptr);
         Commands::DrawImgui* command = AddCommand<Commands::DrawImgui>();
+        command->drawData = drawData;
 
 #if COMMANDLIST_DEBUG_IMMEDIATE_MODE
         Commands::DrawImgui::DISPATCH_FUNCTION(_renderer, _immediateCommandList, command);
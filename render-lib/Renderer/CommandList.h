@@ -14,6 +14,8 @@
 #include "Descriptors/ComputePipelineDesc.h"
 #include "Descriptors/SemaphoreDesc.h"
 
+struct ImDrawData;
+
 #define COMMANDLIST_DEBUG_IMMEDIATE_MODE 0 // This makes it easier to debug the renderer by providing better callstacks if it asserts or crashes inside of render-lib
 
 #if TRACY_ENABLE
@@ -99,7 +101,7 @@ namespace Renderer
         void ImageBarrier(ImageID image);
         void ImageBarrier(DepthImageID image);
 
-        void DrawImgui();
+        void DrawImgui(ImDrawData* drawData);
 
         void PushConstant(void* data, u32 offset, u32 size);
 
@@ -107,6 +109,9 @@ namespace Renderer
         // Execute gets friend-called from RenderGraph
         void Execute();
 
+        // Replays the commands into a backend commandlist that is already recording, used to stitch together passes that were recorded into their own CommandLists
+        void Replay(CommandListID commandList);
+
         template<typename Command>
         Command* AddCommand()
         {
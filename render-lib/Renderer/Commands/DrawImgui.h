@@ -1,6 +1,8 @@
 #pragma once
 #include <NovusTypes.h>
 
+struct ImDrawData;
+
 namespace Renderer
 {
     namespace Commands
@@ -8,6 +10,8 @@ namespace Renderer
         struct DrawImgui
         {
             static const BackendDispatchFunction DISPATCH_FUNCTION;
+
+            ImDrawData* drawData = nullptr;
         };
     }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <NovusTypes.h>
 #include <vector>
+#include <functional>
 
 namespace Memory
 {
@@ -14,5 +15,10 @@ namespace Renderer
     struct RenderGraphDesc
     {
         Memory::Allocator* allocator;
+
+        // Optional, when both are set every pass records into its own CommandList from parallelFor and the lists get submitted in graph order afterwards
+        // getPassAllocator has to return a different allocator for every pass index, parallelFor has to call func for every index in [0, count) and return once all of them are done
+        std::function<Memory::Allocator*(u32 passIndex)> getPassAllocator = nullptr;
+        std::function<void(u32 count, const std::function<void(u32)>& func)> parallelFor = nullptr;
     };
 }
\ No newline at end of file
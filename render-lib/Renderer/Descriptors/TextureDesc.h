@@ -22,6 +22,49 @@ namespace Renderer
         std::string debugName = "";
     };
 
+    // A rectangle of texels in every layer of a DataTexture
+    struct DataTextureRegion
+    {
+        i32 x = 0;
+        i32 y = 0;
+        i32 width = 0;
+        i32 height = 0;
+    };
+
     // Lets strong-typedef an ID type with the underlying type of u16
     STRONG_TYPEDEF(TextureID, u16);
+
+    struct TextureStreamingRequest
+    {
+        TextureID textureID;
+        f32 distance = 0.0f; // Distance from the camera to the closest thing using the texture
+    };
+
+    struct TextureStreamingStats
+    {
+        u32 numStreamedTextures = 0;
+        u32 numLoading = 0;
+        u32 numAtFullDetail = 0;
+        u32 numAtLowestDetail = 0;
+        u32 numRetiredImages = 0;
+        size_t residentBytes = 0; // Sum of the resident mips of all streamed textures
+
+        size_t budget = 0; // The budget the last UpdateStreaming used
+    };
+
+    // Linear is the scan the lookups did before they were indexed by desc hash, hash is the current lookup
+    struct TextureLookupBenchmarkResult
+    {
+        u32 numTextures = 0; // Loaded textures TryFindExistingTexture searches
+        u32 numArrayTextures = 0; // Loaded textures in all texture arrays
+        u32 numQueries = 0;
+        u32 numMismatches = 0; // Queries where the linear and hash lookup disagree, should always be 0
+
+        f32 linearTimeMS = 0.0f; // TryFindExistingTexture
+        f32 hashTimeMS = 0.0f;
+        f32 arrayLinearTimeMS = 0.0f; // TryFindExistingTextureInArray
+        f32 arrayHashTimeMS = 0.0f;
+        f32 loadIntoArrayLinearTimeMS = 0.0f; // LoadTextureIntoArray with textures that already are in the array
+        f32 loadIntoArrayHashTimeMS = 0.0f;
+    };
 }
\ No newline at end of file
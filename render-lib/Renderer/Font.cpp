@@ -3,107 +3,473 @@
 
 #include "Font.h"
 #include "Renderer.h"
+#include "RenderSettings.h"
 #include <Utils/XXHash64.h>
 #include <Utils/FileReader.h>
 #include <Utils/DebugHandler.h>
 #include <filesystem>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <tracy/Tracy.hpp>
 
 namespace Renderer
 {
+    constexpr i32 SDF_PADDING = 3;
+    constexpr u8 SDF_ON_EDGE_VALUE = 128;
+    constexpr f32 SDF_PIXEL_DIST_SCALE = 64.0f;
+    constexpr u32 ATLAS_RETIRE_FRAMES = 3;
+
+    robin_hood::unordered_map<u64, FontFace*> FontFace::_faces;
     robin_hood::unordered_map<u64, Font*> Font::_fonts;
 
-    FontChar& Font::GetChar(char character)
+    // One worker rasterizes the glyphs of every face, generating SDFs is too slow to do while laying out text
+    class GlyphRasterizer
     {
-        auto it = _chars.find(character);
-        if (it == _chars.end())
+    public:
+        GlyphRasterizer()
+        {
+            _thread = std::thread(&GlyphRasterizer::Run, this);
+        }
+
+        ~GlyphRasterizer()
         {
-            FontChar fontChar;
-            if (!InitChar(character, fontChar))
             {
-                DebugHandler::PrintFatal("The font does not support this character");
+                std::scoped_lock lock(_mutex);
+                _shouldExit = true;
             }
+            _condition.notify_all();
 
-            _chars[character] = fontChar;
+            _thread.join();
         }
 
-        return _chars[character];
-    }
+        void Queue(FontFace* face, u32 stbGlyphIndex, u32 glyphIndex)
+        {
+            {
+                std::scoped_lock lock(_mutex);
+                _requests.push_back({ face, stbGlyphIndex, glyphIndex });
+            }
+            _condition.notify_one();
+        }
 
-    Font* Font::GetFont(Renderer* renderer, const std::string& fontPath, f32 fontSize)
-    {
-        // Hash and add together the fontPath and fontSize
-        u64 hash = XXHash64::hash(fontPath.data(), fontPath.size(), 42) + XXHash64::hash(&fontSize, sizeof(f32), 42);
+        static GlyphRasterizer& Get()
+        {
+            static GlyphRasterizer rasterizer;
+            return rasterizer;
+        }
 
-        auto it = _fonts.find(hash);
-        if (it == _fonts.end())
+    private:
+        struct Request
         {
-            Font* font = new Font();
-            font->_renderer = renderer;
+            FontFace* face;
+            u32 stbGlyphIndex;
+            u32 glyphIndex;
+        };
 
-            std::filesystem::path path = std::filesystem::absolute(fontPath);
-            FileReader file(path.string(), path.filename().string());
-            if (!file.Open())
+        void Run()
+        {
+            while (true)
             {
-                DebugHandler::PrintFatal("Could not open Font file %s", fontPath.c_str());
+                Request request;
+                {
+                    std::unique_lock lock(_mutex);
+                    _condition.wait(lock, [&]() { return _shouldExit || !_requests.empty(); });
+
+                    if (_shouldExit)
+                        return;
+
+                    request = _requests.front();
+                    _requests.pop_front();
+                }
+
+                request.face->RasterizeGlyph(request.stbGlyphIndex, request.glyphIndex);
             }
+        }
+
+    private:
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::deque<Request> _requests;
+        bool _shouldExit = false;
+    };
+
+    FontFace* FontFace::GetFontFace(Renderer* renderer, const std::string& fontPath)
+    {
+        u64 hash = XXHash64::hash(fontPath.data(), fontPath.size(), 42);
+
+        auto it = _faces.find(hash);
+        if (it != _faces.end())
+            return it->second;
+
+        FontFace* face = new FontFace();
+        face->_renderer = renderer;
+        face->_path = fontPath;
+
+        std::filesystem::path path = std::filesystem::absolute(fontPath);
+        FileReader file(path.string(), path.filename().string());
+        if (!file.Open())
+        {
+            DebugHandler::PrintFatal("Could not open Font file %s", fontPath.c_str());
+        }
+
+        std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<209715200>();
+        file.Read(buffer.get(), file.Length());
+        face->_fontData.assign(buffer->GetDataPointer(), buffer->GetDataPointer() + file.Length());
+
+        face->_fontInfo = new stbtt_fontinfo();
+        stbtt_InitFont(face->_fontInfo, face->_fontData.data(), 0);
+
+        face->_sdfScale = stbtt_ScaleForPixelHeight(face->_fontInfo, Settings::FONT_SDF_PIXEL_HEIGHT);
 
-            std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<209715200>();
-            file.Read(buffer.get(), file.Length());
+        // The first row and column are never packed into, glyph 0 points at them and it's what glyphs sample until they have been rasterized
+        face->_atlasSize = Settings::FONT_ATLAS_SIZE;
+        face->_atlasData.resize(static_cast<size_t>(face->_atlasSize) * face->_atlasSize, 0);
+        face->_skyline.push_back({ 1, 1, face->_atlasSize - 1 });
+        face->_dirtyMin = ivec2(face->_atlasSize);
+        face->_dirtyMax = ivec2(0);
 
-            font->fontInfo = new stbtt_fontinfo();
-            stbtt_InitFont(font->fontInfo, buffer->GetDataPointer(), 0);
+        DataTextureDesc atlasDesc;
+        atlasDesc.width = Settings::FONT_ATLAS_SIZE;
+        atlasDesc.height = Settings::FONT_ATLAS_SIZE;
+        atlasDesc.format = ImageFormat::R8_UNORM;
+        atlasDesc.data = face->_atlasData.data();
+        atlasDesc.debugName = fontPath + " Atlas";
 
-            font->scale = stbtt_ScaleForPixelHeight(font->fontInfo, fontSize);
+        face->_atlasTexture = renderer->CreateDataTexture(atlasDesc);
+        face->_atlasTextureSize = face->_atlasSize;
+
+        face->_glyphTexCoords.SetDebugName(fontPath + " GlyphTexCoords");
+        face->_glyphTexCoords.SetUsage(BufferUsage::TRANSFER_DESTINATION | BufferUsage::STORAGE_BUFFER);
+        face->_glyphTexCoords.PushBack(vec4(0.0f));
+        face->_glyphTexCoords.SyncToGPU(renderer);
+
+        _faces[hash] = face;
+        return face;
+    }
+
+    const FontFace::Glyph& FontFace::GetGlyph(u32 codepoint)
+    {
+        auto it = _glyphs.find(codepoint);
+        if (it != _glyphs.end())
+            return it->second;
 
-            // Create texture array
-            TextureArrayDesc desc;
-            desc.size = 128;
+        // Codepoints the font doesn't have resolve to its missing glyph
+        i32 stbGlyphIndex = stbtt_FindGlyphIndex(_fontInfo, codepoint);
 
-            font->_textureArray = renderer->CreateTextureArray(desc);
+        Glyph glyph;
 
-            // Preload char 32 to 127 (commonly used ASCII characters)
-            for (int i = 32; i < 127; i++)
+        i32 advance;
+        stbtt_GetGlyphHMetrics(_fontInfo, stbGlyphIndex, &advance, nullptr);
+        glyph.advance = advance * _sdfScale;
+
+        // This is the same box stbtt_GetGlyphSDF produces, which lets text be laid out before the glyph has been rasterized
+        i32 x0, y0, x1, y1;
+        stbtt_GetGlyphBitmapBox(_fontInfo, stbGlyphIndex, _sdfScale, _sdfScale, &x0, &y0, &x1, &y1);
+
+        if (x0 != x1 && y0 != y1)
+        {
+            glyph.xOffset = x0 - SDF_PADDING;
+            glyph.yOffset = y0 - SDF_PADDING;
+            glyph.width = (x1 - x0) + SDF_PADDING * 2;
+            glyph.height = (y1 - y0) + SDF_PADDING * 2;
+
+            glyph.glyphIndex = static_cast<u32>(_glyphTexCoords.Size());
+            _glyphTexCoords.PushBack(vec4(0.0f));
+
+            GlyphRasterizer::Get().Queue(this, stbGlyphIndex, glyph.glyphIndex);
+        }
+
+        return _glyphs.emplace(codepoint, glyph).first->second;
+    }
+
+    void FontFace::SyncToGPU()
+    {
+        ZoneScoped;
+
+        for (auto& [hash, face] : _faces)
+        {
+            face->UpdateAtlas();
+        }
+    }
+
+    void FontFace::RasterizeGlyph(u32 stbGlyphIndex, u32 glyphIndex)
+    {
+        ZoneScoped;
+
+        i32 width, height, xOffset, yOffset;
+        u8* sdf = stbtt_GetGlyphSDF(_fontInfo, _sdfScale, stbGlyphIndex, SDF_PADDING, SDF_ON_EDGE_VALUE, SDF_PIXEL_DIST_SCALE, &width, &height, &xOffset, &yOffset);
+        if (sdf == nullptr)
+            return;
+
+        std::scoped_lock lock(_atlasMutex);
+
+        // One texel of gutter keeps bilinear filtering from reaching into the neighbouring glyphs
+        i32 x, y;
+        while (!PackRect(width + 1, height + 1, x, y))
+        {
+            if (!GrowAtlas())
             {
-                FontChar fontChar;
-                if (font->InitChar(i, fontChar))
+                if (!_isAtlasFull)
                 {
-                    font->_chars[i] = fontChar;
+                    DebugHandler::PrintWarning("Font atlas of %s is full, glyphs that don't fit will not be rendered", _path.c_str());
+                    _isAtlasFull = true;
                 }
+
+                stbtt_FreeSDF(sdf, nullptr);
+                return;
             }
-            
-            _fonts[hash] = font;
         }
 
-        return _fonts[hash];
+        for (i32 row = 0; row < height; row++)
+        {
+            memcpy(&_atlasData[static_cast<size_t>(y + row) * _atlasSize + x], &sdf[row * width], width);
+        }
+
+        stbtt_FreeSDF(sdf, nullptr);
+
+        _dirtyMin = glm::min(_dirtyMin, ivec2(x, y));
+        _dirtyMax = glm::max(_dirtyMax, ivec2(x + width, y + height));
+
+        RasterizedGlyph& rasterizedGlyph = _rasterizedGlyphs.emplace_back();
+        rasterizedGlyph.glyphIndex = glyphIndex;
+        rasterizedGlyph.texelRect = ivec4(x, y, x + width, y + height);
     }
 
-    bool Font::InitChar(char character, FontChar& fontChar)
+    bool FontFace::PackRect(i32 width, i32 height, i32& outX, i32& outY)
     {
-        fontChar.data = stbtt_GetCodepointSDF(fontInfo, scale, character, desc.padding, 128, 64.0f, &fontChar.width, &fontChar.height, &fontChar.xOffset, &fontChar.yOffset);
+        // Skyline bottom-left, the rect goes wherever it ends up lowest and rests on the highest node it spans
+        i32 bestIndex = -1;
+        i32 bestY = std::numeric_limits<i32>::max();
+        i32 bestWidth = std::numeric_limits<i32>::max();
+
+        for (i32 i = 0; i < static_cast<i32>(_skyline.size()); i++)
+        {
+            i32 x = _skyline[i].x;
+            if (x + width > _atlasSize)
+                break; // Nodes are sorted by x, the rest won't fit either
+
+            i32 y = 0;
+            i32 widthLeft = width;
+            for (i32 j = i; widthLeft > 0; j++)
+            {
+                y = glm::max(y, _skyline[j].y);
+                widthLeft -= _skyline[j].width;
+            }
+
+            if (y + height > _atlasSize)
+                continue;
+
+            if (y < bestY || (y == bestY && _skyline[i].width < bestWidth))
+            {
+                bestIndex = i;
+                bestY = y;
+                bestWidth = _skyline[i].width;
+            }
+        }
 
-        if (fontChar.width == 0 && fontChar.height == 0)
+        if (bestIndex == -1)
             return false;
 
-        int advance;
-        stbtt_GetCodepointHMetrics(fontInfo, character, &advance, NULL);
-        fontChar.advance = advance * scale;
+        outX = _skyline[bestIndex].x;
+        outY = bestY;
+
+        SkylineNode node = { outX, outY + height, width };
+        _skyline.insert(_skyline.begin() + bestIndex, node);
 
-        DataTextureDesc textureDesc;
-        textureDesc.width = fontChar.width;
-        textureDesc.height = fontChar.height;
-        textureDesc.format = ImageFormat::R8_UNORM;
-        textureDesc.data = fontChar.data;
-        textureDesc.debugName = desc.path + " " + character;
+        // Shrink or remove the nodes the new one now covers
+        for (size_t i = bestIndex + 1; i < _skyline.size();)
+        {
+            const SkylineNode& previous = _skyline[i - 1];
+            SkylineNode& node = _skyline[i];
 
-        _renderer->CreateDataTextureIntoArray(textureDesc, _textureArray, fontChar.textureIndex);
+            i32 overlap = (previous.x + previous.width) - node.x;
+            if (overlap <= 0)
+                break;
 
-        delete[] textureDesc.data;
+            node.x += overlap;
+            node.width -= overlap;
+
+            if (node.width > 0)
+                break;
+
+            _skyline.erase(_skyline.begin() + i);
+        }
+
+        // Merge neighbours at the same height
+        for (size_t i = 0; i + 1 < _skyline.size();)
+        {
+            if (_skyline[i].y == _skyline[i + 1].y)
+            {
+                _skyline[i].width += _skyline[i + 1].width;
+                _skyline.erase(_skyline.begin() + i + 1);
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        return true;
+    }
+
+    bool FontFace::GrowAtlas()
+    {
+        if (_atlasSize >= Settings::FONT_ATLAS_MAX_SIZE)
+            return false;
+
+        i32 newSize = _atlasSize * 2;
+
+        std::vector<u8> atlasData(static_cast<size_t>(newSize) * newSize, 0);
+        for (i32 row = 0; row < _atlasSize; row++)
+        {
+            memcpy(&atlasData[static_cast<size_t>(row) * newSize], &_atlasData[static_cast<size_t>(row) * _atlasSize], _atlasSize);
+        }
+        _atlasData.swap(atlasData);
+
+        // The packed glyphs keep their texels in the top left corner, the skyline gets a new empty node to the right and can now go further down
+        _skyline.push_back({ _atlasSize, 1, newSize - _atlasSize });
+        _atlasSize = newSize;
 
         return true;
     }
 
-    TextureArrayID Font::GetTextureArray()
+    void FontFace::UpdateAtlas()
+    {
+        for (size_t i = 0; i < _retiredAtlases.size();)
+        {
+            if (--_retiredAtlases[i].framesLeft == 0)
+            {
+                _renderer->UnloadTexture(_retiredAtlases[i].texture);
+                _retiredAtlases.erase(_retiredAtlases.begin() + i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        std::vector<RasterizedGlyph> rasterizedGlyphs;
+        f32 atlasSize = 0.0f;
+        f32 texCoordScale = 1.0f;
+        {
+            std::scoped_lock lock(_atlasMutex);
+
+            if (_atlasSize != _atlasTextureSize || !_rasterizedGlyphs.empty())
+            {
+                DataTextureDesc atlasDesc;
+                atlasDesc.width = _atlasSize;
+                atlasDesc.height = _atlasSize;
+                atlasDesc.format = ImageFormat::R8_UNORM;
+                atlasDesc.data = _atlasData.data();
+                atlasDesc.debugName = _path + " Atlas";
+
+                // Both of these copy into staging memory right away, so the worker can keep packing into the atlas after we let go of the lock
+                if (_atlasSize != _atlasTextureSize)
+                {
+                    // The atlas grew, which needs a new texture with everything in it
+                    _retiredAtlases.push_back({ _atlasTexture, ATLAS_RETIRE_FRAMES });
+                    _atlasTexture = _renderer->CreateDataTexture(atlasDesc);
+
+                    texCoordScale = static_cast<f32>(_atlasTextureSize) / static_cast<f32>(_atlasSize);
+                    _atlasTextureSize = _atlasSize;
+                }
+                else
+                {
+                    DataTextureRegion dirtyRegion;
+                    dirtyRegion.x = _dirtyMin.x;
+                    dirtyRegion.y = _dirtyMin.y;
+                    dirtyRegion.width = _dirtyMax.x - _dirtyMin.x;
+                    dirtyRegion.height = _dirtyMax.y - _dirtyMin.y;
+
+                    _renderer->UpdateDataTexture(_atlasTexture, atlasDesc, dirtyRegion);
+                }
+
+                _dirtyMin = ivec2(_atlasSize);
+                _dirtyMax = ivec2(0);
+
+                atlasSize = static_cast<f32>(_atlasSize);
+                rasterizedGlyphs.swap(_rasterizedGlyphs);
+            }
+        }
+
+        if (texCoordScale != 1.0f)
+        {
+            // Texcoords are normalized, the glyphs that were already packed didn't move but the atlas grew around them
+            _glyphTexCoords.WriteLock([&](std::vector<vec4>& glyphTexCoords)
+            {
+                for (vec4& texCoord : glyphTexCoords)
+                {
+                    texCoord *= texCoordScale;
+                }
+            });
+
+            _glyphTexCoords.SetDirtyElements(0, _glyphTexCoords.Size());
+        }
+
+        if (!rasterizedGlyphs.empty())
+        {
+            _glyphTexCoords.WriteLock([&](std::vector<vec4>& glyphTexCoords)
+            {
+                for (const RasterizedGlyph& rasterizedGlyph : rasterizedGlyphs)
+                {
+                    glyphTexCoords[rasterizedGlyph.glyphIndex] = vec4(rasterizedGlyph.texelRect) / atlasSize;
+                }
+            });
+
+            for (const RasterizedGlyph& rasterizedGlyph : rasterizedGlyphs)
+            {
+                _glyphTexCoords.SetDirtyElement(rasterizedGlyph.glyphIndex);
+            }
+        }
+
+        _glyphTexCoords.SyncToGPU(_renderer);
+    }
+
+    Font* Font::GetFont(Renderer* renderer, const std::string& fontPath, f32 fontSize)
+    {
+        // Hash and add together the fontPath and fontSize
+        u64 hash = XXHash64::hash(fontPath.data(), fontPath.size(), 42) + XXHash64::hash(&fontSize, sizeof(f32), 42);
+
+        auto it = _fonts.find(hash);
+        if (it == _fonts.end())
+        {
+            // Sizes only scale the metrics, the SDF of the face is shared between all of them
+            Font* font = new Font();
+            font->desc.path = fontPath;
+            font->desc.size = fontSize;
+            font->face = FontFace::GetFontFace(renderer, fontPath);
+            font->scale = fontSize / Settings::FONT_SDF_PIXEL_HEIGHT;
+
+            // Lay out char 32 to 127 (commonly used ASCII characters) up front, the face rasterizes them in the background
+            for (u32 i = 32; i < 127; i++)
+            {
+                font->GetChar(i);
+            }
+
+            it = _fonts.emplace(hash, font).first;
+        }
+
+        return it->second;
+    }
+
+    const FontChar& Font::GetChar(u32 codepoint)
     {
-        return _textureArray;
+        auto it = _chars.find(codepoint);
+        if (it != _chars.end())
+            return it->second;
+
+        const FontFace::Glyph& glyph = face->GetGlyph(codepoint);
+
+        FontChar fontChar;
+        fontChar.advance = glyph.advance * scale;
+        fontChar.xOffset = glyph.xOffset * scale;
+        fontChar.yOffset = glyph.yOffset * scale;
+        fontChar.width = glyph.width * scale;
+        fontChar.height = glyph.height * scale;
+        fontChar.glyphIndex = glyph.glyphIndex;
+
+        return _chars.emplace(codepoint, fontChar).first->second;
     }
-}
\ No newline at end of file
+}
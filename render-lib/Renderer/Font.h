@@ -1,8 +1,11 @@
 #pragma once
 #include <NovusTypes.h>
 #include <robin_hood.h>
-#include "Descriptors/TextureArrayDesc.h"
+#include <mutex>
+#include <vector>
+#include "Descriptors/TextureDesc.h"
 #include "Descriptors/FontDesc.h"
+#include "GPUVector.h"
 
 struct stbtt_fontinfo;
 
@@ -12,41 +15,117 @@ namespace Renderer
 
     struct FontChar
     {
-        f32 advance;
-        i32 xOffset;
-        i32 yOffset;
-        i32 width = 0;
-        i32 height = 0;
-        u8* data;
-
-        u32 textureIndex;
+        f32 advance = 0.0f;
+        f32 xOffset = 0.0f;
+        f32 yOffset = 0.0f;
+        f32 width = 0.0f;
+        f32 height = 0.0f;
+
+        u32 glyphIndex = 0; // Index into the glyph texcoords of the face, they stay empty until the glyph has been rasterized
+    };
+
+    // One SDF atlas per font file, shared by every size of it, it doubles in size when it fills up
+    // Glyphs are rasterized on a worker thread the first time they are asked for, their metrics are known right away so text can be laid out before that
+    class FontFace
+    {
+    public:
+        struct Glyph
+        {
+            f32 advance = 0.0f;
+            i32 xOffset = 0;
+            i32 yOffset = 0;
+            i32 width = 0;
+            i32 height = 0;
+
+            u32 glyphIndex = 0;
+        };
+
+        const Glyph& GetGlyph(u32 codepoint);
+
+        TextureID GetAtlasTexture() { return _atlasTexture; }
+        BufferID GetGlyphTexCoordBuffer() { return _glyphTexCoords.GetBuffer(); }
+
+        static FontFace* GetFontFace(Renderer* renderer, const std::string& fontPath);
+
+        // Uploads the glyphs the worker has finished rasterizing, has to be called before text gets rendered
+        static void SyncToGPU();
+
+    private:
+        FontFace() = default;
+
+        void RasterizeGlyph(u32 stbGlyphIndex, u32 glyphIndex);
+        bool PackRect(i32 width, i32 height, i32& outX, i32& outY);
+        bool GrowAtlas();
+        void UpdateAtlas();
+
+    private:
+        struct SkylineNode
+        {
+            i32 x;
+            i32 y;
+            i32 width;
+        };
+
+        struct RasterizedGlyph
+        {
+            u32 glyphIndex;
+            ivec4 texelRect;
+        };
+
+        struct RetiredAtlas
+        {
+            TextureID texture;
+            u32 framesLeft;
+        };
+
+        static robin_hood::unordered_map<u64, FontFace*> _faces;
+
+        Renderer* _renderer;
+        std::string _path;
+
+        std::vector<u8> _fontData; // stb_truetype keeps pointing into this
+        stbtt_fontinfo* _fontInfo;
+        f32 _sdfScale;
+
+        robin_hood::unordered_map<u32, Glyph> _glyphs; // Only touched from the thread laying out text
+
+        std::mutex _atlasMutex; // Guards everything below, the worker packs into it
+        std::vector<u8> _atlasData;
+        std::vector<SkylineNode> _skyline;
+        std::vector<RasterizedGlyph> _rasterizedGlyphs;
+        i32 _atlasSize = 0;
+        ivec2 _dirtyMin; // Bounds of the texels written since the last upload
+        ivec2 _dirtyMax;
+        bool _isAtlasFull = false;
+
+        TextureID _atlasTexture = TextureID::Invalid();
+        i32 _atlasTextureSize = 0;
+        std::vector<RetiredAtlas> _retiredAtlases; // Replaced by a bigger atlas, unloaded once the frames in flight are done with them
+        GPUVector<vec4> _glyphTexCoords;
+
+        friend class GlyphRasterizer;
     };
 
     struct Font
     {
         FontDesc desc;
 
-        stbtt_fontinfo* fontInfo;
-        float scale;
+        FontFace* face;
+        f32 scale; // From the size the face is rasterized at to the size of this font
 
-        FontChar& GetChar(char character);
-        TextureArrayID GetTextureArray();
+        const FontChar& GetChar(u32 codepoint);
+        TextureID GetAtlasTexture() { return face->GetAtlasTexture(); }
+        BufferID GetGlyphTexCoordBuffer() { return face->GetGlyphTexCoordBuffer(); }
 
         static Font* GetFont(Renderer* renderer, const std::string& fontPath, f32 fontSize);
-        
+
     private:
         Font() = default;
 
-        bool InitChar(char character, FontChar& fontChar);
-
     private:
         static robin_hood::unordered_map<u64, Font*> _fonts;
-        robin_hood::unordered_map<char, FontChar> _chars;
-
-        TextureArrayID _textureArray = TextureArrayID::Invalid();
-
-        Renderer* _renderer;
+        robin_hood::unordered_map<u32, FontChar> _chars;
 
         friend class Renderer;
     };
-}
\ No newline at end of file
+}
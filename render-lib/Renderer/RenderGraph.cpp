@@ -4,6 +4,9 @@
 #include <tracy/Tracy.hpp>
 #include <Memory/Allocator.h>
 #include <Containers/DynamicArray.h>
+#include <Utils/Timer.h>
+
+#include <limits>
 
 namespace Renderer
 {
@@ -11,18 +14,21 @@ namespace Renderer
     {
         RenderGraphData(Memory::Allocator* allocator)
             : passes(allocator, 32)
-            , executingPasses(allocator, 32)
+            , isPassExecuting(allocator, 32)
             , signalSemaphores(allocator, 4)
             , waitSemaphores(allocator, 4)
+            , passRecordTimings(allocator, 32)
         {
 
         }
 
         DynamicArray<IRenderPass*> passes;
-        DynamicArray<IRenderPass*> executingPasses;
+        DynamicArray<bool> isPassExecuting; // What the pass returned from Setup
 
         DynamicArray<SemaphoreID> signalSemaphores;
         DynamicArray<SemaphoreID> waitSemaphores;
+
+        DynamicArray<RenderGraph::PassRecordTiming> passRecordTimings;
     };
 
     RenderGraph::RenderGraph(Memory::Allocator* allocator, Renderer* renderer)
@@ -89,11 +95,12 @@ namespace Renderer
             ZoneName(pass->_name, pass->_nameLength);
 
             _renderGraphBuilder->SetCurrentPassIndex(i);
-            if (pass->Setup(_renderGraphBuilder))
-            {
-                data->executingPasses.Insert(pass);
-            }
+
+            bool isExecuting = pass->Setup(_renderGraphBuilder);
+            data->isPassExecuting.Insert(isExecuting);
         }
+
+        _renderGraphBuilder->Compile(data->isPassExecuting);
     }
 
     void RenderGraph::Execute()
@@ -101,7 +108,6 @@ namespace Renderer
         ZoneScopedNC("RenderGraph::Execute", tracy::Color::Red2);
 
         RenderGraphData* data = static_cast<RenderGraphData*>(_data);
-        RenderGraphResources& resources = _renderGraphBuilder->GetResources();
         
         CommandList commandList(_renderer, _desc.allocator);
 
@@ -116,23 +122,75 @@ namespace Renderer
             commandList.AddWaitSemaphore(waitSemaphore);
         }
 
+        for (u32 i = 0; i < data->passes.Count(); i++)
+        {
+            PassRecordTiming timing;
+            timing.name = data->passes[i]->_name;
+            timing.recordTime = 0.0f;
+            timing.isExecuting = data->isPassExecuting[i];
+
+            data->passRecordTimings.Insert(timing);
+        }
+
         _renderer->BeginExecutingCommandlist();
 
-        commandList.PushMarker("RenderGraph", Color::PastelBlue);
-        for (u32 i = 0; i < data->passes.Count(); i++)
+#if COMMANDLIST_DEBUG_IMMEDIATE_MODE
+        // Immediate mode records straight into the backend, so there is nothing to gain from recording in parallel
+        ExecuteSerial(commandList);
+#else
+        if (_desc.getPassAllocator != nullptr && _desc.parallelFor != nullptr)
         {
-            IRenderPass* pass = data->passes[i];
+            ExecuteParallel(commandList);
+        }
+        else
+        {
+            ExecuteSerial(commandList);
+        }
+#endif
 
-            ZoneScopedC(tracy::Color::Red2);
-            ZoneName(pass->_name, pass->_nameLength);
+        _renderer->EndExecutingCommandlist();
+    }
 
-            commandList.PushMarker(pass->_name, Color::PastelGreen);
+    const DynamicArray<RenderGraph::PassRecordTiming>& RenderGraph::GetPassRecordTimings()
+    {
+        RenderGraphData* data = static_cast<RenderGraphData*>(_data);
+        return data->passRecordTimings;
+    }
+
+    void RenderGraph::RecordPass(u32 passIndex, CommandList& commandList)
+    {
+        RenderGraphData* data = static_cast<RenderGraphData*>(_data);
+        RenderGraphResources& resources = _renderGraphBuilder->GetResources();
+
+        IRenderPass* pass = data->passes[passIndex];
+
+        ZoneScopedC(tracy::Color::Red2);
+        ZoneName(pass->_name, pass->_nameLength);
+
+        Timer timer;
+
+        commandList.PushMarker(pass->_name, Color::PastelGreen);
+
+        _renderGraphBuilder->PreExecute(commandList, passIndex);
+        pass->Execute(resources, commandList);
+        _renderGraphBuilder->PostExecute(commandList, passIndex);
 
-            _renderGraphBuilder->PreExecute(commandList, i);
-            pass->Execute(resources, commandList);
-            _renderGraphBuilder->PostExecute(commandList, i);
+        commandList.PopMarker();
+
+        data->passRecordTimings[passIndex].recordTime = timer.GetLifeTime();
+    }
+
+    void RenderGraph::ExecuteSerial(CommandList& commandList)
+    {
+        RenderGraphData* data = static_cast<RenderGraphData*>(_data);
 
-            commandList.PopMarker();
+        commandList.PushMarker("RenderGraph", Color::PastelBlue);
+        for (u32 i = 0; i < data->passes.Count(); i++)
+        {
+            if (!data->isPassExecuting[i])
+                continue;
+
+            RecordPass(i, commandList);
         }
         commandList.PopMarker();
 
@@ -140,7 +198,117 @@ namespace Renderer
             ZoneScopedNC("CommandList::Execute", tracy::Color::Red2);
             commandList.Execute();
         }
+    }
+
+    void RenderGraph::ExecuteParallel(CommandList& commandList)
+    {
+        RenderGraphData* data = static_cast<RenderGraphData*>(_data);
+        u32 numPasses = static_cast<u32>(data->passes.Count());
+
+        // Every pass gets its own CommandList on its own allocator so they can be recorded at the same time
+        DynamicArray<CommandList*> passCommandLists(_desc.allocator, numPasses);
+        for (u32 i = 0; i < numPasses; i++)
+        {
+            Memory::Allocator* passAllocator = _desc.getPassAllocator(i);
+            passCommandLists.Insert(Memory::Allocator::New<CommandList>(passAllocator, _renderer, passAllocator));
+        }
 
-        _renderer->EndExecutingCommandlist();
+        // Passes that share recording state end up in the same chain, a chain is recorded by one job in graph order
+        DynamicArray<u32> chainRoots(_desc.allocator, numPasses);
+        for (u32 i = 0; i < numPasses; i++)
+        {
+            chainRoots.Insert(i);
+        }
+
+        auto FindRoot = [&](u32 passIndex)
+        {
+            while (chainRoots[passIndex] != passIndex)
+            {
+                passIndex = chainRoots[passIndex];
+            }
+            return passIndex;
+        };
+
+        const DynamicArray<RenderGraphBuilder::SharedRecordingState>& sharedStates = _renderGraphBuilder->GetSharedRecordingStates();
+        for (u32 i = 0; i < sharedStates.Count(); i++)
+        {
+            for (u32 j = i + 1; j < sharedStates.Count(); j++)
+            {
+                if (sharedStates[i].state != sharedStates[j].state)
+                    continue;
+
+                u32 rootA = FindRoot(sharedStates[i].passIndex);
+                u32 rootB = FindRoot(sharedStates[j].passIndex);
+
+                // Always keep the earliest pass as the root so it is also the first pass of the chain
+                if (rootA < rootB)
+                {
+                    chainRoots[rootB] = rootA;
+                }
+                else if (rootB < rootA)
+                {
+                    chainRoots[rootA] = rootB;
+                }
+            }
+        }
+
+        constexpr u32 NO_PASS = std::numeric_limits<u32>::max();
+
+        DynamicArray<u32> chainStarts(_desc.allocator, numPasses);
+        DynamicArray<u32> nextPassInChain(_desc.allocator, numPasses);
+        DynamicArray<u32> lastPassInChain(_desc.allocator, numPasses);
+        for (u32 i = 0; i < numPasses; i++)
+        {
+            nextPassInChain.Insert(NO_PASS);
+            lastPassInChain.Insert(NO_PASS);
+        }
+
+        for (u32 i = 0; i < numPasses; i++)
+        {
+            u32 root = FindRoot(i);
+
+            if (root == i)
+            {
+                chainStarts.Insert(i);
+            }
+            else
+            {
+                nextPassInChain[lastPassInChain[root]] = i;
+            }
+
+            lastPassInChain[root] = i;
+        }
+
+        {
+            ZoneScopedNC("RenderGraph::RecordPasses", tracy::Color::Red2);
+
+            _desc.parallelFor(static_cast<u32>(chainStarts.Count()), [&](u32 chainIndex)
+            {
+                for (u32 passIndex = chainStarts[chainIndex]; passIndex != NO_PASS; passIndex = nextPassInChain[passIndex])
+                {
+                    if (!data->isPassExecuting[passIndex])
+                        continue;
+
+                    RecordPass(passIndex, *passCommandLists[passIndex]);
+                }
+            });
+        }
+
+        // Submitting stays on this thread and goes through a single backend commandlist in graph order
+        {
+            ZoneScopedNC("CommandList::Execute", tracy::Color::Red2);
+
+            CommandListID commandListID = _renderer->BeginCommandList();
+            commandList.Replay(commandListID);
+
+            _renderer->PushMarker(commandListID, Color::PastelBlue, "RenderGraph");
+            for (CommandList* passCommandList : passCommandLists)
+            {
+                passCommandList->Replay(commandListID);
+            }
+            _renderer->PopMarker(commandListID);
+
+            _renderer->EndCommandList(commandListID);
+        }
     }
 }
\ No newline at end of file
@@ -17,6 +17,13 @@ namespace Renderer
     class RenderGraph
     {
     public:
+        struct PassRecordTiming
+        {
+            const char* name;
+            f32 recordTime; // In seconds, includes the barriers and clears queued up by the RenderGraph for this pass
+            bool isExecuting; // False if Setup disabled the pass
+        };
+
         ~RenderGraph();
 
         template <typename PassData>
@@ -34,12 +41,19 @@ namespace Renderer
 
         RenderGraphBuilder* GetBuilder() { return _renderGraphBuilder; }
 
+        // One entry per pass in graph order, filled in by Execute
+        const DynamicArray<PassRecordTiming>& GetPassRecordTimings();
+
     private:
         RenderGraph(Memory::Allocator* allocator, Renderer* renderer);
         bool Init(RenderGraphDesc& desc);
 
         void AddPass(IRenderPass* pass);
 
+        void RecordPass(u32 passIndex, CommandList& commandList);
+        void ExecuteSerial(CommandList& commandList);
+        void ExecuteParallel(CommandList& commandList);
+
     private:
         IRenderGraphData* _data;
 
@@ -2,11 +2,16 @@
 #include "Renderer.h"
 #include "RenderGraph.h"
 
+#include <tracy/Tracy.hpp>
+
 namespace Renderer
 {
     RenderGraphBuilder::RenderGraphBuilder(Memory::Allocator* allocator, Renderer* renderer, size_t numPasses)
-        : _renderer(renderer)
+        : _allocator(allocator)
+        , _renderer(renderer)
         , _resources(allocator, numPasses)
+        , _sharedRecordingStates(allocator, 32)
+        , _accesses(allocator, 128)
     {
 
     }
@@ -16,9 +21,25 @@ namespace Renderer
         if (!_resources.NeedsPreExecute(passIndex))
             return;
 
-        // Queue up all the clears for this pass
         commandList.PushMarker("RenderGraph::PreExecute", Color::White);
 
+        // Barriers go first since the clears below have to wait for earlier passes as well
+        const DynamicArray<ImageID>& imageBarriers = _resources.GetImageBarriers(passIndex);
+
+        for (ImageID image : imageBarriers)
+        {
+            commandList.ImageBarrier(image);
+        }
+
+        const DynamicArray<DepthImageID>& depthImageBarriers = _resources.GetDepthImageBarriers(passIndex);
+
+        for (DepthImageID image : depthImageBarriers)
+        {
+            commandList.DepthImageBarrier(image);
+        }
+
+        // Queue up all the clears for this pass
+
         const DynamicArray<ImageID>& colorClears = _resources.GetColorClears(passIndex);
 
         for (ImageID image : colorClears)
@@ -53,11 +74,6 @@ namespace Renderer
             commandList.Clear(image, imageDesc.depthClearValue);
         }
 
-        // TODO: Handling between-pass barriers here
-        // If we have .Read operations we need to:
-        // * Check if the same resource had any .Write operations with WriteMode UAV in earlier passes
-        // * If it did, add a Compute-Compute barrier if this read has the shaderstage Compute, otherwise add a Compute-ShaderRead barrier'
-
         commandList.PopMarker();
     }
 
@@ -72,6 +88,165 @@ namespace Renderer
         return _resources;
     }
 
+    void RenderGraphBuilder::Compile(DynamicArray<bool>& isPassExecuting)
+    {
+        ZoneScopedNC("RenderGraphBuilder::Compile", tracy::Color::Red2);
+
+        PlaceBarriers(isPassExecuting);
+    }
+
+    void RenderGraphBuilder::PlaceBarriers(DynamicArray<bool>& isPassExecuting)
+    {
+        enum class PendingWrite : u8
+        {
+            NONE,
+            RENDERTARGET,
+            OTHER // UAV writes and clears
+        };
+
+        struct ImageState
+        {
+            u16 image;
+            bool isDepth;
+            PendingWrite pendingWrite;
+            bool pendingRead;
+        };
+
+        DynamicArray<ImageState> imageStates(_allocator, 32);
+
+        // Accesses store the resource handed to the pass, barriers and state tracking work on the image behind it
+        auto GetImage = [&](const ResourceAccess& access) -> u16
+        {
+            if (access.isDepth)
+            {
+                return static_cast<DepthImageID::type>(_resources.GetDepthImage(RenderPassResource(access.resource)));
+            }
+
+            return static_cast<ImageID::type>(_resources.GetImage(RenderPassResource(access.resource)));
+        };
+
+        u32 accessStart = 0;
+        while (accessStart < _accesses.Count())
+        {
+            u32 passIndex = _accesses[accessStart].passIndex;
+
+            u32 accessEnd = accessStart;
+            while (accessEnd < _accesses.Count() && _accesses[accessEnd].passIndex == passIndex)
+            {
+                accessEnd++;
+            }
+
+            if (!isPassExecuting[passIndex])
+            {
+                accessStart = accessEnd;
+                continue;
+            }
+
+            for (u32 i = accessStart; i < accessEnd; i++)
+            {
+                const ResourceAccess& access = _accesses[i];
+                u16 image = GetImage(access);
+
+                // A pass can declare the same image more than once, all of them are handled together at the first one
+                bool isFirstDeclaration = true;
+                for (u32 j = accessStart; j < i; j++)
+                {
+                    if (_accesses[j].isDepth == access.isDepth && GetImage(_accesses[j]) == image)
+                    {
+                        isFirstDeclaration = false;
+                        break;
+                    }
+                }
+
+                if (!isFirstDeclaration)
+                    continue;
+
+                bool reads = false;
+                bool writes = false;
+                bool writesUAV = false;
+                bool clears = false;
+
+                for (u32 j = i; j < accessEnd; j++)
+                {
+                    const ResourceAccess& otherAccess = _accesses[j];
+                    if (otherAccess.isDepth != access.isDepth || GetImage(otherAccess) != image)
+                        continue;
+
+                    reads |= otherAccess.type == AccessType::READ;
+                    writes |= otherAccess.type != AccessType::READ;
+                    writesUAV |= otherAccess.type == AccessType::WRITE_UAV;
+                    clears |= otherAccess.type != AccessType::READ && otherAccess.loadMode == LoadMode::CLEAR;
+                }
+
+                ImageState* state = nullptr;
+                for (ImageState& imageState : imageStates)
+                {
+                    if (imageState.image == image && imageState.isDepth == access.isDepth)
+                    {
+                        state = &imageState;
+                        break;
+                    }
+                }
+
+                if (state == nullptr)
+                {
+                    ImageState imageState;
+                    imageState.image = image;
+                    imageState.isDepth = access.isDepth;
+                    imageState.pendingWrite = PendingWrite::NONE;
+                    imageState.pendingRead = false;
+
+                    imageStates.Insert(imageState);
+                    state = &imageStates[imageStates.Count() - 1];
+                }
+
+                // Render passes already wait for the attachment writes of earlier render passes, so rendertarget after rendertarget and read after read need nothing
+                // Everything else involving a write has to wait for the earlier access, clears included since they happen outside of the render pass
+                bool isOtherWrite = writesUAV || clears;
+                bool needsBarrier = (state->pendingWrite != PendingWrite::NONE && (reads || isOtherWrite || state->pendingWrite == PendingWrite::OTHER)) || (state->pendingRead && writes);
+
+                if (needsBarrier)
+                {
+                    if (access.isDepth)
+                    {
+                        _resources.AddBarrier(passIndex, DepthImageID(image));
+                    }
+                    else
+                    {
+                        _resources.AddBarrier(passIndex, ImageID(image));
+                    }
+
+                    state->pendingWrite = PendingWrite::NONE;
+                    state->pendingRead = false;
+                }
+
+                if (reads)
+                {
+                    state->pendingRead = true;
+                }
+
+                if (writes)
+                {
+                    state->pendingWrite = writesUAV ? PendingWrite::OTHER : PendingWrite::RENDERTARGET;
+                }
+            }
+
+            accessStart = accessEnd;
+        }
+    }
+
+    void RenderGraphBuilder::AddAccess(u16 resource, bool isDepth, AccessType type, LoadMode loadMode)
+    {
+        ResourceAccess access;
+        access.passIndex = _currentPassIndex;
+        access.resource = resource;
+        access.isDepth = isDepth;
+        access.type = type;
+        access.loadMode = loadMode;
+
+        _accesses.Insert(access);
+    }
+
     ImageID RenderGraphBuilder::Create(ImageDesc& /*desc*/)
     {
         return ImageID::Invalid();
@@ -85,6 +260,7 @@ namespace Renderer
     RenderPassResource RenderGraphBuilder::Read(ImageID id, ShaderStage /*shaderStage*/)
     {
         RenderPassResource resource = _resources.GetResource(id);
+        AddAccess(static_cast<RenderPassResource::type>(resource), false, AccessType::READ, LoadMode::LOAD);
 
         return resource;
     }
@@ -99,13 +275,15 @@ namespace Renderer
     RenderPassResource RenderGraphBuilder::Read(DepthImageID id, ShaderStage /*shaderStage*/)
     {
         RenderPassResource resource = _resources.GetResource(id);
+        AddAccess(static_cast<RenderPassResource::type>(resource), true, AccessType::READ, LoadMode::LOAD);
 
         return resource;
     }
 
-    RenderPassMutableResource RenderGraphBuilder::Write(ImageID id, WriteMode /*writeMode*/, LoadMode loadMode)
+    RenderPassMutableResource RenderGraphBuilder::Write(ImageID id, WriteMode writeMode, LoadMode loadMode)
     {
         RenderPassMutableResource resource = _resources.GetMutableResource(id);
+        AddAccess(static_cast<RenderPassMutableResource::type>(resource), false, writeMode == WriteMode::UAV ? AccessType::WRITE_UAV : AccessType::WRITE_RENDERTARGET, loadMode);
 
         if (loadMode == LoadMode::CLEAR)
         {
@@ -115,9 +293,10 @@ namespace Renderer
         return resource;
     }
 
-    RenderPassMutableResource RenderGraphBuilder::Write(DepthImageID id, WriteMode /*writeMode*/, LoadMode loadMode)
+    RenderPassMutableResource RenderGraphBuilder::Write(DepthImageID id, WriteMode writeMode, LoadMode loadMode)
     {
         RenderPassMutableResource resource = _resources.GetMutableResource(id);
+        AddAccess(static_cast<RenderPassMutableResource::type>(resource), true, writeMode == WriteMode::UAV ? AccessType::WRITE_UAV : AccessType::WRITE_RENDERTARGET, loadMode);
 
         if (loadMode == LoadMode::CLEAR)
         {
@@ -126,4 +305,13 @@ namespace Renderer
 
         return resource;
     }
-}
\ No newline at end of file
+
+    void RenderGraphBuilder::ShareRecordingState(const void* state)
+    {
+        SharedRecordingState sharedState;
+        sharedState.passIndex = _currentPassIndex;
+        sharedState.state = state;
+
+        _sharedRecordingStates.Insert(sharedState);
+    }
+}
@@ -2,6 +2,7 @@
 #include <NovusTypes.h>
 
 #include "RenderGraphResources.h"
+#include <Containers/DynamicArray.h>
 
 #include "RenderStates.h"
 #include "RenderPassResources.h"
@@ -60,10 +61,43 @@ namespace Renderer
         RenderPassMutableResource Write(ImageID id, WriteMode writeMode, LoadMode loadMode);
         RenderPassMutableResource Write(DepthImageID id, WriteMode writeMode, LoadMode loadMode);
 
+        // Only matters when passes are recorded in parallel, declares CPU side state this pass touches while executing that other passes touch as well (DescriptorSets it binds into, members of its renderer)
+        // Passes sharing any state are recorded one after another in graph order, anything else they touch while executing has to be safe to use from several threads
+        void ShareRecordingState(const void* state);
+
     private:
+        struct SharedRecordingState
+        {
+            u32 passIndex;
+            const void* state;
+        };
+
+        enum class AccessType : u8
+        {
+            READ,
+            WRITE_RENDERTARGET,
+            WRITE_UAV
+        };
+
+        struct ResourceAccess
+        {
+            u32 passIndex;
+            u16 resource; // Index into the tracked images or depth images
+            bool isDepth;
+            AccessType type;
+            LoadMode loadMode;
+        };
+
+        void AddAccess(u16 resource, bool isDepth, AccessType type, LoadMode loadMode);
+
+        // Runs once every pass is set up, isPassExecuting comes in with what the passes returned from Setup
+        void Compile(DynamicArray<bool>& isPassExecuting);
+        void PlaceBarriers(DynamicArray<bool>& isPassExecuting);
+
         void PreExecute(CommandList& commandList, u32 passIndex);
         void PostExecute(CommandList& commandList, u32 passIndex);
         RenderGraphResources& GetResources();
+        const DynamicArray<SharedRecordingState>& GetSharedRecordingStates() { return _sharedRecordingStates; }
 
         void SetCurrentPassIndex(u32 index) { _currentPassIndex = index; }
 
@@ -74,6 +108,9 @@ namespace Renderer
         RenderGraphResources _resources;
         u32 _currentPassIndex;
 
+        DynamicArray<SharedRecordingState> _sharedRecordingStates;
+        DynamicArray<ResourceAccess> _accesses;
+
         friend class RenderGraph;
     };
 }
\ No newline at end of file
@@ -9,6 +9,8 @@ namespace Renderer
         TrackedPass(Memory::Allocator* allocator)
             : colorClears(allocator, 4)
             , depthClears(allocator, 4)
+            , imageBarriers(allocator, 4)
+            , depthImageBarriers(allocator, 4)
         {
 
         }
@@ -17,6 +19,8 @@ namespace Renderer
         bool needsPostExecute = false;
         DynamicArray<ImageID> colorClears;
         DynamicArray<DepthImageID> depthClears;
+        DynamicArray<ImageID> imageBarriers;
+        DynamicArray<DepthImageID> depthImageBarriers;
     };
 
     struct RenderGraphResourcesData : IRenderGraphResourcesData
@@ -213,6 +217,32 @@ namespace Renderer
         data->trackedPasses[passIndex].depthClears.Insert(id);
     }
 
+    void RenderGraphResources::AddBarrier(u32 passIndex, ImageID id)
+    {
+        RenderGraphResourcesData* data = static_cast<RenderGraphResourcesData*>(_data);
+
+        if (passIndex >= data->trackedPasses.Count())
+        {
+            DebugHandler::PrintFatal("Tried to access barriers of pass that hasn't been tracked yet");
+        }
+
+        data->trackedPasses[passIndex].needsPreExecute = true;
+        data->trackedPasses[passIndex].imageBarriers.Insert(id);
+    }
+
+    void RenderGraphResources::AddBarrier(u32 passIndex, DepthImageID id)
+    {
+        RenderGraphResourcesData* data = static_cast<RenderGraphResourcesData*>(_data);
+
+        if (passIndex >= data->trackedPasses.Count())
+        {
+            DebugHandler::PrintFatal("Tried to access barriers of pass that hasn't been tracked yet");
+        }
+
+        data->trackedPasses[passIndex].needsPreExecute = true;
+        data->trackedPasses[passIndex].depthImageBarriers.Insert(id);
+    }
+
     bool RenderGraphResources::NeedsPreExecute(u32 passIndex)
     {
         RenderGraphResourcesData* data = static_cast<RenderGraphResourcesData*>(_data);
@@ -260,4 +290,28 @@ namespace Renderer
 
         return data->trackedPasses[passIndex].depthClears;
     }
+
+    const DynamicArray<ImageID>& RenderGraphResources::GetImageBarriers(u32 passIndex)
+    {
+        RenderGraphResourcesData* data = static_cast<RenderGraphResourcesData*>(_data);
+
+        if (passIndex >= data->trackedPasses.Count())
+        {
+            DebugHandler::PrintFatal("Tried to access barriers of pass that hasn't been tracked yet");
+        }
+
+        return data->trackedPasses[passIndex].imageBarriers;
+    }
+
+    const DynamicArray<DepthImageID>& RenderGraphResources::GetDepthImageBarriers(u32 passIndex)
+    {
+        RenderGraphResourcesData* data = static_cast<RenderGraphResourcesData*>(_data);
+
+        if (passIndex >= data->trackedPasses.Count())
+        {
+            DebugHandler::PrintFatal("Tried to access barriers of pass that hasn't been tracked yet");
+        }
+
+        return data->trackedPasses[passIndex].depthImageBarriers;
+    }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <NovusTypes.h>
 #include <Memory/Allocator.h>
 #include <Containers/DynamicArray.h>
+#include <mutex>
 
 #include "RenderPassResources.h"
 
@@ -25,6 +26,8 @@ namespace Renderer
         template<typename T, typename... Args>
         T* FrameNew(Args... args)
         {
+            // Passes can be recorded in parallel and they all share the frame allocator
+            std::scoped_lock lock(_allocatorMutex);
             return Memory::Allocator::New<T>(_allocator, args...);
         }
 
@@ -45,14 +48,20 @@ namespace Renderer
         void Clear(u32 passIndex, ImageID id);
         void Clear(u32 passIndex, DepthImageID id);
 
+        void AddBarrier(u32 passIndex, ImageID id);
+        void AddBarrier(u32 passIndex, DepthImageID id);
+
         bool NeedsPreExecute(u32 passIndex);
         bool NeedsPostExecute(u32 passIndex);
 
         const DynamicArray<ImageID>& GetColorClears(u32 passIndex);
         const DynamicArray<DepthImageID>& GetDepthClears(u32 passIndex);
+        const DynamicArray<ImageID>& GetImageBarriers(u32 passIndex);
+        const DynamicArray<DepthImageID>& GetDepthImageBarriers(u32 passIndex);
 
     private:
         Memory::Allocator* _allocator = nullptr;
+        std::mutex _allocatorMutex;
 
         IRenderGraphResourcesData* _data = nullptr;
 
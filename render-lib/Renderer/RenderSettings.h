@@ -10,6 +10,21 @@ namespace Renderer
         const i32 SCREEN_HEIGHT = 1080;
         constexpr size_t STAGING_BUFFER_SIZE = 32 * 1024 * 1024; // 32 MB
 
+        // Texture streaming, mipmapped textures start out with their top mips dropped and get them back based on the distances renderers request them at
+        constexpr u32 TEXTURE_STREAMING_MAX_DROPPED_MIPS = 4;
+        constexpr u32 TEXTURE_STREAMING_MIN_DIMENSION = 64; // We never drop mips below this size
+        constexpr f32 TEXTURE_STREAMING_FULL_DETAIL_DISTANCE = 100.0f; // Every doubling of the distance past this drops one mip
+        constexpr f32 TEXTURE_STREAMING_BUDGET_FRACTION = 0.9f; // Start evicting mips when VRAM usage goes above this fraction of the budget
+        constexpr u32 TEXTURE_STREAMING_MAX_LOADS_PER_FRAME = 8;
+        constexpr u32 TEXTURE_STREAMING_STALE_FRAMES = 120; // Textures that weren't requested for this many frames are not upgraded anymore
+
+        constexpr u32 DESCRIPTOR_SET_CACHE_MAX_UNUSED_FRAMES = 60; // Cached descriptor sets that weren't bound for this many frames get recycled
+
+        // Fonts, every font file gets one SDF atlas that all sizes of it share
+        constexpr f32 FONT_SDF_PIXEL_HEIGHT = 48.0f; // Glyphs are rasterized at this size and scaled to the size of the text
+        constexpr i32 FONT_ATLAS_SIZE = 1024; // Atlases start out at this size and double whenever they fill up
+        constexpr i32 FONT_ATLAS_MAX_SIZE = 4096;
+
         const FrontFaceState FRONT_FACE_STATE = FrontFaceState::COUNTERCLOCKWISE;
     }
 }
@@ -20,6 +20,7 @@
 #include "Descriptors/UploadBuffer.h"
 
 class Window;
+struct ImDrawData;
 
 namespace tracy
 {
@@ -68,6 +69,8 @@ namespace Renderer
 
         virtual [[nodiscard]] TextureID CreateDataTexture(DataTextureDesc& desc) = 0;
         virtual [[nodiscard]] TextureID CreateDataTextureIntoArray(DataTextureDesc& desc, TextureArrayID textureArray, u32& arrayIndex) = 0;
+        virtual void UpdateDataTexture(TextureID textureID, DataTextureDesc& desc) = 0; // Reuploads the whole texture, the desc has to match the one it was created with
+        virtual void UpdateDataTexture(TextureID textureID, DataTextureDesc& desc, const DataTextureRegion& region) = 0; // Only reuploads the region, desc.data still points at the whole texture
 
         // Loading
         virtual [[nodiscard]] TextureID LoadTexture(TextureDesc& desc) = 0;
@@ -81,6 +84,14 @@ namespace Renderer
         virtual void UnloadTexture(TextureID textureID) = 0;
         virtual void UnloadTexturesInArray(TextureArrayID textureArrayID, u32 unloadStartIndex) = 0;
 
+        // Streaming, textures that are never requested stay at full detail
+        virtual void RequestTextureDetail(const std::vector<TextureStreamingRequest>& requests) = 0;
+        virtual void SetTextureStreamingBudget(size_t budget) = 0; // 0 uses the device budget, anything else lets eviction be exercised on devices with plenty of memory like software drivers
+        virtual [[nodiscard]] TextureStreamingStats GetTextureStreamingStats() = 0;
+
+        // Times looking up already loaded textures through the desc hash indices against the linear scans they replaced
+        virtual [[nodiscard]] TextureLookupBenchmarkResult BenchmarkTextureLookups(u32 numQueries) = 0;
+
         // Command List Functions
         virtual [[nodiscard]] CommandListID BeginCommandList() = 0;
         virtual void EndCommandList(CommandListID commandListID) = 0;
@@ -160,11 +171,15 @@ namespace Renderer
         virtual [[nodiscard]] size_t GetVRAMUsage() = 0;
         virtual [[nodiscard]] size_t GetVRAMBudget() = 0;
 
+        virtual [[nodiscard]] u32 GetNumDescriptorSetCacheHits() = 0;
+        virtual [[nodiscard]] u32 GetNumDescriptorSetCacheMisses() = 0;
+        virtual [[nodiscard]] u32 GetNumCachedDescriptorSets() = 0;
+
         virtual [[nodiscard]] u32 GetNumImages() = 0;
         virtual [[nodiscard]] u32 GetNumDepthImages() = 0;
 
         virtual void InitImgui() = 0;
-        virtual void DrawImgui(CommandListID commandListID) = 0;
+        virtual void DrawImgui(CommandListID commandListID, ImDrawData* drawData) = 0;
 
     protected:
         Renderer() {}; // Pure virtual class, disallow creation of it
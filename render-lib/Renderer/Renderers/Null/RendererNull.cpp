@@ -0,0 +1,895 @@
+#include "RendererNull.h"
+#include "../../RenderSettings.h"
+#include "../../../Window/Window.h"
+#include <Utils/DebugHandler.h>
+#include <Utils/XXHash64.h>
+#include <GLFW/glfw3.h>
+#include <tracy/Tracy.hpp>
+
+#include <imgui/imgui.h>
+
+namespace Renderer
+{
+    namespace
+    {
+        u32 PreviousPow2(u32 v)
+        {
+            u32 r = 1;
+
+            while (r * 2 < v)
+                r *= 2;
+
+            return r;
+        }
+
+        u32 GetImageMipLevels(u32 width, u32 height)
+        {
+            u32 result = 1;
+
+            while (width > 1 || height > 1)
+            {
+                result++;
+                width /= 2;
+                height /= 2;
+            }
+
+            return result;
+        }
+
+        template <typename T>
+        u64 CalculateShaderHash(const T& desc)
+        {
+            u64 hash = XXHash64::hash(desc.path.data(), desc.path.size(), 0);
+
+            for (const PermutationField& permutationField : desc.permutationFields)
+            {
+                hash = XXHash64::hash(permutationField.key.data(), permutationField.key.size(), hash);
+                hash = XXHash64::hash(permutationField.value.data(), permutationField.value.size(), hash);
+            }
+
+            return hash;
+        }
+    }
+
+    RendererNull::Stats& RendererNull::Stats::operator+=(const Stats& other)
+    {
+        numCommandLists += other.numCommandLists;
+        numCommands += other.numCommands;
+
+        numDraws += other.numDraws;
+        numIndirectDraws += other.numIndirectDraws;
+        numVertices += other.numVertices;
+        numIndices += other.numIndices;
+        numInstances += other.numInstances;
+
+        numDispatches += other.numDispatches;
+        numThreadGroups += other.numThreadGroups;
+
+        numPipelineBinds += other.numPipelineBinds;
+        numDescriptorSetBinds += other.numDescriptorSetBinds;
+        numDescriptors += other.numDescriptors;
+        numBarriers += other.numBarriers;
+        numCopies += other.numCopies;
+
+        numUploads += other.numUploads;
+        numBytesUploaded += other.numBytesUploaded;
+        numBytesPushed += other.numBytesPushed;
+
+        numBuffersCreated += other.numBuffersCreated;
+        numBufferBytesCreated += other.numBufferBytesCreated;
+
+        return *this;
+    }
+
+    RendererNull::RendererNull()
+        : _windowSize(Settings::SCREEN_WIDTH, Settings::SCREEN_HEIGHT)
+    {
+        // Buffer 0 is never handed out so a zero resource in a recorded command always means "no resource"
+        _buffers.emplace_back();
+
+        _freeCommandListIDs.reserve(MAX_COMMAND_LISTS);
+        for (u32 i = MAX_COMMAND_LISTS; i-- > 0;)
+        {
+            _freeCommandListIDs.push_back(CommandListID(static_cast<CommandListID::type>(i)));
+        }
+    }
+
+    void RendererNull::InitWindow(Window* window)
+    {
+        i32 width = 0;
+        i32 height = 0;
+        glfwGetFramebufferSize(window->GetWindow(), &width, &height);
+
+        if (width > 0 && height > 0)
+        {
+            _windowSize = uvec2(width, height);
+        }
+    }
+
+    void RendererNull::Deinit()
+    {
+        std::scoped_lock lock(_resourceMutex);
+        _buffers.clear();
+        _freeBufferIDs.clear();
+        _bufferBytesAlive = 0;
+    }
+
+    void RendererNull::ReloadShaders(bool forceRecompileAll)
+    {
+        std::scoped_lock lock(_resourceMutex);
+        _vertexShaderIDs.clear();
+        _pixelShaderIDs.clear();
+        _computeShaderIDs.clear();
+        _graphicsPipelineIDs.clear();
+        _computePipelineIDs.clear();
+    }
+
+    void RendererNull::ClearUploadBuffers()
+    {
+    }
+
+    BufferID RendererNull::CreateBuffer(BufferDesc& desc)
+    {
+        return AcquireBuffer(desc, 0);
+    }
+
+    BufferID RendererNull::CreateTemporaryBuffer(BufferDesc& desc, u32 framesLifetime)
+    {
+        return AcquireBuffer(desc, Math::Max(framesLifetime, 1u));
+    }
+
+    void RendererNull::QueueDestroyBuffer(BufferID buffer)
+    {
+        DestroyBuffer(buffer);
+    }
+
+    void RendererNull::DestroyBuffer(BufferID buffer)
+    {
+        std::scoped_lock lock(_resourceMutex);
+
+        BufferID::type id = static_cast<BufferID::type>(buffer);
+        if (id >= _buffers.size() || !_buffers[id].isAlive)
+            return;
+
+        Buffer& nullBuffer = _buffers[id];
+
+        _bufferBytesAlive -= nullBuffer.desc.size;
+
+        nullBuffer.isAlive = false;
+        nullBuffer.mappedMemory.clear();
+        nullBuffer.mappedMemory.shrink_to_fit();
+        _freeBufferIDs.push_back(buffer);
+    }
+
+    ImageID RendererNull::CreateImage(ImageDesc& desc)
+    {
+        std::scoped_lock lock(_resourceMutex);
+
+        size_t id = _images.size();
+        assert(id < ImageID::MaxValue());
+
+        _images.push_back(desc);
+        return ImageID(static_cast<ImageID::type>(id));
+    }
+
+    DepthImageID RendererNull::CreateDepthImage(DepthImageDesc& desc)
+    {
+        std::scoped_lock lock(_resourceMutex);
+
+        size_t id = _depthImages.size();
+        assert(id < DepthImageID::MaxValue());
+
+        _depthImages.push_back(desc);
+        return DepthImageID(static_cast<DepthImageID::type>(id));
+    }
+
+    SamplerID RendererNull::CreateSampler(SamplerDesc& desc)
+    {
+        std::scoped_lock lock(_resourceMutex);
+        return SamplerID(static_cast<SamplerID::type>(_numSamplers++));
+    }
+
+    SemaphoreID RendererNull::CreateNSemaphore()
+    {
+        std::scoped_lock lock(_resourceMutex);
+        return SemaphoreID(static_cast<SemaphoreID::type>(_numSemaphores++));
+    }
+
+    GraphicsPipelineID RendererNull::CreatePipeline(GraphicsPipelineDesc& desc)
+    {
+        // Pipelines are requested every frame, cache them on the same state as the Vulkan backend so IDs stay stable
+        u64 hash = XXHash64::hash(&desc.states, sizeof(GraphicsPipelineDesc::States), 0);
+
+        for (u32 i = 0; i < MAX_RENDER_TARGETS; i++)
+        {
+            if (desc.renderTargets[i] == RenderPassMutableResource::Invalid())
+                break;
+
+            ImageID imageID = desc.MutableResourceToImageID(desc.renderTargets[i]);
+            hash = XXHash64::hash(&imageID, sizeof(ImageID), hash);
+        }
+
+        if (desc.depthStencil != RenderPassMutableResource::Invalid())
+        {
+            DepthImageID depthImageID = desc.MutableResourceToDepthImageID(desc.depthStencil);
+            hash = XXHash64::hash(&depthImageID, sizeof(DepthImageID), hash);
+        }
+
+        std::scoped_lock lock(_resourceMutex);
+        return GetOrAddID<GraphicsPipelineID>(_graphicsPipelineIDs, hash);
+    }
+
+    ComputePipelineID RendererNull::CreatePipeline(ComputePipelineDesc& desc)
+    {
+        u64 hash = XXHash64::hash(&desc.computeShader, sizeof(ComputeShaderID), 0);
+
+        std::scoped_lock lock(_resourceMutex);
+        return GetOrAddID<ComputePipelineID>(_computePipelineIDs, hash);
+    }
+
+    TextureArrayID RendererNull::CreateTextureArray(TextureArrayDesc& desc)
+    {
+        std::scoped_lock lock(_resourceMutex);
+
+        size_t id = _textureArraySizes.size();
+        assert(id < TextureArrayID::MaxValue());
+
+        _textureArraySizes.push_back(0);
+        return TextureArrayID(static_cast<TextureArrayID::type>(id));
+    }
+
+    TextureID RendererNull::CreateDataTexture(DataTextureDesc& desc)
+    {
+        std::scoped_lock lock(_resourceMutex);
+
+        u32 id = _numTextures++;
+        assert(id < TextureID::MaxValue());
+
+        return TextureID(static_cast<TextureID::type>(id));
+    }
+
+    TextureID RendererNull::CreateDataTextureIntoArray(DataTextureDesc& desc, TextureArrayID textureArray, u32& arrayIndex)
+    {
+        TextureID textureID = CreateDataTexture(desc);
+
+        std::scoped_lock lock(_resourceMutex);
+        arrayIndex = _textureArraySizes[static_cast<TextureArrayID::type>(textureArray)]++;
+
+        return textureID;
+    }
+
+    void RendererNull::UpdateDataTexture(TextureID /*textureID*/, DataTextureDesc& /*desc*/)
+    {
+    }
+
+    void RendererNull::UpdateDataTexture(TextureID /*textureID*/, DataTextureDesc& /*desc*/, const DataTextureRegion& /*region*/)
+    {
+    }
+
+    TextureID RendererNull::LoadTexture(TextureDesc& desc)
+    {
+        u64 hash = XXHash64::hash(desc.path.data(), desc.path.size(), 0);
+
+        std::scoped_lock lock(_resourceMutex);
+
+        auto it = _textureIDs.find(hash);
+        if (it != _textureIDs.end())
+            return TextureID(static_cast<TextureID::type>(it->second));
+
+        u32 id = _numTextures++;
+        assert(id < TextureID::MaxValue());
+
+        _textureIDs[hash] = id;
+        return TextureID(static_cast<TextureID::type>(id));
+    }
+
+    TextureID RendererNull::LoadTextureIntoArray(TextureDesc& desc, TextureArrayID textureArray, u32& arrayIndex, bool allowDuplicates)
+    {
+        TextureID textureID = LoadTexture(desc);
+
+        TextureArrayID::type arrayID = static_cast<TextureArrayID::type>(textureArray);
+        u64 arrayHash = XXHash64::hash(desc.path.data(), desc.path.size(), arrayID);
+
+        std::scoped_lock lock(_resourceMutex);
+
+        if (!allowDuplicates)
+        {
+            auto it = _textureArrayIndices.find(arrayHash);
+            if (it != _textureArrayIndices.end())
+            {
+                arrayIndex = it->second;
+                return textureID;
+            }
+        }
+
+        arrayIndex = _textureArraySizes[arrayID]++;
+        _textureArrayIndices[arrayHash] = arrayIndex;
+
+        return textureID;
+    }
+
+    VertexShaderID RendererNull::LoadShader(VertexShaderDesc& desc)
+    {
+        u64 hash = CalculateShaderHash(desc);
+
+        std::scoped_lock lock(_resourceMutex);
+        return GetOrAddID<VertexShaderID>(_vertexShaderIDs, hash);
+    }
+
+    PixelShaderID RendererNull::LoadShader(PixelShaderDesc& desc)
+    {
+        u64 hash = CalculateShaderHash(desc);
+
+        std::scoped_lock lock(_resourceMutex);
+        return GetOrAddID<PixelShaderID>(_pixelShaderIDs, hash);
+    }
+
+    ComputeShaderID RendererNull::LoadShader(ComputeShaderDesc& desc)
+    {
+        u64 hash = CalculateShaderHash(desc);
+
+        std::scoped_lock lock(_resourceMutex);
+        return GetOrAddID<ComputeShaderID>(_computeShaderIDs, hash);
+    }
+
+    void RendererNull::UnloadTexture(TextureID textureID)
+    {
+    }
+
+    void RendererNull::UnloadTexturesInArray(TextureArrayID textureArrayID, u32 unloadStartIndex)
+    {
+        std::scoped_lock lock(_resourceMutex);
+
+        u32& arraySize = _textureArraySizes[static_cast<TextureArrayID::type>(textureArrayID)];
+        arraySize = Math::Min(arraySize, unloadStartIndex);
+    }
+
+    void RendererNull::RequestTextureDetail(const std::vector<TextureStreamingRequest>& /*requests*/)
+    {
+        // Nothing is resident, so there is nothing to stream
+    }
+
+    void RendererNull::SetTextureStreamingBudget(size_t /*budget*/)
+    {
+        // There is no texture streaming without a device
+    }
+
+    TextureStreamingStats RendererNull::GetTextureStreamingStats()
+    {
+        return TextureStreamingStats();
+    }
+
+    TextureLookupBenchmarkResult RendererNull::BenchmarkTextureLookups(u32 /*numQueries*/)
+    {
+        // No textures are ever loaded
+        return TextureLookupBenchmarkResult();
+    }
+
+    CommandListID RendererNull::BeginCommandList()
+    {
+        std::scoped_lock lock(_commandListMutex);
+
+        if (_freeCommandListIDs.empty())
+        {
+            DebugHandler::PrintFatal("RendererNull : Ran out of command lists, more than %u are being recorded at the same time", MAX_COMMAND_LISTS);
+        }
+
+        CommandListID commandListID = _freeCommandListIDs.back();
+        _freeCommandListIDs.pop_back();
+
+        CommandListData& commandList = _commandLists[static_cast<CommandListID::type>(commandListID)];
+        commandList.commands.clear();
+        commandList.stats = Stats();
+        commandList.stats.numCommandLists = 1;
+        commandList.isRecording = true;
+
+        return commandListID;
+    }
+
+    void RendererNull::EndCommandList(CommandListID commandListID)
+    {
+        std::scoped_lock lock(_commandListMutex);
+
+        CommandListData& commandList = _commandLists[static_cast<CommandListID::type>(commandListID)];
+        assert(commandList.isRecording);
+
+        _pendingStats += commandList.stats;
+        if (_recordCommands)
+        {
+            _recordedCommands.insert(_recordedCommands.end(), commandList.commands.begin(), commandList.commands.end());
+        }
+
+        commandList.isRecording = false;
+        _freeCommandListIDs.push_back(commandListID);
+    }
+
+    void RendererNull::Clear(CommandListID commandListID, ImageID image, Color color)
+    {
+        Record(commandListID, RecordedCommandType::Clear, static_cast<ImageID::type>(image));
+    }
+
+    void RendererNull::Clear(CommandListID commandListID, ImageID image, uvec4 values)
+    {
+        Record(commandListID, RecordedCommandType::Clear, static_cast<ImageID::type>(image));
+    }
+
+    void RendererNull::Clear(CommandListID commandListID, ImageID image, ivec4 values)
+    {
+        Record(commandListID, RecordedCommandType::Clear, static_cast<ImageID::type>(image));
+    }
+
+    void RendererNull::Clear(CommandListID commandListID, DepthImageID image, DepthClearFlags clearFlags, f32 depth, u8 stencil)
+    {
+        Record(commandListID, RecordedCommandType::Clear, static_cast<DepthImageID::type>(image));
+    }
+
+    void RendererNull::Draw(CommandListID commandListID, u32 numVertices, u32 numInstances, u32 vertexOffset, u32 instanceOffset)
+    {
+        Stats& stats = _commandLists[static_cast<CommandListID::type>(commandListID)].stats;
+        stats.numDraws++;
+        stats.numVertices += static_cast<u64>(numVertices) * numInstances;
+        stats.numInstances += numInstances;
+
+        Record(commandListID, RecordedCommandType::Draw, 0, numVertices);
+    }
+
+    void RendererNull::DrawIndirect(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset, u32 drawCount)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numIndirectDraws++;
+        Record(commandListID, RecordedCommandType::DrawIndirect, static_cast<BufferID::type>(argumentBuffer), drawCount);
+    }
+
+    void RendererNull::DrawIndexed(CommandListID commandListID, u32 numIndices, u32 numInstances, u32 indexOffset, u32 vertexOffset, u32 instanceOffset)
+    {
+        Stats& stats = _commandLists[static_cast<CommandListID::type>(commandListID)].stats;
+        stats.numDraws++;
+        stats.numIndices += static_cast<u64>(numIndices) * numInstances;
+        stats.numInstances += numInstances;
+
+        Record(commandListID, RecordedCommandType::DrawIndexed, 0, numIndices);
+    }
+
+    void RendererNull::DrawIndexedIndirect(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset, u32 drawCount)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numIndirectDraws++;
+        Record(commandListID, RecordedCommandType::DrawIndexedIndirect, static_cast<BufferID::type>(argumentBuffer), drawCount);
+    }
+
+    void RendererNull::DrawIndexedIndirectCount(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset, BufferID drawCountBuffer, u32 drawCountBufferOffset, u32 maxDrawCount)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numIndirectDraws++;
+        Record(commandListID, RecordedCommandType::DrawIndexedIndirectCount, static_cast<BufferID::type>(argumentBuffer), maxDrawCount);
+    }
+
+    void RendererNull::Dispatch(CommandListID commandListID, u32 threadGroupCountX, u32 threadGroupCountY, u32 threadGroupCountZ)
+    {
+        u64 numThreadGroups = static_cast<u64>(threadGroupCountX) * threadGroupCountY * threadGroupCountZ;
+
+        Stats& stats = _commandLists[static_cast<CommandListID::type>(commandListID)].stats;
+        stats.numDispatches++;
+        stats.numThreadGroups += numThreadGroups;
+
+        Record(commandListID, RecordedCommandType::Dispatch, 0, numThreadGroups);
+    }
+
+    void RendererNull::DispatchIndirect(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numDispatches++;
+        Record(commandListID, RecordedCommandType::DispatchIndirect, static_cast<BufferID::type>(argumentBuffer));
+    }
+
+    void RendererNull::PopMarker(CommandListID commandListID)
+    {
+        Record(commandListID, RecordedCommandType::PopMarker);
+    }
+
+    void RendererNull::PushMarker(CommandListID commandListID, Color color, std::string name)
+    {
+        Record(commandListID, RecordedCommandType::PushMarker);
+    }
+
+    void RendererNull::BeginPipeline(CommandListID commandListID, GraphicsPipelineID pipeline)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numPipelineBinds++;
+        Record(commandListID, RecordedCommandType::BeginPipeline, static_cast<GraphicsPipelineID::type>(pipeline));
+    }
+
+    void RendererNull::EndPipeline(CommandListID commandListID, GraphicsPipelineID pipeline)
+    {
+        Record(commandListID, RecordedCommandType::EndPipeline, static_cast<GraphicsPipelineID::type>(pipeline));
+    }
+
+    void RendererNull::BeginPipeline(CommandListID commandListID, ComputePipelineID pipeline)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numPipelineBinds++;
+        Record(commandListID, RecordedCommandType::BeginPipeline, static_cast<ComputePipelineID::type>(pipeline));
+    }
+
+    void RendererNull::EndPipeline(CommandListID commandListID, ComputePipelineID pipeline)
+    {
+        Record(commandListID, RecordedCommandType::EndPipeline, static_cast<ComputePipelineID::type>(pipeline));
+    }
+
+    void RendererNull::SetScissorRect(CommandListID commandListID, ScissorRect scissorRect)
+    {
+        Record(commandListID, RecordedCommandType::SetScissorRect);
+    }
+
+    void RendererNull::SetViewport(CommandListID commandListID, Viewport viewport)
+    {
+        Record(commandListID, RecordedCommandType::SetViewport);
+    }
+
+    void RendererNull::SetVertexBuffer(CommandListID commandListID, u32 slot, BufferID bufferID)
+    {
+        Record(commandListID, RecordedCommandType::SetVertexBuffer, static_cast<BufferID::type>(bufferID), slot);
+    }
+
+    void RendererNull::SetIndexBuffer(CommandListID commandListID, BufferID bufferID, IndexFormat indexFormat)
+    {
+        Record(commandListID, RecordedCommandType::SetIndexBuffer, static_cast<BufferID::type>(bufferID));
+    }
+
+    void RendererNull::SetBuffer(CommandListID commandListID, u32 slot, BufferID buffer)
+    {
+        Record(commandListID, RecordedCommandType::SetBuffer, static_cast<BufferID::type>(buffer), slot);
+    }
+
+    void RendererNull::BindDescriptorSet(CommandListID commandListID, DescriptorSetSlot slot, Descriptor* descriptors, u32 numDescriptors)
+    {
+        Stats& stats = _commandLists[static_cast<CommandListID::type>(commandListID)].stats;
+        stats.numDescriptorSetBinds++;
+        stats.numDescriptors += numDescriptors;
+
+        Record(commandListID, RecordedCommandType::BindDescriptorSet, slot, numDescriptors);
+    }
+
+    void RendererNull::MarkFrameStart(CommandListID commandListID, u32 frameIndex)
+    {
+        Record(commandListID, RecordedCommandType::MarkFrameStart, 0, frameIndex);
+    }
+
+    void RendererNull::BeginTrace(CommandListID commandListID, const tracy::SourceLocationData* sourceLocation)
+    {
+    }
+
+    void RendererNull::EndTrace(CommandListID commandListID)
+    {
+    }
+
+    void RendererNull::AddSignalSemaphore(CommandListID commandListID, SemaphoreID semaphoreID)
+    {
+    }
+
+    void RendererNull::AddWaitSemaphore(CommandListID commandListID, SemaphoreID semaphoreID)
+    {
+    }
+
+    void RendererNull::CopyImage(CommandListID commandListID, ImageID dstImageID, uvec2 dstPos, u32 dstMipLevel, ImageID srcImageID, uvec2 srcPos, u32 srcMipLevel, uvec2 size)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numCopies++;
+        Record(commandListID, RecordedCommandType::CopyImage, static_cast<ImageID::type>(dstImageID), static_cast<u64>(size.x) * size.y);
+    }
+
+    void RendererNull::CopyDepthImage(CommandListID commandListID, DepthImageID dstImageID, uvec2 dstPos, DepthImageID srcImageID, uvec2 srcPos, uvec2 size)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numCopies++;
+        Record(commandListID, RecordedCommandType::CopyDepthImage, static_cast<DepthImageID::type>(dstImageID), static_cast<u64>(size.x) * size.y);
+    }
+
+    void RendererNull::CopyBuffer(CommandListID commandListID, BufferID dstBuffer, u64 dstOffset, BufferID srcBuffer, u64 srcOffset, u64 range)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numCopies++;
+        Record(commandListID, RecordedCommandType::CopyBuffer, static_cast<BufferID::type>(dstBuffer), range);
+    }
+
+    void RendererNull::PipelineBarrier(CommandListID commandListID, PipelineBarrierType type, BufferID buffer)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numBarriers++;
+        Record(commandListID, RecordedCommandType::PipelineBarrier, static_cast<BufferID::type>(buffer));
+    }
+
+    void RendererNull::ImageBarrier(CommandListID commandListID, ImageID image)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numBarriers++;
+        Record(commandListID, RecordedCommandType::ImageBarrier, static_cast<ImageID::type>(image));
+    }
+
+    void RendererNull::DepthImageBarrier(CommandListID commandListID, DepthImageID image)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numBarriers++;
+        Record(commandListID, RecordedCommandType::DepthImageBarrier, static_cast<DepthImageID::type>(image));
+    }
+
+    void RendererNull::PushConstant(CommandListID commandListID, void* data, u32 offset, u32 size)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numBytesPushed += size;
+        Record(commandListID, RecordedCommandType::PushConstant, 0, size);
+    }
+
+    void RendererNull::FillBuffer(CommandListID commandListID, BufferID dstBuffer, u64 dstOffset, u64 size, u32 data)
+    {
+        Record(commandListID, RecordedCommandType::FillBuffer, static_cast<BufferID::type>(dstBuffer), size);
+    }
+
+    void RendererNull::UpdateBuffer(CommandListID commandListID, BufferID dstBuffer, u64 dstOffset, u64 size, void* data)
+    {
+        _commandLists[static_cast<CommandListID::type>(commandListID)].stats.numBytesPushed += size;
+        Record(commandListID, RecordedCommandType::UpdateBuffer, static_cast<BufferID::type>(dstBuffer), size);
+    }
+
+    void RendererNull::Present(Window* window, ImageID image, SemaphoreID semaphoreID)
+    {
+    }
+
+    void RendererNull::Present(Window* window, DepthImageID image, SemaphoreID semaphoreID)
+    {
+    }
+
+    std::shared_ptr<UploadBuffer> RendererNull::CreateUploadBuffer(BufferID targetBuffer, size_t targetOffset, size_t size)
+    {
+        _uploadCounters.numUploads++;
+        _uploadCounters.numBytesUploaded += size;
+
+        // The caller still writes the whole range, give it real memory so the memcpy cost is part of what we measure
+        u8* memory = new u8[size];
+
+        std::shared_ptr<UploadBuffer> uploadBuffer(new UploadBuffer(), [memory](UploadBuffer* uploadBuffer)
+        {
+            delete[] memory;
+            delete uploadBuffer;
+        });
+        uploadBuffer->mappedMemory = memory;
+        uploadBuffer->size = size;
+
+        return uploadBuffer;
+    }
+
+    bool RendererNull::ShouldWaitForUpload()
+    {
+        return false;
+    }
+
+    void RendererNull::SetHasWaitedForUpload()
+    {
+    }
+
+    SemaphoreID RendererNull::GetUploadFinishedSemaphore()
+    {
+        return SemaphoreID::Invalid();
+    }
+
+    void RendererNull::CopyBuffer(BufferID dstBuffer, u64 dstOffset, BufferID srcBuffer, u64 srcOffset, u64 range)
+    {
+    }
+
+    void* RendererNull::MapBuffer(BufferID buffer)
+    {
+        std::scoped_lock lock(_resourceMutex);
+
+        Buffer& nullBuffer = _buffers[static_cast<BufferID::type>(buffer)];
+        if (nullBuffer.desc.cpuAccess == BufferCPUAccess::None)
+        {
+            DebugHandler::PrintFatal("RendererNull : Tried to map buffer (%s) that was created without CPU access", nullBuffer.desc.name.c_str());
+        }
+
+        // Readback buffers never get written by a GPU, so mapping them reads zeroes
+        if (nullBuffer.mappedMemory.size() != nullBuffer.desc.size)
+        {
+            nullBuffer.mappedMemory.resize(nullBuffer.desc.size, 0);
+        }
+
+        return nullBuffer.mappedMemory.data();
+    }
+
+    void RendererNull::UnmapBuffer(BufferID buffer)
+    {
+    }
+
+    void RendererNull::FlipFrame(u32 frameIndex)
+    {
+        ZoneScopedNC("RendererNull::FlipFrame", tracy::Color::Red2);
+
+        {
+            std::scoped_lock lock(_commandListMutex);
+
+            _frameStats = _pendingStats;
+            _pendingStats = Stats();
+
+            _frameCommands.swap(_recordedCommands);
+            _recordedCommands.clear();
+        }
+
+        _frameStats.numUploads = _uploadCounters.numUploads.exchange(0);
+        _frameStats.numBytesUploaded = _uploadCounters.numBytesUploaded.exchange(0);
+        _frameStats.numBuffersCreated = _uploadCounters.numBuffersCreated.exchange(0);
+        _frameStats.numBufferBytesCreated = _uploadCounters.numBufferBytesCreated.exchange(0);
+
+        _totalStats += _frameStats;
+
+        // Temporary buffers die after their lifetime in frames, same as in the Vulkan backend
+        std::vector<BufferID> buffersToDestroy;
+        {
+            std::scoped_lock lock(_resourceMutex);
+
+            for (size_t i = 1; i < _buffers.size(); i++)
+            {
+                Buffer& nullBuffer = _buffers[i];
+                if (!nullBuffer.isAlive || nullBuffer.framesLifetime == 0)
+                    continue;
+
+                if (--nullBuffer.framesLifetime == 0)
+                {
+                    buffersToDestroy.push_back(BufferID(static_cast<BufferID::type>(i)));
+                }
+            }
+        }
+
+        for (BufferID bufferID : buffersToDestroy)
+        {
+            DestroyBuffer(bufferID);
+        }
+    }
+
+    ImageDesc RendererNull::GetImageDesc(ImageID ID)
+    {
+        std::scoped_lock lock(_resourceMutex);
+        return _images[static_cast<ImageID::type>(ID)];
+    }
+
+    DepthImageDesc RendererNull::GetDepthImageDesc(DepthImageID ID)
+    {
+        std::scoped_lock lock(_resourceMutex);
+        return _depthImages[static_cast<DepthImageID::type>(ID)];
+    }
+
+    uvec2 RendererNull::GetImageDimension(const ImageID id)
+    {
+        return GetImageDimension(id, 0);
+    }
+
+    uvec2 RendererNull::GetImageDimension(const ImageID id, u32 mipLevel)
+    {
+        ImageDesc desc = GetImageDesc(id);
+        return GetScaledDimension(desc.dimensions, desc.dimensionType, desc.mipLevels, mipLevel);
+    }
+
+    uvec2 RendererNull::GetImageDimension(const DepthImageID id)
+    {
+        DepthImageDesc desc = GetDepthImageDesc(id);
+        return GetScaledDimension(desc.dimensions, desc.dimensionType, 1, 0);
+    }
+
+    const std::string& RendererNull::GetGPUName()
+    {
+        return _gpuName;
+    }
+
+    size_t RendererNull::GetVRAMUsage()
+    {
+        std::scoped_lock lock(_resourceMutex);
+        return _bufferBytesAlive;
+    }
+
+    size_t RendererNull::GetVRAMBudget()
+    {
+        // There is no device to run out of memory on, report the same budget as our minimum spec
+        return 1500 * 1000000ull;
+    }
+
+    u32 RendererNull::GetNumDescriptorSetCacheHits()
+    {
+        // Descriptor sets are never built, so there is nothing to cache
+        return 0;
+    }
+
+    u32 RendererNull::GetNumDescriptorSetCacheMisses()
+    {
+        return 0;
+    }
+
+    u32 RendererNull::GetNumCachedDescriptorSets()
+    {
+        return 0;
+    }
+
+    u32 RendererNull::GetNumImages()
+    {
+        std::scoped_lock lock(_resourceMutex);
+        return static_cast<u32>(_images.size());
+    }
+
+    u32 RendererNull::GetNumDepthImages()
+    {
+        std::scoped_lock lock(_resourceMutex);
+        return static_cast<u32>(_depthImages.size());
+    }
+
+    void RendererNull::InitImgui()
+    {
+        // ImGui::NewFrame requires a built font atlas, we just never upload it
+        u8* pixels = nullptr;
+        i32 width = 0;
+        i32 height = 0;
+        ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    }
+
+    void RendererNull::DrawImgui(CommandListID commandListID, ImDrawData* drawData)
+    {
+        Stats& stats = _commandLists[static_cast<CommandListID::type>(commandListID)].stats;
+        stats.numDraws += drawData->CmdListsCount;
+        stats.numIndices += drawData->TotalIdxCount;
+
+        Record(commandListID, RecordedCommandType::DrawImgui, 0, drawData->TotalIdxCount);
+    }
+
+    void RendererNull::Record(CommandListID commandListID, RecordedCommandType type, u32 resource, u64 count)
+    {
+        CommandListData& commandList = _commandLists[static_cast<CommandListID::type>(commandListID)];
+        commandList.stats.numCommands++;
+
+        if (_recordCommands)
+        {
+            RecordedCommand& command = commandList.commands.emplace_back();
+            command.type = type;
+            command.commandList = commandListID;
+            command.resource = resource;
+            command.count = count;
+        }
+    }
+
+    BufferID RendererNull::AcquireBuffer(BufferDesc& desc, u32 framesLifetime)
+    {
+        _uploadCounters.numBuffersCreated++;
+        _uploadCounters.numBufferBytesCreated += desc.size;
+
+        std::scoped_lock lock(_resourceMutex);
+
+        BufferID bufferID;
+        if (!_freeBufferIDs.empty())
+        {
+            bufferID = _freeBufferIDs.back();
+            _freeBufferIDs.pop_back();
+        }
+        else
+        {
+            size_t id = _buffers.size();
+            assert(id < BufferID::MaxValue());
+
+            _buffers.emplace_back();
+            bufferID = BufferID(static_cast<BufferID::type>(id));
+        }
+
+        Buffer& nullBuffer = _buffers[static_cast<BufferID::type>(bufferID)];
+        nullBuffer.desc = desc;
+        nullBuffer.framesLifetime = framesLifetime;
+        nullBuffer.isAlive = true;
+
+        _bufferBytesAlive += desc.size;
+
+        return bufferID;
+    }
+
+    uvec2 RendererNull::GetScaledDimension(vec2 dimensions, ImageDimensionType dimensionType, u32 mipLevels, u32 mipLevel)
+    {
+        u32 width = static_cast<u32>(dimensions.x);
+        u32 height = static_cast<u32>(dimensions.y);
+
+        // Same rules as the Vulkan image handler, scale and pyramid are relative to the window size
+        if (dimensionType == ImageDimensionType::DIMENSION_SCALE || dimensionType == ImageDimensionType::DIMENSION_PYRAMID)
+        {
+            width = static_cast<u32>(dimensions.x * _windowSize.x);
+            height = static_cast<u32>(dimensions.y * _windowSize.y);
+        }
+
+        if (dimensionType == ImageDimensionType::DIMENSION_PYRAMID)
+        {
+            width = PreviousPow2(width);
+            height = PreviousPow2(height);
+            mipLevels = GetImageMipLevels(width, height);
+        }
+
+        u32 mip = glm::min(mipLevels, mipLevel);
+        return { width >> mip, height >> mip };
+    }
+}
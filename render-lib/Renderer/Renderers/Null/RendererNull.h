@@ -0,0 +1,306 @@
+#pragma once
+#include "../../Renderer.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace Renderer
+{
+    // Headless backend, creates no GPU objects and either drops commands or records them so the CPU side of a frame can be measured without a device
+    class RendererNull : public Renderer
+    {
+    public:
+        enum class RecordedCommandType : u8
+        {
+            Clear,
+            Draw,
+            DrawIndirect,
+            DrawIndexed,
+            DrawIndexedIndirect,
+            DrawIndexedIndirectCount,
+            Dispatch,
+            DispatchIndirect,
+            PushMarker,
+            PopMarker,
+            BeginPipeline,
+            EndPipeline,
+            SetScissorRect,
+            SetViewport,
+            SetVertexBuffer,
+            SetIndexBuffer,
+            SetBuffer,
+            BindDescriptorSet,
+            MarkFrameStart,
+            CopyImage,
+            CopyDepthImage,
+            CopyBuffer,
+            PipelineBarrier,
+            ImageBarrier,
+            DepthImageBarrier,
+            PushConstant,
+            FillBuffer,
+            UpdateBuffer,
+            DrawImgui
+        };
+
+        struct RecordedCommand
+        {
+            RecordedCommandType type;
+            CommandListID commandList;
+            u32 resource = 0; // The buffer, image or pipeline the command works on, 0 if there is none
+            u64 count = 0; // Vertices, indices, thread groups, descriptors, draws or bytes depending on the command type
+        };
+
+        struct Stats
+        {
+            Stats& operator+=(const Stats& other);
+
+            u32 numCommandLists = 0;
+            u32 numCommands = 0;
+
+            u32 numDraws = 0;
+            u32 numIndirectDraws = 0;
+            u64 numVertices = 0;
+            u64 numIndices = 0;
+            u64 numInstances = 0;
+
+            u32 numDispatches = 0;
+            u64 numThreadGroups = 0;
+
+            u32 numPipelineBinds = 0;
+            u32 numDescriptorSetBinds = 0;
+            u32 numDescriptors = 0;
+            u32 numBarriers = 0;
+            u32 numCopies = 0;
+
+            u32 numUploads = 0;
+            u64 numBytesUploaded = 0;
+            u64 numBytesPushed = 0; // Push constants and UpdateBuffer
+
+            u32 numBuffersCreated = 0;
+            u64 numBufferBytesCreated = 0;
+        };
+
+        RendererNull();
+
+        void InitWindow(Window* window) override;
+        void Deinit() override;
+
+        void ReloadShaders(bool forceRecompileAll) override;
+        void ClearUploadBuffers() override;
+
+        // Creation
+        [[nodiscard]] BufferID CreateBuffer(BufferDesc& desc) override;
+        [[nodiscard]] BufferID CreateTemporaryBuffer(BufferDesc& desc, u32 framesLifetime) override;
+        void QueueDestroyBuffer(BufferID buffer) override;
+        void DestroyBuffer(BufferID buffer) override;
+
+        [[nodiscard]] ImageID CreateImage(ImageDesc& desc) override;
+        [[nodiscard]] DepthImageID CreateDepthImage(DepthImageDesc& desc) override;
+
+        [[nodiscard]] SamplerID CreateSampler(SamplerDesc& desc) override;
+        [[nodiscard]] SemaphoreID CreateNSemaphore() override;
+
+        [[nodiscard]] GraphicsPipelineID CreatePipeline(GraphicsPipelineDesc& desc) override;
+        [[nodiscard]] ComputePipelineID CreatePipeline(ComputePipelineDesc& desc) override;
+
+        [[nodiscard]] TextureArrayID CreateTextureArray(TextureArrayDesc& desc) override;
+
+        [[nodiscard]] TextureID CreateDataTexture(DataTextureDesc& desc) override;
+        [[nodiscard]] TextureID CreateDataTextureIntoArray(DataTextureDesc& desc, TextureArrayID textureArray, u32& arrayIndex) override;
+        void UpdateDataTexture(TextureID textureID, DataTextureDesc& desc) override;
+        void UpdateDataTexture(TextureID textureID, DataTextureDesc& desc, const DataTextureRegion& region) override;
+
+        // Loading
+        [[nodiscard]] TextureID LoadTexture(TextureDesc& desc) override;
+        [[nodiscard]] TextureID LoadTextureIntoArray(TextureDesc& desc, TextureArrayID textureArray, u32& arrayIndex, bool allowDuplicates = false) override;
+
+        [[nodiscard]] VertexShaderID LoadShader(VertexShaderDesc& desc) override;
+        [[nodiscard]] PixelShaderID LoadShader(PixelShaderDesc& desc) override;
+        [[nodiscard]] ComputeShaderID LoadShader(ComputeShaderDesc& desc) override;
+
+        // Unloading
+        void UnloadTexture(TextureID textureID) override;
+        void UnloadTexturesInArray(TextureArrayID textureArrayID, u32 unloadStartIndex) override;
+
+        void RequestTextureDetail(const std::vector<TextureStreamingRequest>& requests) override;
+        void SetTextureStreamingBudget(size_t budget) override;
+        [[nodiscard]] TextureStreamingStats GetTextureStreamingStats() override;
+
+        [[nodiscard]] TextureLookupBenchmarkResult BenchmarkTextureLookups(u32 numQueries) override;
+
+        // Command List Functions
+        [[nodiscard]] CommandListID BeginCommandList() override;
+        void EndCommandList(CommandListID commandListID) override;
+        void Clear(CommandListID commandListID, ImageID image, Color color) override;
+        void Clear(CommandListID commandListID, ImageID image, uvec4 values) override;
+        void Clear(CommandListID commandListID, ImageID image, ivec4 values) override;
+        void Clear(CommandListID commandListID, DepthImageID image, DepthClearFlags clearFlags, f32 depth, u8 stencil) override;
+        void Draw(CommandListID commandListID, u32 numVertices, u32 numInstances, u32 vertexOffset, u32 instanceOffset) override;
+        void DrawIndirect(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset, u32 drawCount) override;
+        void DrawIndexed(CommandListID commandListID, u32 numIndices, u32 numInstances, u32 indexOffset, u32 vertexOffset, u32 instanceOffset) override;
+        void DrawIndexedIndirect(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset, u32 drawCount) override;
+        void DrawIndexedIndirectCount(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset, BufferID drawCountBuffer, u32 drawCountBufferOffset, u32 maxDrawCount) override;
+        void Dispatch(CommandListID commandListID, u32 threadGroupCountX, u32 threadGroupCountY, u32 threadGroupCountZ) override;
+        void DispatchIndirect(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset) override;
+        void PopMarker(CommandListID commandListID) override;
+        void PushMarker(CommandListID commandListID, Color color, std::string name) override;
+        void BeginPipeline(CommandListID commandListID, GraphicsPipelineID pipeline) override;
+        void EndPipeline(CommandListID commandListID, GraphicsPipelineID pipeline) override;
+        void BeginPipeline(CommandListID commandListID, ComputePipelineID pipeline) override;
+        void EndPipeline(CommandListID commandListID, ComputePipelineID pipeline) override;
+        void SetScissorRect(CommandListID commandListID, ScissorRect scissorRect) override;
+        void SetViewport(CommandListID commandListID, Viewport viewport) override;
+        void SetVertexBuffer(CommandListID commandListID, u32 slot, BufferID bufferID) override;
+        void SetIndexBuffer(CommandListID commandListID, BufferID bufferID, IndexFormat indexFormat) override;
+        void SetBuffer(CommandListID commandListID, u32 slot, BufferID buffer) override;
+        void BindDescriptorSet(CommandListID commandListID, DescriptorSetSlot slot, Descriptor* descriptors, u32 numDescriptors) override;
+        void MarkFrameStart(CommandListID commandListID, u32 frameIndex) override;
+        void BeginTrace(CommandListID commandListID, const tracy::SourceLocationData* sourceLocation) override;
+        void EndTrace(CommandListID commandListID) override;
+        void AddSignalSemaphore(CommandListID commandListID, SemaphoreID semaphoreID) override;
+        void AddWaitSemaphore(CommandListID commandListID, SemaphoreID semaphoreID) override;
+        void CopyImage(CommandListID commandListID, ImageID dstImageID, uvec2 dstPos, u32 dstMipLevel, ImageID srcImageID, uvec2 srcPos, u32 srcMipLevel, uvec2 size) override;
+        void CopyDepthImage(CommandListID commandListID, DepthImageID dstImageID, uvec2 dstPos, DepthImageID srcImageID, uvec2 srcPos, uvec2 size) override;
+        void CopyBuffer(CommandListID commandListID, BufferID dstBuffer, u64 dstOffset, BufferID srcBuffer, u64 srcOffset, u64 range) override;
+        void PipelineBarrier(CommandListID commandListID, PipelineBarrierType type, BufferID buffer) override;
+        void ImageBarrier(CommandListID commandListID, ImageID image) override;
+        void DepthImageBarrier(CommandListID commandListID, DepthImageID image) override;
+        void PushConstant(CommandListID commandListID, void* data, u32 offset, u32 size) override;
+        void FillBuffer(CommandListID commandListID, BufferID dstBuffer, u64 dstOffset, u64 size, u32 data) override;
+        void UpdateBuffer(CommandListID commandListID, BufferID dstBuffer, u64 dstOffset, u64 size, void* data) override;
+
+        // Present functions
+        void Present(Window* window, ImageID image, SemaphoreID semaphoreID = SemaphoreID::Invalid()) override;
+        void Present(Window* window, DepthImageID image, SemaphoreID semaphoreID = SemaphoreID::Invalid()) override;
+
+        // Staging and memory
+        [[nodiscard]] std::shared_ptr<UploadBuffer> CreateUploadBuffer(BufferID targetBuffer, size_t targetOffset, size_t size) override;
+        [[nodiscard]] bool ShouldWaitForUpload() override;
+        void SetHasWaitedForUpload() override;
+        [[nodiscard]] SemaphoreID GetUploadFinishedSemaphore() override;
+
+        void CopyBuffer(BufferID dstBuffer, u64 dstOffset, BufferID srcBuffer, u64 srcOffset, u64 range) override;
+
+        [[nodiscard]] void* MapBuffer(BufferID buffer) override;
+        void UnmapBuffer(BufferID buffer) override;
+
+        // Utils
+        void FlipFrame(u32 frameIndex) override;
+
+        [[nodiscard]] ImageDesc GetImageDesc(ImageID ID) override;
+        [[nodiscard]] DepthImageDesc GetDepthImageDesc(DepthImageID ID) override;
+
+        [[nodiscard]] uvec2 GetImageDimension(const ImageID id) override;
+        [[nodiscard]] uvec2 GetImageDimension(const ImageID id, u32 mipLevel) override;
+
+        [[nodiscard]] uvec2 GetImageDimension(const DepthImageID id) override;
+
+        [[nodiscard]] const std::string& GetGPUName() override;
+
+        [[nodiscard]] size_t GetVRAMUsage() override;
+        [[nodiscard]] size_t GetVRAMBudget() override;
+
+        [[nodiscard]] u32 GetNumDescriptorSetCacheHits() override;
+        [[nodiscard]] u32 GetNumDescriptorSetCacheMisses() override;
+        [[nodiscard]] u32 GetNumCachedDescriptorSets() override;
+
+        [[nodiscard]] u32 GetNumImages() override;
+        [[nodiscard]] u32 GetNumDepthImages() override;
+
+        void InitImgui() override;
+        void DrawImgui(CommandListID commandListID, ImDrawData* drawData) override;
+
+        // Null specific
+        void SetRecordCommands(bool recordCommands) { _recordCommands = recordCommands; }
+        bool IsRecordingCommands() const { return _recordCommands; }
+
+        // Stats and commands of the last frame that was flipped
+        const Stats& GetFrameStats() const { return _frameStats; }
+        const std::vector<RecordedCommand>& GetFrameCommands() const { return _frameCommands; }
+
+        // Stats since the renderer was created
+        const Stats& GetTotalStats() const { return _totalStats; }
+
+    private:
+        struct Buffer
+        {
+            BufferDesc desc;
+            std::vector<u8> mappedMemory; // Only allocated when the buffer is mapped
+            u32 framesLifetime = 0; // 0 for buffers that live until they are destroyed
+            bool isAlive = false;
+        };
+
+        struct CommandListData
+        {
+            std::vector<RecordedCommand> commands;
+            Stats stats; // Only touched by the thread recording the command list, merged into the frame when it ends
+            bool isRecording = false;
+        };
+
+        // Uploads and buffer creation happen concurrently on the loader threads
+        struct UploadCounters
+        {
+            std::atomic<u32> numUploads = 0;
+            std::atomic<u64> numBytesUploaded = 0;
+            std::atomic<u32> numBuffersCreated = 0;
+            std::atomic<u64> numBufferBytesCreated = 0;
+        };
+
+        void Record(CommandListID commandListID, RecordedCommandType type, u32 resource = 0, u64 count = 0);
+        BufferID AcquireBuffer(BufferDesc& desc, u32 framesLifetime);
+        uvec2 GetScaledDimension(vec2 dimensions, ImageDimensionType dimensionType, u32 mipLevels, u32 mipLevel);
+
+        template <typename T>
+        T GetOrAddID(std::unordered_map<u64, u32>& ids, u64 hash)
+        {
+            auto it = ids.find(hash);
+            if (it != ids.end())
+                return T(static_cast<typename T::type>(it->second));
+
+            u32 id = static_cast<u32>(ids.size());
+            assert(id < T::MaxValue());
+
+            ids[hash] = id;
+            return T(static_cast<typename T::type>(id));
+        }
+
+    private:
+        static constexpr u32 MAX_COMMAND_LISTS = 64;
+
+        std::string _gpuName = "Null Renderer";
+        uvec2 _windowSize;
+
+        std::mutex _resourceMutex;
+        std::vector<Buffer> _buffers;
+        std::vector<BufferID> _freeBufferIDs;
+        size_t _bufferBytesAlive = 0;
+
+        std::vector<ImageDesc> _images;
+        std::vector<DepthImageDesc> _depthImages;
+        std::vector<u32> _textureArraySizes;
+        std::unordered_map<u64, u32> _textureArrayIndices; // Texture path hash combined with the array ID
+        std::unordered_map<u64, u32> _textureIDs; // Texture path hash, data textures are never shared
+        u32 _numTextures = 0;
+        std::unordered_map<u64, u32> _vertexShaderIDs;
+        std::unordered_map<u64, u32> _pixelShaderIDs;
+        std::unordered_map<u64, u32> _computeShaderIDs;
+        std::unordered_map<u64, u32> _graphicsPipelineIDs;
+        std::unordered_map<u64, u32> _computePipelineIDs;
+        u32 _numSamplers = 0;
+        u32 _numSemaphores = 0;
+
+        std::mutex _commandListMutex;
+        std::array<CommandListData, MAX_COMMAND_LISTS> _commandLists;
+        std::vector<CommandListID> _freeCommandListIDs;
+        std::vector<RecordedCommand> _recordedCommands;
+        bool _recordCommands = false;
+
+        UploadCounters _uploadCounters;
+        Stats _pendingStats; // Command lists that ended since the last FlipFrame
+        Stats _frameStats;
+        Stats _totalStats;
+        std::vector<RecordedCommand> _frameCommands;
+    };
+}
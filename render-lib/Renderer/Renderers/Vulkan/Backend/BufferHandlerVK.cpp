@@ -1,5 +1,6 @@
 #include "BufferHandlerVK.h"
 #include "RenderDeviceVK.h"
+#include "DescriptorSetCacheVK.h"
 #include "DebugMarkerUtilVK.h"
 
 #include <vector>
@@ -195,6 +196,7 @@ namespace Renderer
             {
                 Buffer& buffer = buffers[(BufferID::type)bufferID];
 
+                _device->_descriptorSetCache->InvalidateHandle(reinterpret_cast<u64>(buffer.buffer));
                 vmaDestroyBuffer(_device->_allocator, buffer.buffer, buffer.allocation);
             });
 
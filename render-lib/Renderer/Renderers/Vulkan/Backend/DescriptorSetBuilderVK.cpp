@@ -403,19 +403,11 @@ namespace Renderer
 
         VkDescriptorSet DescriptorSetBuilderVK::BuildDescriptor(i32 set, DescriptorLifetime lifetime)
         {
-            VkDescriptorSetLayout* layout; 
-            if (_pipelineType == PipelineType::Graphics)
-            {
-                layout = &_pipelineHandler->GetDescriptorSetLayout(_graphicsPipelineID, set);
-            }
-            else
-            {
-                layout = &_pipelineHandler->GetDescriptorSetLayout(_computePipelineID, set);
-            }
+            VkDescriptorSetLayout layout = GetDescriptorSetLayout(set);
 
             void* next = nullptr;
             u32 counts[1];
-            counts[0] = 4096;
+            counts[0] = GetVariableDescriptorCount(set);
 
             VkDescriptorSetVariableDescriptorCountAllocateInfo setCounts = {};
             setCounts.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
@@ -423,18 +415,41 @@ namespace Renderer
             setCounts.descriptorSetCount = 1;
             setCounts.pDescriptorCounts = counts;
 
+            if (counts[0] > 0)
+            {
+                next = &setCounts;
+            }
+
+            VkDescriptorSet newSet = _parentPool->AllocateDescriptor(layout, lifetime, next);
+            UpdateDescriptor(set, newSet, *_parentPool->_device);
+            return newSet;
+        }
+
+        VkDescriptorSetLayout DescriptorSetBuilderVK::GetDescriptorSetLayout(i32 set)
+        {
+            if (_pipelineType == PipelineType::Graphics)
+            {
+                return _pipelineHandler->GetDescriptorSetLayout(_graphicsPipelineID, set);
+            }
+            else
+            {
+                return _pipelineHandler->GetDescriptorSetLayout(_computePipelineID, set);
+            }
+        }
+
+        u32 DescriptorSetBuilderVK::GetVariableDescriptorCount(i32 set)
+        {
+            u32 count = 0;
+
             for (const ImageWriteDescriptor& imageWrite : _imageWrites)
             {
                 if (imageWrite.descriptorType != VK_DESCRIPTOR_TYPE_STORAGE_IMAGE && imageWrite.imageArray != nullptr && imageWrite.dstSet == set)
                 {
-                    counts[0] = imageWrite.imageCount;
-                    next = &setCounts;
+                    count = imageWrite.imageCount;
                 }
             }
 
-            VkDescriptorSet newSet = _parentPool->AllocateDescriptor(*layout, lifetime, next);
-            UpdateDescriptor(set, newSet, *_parentPool->_device);
-            return newSet;
+            return count;
         }
 
         VkDescriptorSet DescriptorMegaPoolVK::AllocateDescriptor(VkDescriptorSetLayout layout, DescriptorLifetime lifetime, void* next)
@@ -56,6 +56,9 @@ namespace Renderer
             void UpdateDescriptor(i32 set, VkDescriptorSet& descriptor, RenderDeviceVK& device);
             VkDescriptorSet BuildDescriptor(i32 set, DescriptorLifetime lifetime);
 
+            VkDescriptorSetLayout GetDescriptorSetLayout(i32 set);
+            u32 GetVariableDescriptorCount(i32 set); // 0 if the set has no image array bound
+
         private:
             enum class PipelineType
             {
@@ -0,0 +1,271 @@
+#include "DescriptorSetCacheVK.h"
+#include <Utils/XXHash64.h>
+#include <vulkan/vulkan.h>
+#include <robin_hood.h>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+
+#include "RenderDeviceVK.h"
+#include "DescriptorSetBuilderVK.h"
+#include "../../../RenderSettings.h"
+
+namespace Renderer
+{
+    namespace Backend
+    {
+        struct CachedDescriptorSet
+        {
+            VkDescriptorSet descriptorSet;
+            VkDescriptorPool pool;
+            u64 layoutHash; // Layout and variable descriptor count, sets can only be recycled into sets with the same ones
+            u64 lastUsedFrame;
+
+            std::vector<u64> handles;
+        };
+
+        struct FreeDescriptorSet
+        {
+            VkDescriptorSet descriptorSet;
+            VkDescriptorPool pool;
+            u64 lastUsedFrame;
+        };
+
+        struct DescriptorSetCacheVKData : IDescriptorSetCacheVKData
+        {
+            std::mutex mutex;
+
+            robin_hood::unordered_map<u64, CachedDescriptorSet> descriptorSets;
+            robin_hood::unordered_map<u64, std::vector<u64>> handleToDescriptorSets;
+            robin_hood::unordered_map<u64, std::deque<FreeDescriptorSet>> freeDescriptorSets;
+
+            u64 frame = 0;
+
+            u32 numHits = 0;
+            u32 numMisses = 0;
+            u32 lastFrameNumHits = 0;
+            u32 lastFrameNumMisses = 0;
+        };
+
+        static void RetireDescriptorSet(DescriptorSetCacheVKData& data, u64 hash)
+        {
+            auto itr = data.descriptorSets.find(hash);
+            if (itr == data.descriptorSets.end())
+                return;
+
+            CachedDescriptorSet& cachedSet = itr->second;
+
+            // No frame in flight can use it after FRAME_INDEX_COUNT frames have passed since it was last bound, then it can be rewritten
+            FreeDescriptorSet& freeSet = data.freeDescriptorSets[cachedSet.layoutHash].emplace_back();
+            freeSet.descriptorSet = cachedSet.descriptorSet;
+            freeSet.pool = cachedSet.pool;
+            freeSet.lastUsedFrame = cachedSet.lastUsedFrame;
+
+            for (u64 handle : cachedSet.handles)
+            {
+                auto handleItr = data.handleToDescriptorSets.find(handle);
+                if (handleItr == data.handleToDescriptorSets.end())
+                    continue;
+
+                std::vector<u64>& hashes = handleItr->second;
+                hashes.erase(std::remove(hashes.begin(), hashes.end(), hash), hashes.end());
+
+                if (hashes.empty())
+                {
+                    data.handleToDescriptorSets.erase(handleItr);
+                }
+            }
+
+            data.descriptorSets.erase(itr);
+        }
+
+        DescriptorSetCacheVK::~DescriptorSetCacheVK()
+        {
+            delete _data;
+        }
+
+        void DescriptorSetCacheVK::Init(RenderDeviceVK* device)
+        {
+            _device = device;
+            _data = new DescriptorSetCacheVKData();
+        }
+
+        bool DescriptorSetCacheVK::TryGetDescriptorSet(u64 hash, VkDescriptorSet& outDescriptorSet)
+        {
+            DescriptorSetCacheVKData& data = static_cast<DescriptorSetCacheVKData&>(*_data);
+            std::scoped_lock lock(data.mutex);
+
+            auto itr = data.descriptorSets.find(hash);
+            if (itr == data.descriptorSets.end())
+            {
+                data.numMisses++;
+                return false;
+            }
+
+            itr->second.lastUsedFrame = data.frame;
+            outDescriptorSet = itr->second.descriptorSet;
+
+            data.numHits++;
+            return true;
+        }
+
+        VkDescriptorSet DescriptorSetCacheVK::AddDescriptorSet(u64 hash, DescriptorSetBuilderVK* builder, i32 set, const u64* handles, u32 numHandles)
+        {
+            ZoneScoped;
+
+            DescriptorSetCacheVKData& data = static_cast<DescriptorSetCacheVKData&>(*_data);
+            std::scoped_lock lock(data.mutex);
+
+            // Another thread recording the same pass might have beaten us to it
+            auto itr = data.descriptorSets.find(hash);
+            if (itr != data.descriptorSets.end())
+            {
+                itr->second.lastUsedFrame = data.frame;
+                return itr->second.descriptorSet;
+            }
+
+            struct LayoutKey
+            {
+                VkDescriptorSetLayout layout;
+                u32 variableDescriptorCount;
+            } layoutKey = {};
+            layoutKey.layout = builder->GetDescriptorSetLayout(set);
+            layoutKey.variableDescriptorCount = builder->GetVariableDescriptorCount(set);
+
+            CachedDescriptorSet cachedSet;
+            cachedSet.layoutHash = XXHash64::hash(&layoutKey, sizeof(LayoutKey), 0);
+            cachedSet.lastUsedFrame = data.frame;
+            cachedSet.handles.assign(handles, handles + numHandles);
+
+            std::deque<FreeDescriptorSet>& freeSets = data.freeDescriptorSets[cachedSet.layoutHash];
+            if (!freeSets.empty() && freeSets.front().lastUsedFrame + RenderDeviceVK::FRAME_INDEX_COUNT <= data.frame)
+            {
+                cachedSet.descriptorSet = freeSets.front().descriptorSet;
+                cachedSet.pool = freeSets.front().pool;
+                freeSets.pop_front();
+
+                builder->UpdateDescriptor(set, cachedSet.descriptorSet, *_device);
+            }
+            else
+            {
+                // Cached sets outlive the frame, so they come from the static pool rather than the per frame one
+                cachedSet.descriptorSet = builder->BuildDescriptor(set, DescriptorLifetime::Static);
+                cachedSet.pool = _device->_descriptorMegaPool->_staticHandle.vkPool;
+            }
+
+            for (u32 i = 0; i < numHandles; i++)
+            {
+                data.handleToDescriptorSets[handles[i]].push_back(hash);
+            }
+
+            VkDescriptorSet descriptorSet = cachedSet.descriptorSet;
+            data.descriptorSets.emplace(hash, std::move(cachedSet));
+
+            return descriptorSet;
+        }
+
+        void DescriptorSetCacheVK::InvalidateHandle(u64 handle)
+        {
+            DescriptorSetCacheVKData& data = static_cast<DescriptorSetCacheVKData&>(*_data);
+            std::scoped_lock lock(data.mutex);
+
+            auto itr = data.handleToDescriptorSets.find(handle);
+            if (itr == data.handleToDescriptorSets.end())
+                return;
+
+            // Retiring removes the hashes from this list, so we need a copy
+            std::vector<u64> hashes = itr->second;
+            for (u64 hash : hashes)
+            {
+                RetireDescriptorSet(data, hash);
+            }
+
+            data.handleToDescriptorSets.erase(handle);
+        }
+
+        void DescriptorSetCacheVK::FlipFrame()
+        {
+            ZoneScoped;
+
+            DescriptorSetCacheVKData& data = static_cast<DescriptorSetCacheVKData&>(*_data);
+            std::scoped_lock lock(data.mutex);
+
+            data.frame++;
+
+            data.lastFrameNumHits = data.numHits;
+            data.lastFrameNumMisses = data.numMisses;
+            data.numHits = 0;
+            data.numMisses = 0;
+
+            // Retire sets that haven't been bound in a while so they can be recycled for new combinations of resources
+            std::vector<u64> unusedHashes;
+            for (auto& [hash, cachedSet] : data.descriptorSets)
+            {
+                if (cachedSet.lastUsedFrame + Settings::DESCRIPTOR_SET_CACHE_MAX_UNUSED_FRAMES < data.frame)
+                {
+                    unusedHashes.push_back(hash);
+                }
+            }
+
+            for (u64 hash : unusedHashes)
+            {
+                RetireDescriptorSet(data, hash);
+            }
+
+            // And give back the ones that didn't get recycled either
+            for (auto& [layoutHash, freeSets] : data.freeDescriptorSets)
+            {
+                while (!freeSets.empty() && freeSets.front().lastUsedFrame + Settings::DESCRIPTOR_SET_CACHE_MAX_UNUSED_FRAMES * 2 < data.frame)
+                {
+                    vkFreeDescriptorSets(_device->_device, freeSets.front().pool, 1, &freeSets.front().descriptorSet);
+                    freeSets.pop_front();
+                }
+            }
+        }
+
+        void DescriptorSetCacheVK::Clear()
+        {
+            DescriptorSetCacheVKData& data = static_cast<DescriptorSetCacheVKData&>(*_data);
+            std::scoped_lock lock(data.mutex);
+
+            for (auto& [hash, cachedSet] : data.descriptorSets)
+            {
+                vkFreeDescriptorSets(_device->_device, cachedSet.pool, 1, &cachedSet.descriptorSet);
+            }
+
+            for (auto& [layoutHash, freeSets] : data.freeDescriptorSets)
+            {
+                for (FreeDescriptorSet& freeSet : freeSets)
+                {
+                    vkFreeDescriptorSets(_device->_device, freeSet.pool, 1, &freeSet.descriptorSet);
+                }
+            }
+
+            data.descriptorSets.clear();
+            data.handleToDescriptorSets.clear();
+            data.freeDescriptorSets.clear();
+        }
+
+        u32 DescriptorSetCacheVK::GetNumHits()
+        {
+            DescriptorSetCacheVKData& data = static_cast<DescriptorSetCacheVKData&>(*_data);
+            return data.lastFrameNumHits;
+        }
+
+        u32 DescriptorSetCacheVK::GetNumMisses()
+        {
+            DescriptorSetCacheVKData& data = static_cast<DescriptorSetCacheVKData&>(*_data);
+            return data.lastFrameNumMisses;
+        }
+
+        u32 DescriptorSetCacheVK::GetNumDescriptorSets()
+        {
+            DescriptorSetCacheVKData& data = static_cast<DescriptorSetCacheVKData&>(*_data);
+            std::scoped_lock lock(data.mutex);
+
+            return static_cast<u32>(data.descriptorSets.size());
+        }
+    }
+}
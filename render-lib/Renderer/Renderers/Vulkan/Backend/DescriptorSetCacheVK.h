@@ -0,0 +1,45 @@
+#pragma once
+#include <NovusTypes.h>
+#include <vulkan/vulkan_core.h>
+
+namespace Renderer
+{
+    namespace Backend
+    {
+        class RenderDeviceVK;
+        class DescriptorSetBuilderVK;
+
+        struct IDescriptorSetCacheVKData {};
+
+        // Keeps built descriptor sets around between frames, keyed on a hash of their layout and the resources bound to them
+        class DescriptorSetCacheVK
+        {
+        public:
+            ~DescriptorSetCacheVK();
+
+            void Init(RenderDeviceVK* device);
+
+            bool TryGetDescriptorSet(u64 hash, VkDescriptorSet& outDescriptorSet);
+
+            // Builds (or rewrites a recycled) descriptor set from what is currently bound to the builder, handles are the buffers, image views and samplers it references
+            VkDescriptorSet AddDescriptorSet(u64 hash, DescriptorSetBuilderVK* builder, i32 set, const u64* handles, u32 numHandles);
+
+            // Drops every cached descriptor set referencing this handle, has to be called before the resource behind it is destroyed
+            void InvalidateHandle(u64 handle);
+
+            void FlipFrame();
+
+            // Frees every cached descriptor set, the device has to be idle
+            void Clear();
+
+            u32 GetNumHits(); // During the last frame
+            u32 GetNumMisses(); // During the last frame
+            u32 GetNumDescriptorSets();
+
+        private:
+            RenderDeviceVK* _device;
+
+            IDescriptorSetCacheVKData* _data;
+        };
+    }
+}
@@ -5,6 +5,7 @@
 #include "ImageHandlerVK.h"
 #include "SemaphoreHandlerVK.h"
 #include "DescriptorSetBuilderVK.h"
+#include "DescriptorSetCacheVK.h"
 #include "../../../../Window/Window.h"
 #include "../../../Descriptors/VertexShaderDesc.h"
 #include "../../../Descriptors/PixelShaderDesc.h"
@@ -59,6 +60,7 @@ namespace Renderer
         {
             // TODO: All cleanup
 
+            delete _descriptorSetCache;
             delete _descriptorMegaPool;
             delete _imguiContext;
         }
@@ -147,6 +149,9 @@ namespace Renderer
             _descriptorMegaPool = new DescriptorMegaPoolVK();
             _descriptorMegaPool->Init(FRAME_INDEX_COUNT, this);
 
+            _descriptorSetCache = new DescriptorSetCacheVK();
+            _descriptorSetCache->Init(this);
+
             fnVkCmdDrawIndexedIndirectCountKHR = (PFN_vkCmdDrawIndexedIndirectCountKHR)vkGetDeviceProcAddr(_device, "vkCmdDrawIndexedIndirectCountKHR");
 
             _initialized = true;
@@ -1372,6 +1377,25 @@ namespace Renderer
             );
         }
 
+        void RenderDeviceVK::CopyBufferToImageRegion(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, size_t srcOffset, VkImage dstImage, i32 x, i32 y, u32 width, u32 height, u32 numLayers)
+        {
+            // The source is tightly packed, one width * height rect per layer
+            VkBufferImageCopy region = {};
+            region.bufferOffset = srcOffset;
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
+
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.mipLevel = 0;
+            region.imageSubresource.baseArrayLayer = 0;
+            region.imageSubresource.layerCount = numLayers;
+
+            region.imageOffset = { x, y, 0 };
+            region.imageExtent = { width, height, 1 };
+
+            vkCmdCopyBufferToImage(commandBuffer, srcBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+        }
+
         void RenderDeviceVK::TransitionImageLayout(VkImage image, VkImageAspectFlags aspects, VkImageLayout oldLayout, VkImageLayout newLayout, u32 numLayers, u32 numMipLevels)
         {
             VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
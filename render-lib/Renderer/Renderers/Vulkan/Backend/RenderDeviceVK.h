@@ -24,6 +24,7 @@ namespace Renderer
         class ImageHandlerVK;
         class SemaphoreHandlerVK;
         struct DescriptorMegaPoolVK;
+        class DescriptorSetCacheVK;
 
         struct QueueFamilyIndices
         {
@@ -88,6 +89,7 @@ namespace Renderer
             void CopyBuffer(VkBuffer dstBuffer, u64 dstOffset, VkBuffer srcBuffer, u64 srcOffset, u64 range);
             void CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkFormat format, u32 width, u32 height, u32 numLayers, u32 numMipLevels);
             void CopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, size_t srcOffset, VkImage dstImage, VkFormat format, u32 width, u32 height, u32 numLayers, u32 numMipLevels);
+            void CopyBufferToImageRegion(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, size_t srcOffset, VkImage dstImage, i32 x, i32 y, u32 width, u32 height, u32 numLayers);
             void TransitionImageLayout(VkImage image, VkImageAspectFlags aspects, VkImageLayout oldLayout, VkImageLayout newLayout, u32 numLayers, u32 numMipLevels);
             void TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkImageAspectFlags aspects, VkImageLayout oldLayout, VkImageLayout newLayout, u32 numLayers, u32 numMipLevels);
 
@@ -119,6 +121,7 @@ namespace Renderer
             VmaAllocator _allocator;
 
             DescriptorMegaPoolVK* _descriptorMegaPool;
+            DescriptorSetCacheVK* _descriptorSetCache;
 
             tracy::VkCtx* _tracyContext = nullptr;
             struct ImguiContext* _imguiContext = nullptr;
@@ -136,6 +139,7 @@ namespace Renderer
             friend struct DescriptorAllocatorHandleVK;
             friend class DescriptorAllocatorPoolVKImpl;
             friend class DescriptorSetBuilderVK;
+            friend class DescriptorSetCacheVK;
         };
     }
 }
\ No newline at end of file
@@ -4,19 +4,31 @@
 #include <Utils/StringUtils.h>
 #include <Utils/XXHash64.h>
 #include <Utils/FileReader.h>
+#include <Utils/ByteBuffer.h>
 #include <Utils/SafeVector.h>
+#include <Utils/SafeUnorderedMap.h>
+#include <Utils/Timer.h>
 #include <vulkan/vulkan.h>
 #include <gli/gli.hpp>
 #include <vector>
 #include <queue>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <filesystem>
+#include <algorithm>
+#include <limits>
+#include <random>
 
 #include "vk_mem_alloc.h"
 #include "RenderDeviceVK.h"
+#include "DescriptorSetCacheVK.h"
 #include "FormatConverterVK.h"
 #include "DebugMarkerUtilVK.h"
 #include "BufferHandlerVK.h"
 #include "UploadBufferHandlerVK.h"
+#include "../../../RenderSettings.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -33,24 +45,54 @@ namespace Renderer
         {
             bool loaded = true;
             u64 hash;
+            u32 generation = 0; // Bumped on unload, load requests that were queued for an older generation are dropped
 
             TextureID::type textureIndex;
 
-            i32 width;
-            i32 height;
-            i32 layers;
-            i32 mipLevels;
+            i32 width = 0;
+            i32 height = 0;
+            i32 layers = 1;
+            i32 mipLevels = 1;
 
-            VkFormat format;
-            size_t fileSize;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            size_t fileSize = 0;
 
-            VmaAllocation allocation;
-            VkImage image;
-            VkImageView imageView;
+            // These stay null until a load thread has decoded the file and created the image
+            VmaAllocation allocation = nullptr;
+            VkImage image = VK_NULL_HANDLE;
+            VkImageView imageView = VK_NULL_HANDLE;
 
             std::string debugName = "";
 
             bool layoutUndefined = true;
+
+            // When streaming changes which mips are resident the new image is created here, CopyBufferToImage swaps it in once it has been uploaded
+            Texture* pending = nullptr;
+        };
+
+        struct TextureStreamingState
+        {
+            std::string path;
+            u32 generation = 0;
+
+            u32 residentBaseMip = 0; // Mip level of the file that is level 0 of the resident image
+            u32 maxBaseMip = 0;
+            std::vector<size_t> mipSizes; // Size of each mip level in the file
+            bool isLoading = false;
+            size_t pendingFreeBytes = 0; // What the requested load frees once it is swapped in and the old image is retired, only valid while isLoading
+
+            f32 distance = 0.0f;
+            u32 lastRequestedFrame = 0; // 0 means it has never been requested, those textures are kept at full detail
+        };
+
+        struct RetiredTextureImage
+        {
+            VmaAllocation allocation;
+            VkImage image;
+            VkImageView imageView;
+            size_t size;
+
+            u32 framesLeft; // In-flight frames might still have descriptors pointing at the image
         };
 
         struct TextureArray
@@ -59,22 +101,177 @@ namespace Renderer
 
             SafeVector<TextureID>* textures = nullptr;
             SafeVector<u64>* textureHashes = nullptr;
+            SafeUnorderedMap<u64, u32>* textureHashToArrayIndex = nullptr; // Mirrors textureHashes so lookups don't have to scan the array
+        };
+
+        struct TextureLoadRequest
+        {
+            std::string path;
+            TextureID textureID;
+            u32 generation = 0;
+
+            bool isInitialLoad = true;
+            u32 baseMip = 0;
         };
 
         struct TextureHandlerVKData : ITextureHandlerVKData
         {
             SafeVector<Texture*> textures;
+            SafeUnorderedMap<u64, TextureID::type> textureHashToIndex; // Only contains loaded textures, data textures are never deduplicated
             std::queue<Texture*> freeTextureQueue;
 
             SafeVector<TextureArray> textureArrays;
+
+            std::vector<std::thread> loadThreads;
+            std::mutex loadMutex;
+            std::condition_variable loadCondition;
+            std::deque<TextureLoadRequest> loadRequests;
+            bool loadThreadsShouldExit = false;
+
+            // Only mipmapped single layer DDS/KTX textures are streamed, everything else is always fully resident
+            std::mutex streamingMutex;
+            robin_hood::unordered_map<TextureID::type, TextureStreamingState> streamingStates;
+            std::vector<RetiredTextureImage> retiredImages;
+            u32 streamingFrame = 1;
+            size_t streamingBudgetOverride = 0; // Replaces the device budget when set
+            size_t lastStreamingBudget = 0;
+        };
+
+        struct DDSInfo
+        {
+            gli::format format = gli::FORMAT_UNDEFINED;
+            i32 width = 0;
+            i32 height = 0;
+            i32 depth = 1;
+            i32 layers = 1;
+            i32 faces = 1;
+            i32 mipLevels = 1;
+
+            size_t payloadOffset = 0; // Mips are stored layer by layer, face by face, largest first, the same layout CopyBufferToImage expects
+            std::vector<size_t> mipSizes; // Size of each mip level of one face
         };
 
+        // The DDS payload is raw, so instead of letting gli copy it into its own storage we only parse the header and upload straight from the file data
+        static bool ParseDDSHeader(const u8* fileData, size_t fileSize, DDSInfo& info)
+        {
+            size_t offset = sizeof(gli::detail::FOURCC_DDS);
+            if (fileSize < offset + sizeof(gli::detail::dds_header))
+                return false;
+
+            gli::detail::dds_header header;
+            memcpy(&header, fileData + offset, sizeof(header));
+            offset += sizeof(header);
+
+            gli::detail::dds_header10 header10;
+            bool hasHeader10 = (header.Format.flags & gli::dx::DDPF_FOURCC) && (header.Format.fourCC == gli::dx::D3DFMT_DX10 || header.Format.fourCC == gli::dx::D3DFMT_GLI1);
+            if (hasHeader10)
+            {
+                if (fileSize < offset + sizeof(header10))
+                    return false;
+
+                memcpy(&header10, fileData + offset, sizeof(header10));
+                offset += sizeof(header10);
+            }
+
+            gli::dx dx;
+            if (hasHeader10)
+            {
+                info.format = dx.find(header.Format.fourCC, header10.Format);
+            }
+            else if (header.Format.flags & gli::dx::DDPF_FOURCC)
+            {
+                info.format = dx.find(gli::detail::remap_four_cc(header.Format.fourCC));
+            }
+            else if (header.Format.bpp != 0)
+            {
+                // Uncompressed formats are identified by their channel masks, in the same order gli::load_dds checks them
+                static const gli::format maskedFormats[] =
+                {
+                    gli::FORMAT_RG4_UNORM_PACK8, gli::FORMAT_L8_UNORM_PACK8, gli::FORMAT_A8_UNORM_PACK8, gli::FORMAT_R8_UNORM_PACK8, gli::FORMAT_RG3B2_UNORM_PACK8,
+                    gli::FORMAT_RGBA4_UNORM_PACK16, gli::FORMAT_BGRA4_UNORM_PACK16, gli::FORMAT_R5G6B5_UNORM_PACK16, gli::FORMAT_B5G6R5_UNORM_PACK16, gli::FORMAT_RGB5A1_UNORM_PACK16,
+                    gli::FORMAT_BGR5A1_UNORM_PACK16, gli::FORMAT_LA8_UNORM_PACK8, gli::FORMAT_RG8_UNORM_PACK8, gli::FORMAT_L16_UNORM_PACK16, gli::FORMAT_A16_UNORM_PACK16,
+                    gli::FORMAT_R16_UNORM_PACK16, gli::FORMAT_RGB8_UNORM_PACK8, gli::FORMAT_BGR8_UNORM_PACK8, gli::FORMAT_BGR8_UNORM_PACK32, gli::FORMAT_BGRA8_UNORM_PACK8,
+                    gli::FORMAT_RGBA8_UNORM_PACK8, gli::FORMAT_RGB10A2_UNORM_PACK32, gli::FORMAT_LA16_UNORM_PACK16, gli::FORMAT_RG16_UNORM_PACK16, gli::FORMAT_R32_SFLOAT_PACK32
+                };
+
+                for (gli::format maskedFormat : maskedFormats)
+                {
+                    if (gli::block_size(maskedFormat) * 8 == header.Format.bpp && glm::all(glm::equal(header.Format.Mask, dx.translate(maskedFormat).Mask)))
+                    {
+                        info.format = maskedFormat;
+                        break;
+                    }
+                }
+            }
+
+            if (info.format == gli::FORMAT_UNDEFINED)
+                return false;
+
+            info.width = static_cast<i32>(header.Width);
+            info.height = static_cast<i32>(header.Height);
+            info.depth = (header.CubemapFlags & gli::detail::DDSCAPS2_VOLUME) ? Math::Max(1, static_cast<i32>(header.Depth)) : 1;
+            info.layers = Math::Max(1, static_cast<i32>(header10.ArraySize));
+            info.mipLevels = (header.Flags & gli::detail::DDSD_MIPMAPCOUNT) ? Math::Max(1, static_cast<i32>(header.MipMapLevels)) : 1;
+
+            if (header.CubemapFlags & gli::detail::DDSCAPS2_CUBEMAP)
+            {
+                info.faces = static_cast<i32>(glm::bitCount(header.CubemapFlags & gli::detail::DDSCAPS2_CUBEMAP_ALLFACES));
+            }
+            else if (header10.MiscFlag & gli::detail::D3D10_RESOURCE_MISC_TEXTURECUBE)
+            {
+                info.faces = 6;
+            }
+
+            const glm::ivec3 blockExtent = gli::block_extent(info.format);
+            const size_t blockSize = gli::block_size(info.format);
+
+            size_t faceSize = 0;
+            info.mipSizes.resize(info.mipLevels);
+            for (i32 i = 0; i < info.mipLevels; i++)
+            {
+                size_t blocksX = (Math::Max(1, info.width >> i) + blockExtent.x - 1) / blockExtent.x;
+                size_t blocksY = (Math::Max(1, info.height >> i) + blockExtent.y - 1) / blockExtent.y;
+                size_t blocksZ = (Math::Max(1, info.depth >> i) + blockExtent.z - 1) / blockExtent.z;
+
+                info.mipSizes[i] = blocksX * blocksY * blocksZ * blockSize;
+                faceSize += info.mipSizes[i];
+            }
+
+            // A truncated file would make us upload past the end of the file data
+            info.payloadOffset = offset;
+            return offset + faceSize * info.faces * info.layers <= fileSize;
+        }
+
+        TextureHandlerVK::~TextureHandlerVK()
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+
+            {
+                std::scoped_lock lock(data.loadMutex);
+                data.loadThreadsShouldExit = true;
+            }
+            data.loadCondition.notify_all();
+
+            for (std::thread& loadThread : data.loadThreads)
+            {
+                loadThread.join();
+            }
+        }
+
         void TextureHandlerVK::Init(RenderDeviceVK* device, BufferHandlerVK* bufferHandler, UploadBufferHandlerVK* uploadBufferHandler)
         {
             _data = new TextureHandlerVKData();
             _device = device;
             _bufferHandler = bufferHandler;
             _uploadBufferHandler = uploadBufferHandler;
+
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+
+            u32 numLoadThreads = std::max(1u, std::thread::hardware_concurrency() / 2);
+            for (u32 i = 0; i < numLoadThreads; i++)
+            {
+                data.loadThreads.emplace_back(&TextureHandlerVK::RunLoadThread, this);
+            }
         }
 
         void TextureHandlerVK::InitDebugTexture()
@@ -164,8 +361,21 @@ namespace Renderer
             texture->hash = cacheDescHash;
             texture->debugName = desc.path;
 
+            // If another thread raced us to the same texture we keep pointing at the first one
+            data.textureHashToIndex.WriteLock(
+                [&](robin_hood::unordered_map<u64, TextureID::type>& textureHashToIndex)
+                {
+                    textureHashToIndex.emplace(cacheDescHash, static_cast<TextureID::type>(textureID));
+                });
+
             texture->textureIndex = static_cast<TextureID::type>(textureID);
-            LoadFile(desc.path, *texture, textureID);
+
+            // The image is created and uploaded by a load thread, until then GetImageView returns the debug texture for it
+            {
+                std::scoped_lock lock(data.loadMutex);
+                data.loadRequests.push_back({ desc.path, textureID, texture->generation, true, 0 });
+            }
+            data.loadCondition.notify_one();
 
             return textureID;
         }
@@ -202,17 +412,44 @@ namespace Renderer
                 }
             }
 
-            textureID = LoadTexture(desc);
-
             {
                 ZoneScopedN("TextureArrays WriteLock");
                 data.textureArrays.WriteLock(
                     [&](std::vector<TextureArray>& textureArrays)
                     {
                         TextureArray& textureArray = textureArrays[static_cast<TextureArrayID::type>(textureArrayID)];
+
+                        // Another thread might have added the same texture since we looked, check again now that nobody else can add to the array
+                        if (!allowDuplicates)
+                        {
+                            bool foundTexture = false;
+                            textureArray.textureHashToArrayIndex->ReadLock(
+                                [&](const robin_hood::unordered_map<u64, u32>& textureHashToArrayIndex)
+                                {
+                                    auto itr = textureHashToArrayIndex.find(descHash);
+                                    if (itr != textureHashToArrayIndex.end())
+                                    {
+                                        arrayIndex = itr->second;
+                                        textureID = textureArray.textures->ReadGet(arrayIndex);
+                                        foundTexture = true;
+                                    }
+                                });
+
+                            if (foundTexture)
+                                return;
+                        }
+
+                        textureID = LoadTexture(desc);
+
                         arrayIndex = static_cast<u32>(textureArray.textures->Size());
                         textureArray.textures->PushBack(textureID);
                         textureArray.textureHashes->PushBack(descHash);
+
+                        textureArray.textureHashToArrayIndex->WriteLock(
+                            [&](robin_hood::unordered_map<u64, u32>& textureHashToArrayIndex)
+                            {
+                                textureHashToArrayIndex.emplace(descHash, arrayIndex);
+                            });
                     });
             }
             
@@ -233,13 +470,43 @@ namespace Renderer
                         return;
                     }
 
+                    data.textureHashToIndex.WriteLock(
+                        [&](robin_hood::unordered_map<u64, TextureID::type>& textureHashToIndex)
+                        {
+                            auto itr = textureHashToIndex.find(texture->hash);
+                            if (itr != textureHashToIndex.end() && itr->second == static_cast<TextureID::type>(textureID))
+                            {
+                                textureHashToIndex.erase(itr);
+                            }
+                        });
+
                     texture->loaded = false;
                     texture->hash = 0;
+                    texture->generation++;
+
+                    _device->_descriptorSetCache->InvalidateHandle(reinterpret_cast<u64>(texture->imageView));
 
                     vmaFreeMemory(_device->_allocator, texture->allocation);
                     vkDestroyImage(_device->_device, texture->image, nullptr);
                     vkDestroyImageView(_device->_device, texture->imageView, nullptr);
 
+                    if (texture->pending != nullptr)
+                    {
+                        _device->_descriptorSetCache->InvalidateHandle(reinterpret_cast<u64>(texture->pending->imageView));
+
+                        vmaFreeMemory(_device->_allocator, texture->pending->allocation);
+                        vkDestroyImage(_device->_device, texture->pending->image, nullptr);
+                        vkDestroyImageView(_device->_device, texture->pending->imageView, nullptr);
+
+                        delete texture->pending;
+                        texture->pending = nullptr;
+                    }
+
+                    {
+                        std::scoped_lock lock(data.streamingMutex);
+                        data.streamingStates.erase(static_cast<TextureID::type>(textureID));
+                    }
+
                     data.freeTextureQueue.push(texture);
                 });
         }
@@ -262,11 +529,237 @@ namespace Renderer
                             }
                         });
 
+                    textureArray.textureHashToArrayIndex->WriteLock(
+                        [&](robin_hood::unordered_map<u64, u32>& textureHashToArrayIndex)
+                        {
+                            for (auto itr = textureHashToArrayIndex.begin(); itr != textureHashToArrayIndex.end();)
+                            {
+                                if (itr->second >= unloadStartIndex)
+                                {
+                                    itr = textureHashToArrayIndex.erase(itr);
+                                }
+                                else
+                                {
+                                    itr++;
+                                }
+                            }
+                        });
+
                     textureArray.textureHashes->Resize(unloadStartIndex);
                     textureArray.textures->Resize(unloadStartIndex);
                 });
         }
 
+        void TextureHandlerVK::RequestTextureDetail(const std::vector<TextureStreamingRequest>& requests)
+        {
+            ZoneScoped;
+
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+            std::scoped_lock lock(data.streamingMutex);
+
+            for (const TextureStreamingRequest& request : requests)
+            {
+                auto itr = data.streamingStates.find(static_cast<TextureID::type>(request.textureID));
+                if (itr == data.streamingStates.end())
+                    continue;
+
+                // Several users can request the same texture in a frame, the closest one decides
+                TextureStreamingState& state = itr->second;
+                if (state.lastRequestedFrame != data.streamingFrame || request.distance < state.distance)
+                {
+                    state.distance = request.distance;
+                }
+                state.lastRequestedFrame = data.streamingFrame;
+            }
+        }
+
+        void TextureHandlerVK::UpdateStreaming(size_t vramUsage, size_t vramBudget)
+        {
+            ZoneScoped;
+
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+
+            std::vector<TextureLoadRequest> loadRequests;
+            {
+                std::scoped_lock lock(data.streamingMutex);
+
+                // Destroy the images that have been replaced, once no frame in flight can reference them anymore
+                for (auto itr = data.retiredImages.begin(); itr != data.retiredImages.end();)
+                {
+                    if (itr->framesLeft-- == 0)
+                    {
+                        _device->_descriptorSetCache->InvalidateHandle(reinterpret_cast<u64>(itr->imageView));
+
+                        vmaFreeMemory(_device->_allocator, itr->allocation);
+                        vkDestroyImage(_device->_device, itr->image, nullptr);
+                        vkDestroyImageView(_device->_device, itr->imageView, nullptr);
+
+                        itr = data.retiredImages.erase(itr);
+                    }
+                    else
+                    {
+                        itr++;
+                    }
+                }
+
+                if (data.streamingBudgetOverride != 0)
+                {
+                    vramBudget = data.streamingBudgetOverride;
+                }
+
+                const size_t streamingBudget = static_cast<size_t>(static_cast<f64>(vramBudget) * Settings::TEXTURE_STREAMING_BUDGET_FRACTION);
+                data.lastStreamingBudget = streamingBudget;
+                const u32 currentFrame = data.streamingFrame;
+
+                std::vector<std::pair<TextureID::type, TextureStreamingState*>> candidates;
+                candidates.reserve(data.streamingStates.size());
+
+                if (vramUsage > streamingBudget)
+                {
+                    // Drops we already requested and replaced images that are waiting to be destroyed will free memory on their own
+                    size_t pendingFreeBytes = 0;
+                    for (const RetiredTextureImage& retiredImage : data.retiredImages)
+                    {
+                        pendingFreeBytes += retiredImage.size;
+                    }
+
+                    // Over budget, drop the top mip of the least recently requested textures first and the farthest ones among those
+                    for (auto& [id, state] : data.streamingStates)
+                    {
+                        if (state.isLoading)
+                        {
+                            pendingFreeBytes += state.pendingFreeBytes;
+                        }
+                        else if (state.lastRequestedFrame != 0 && state.residentBaseMip < state.maxBaseMip)
+                        {
+                            candidates.emplace_back(id, &state);
+                        }
+                    }
+
+                    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b)
+                    {
+                        if (a.second->lastRequestedFrame != b.second->lastRequestedFrame)
+                            return a.second->lastRequestedFrame < b.second->lastRequestedFrame;
+
+                        return a.second->distance > b.second->distance;
+                    });
+
+                    size_t bytesToFree = vramUsage - streamingBudget;
+                    bytesToFree -= Math::Min(bytesToFree, pendingFreeBytes);
+                    for (auto& [id, state] : candidates)
+                    {
+                        if (bytesToFree == 0 || loadRequests.size() >= Settings::TEXTURE_STREAMING_MAX_LOADS_PER_FRAME)
+                            break;
+
+                        size_t freedBytes = state->mipSizes[state->residentBaseMip];
+                        bytesToFree -= Math::Min(bytesToFree, freedBytes);
+
+                        state->isLoading = true;
+                        state->pendingFreeBytes = freedBytes;
+                        loadRequests.push_back({ state->path, TextureID(id), state->generation, false, state->residentBaseMip + 1 });
+                    }
+                }
+                else
+                {
+                    // Under budget, load the mips that the requested distances want, closest textures first
+                    auto getWantedBaseMip = [&](const TextureStreamingState& state) -> u32
+                    {
+                        if (state.lastRequestedFrame == 0 || state.distance <= Settings::TEXTURE_STREAMING_FULL_DETAIL_DISTANCE)
+                            return 0;
+
+                        u32 mip = static_cast<u32>(glm::log2(state.distance / Settings::TEXTURE_STREAMING_FULL_DETAIL_DISTANCE)) + 1;
+                        return Math::Min(mip, state.maxBaseMip);
+                    };
+
+                    for (auto& [id, state] : data.streamingStates)
+                    {
+                        bool isStale = state.lastRequestedFrame != 0 && currentFrame - state.lastRequestedFrame > Settings::TEXTURE_STREAMING_STALE_FRAMES;
+                        if (!state.isLoading && !isStale && getWantedBaseMip(state) < state.residentBaseMip)
+                        {
+                            candidates.emplace_back(id, &state);
+                        }
+                    }
+
+                    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b)
+                    {
+                        return a.second->distance < b.second->distance;
+                    });
+
+                    size_t projectedUsage = vramUsage;
+                    for (auto& [id, state] : candidates)
+                    {
+                        if (loadRequests.size() >= Settings::TEXTURE_STREAMING_MAX_LOADS_PER_FRAME)
+                            break;
+
+                        u32 wantedBaseMip = getWantedBaseMip(*state);
+
+                        // Both the old and the new image are alive until the old one is retired
+                        size_t newSize = 0;
+                        for (u32 i = wantedBaseMip; i < state->mipSizes.size(); i++)
+                        {
+                            newSize += state->mipSizes[i];
+                        }
+
+                        if (projectedUsage + newSize > streamingBudget)
+                            break;
+
+                        projectedUsage += newSize;
+
+                        state->isLoading = true;
+                        state->pendingFreeBytes = 0;
+                        loadRequests.push_back({ state->path, TextureID(id), state->generation, false, wantedBaseMip });
+                    }
+                }
+
+                data.streamingFrame++;
+            }
+
+            if (loadRequests.size() > 0)
+            {
+                {
+                    std::scoped_lock lock(data.loadMutex);
+                    for (TextureLoadRequest& loadRequest : loadRequests)
+                    {
+                        data.loadRequests.push_back(std::move(loadRequest));
+                    }
+                }
+                data.loadCondition.notify_all();
+            }
+        }
+
+        void TextureHandlerVK::SetStreamingBudget(size_t budget)
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+
+            std::scoped_lock lock(data.streamingMutex);
+            data.streamingBudgetOverride = budget;
+        }
+
+        TextureStreamingStats TextureHandlerVK::GetStreamingStats()
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+            std::scoped_lock lock(data.streamingMutex);
+
+            TextureStreamingStats stats;
+            stats.numStreamedTextures = static_cast<u32>(data.streamingStates.size());
+            stats.numRetiredImages = static_cast<u32>(data.retiredImages.size());
+            stats.budget = data.lastStreamingBudget;
+
+            for (const auto& [id, state] : data.streamingStates)
+            {
+                stats.numLoading += state.isLoading;
+                stats.numAtFullDetail += state.residentBaseMip == 0;
+                stats.numAtLowestDetail += state.residentBaseMip == state.maxBaseMip;
+
+                for (u32 i = state.residentBaseMip; i < state.mipSizes.size(); i++)
+                {
+                    stats.residentBytes += state.mipSizes[i];
+                }
+            }
+
+            return stats;
+        }
+
         TextureArrayID TextureHandlerVK::CreateTextureArray(const TextureArrayDesc& desc)
         {
             TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
@@ -285,6 +778,7 @@ namespace Renderer
                     textureArray.textures->Reserve(desc.size);
                     textureArray.textureHashes = new SafeVector<u64>();
                     textureArray.textureHashes->Reserve(desc.size);
+                    textureArray.textureHashToArrayIndex = new SafeUnorderedMap<u64, u32>();
                     textureArray.size = desc.size;
                 });
 
@@ -366,13 +860,19 @@ namespace Renderer
             return textureID;
         }
 
-        void TextureHandlerVK::CopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, size_t srcOffset, TextureID dstTextureID)
+        void TextureHandlerVK::UpdateDataTexture(TextureID textureID, const DataTextureDesc& desc)
         {
             TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
-            TextureID::type id = static_cast<TextureID::type>(dstTextureID);
+            TextureID::type id = static_cast<TextureID::type>(textureID);
 
-            data.textures.WriteLock(
-                [&](std::vector<Texture*>& textures)
+            if (desc.data == nullptr)
+            {
+                DebugHandler::PrintFatal("Tried to update a DataTexture with the data being a nullptr! (%s)", desc.debugName.c_str());
+            }
+
+            size_t fileSize = 0;
+            data.textures.ReadLock(
+                [&](const std::vector<Texture*>& textures)
                 {
                     // Lets make sure this id exists
                     if (textures.size() <= id)
@@ -380,51 +880,222 @@ namespace Renderer
                         DebugHandler::PrintFatal("Tried to access invalid TextureID: %u", id);
                     }
 
-                    Texture& texture = *textures[id];
-
-                    // If the texture has been unloaded, just return
-                    if (!texture.loaded)
-                        return;
-
-                    // Transition to TRANSFER_DST_OPTIMAL
-                    VkImageLayout beforeLayout = (texture.layoutUndefined) ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                    _device->TransitionImageLayout(commandBuffer, texture.image, VK_IMAGE_ASPECT_COLOR_BIT, beforeLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, texture.layers, texture.mipLevels);
-
-                    // Do the copy
-                    _device->CopyBufferToImage(commandBuffer, srcBuffer, srcOffset, texture.image, texture.format, static_cast<u32>(texture.width), static_cast<u32>(texture.height), texture.layers, texture.mipLevels);
+                    const Texture& texture = *textures[id];
+                    if (texture.width != desc.width || texture.height != desc.height || texture.layers != desc.layers || texture.format != FormatConverterVK::ToVkFormat(desc.format))
+                    {
+                        DebugHandler::PrintFatal("Tried to update DataTexture (%s) with a desc that doesn't match the one it was created with", texture.debugName.c_str());
+                    }
 
-                    // Transition back to SHADER_READ_ONLY_OPTIMAL
-                    _device->TransitionImageLayout(commandBuffer, texture.image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texture.layers, texture.mipLevels);
-                    texture.layoutUndefined = false;
+                    fileSize = texture.fileSize;
                 });
-        }
-
-        void TextureHandlerVK::TransitionImageLayout(VkCommandBuffer commandBuffer, TextureID textureID, VkImageAspectFlags aspects, VkImageLayout oldLayout, VkImageLayout newLayout)
-        {
-            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
-            TextureID::type id = static_cast<TextureID::type>(textureID);
 
+            // The whole texture gets reuploaded, CopyBufferToImage transitions it out of and back into SHADER_READ_ONLY_OPTIMAL around the copy
+            auto uploadBuffer = _uploadBufferHandler->CreateUploadBuffer(textureID, 0, fileSize);
+            memcpy(uploadBuffer->mappedMemory, desc.data, fileSize);
         }
 
-        const SafeVector<TextureID>& TextureHandlerVK::GetTextureIDsInArray(const TextureArrayID textureArrayID)
+        void TextureHandlerVK::UpdateDataTexture(TextureID textureID, const DataTextureDesc& desc, const DataTextureRegion& region)
         {
             TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
-            TextureArrayID::type id = static_cast<TextureArrayID::type>(textureArrayID);
+            TextureID::type id = static_cast<TextureID::type>(textureID);
 
-            // Lets make sure this id exists
-            if (data.textureArrays.Size() <= id)
+            if (desc.data == nullptr)
             {
-                DebugHandler::PrintFatal("Tried to access invalid TextureArrayID: %u", id);
+                DebugHandler::PrintFatal("Tried to update a DataTexture with the data being a nullptr! (%s)", desc.debugName.c_str());
             }
 
-            const SafeVector<TextureID>* textures = nullptr;
-            data.textureArrays.ReadLock(
-                [&](const std::vector<TextureArray>& textureArrays)
-                {
-                    textures = textureArrays[id].textures;
-                });
+            if (region.width <= 0 || region.height <= 0)
+                return;
 
-            return *textures;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            data.textures.ReadLock(
+                [&](const std::vector<Texture*>& textures)
+                {
+                    // Lets make sure this id exists
+                    if (textures.size() <= id)
+                    {
+                        DebugHandler::PrintFatal("Tried to access invalid TextureID: %u", id);
+                    }
+
+                    const Texture& texture = *textures[id];
+                    if (texture.width != desc.width || texture.height != desc.height || texture.layers != desc.layers || texture.format != FormatConverterVK::ToVkFormat(desc.format))
+                    {
+                        DebugHandler::PrintFatal("Tried to update DataTexture (%s) with a desc that doesn't match the one it was created with", texture.debugName.c_str());
+                    }
+
+                    if (region.x < 0 || region.y < 0 || region.x + region.width > texture.width || region.y + region.height > texture.height)
+                    {
+                        DebugHandler::PrintFatal("Tried to update a region outside of DataTexture (%s)", texture.debugName.c_str());
+                    }
+
+                    format = texture.format;
+                });
+
+            if (FormatIsCompressed(format))
+            {
+                DebugHandler::PrintFatal("Tried to update a region of a compressed DataTexture (%s)", desc.debugName.c_str());
+            }
+
+            // Only the rows of the region go into staging memory, packed tightly layer by layer
+            size_t texelSize = static_cast<size_t>(FormatTexelSize(format));
+            size_t srcRowSize = static_cast<size_t>(desc.width) * texelSize;
+            size_t srcLayerSize = srcRowSize * desc.height;
+            size_t dstRowSize = static_cast<size_t>(region.width) * texelSize;
+            size_t uploadSize = dstRowSize * region.height * desc.layers;
+
+            auto uploadBuffer = _uploadBufferHandler->CreateUploadBuffer(textureID, region, uploadSize);
+
+            u8* dst = static_cast<u8*>(uploadBuffer->mappedMemory);
+            for (i32 layer = 0; layer < desc.layers; layer++)
+            {
+                const u8* src = desc.data + (layer * srcLayerSize) + (region.y * srcRowSize) + (region.x * texelSize);
+                for (i32 row = 0; row < region.height; row++)
+                {
+                    memcpy(dst, src, dstRowSize);
+
+                    dst += dstRowSize;
+                    src += srcRowSize;
+                }
+            }
+        }
+
+        void TextureHandlerVK::CopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, size_t srcOffset, TextureID dstTextureID)
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+            TextureID::type id = static_cast<TextureID::type>(dstTextureID);
+
+            data.textures.WriteLock(
+                [&](std::vector<Texture*>& textures)
+                {
+                    // Lets make sure this id exists
+                    if (textures.size() <= id)
+                    {
+                        DebugHandler::PrintFatal("Tried to access invalid TextureID: %u", id);
+                    }
+
+                    Texture& texture = *textures[id];
+
+                    // If the texture has been unloaded, just return
+                    if (!texture.loaded)
+                        return;
+
+                    // Streaming uploads go into the pending image, which then replaces the current one
+                    // A pending image is only created after the initial upload has been recorded, see TextureStreamingState::isLoading
+                    Texture& target = (texture.pending != nullptr) ? *texture.pending : texture;
+                    bool isInitialUpload = target.layoutUndefined;
+
+                    // Transition to TRANSFER_DST_OPTIMAL
+                    VkImageLayout beforeLayout = (target.layoutUndefined) ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                    _device->TransitionImageLayout(commandBuffer, target.image, VK_IMAGE_ASPECT_COLOR_BIT, beforeLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, target.layers, target.mipLevels);
+
+                    // Do the copy
+                    _device->CopyBufferToImage(commandBuffer, srcBuffer, srcOffset, target.image, target.format, static_cast<u32>(target.width), static_cast<u32>(target.height), target.layers, target.mipLevels);
+
+                    // Transition back to SHADER_READ_ONLY_OPTIMAL
+                    _device->TransitionImageLayout(commandBuffer, target.image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, target.layers, target.mipLevels);
+                    target.layoutUndefined = false;
+
+                    if (texture.pending != nullptr)
+                    {
+                        Texture* pending = texture.pending;
+
+                        std::scoped_lock lock(data.streamingMutex);
+
+                        if (texture.image != VK_NULL_HANDLE)
+                        {
+                            data.retiredImages.push_back({ texture.allocation, texture.image, texture.imageView, texture.fileSize, RenderDeviceVK::FRAME_INDEX_COUNT });
+                        }
+
+                        texture.allocation = pending->allocation;
+                        texture.image = pending->image;
+                        texture.imageView = pending->imageView;
+                        texture.width = pending->width;
+                        texture.height = pending->height;
+                        texture.mipLevels = pending->mipLevels;
+                        texture.fileSize = pending->fileSize;
+                        texture.layoutUndefined = false;
+
+                        auto itr = data.streamingStates.find(id);
+                        if (itr != data.streamingStates.end())
+                        {
+                            itr->second.residentBaseMip = static_cast<u32>(itr->second.mipSizes.size()) - static_cast<u32>(pending->mipLevels);
+                            itr->second.isLoading = false;
+                        }
+
+                        delete pending;
+                        texture.pending = nullptr;
+                    }
+                    else if (isInitialUpload)
+                    {
+                        // Streaming can start changing the resident mips now that the initial upload is ahead of it in the command buffer
+                        std::scoped_lock lock(data.streamingMutex);
+
+                        auto itr = data.streamingStates.find(id);
+                        if (itr != data.streamingStates.end())
+                        {
+                            itr->second.isLoading = false;
+                        }
+                    }
+                });
+        }
+
+        void TextureHandlerVK::CopyBufferToImageRegion(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, size_t srcOffset, TextureID dstTextureID, const DataTextureRegion& region)
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+            TextureID::type id = static_cast<TextureID::type>(dstTextureID);
+
+            data.textures.WriteLock(
+                [&](std::vector<Texture*>& textures)
+                {
+                    // Lets make sure this id exists
+                    if (textures.size() <= id)
+                    {
+                        DebugHandler::PrintFatal("Tried to access invalid TextureID: %u", id);
+                    }
+
+                    Texture& texture = *textures[id];
+
+                    // If the texture has been unloaded, just return
+                    if (!texture.loaded)
+                        return;
+
+                    // Coming from SHADER_READ_ONLY_OPTIMAL keeps the texels outside of the region intact
+                    VkImageLayout beforeLayout = (texture.layoutUndefined) ? VK_IMAGE_LAYOUT_UNDEFINED : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                    _device->TransitionImageLayout(commandBuffer, texture.image, VK_IMAGE_ASPECT_COLOR_BIT, beforeLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, texture.layers, texture.mipLevels);
+
+                    _device->CopyBufferToImageRegion(commandBuffer, srcBuffer, srcOffset, texture.image, region.x, region.y, static_cast<u32>(region.width), static_cast<u32>(region.height), texture.layers);
+
+                    _device->TransitionImageLayout(commandBuffer, texture.image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texture.layers, texture.mipLevels);
+                    texture.layoutUndefined = false;
+                });
+        }
+
+        void TextureHandlerVK::TransitionImageLayout(VkCommandBuffer commandBuffer, TextureID textureID, VkImageAspectFlags aspects, VkImageLayout oldLayout, VkImageLayout newLayout)
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+            TextureID::type id = static_cast<TextureID::type>(textureID);
+
+        }
+
+        const SafeVector<TextureID>& TextureHandlerVK::GetTextureIDsInArray(const TextureArrayID textureArrayID)
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+            TextureArrayID::type id = static_cast<TextureArrayID::type>(textureArrayID);
+
+            // Lets make sure this id exists
+            if (data.textureArrays.Size() <= id)
+            {
+                DebugHandler::PrintFatal("Tried to access invalid TextureArrayID: %u", id);
+            }
+
+            const SafeVector<TextureID>* textures = nullptr;
+            data.textureArrays.ReadLock(
+                [&](const std::vector<TextureArray>& textureArrays)
+                {
+                    textures = textureArrays[id].textures;
+                });
+
+            return *textures;
         }
 
         bool TextureHandlerVK::IsOnionTexture(const TextureID textureID)
@@ -452,7 +1123,27 @@ namespace Renderer
                 DebugHandler::PrintFatal("Tried to access invalid TextureID: %u", id);
             }
 
-            return data.textures.ReadGet(id)->imageView;
+            VkImageView imageView = VK_NULL_HANDLE;
+            bool isReady = false;
+            bool isOnionTexture = false;
+
+            data.textures.ReadLock(
+                [&](const std::vector<Texture*>& textures)
+                {
+                    const Texture* texture = textures[id];
+
+                    imageView = texture->imageView;
+                    isReady = !texture->layoutUndefined;
+                    isOnionTexture = texture->layers != 1;
+                });
+
+            // Until the first upload to a texture has been recorded it has no contents (or no image at all yet), so we show the debug texture in its place
+            if (!isReady && textureID != _debugTexture && textureID != _debugOnionTexture)
+            {
+                return isOnionTexture ? GetDebugOnionTextureImageView() : GetDebugTextureImageView();
+            }
+
+            return imageView;
         }
 
         VkImageView TextureHandlerVK::GetDebugTextureImageView()
@@ -476,7 +1167,16 @@ namespace Renderer
                 DebugHandler::PrintFatal("Tried to access invalid TextureID: %u", id);
             }
 
-            return data.textures.ReadGet(id)->fileSize;
+            size_t textureSize = 0;
+            data.textures.ReadLock(
+                [&](const std::vector<Texture*>& textures)
+                {
+                    // While a streamed replacement is pending, uploads target it rather than the current image
+                    const Texture* texture = textures[id];
+                    textureSize = (texture->pending != nullptr) ? texture->pending->fileSize : texture->fileSize;
+                });
+
+            return textureSize;
         }
 
         u32 TextureHandlerVK::GetTextureArraySize(const TextureArrayID textureArrayID)
@@ -501,21 +1201,20 @@ namespace Renderer
 
         bool TextureHandlerVK::TryFindExistingTexture(u64 descHash, size_t& id)
         {
+            ZoneScoped;
+
             TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
             id = 0;
 
             bool foundTexture = false;
-            data.textures.ReadLock(
-                [&](const std::vector<Texture*>& textures)
+            data.textureHashToIndex.ReadLock(
+                [&](const robin_hood::unordered_map<u64, TextureID::type>& textureHashToIndex)
                 {
-                    for (auto* texture : textures)
+                    auto itr = textureHashToIndex.find(descHash);
+                    if (itr != textureHashToIndex.end())
                     {
-                        if (descHash == texture->hash)
-                        {
-                            foundTexture = true;
-                            return;
-                        }
-                        id++;
+                        id = itr->second;
+                        foundTexture = true;
                     }
                 });
 
@@ -524,6 +1223,8 @@ namespace Renderer
 
         bool TextureHandlerVK::TryFindExistingTextureInArray(TextureArrayID textureArrayID, u64 descHash, size_t& arrayIndex, TextureID& textureID)
         {
+            ZoneScoped;
+
             TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
             TextureArrayID::type id = static_cast<TextureArrayID::type>(textureArrayID);
             if (data.textureArrays.Size() <= id)
@@ -532,77 +1233,507 @@ namespace Renderer
             }
 
             bool foundTexture = false;
-            data.textureArrays.WriteLock(
-                [&](std::vector<TextureArray>& textureArrays)
+            data.textureArrays.ReadLock(
+                [&](const std::vector<TextureArray>& textureArrays)
                 {
-                    TextureArray& array = textureArrays[id];
+                    const TextureArray& array = textureArrays[id];
 
-                    for (arrayIndex = 0; arrayIndex < array.textureHashes->Size(); arrayIndex++)
-                    {
-                        if (descHash == array.textureHashes->ReadGet(arrayIndex))
+                    array.textureHashToArrayIndex->ReadLock(
+                        [&](const robin_hood::unordered_map<u64, u32>& textureHashToArrayIndex)
                         {
-                            textureID = array.textures->ReadGet(arrayIndex);
-                            foundTexture = true;
-                            return;
-                        }
-                    }
+                            auto itr = textureHashToArrayIndex.find(descHash);
+                            if (itr != textureHashToArrayIndex.end())
+                            {
+                                arrayIndex = itr->second;
+                                textureID = array.textures->ReadGet(arrayIndex);
+                                foundTexture = true;
+                            }
+                        });
                 });
 
             return foundTexture;
         }
 
-        void TextureHandlerVK::LoadFile(const std::string& filename, Texture& texture, TextureID textureID)
+        TextureLookupBenchmarkResult TextureHandlerVK::BenchmarkLookups(u32 numQueries)
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+
+            TextureLookupBenchmarkResult result;
+            result.numQueries = numQueries;
+
+            struct ArrayEntry
+            {
+                TextureArrayID textureArrayID;
+                u64 hash;
+                std::string path;
+            };
+
+            std::vector<u64> textureHashes;
+            std::vector<ArrayEntry> arrayEntries;
+
+            data.textureArrays.ReadLock(
+                [&](const std::vector<TextureArray>& textureArrays)
+                {
+                    data.textures.ReadLock(
+                        [&](const std::vector<Texture*>& textures)
+                        {
+                            for (const Texture* texture : textures)
+                            {
+                                if (texture->loaded && texture->hash != 0)
+                                    textureHashes.push_back(texture->hash);
+                            }
+
+                            for (size_t i = 0; i < textureArrays.size(); i++)
+                            {
+                                const TextureArray& textureArray = textureArrays[i];
+
+                                textureArray.textures->ReadLock(
+                                    [&](const std::vector<TextureID>& arrayTextures)
+                                    {
+                                        textureArray.textureHashes->ReadLock(
+                                            [&](const std::vector<u64>& arrayHashes)
+                                            {
+                                                for (size_t j = 0; j < arrayHashes.size(); j++)
+                                                {
+                                                    // Data textures are never looked up
+                                                    if (arrayHashes[j] == 0)
+                                                        continue;
+
+                                                    const Texture* texture = textures[static_cast<TextureID::type>(arrayTextures[j])];
+                                                    arrayEntries.push_back({ TextureArrayID(static_cast<TextureArrayID::type>(i)), arrayHashes[j], texture->debugName });
+                                                }
+                                            });
+                                    });
+                            }
+                        });
+                });
+
+            result.numTextures = static_cast<u32>(textureHashes.size());
+            result.numArrayTextures = static_cast<u32>(arrayEntries.size());
+
+            if (numQueries == 0)
+                return result;
+
+            // These are the scans TryFindExistingTexture and TryFindExistingTextureInArray did before they were indexed
+            auto LinearFindTexture = [&](u64 descHash, size_t& id)
+            {
+                id = 0;
+
+                bool foundTexture = false;
+                data.textures.ReadLock(
+                    [&](const std::vector<Texture*>& textures)
+                    {
+                        for (auto* texture : textures)
+                        {
+                            if (descHash == texture->hash)
+                            {
+                                foundTexture = true;
+                                return;
+                            }
+                            id++;
+                        }
+                    });
+
+                return foundTexture;
+            };
+
+            auto LinearFindTextureInArray = [&](TextureArrayID textureArrayID, u64 descHash, size_t& arrayIndex, TextureID& textureID)
+            {
+                bool foundTexture = false;
+                data.textureArrays.WriteLock(
+                    [&](std::vector<TextureArray>& textureArrays)
+                    {
+                        TextureArray& array = textureArrays[static_cast<TextureArrayID::type>(textureArrayID)];
+
+                        for (arrayIndex = 0; arrayIndex < array.textureHashes->Size(); arrayIndex++)
+                        {
+                            if (descHash == array.textureHashes->ReadGet(arrayIndex))
+                            {
+                                textureID = array.textures->ReadGet(arrayIndex);
+                                foundTexture = true;
+                                return;
+                            }
+                        }
+                    });
+
+                return foundTexture;
+            };
+
+            // Fixed seed so runs are comparable, every fourth query looks for a texture that isn't loaded which is the worst case for a scan
+            std::mt19937_64 randomEngine(1337);
+
+            if (!textureHashes.empty())
+            {
+                std::vector<u64> queryHashes(numQueries);
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    queryHashes[i] = (i % 4 == 3) ? (randomEngine() | 1) : textureHashes[randomEngine() % textureHashes.size()];
+                }
+
+                std::vector<size_t> linearIDs(numQueries, std::numeric_limits<size_t>::max());
+                std::vector<size_t> hashIDs(numQueries, std::numeric_limits<size_t>::max());
+
+                Timer timer;
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    size_t id;
+                    if (LinearFindTexture(queryHashes[i], id))
+                        linearIDs[i] = id;
+                }
+                result.linearTimeMS = timer.GetLifeTime() * 1000.0f;
+
+                timer.Reset();
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    size_t id;
+                    if (TryFindExistingTexture(queryHashes[i], id))
+                        hashIDs[i] = id;
+                }
+                result.hashTimeMS = timer.GetLifeTime() * 1000.0f;
+
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    if (linearIDs[i] != hashIDs[i])
+                        result.numMismatches++;
+                }
+            }
+
+            if (!arrayEntries.empty())
+            {
+                struct ArrayQuery
+                {
+                    const ArrayEntry* entry;
+                    u64 hash;
+                };
+
+                std::vector<ArrayQuery> arrayQueries(numQueries);
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    ArrayQuery& arrayQuery = arrayQueries[i];
+                    arrayQuery.entry = &arrayEntries[randomEngine() % arrayEntries.size()];
+                    arrayQuery.hash = (i % 4 == 3) ? (randomEngine() | 1) : arrayQuery.entry->hash;
+                }
+
+                std::vector<size_t> linearIndices(numQueries, std::numeric_limits<size_t>::max());
+                std::vector<size_t> hashIndices(numQueries, std::numeric_limits<size_t>::max());
+
+                Timer timer;
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    size_t arrayIndex;
+                    TextureID textureID;
+                    if (LinearFindTextureInArray(arrayQueries[i].entry->textureArrayID, arrayQueries[i].hash, arrayIndex, textureID))
+                        linearIndices[i] = arrayIndex;
+                }
+                result.arrayLinearTimeMS = timer.GetLifeTime() * 1000.0f;
+
+                timer.Reset();
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    size_t arrayIndex;
+                    TextureID textureID;
+                    if (TryFindExistingTextureInArray(arrayQueries[i].entry->textureArrayID, arrayQueries[i].hash, arrayIndex, textureID))
+                        hashIndices[i] = arrayIndex;
+                }
+                result.arrayHashTimeMS = timer.GetLifeTime() * 1000.0f;
+
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    if (linearIndices[i] != hashIndices[i])
+                        result.numMismatches++;
+                }
+
+                // Only textures that are already in their array, anything else would actually load a file
+                std::vector<TextureDesc> descs(numQueries);
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    descs[i].path = arrayQueries[i].entry->path;
+                }
+
+                std::fill(linearIndices.begin(), linearIndices.end(), std::numeric_limits<size_t>::max());
+
+                timer.Reset();
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    size_t arrayIndex;
+                    TextureID textureID;
+                    u64 descHash = CalculateDescHash(descs[i]);
+                    if (LinearFindTextureInArray(arrayQueries[i].entry->textureArrayID, descHash, arrayIndex, textureID))
+                        linearIndices[i] = arrayIndex;
+                }
+                result.loadIntoArrayLinearTimeMS = timer.GetLifeTime() * 1000.0f;
+
+                timer.Reset();
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    u32 arrayIndex;
+                    LoadTextureIntoArray(descs[i], arrayQueries[i].entry->textureArrayID, arrayIndex, false);
+                    hashIndices[i] = arrayIndex;
+                }
+                result.loadIntoArrayHashTimeMS = timer.GetLifeTime() * 1000.0f;
+
+                for (u32 i = 0; i < numQueries; i++)
+                {
+                    if (linearIndices[i] != hashIndices[i])
+                        result.numMismatches++;
+                }
+            }
+
+            return result;
+        }
+
+        void TextureHandlerVK::RunLoadThread()
+        {
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+
+            while (true)
+            {
+                TextureLoadRequest request;
+                {
+                    std::unique_lock lock(data.loadMutex);
+                    data.loadCondition.wait(lock, [&]() { return data.loadThreadsShouldExit || !data.loadRequests.empty(); });
+
+                    if (data.loadThreadsShouldExit)
+                        return;
+
+                    request = std::move(data.loadRequests.front());
+                    data.loadRequests.pop_front();
+                }
+
+                LoadFile(request.path, request.textureID, request.generation, request.isInitialLoad, request.baseMip);
+            }
+        }
+
+        void TextureHandlerVK::LoadFile(const std::string& filename, TextureID textureID, u32 generation, bool isInitialLoad, u32 baseMip)
         {
             ZoneScoped;
 
-            int channels;
+            TextureHandlerVKData& data = static_cast<TextureHandlerVKData&>(*_data);
+            TextureID::type id = static_cast<TextureID::type>(textureID);
+
+            std::filesystem::path path = filename;
+            FileReader file(path.string(), path.filename().string());
+            if (!file.Open())
+            {
+                DebugHandler::PrintFatal("Failed to open texture (%s)", filename.c_str());
+                return;
+            }
 
-            void* pixels = stbi_load(filename.c_str(), &texture.width, &texture.height, &channels, STBI_rgb_alpha);
+            Bytebuffer fileBuffer(nullptr, file.Length());
+            file.Read(&fileBuffer, fileBuffer.size);
+            file.Close();
 
+            const u8* fileData = fileBuffer.GetDataPointer();
+            size_t fileSize = fileBuffer.size;
+
+            i32 width = 0;
+            i32 height = 0;
+            i32 layers = 1;
+            i32 mipLevels = 1;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            size_t textureSize = 0;
+
+            const void* pixels = nullptr;
+            stbi_uc* stbiPixels = nullptr;
             gli::texture gliTexture;
 
-            // If stbi could open this file
-            if (pixels != nullptr)
+            bool isStreamable = false;
+            u32 maxBaseMip = 0;
+            std::vector<size_t> mipSizes;
+
+            // DDS and KTX files are identified by their magic, DDS headers are parsed here, KTX files by gli and everything else goes to stbi
+            bool isDDSTexture = fileSize >= 4 && memcmp(fileData, gli::detail::FOURCC_DDS, 4) == 0;
+            bool isKTXTexture = fileSize >= 4 && memcmp(fileData, "\xABKTX", 4) == 0;
+            if (isDDSTexture || isKTXTexture)
             {
-                // This is hardcoded to 4 instead of channels since STBI is loading it as STBI_rgb_alpha, making it 4 channels
-                texture.fileSize = texture.width * texture.height * 4;
-                texture.format = VK_FORMAT_R8G8B8A8_UNORM;
-                texture.mipLevels = 1; // If we are not loading using gli we don't support mips, so don't bother with it
-                texture.layers = 1; // If we are not loading using gli we don't support layers, so don't bother with it
+                gli::format gliFormat = gli::FORMAT_UNDEFINED;
+                i32 faces = 1;
+                const u8* payload = nullptr;
+
+                if (isDDSTexture)
+                {
+                    DDSInfo ddsInfo;
+                    if (!ParseDDSHeader(fileData, fileSize, ddsInfo))
+                    {
+                        DebugHandler::PrintFatal("Failed to load texture (%s)", filename.c_str());
+                        return;
+                    }
+
+                    gliFormat = ddsInfo.format;
+                    width = ddsInfo.width;
+                    height = ddsInfo.height;
+                    layers = ddsInfo.layers;
+                    faces = ddsInfo.faces;
+                    mipLevels = ddsInfo.mipLevels;
+                    mipSizes = std::move(ddsInfo.mipSizes);
+                    payload = fileData + ddsInfo.payloadOffset;
+                }
+                else
+                {
+                    gliTexture = gli::load(reinterpret_cast<const char*>(fileData), fileSize);
+                    if (gliTexture.empty())
+                    {
+                        DebugHandler::PrintFatal("Failed to load texture (%s)", filename.c_str());
+                        return;
+                    }
+
+                    gliFormat = gliTexture.format();
+                    width = gliTexture.extent().x;
+                    height = gliTexture.extent().y;
+                    layers = static_cast<i32>(gliTexture.layers());
+                    faces = static_cast<i32>(gliTexture.faces());
+                    mipLevels = static_cast<i32>(gliTexture.levels());
+
+                    mipSizes.resize(mipLevels);
+                    for (i32 i = 0; i < mipLevels; i++)
+                    {
+                        mipSizes[i] = gliTexture.size(i);
+                    }
+                    payload = static_cast<const u8*>(gliTexture.data());
+                }
+
+                gli::gl gl(gli::gl::PROFILE_GL33);
+                gli::gl::format const glFormat = gl.translate(gliFormat, gli::swizzles(gli::SWIZZLE_RED, gli::SWIZZLE_GREEN, gli::SWIZZLE_BLUE, gli::SWIZZLE_ALPHA));
+
+                format = vkGetFormatFromOpenGLInternalFormat(glFormat.Internal);
+
+                // Mips are stored largest first, so dropping the top ones means offsetting into the file data and shrinking the image
+                isStreamable = layers == 1 && faces == 1 && mipLevels > 1;
+                if (isStreamable)
+                {
+                    while (maxBaseMip < Settings::TEXTURE_STREAMING_MAX_DROPPED_MIPS && maxBaseMip + 1 < static_cast<u32>(mipLevels) &&
+                        Math::Min(width, height) >> (maxBaseMip + 1) >= static_cast<i32>(Settings::TEXTURE_STREAMING_MIN_DIMENSION))
+                    {
+                        maxBaseMip++;
+                    }
+
+                    // New textures start out at their lowest streamed detail and get upgraded from there
+                    if (isInitialLoad)
+                    {
+                        baseMip = maxBaseMip;
+                    }
+                    baseMip = Math::Min(baseMip, maxBaseMip);
+                }
+                else
+                {
+                    baseMip = 0;
+                }
+
+                width = Math::Max(1, width >> baseMip);
+                height = Math::Max(1, height >> baseMip);
+
+                size_t skippedSize = 0;
+                textureSize = 0;
+                for (u32 i = 0; i < static_cast<u32>(mipLevels); i++)
+                {
+                    if (i < baseMip)
+                    {
+                        skippedSize += mipSizes[i];
+                    }
+                    else
+                    {
+                        textureSize += mipSizes[i];
+                    }
+                }
+                textureSize *= static_cast<size_t>(layers) * faces; // Arrays and cubemaps are never streamed, so baseMip is 0 whenever this is more than one image
+
+                mipLevels -= baseMip;
+                pixels = payload + skippedSize;
             }
             else
             {
-                // Try to open it with gli
-                gliTexture = gli::load(filename);
-                if (gliTexture.empty())
+                int channels;
+                stbiPixels = stbi_load_from_memory(fileData, static_cast<int>(fileSize), &width, &height, &channels, STBI_rgb_alpha);
+                if (stbiPixels == nullptr)
                 {
                     DebugHandler::PrintFatal("Failed to load texture (%s)", filename.c_str());
+                    return;
                 }
 
-                gli::gl gl(gli::gl::PROFILE_GL33);
-                gli::gl::format const gliFormat = gl.translate(gliTexture.format(), gliTexture.swizzles());
-
-                texture.width = gliTexture.extent().x;
-                texture.height = gliTexture.extent().y;
-                texture.layers = static_cast<i32>(gliTexture.layers());
-                texture.mipLevels = static_cast<i32>(gliTexture.levels());
-
-                texture.format = vkGetFormatFromOpenGLInternalFormat(gliFormat.Internal);
-                texture.fileSize = gliTexture.size();
+                // This is hardcoded to 4 instead of channels since STBI is loading it as STBI_rgb_alpha, making it 4 channels
+                textureSize = static_cast<size_t>(width) * height * 4;
+                format = VK_FORMAT_R8G8B8A8_UNORM;
 
-                pixels = gliTexture.data();
+                pixels = stbiPixels;
             }
 
+            bool isLoaded = false;
             {
                 ZoneScopedN("CreateTexture");
-                // Create texture
-                CreateTexture(texture);
 
-                // Create upload buffer
-                auto uploadBuffer = _uploadBufferHandler->CreateUploadBuffer(textureID, 0, texture.fileSize);
+                data.textures.WriteLock(
+                    [&](std::vector<Texture*>& textures)
+                    {
+                        Texture& texture = *textures[id];
 
-                // Copy data to upload buffer
-                memcpy(uploadBuffer->mappedMemory, pixels, texture.fileSize);
+                        // The texture was unloaded while we were decoding it, and its slot might already belong to another texture
+                        if (!texture.loaded || texture.generation != generation)
+                            return;
+
+                        if (isInitialLoad)
+                        {
+                            texture.width = width;
+                            texture.height = height;
+                            texture.layers = layers;
+                            texture.mipLevels = mipLevels;
+                            texture.format = format;
+                            texture.fileSize = textureSize;
+
+                            CreateTexture(texture);
+                            isLoaded = true;
+
+                            if (isStreamable)
+                            {
+                                std::scoped_lock lock(data.streamingMutex);
+
+                                TextureStreamingState& state = data.streamingStates[id];
+                                state.path = filename;
+                                state.generation = generation;
+                                state.residentBaseMip = baseMip;
+                                state.maxBaseMip = maxBaseMip;
+                                state.mipSizes = std::move(mipSizes);
+                                state.isLoading = true; // Cleared by CopyBufferToImage once the initial upload has been recorded
+                            }
+                        }
+                        else if (texture.pending == nullptr)
+                        {
+                            Texture* pending = new Texture();
+                            pending->debugName = texture.debugName;
+                            pending->width = width;
+                            pending->height = height;
+                            pending->layers = layers;
+                            pending->mipLevels = mipLevels;
+                            pending->format = format;
+                            pending->fileSize = textureSize;
+
+                            CreateTexture(*pending);
+                            texture.pending = pending;
+                            isLoaded = true;
+                        }
+                        else
+                        {
+                            // Another replacement is still waiting for its upload, drop this one so the texture can be picked again by UpdateStreaming
+                            std::scoped_lock lock(data.streamingMutex);
+
+                            auto itr = data.streamingStates.find(id);
+                            if (itr != data.streamingStates.end())
+                            {
+                                itr->second.isLoading = false;
+                            }
+                        }
+                    });
+            }
+
+            if (isLoaded)
+            {
+                // The upload is recorded once this handle goes out of scope, CopyBufferToImage then marks the texture as ready
+                auto uploadBuffer = _uploadBufferHandler->CreateUploadBuffer(textureID, 0, textureSize);
+                memcpy(uploadBuffer->mappedMemory, pixels, textureSize);
+            }
+
+            if (stbiPixels != nullptr)
+            {
+                stbi_image_free(stbiPixels);
             }
         }
 
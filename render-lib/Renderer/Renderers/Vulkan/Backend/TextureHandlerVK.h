@@ -1,6 +1,7 @@
 #pragma once
 #include <NovusTypes.h>
 #include <vulkan/vulkan_core.h>
+#include <vector>
 
 #include "../../../Descriptors/TextureDesc.h"
 #include "../../../Descriptors/TextureArrayDesc.h"
@@ -22,6 +23,8 @@ namespace Renderer
         class TextureHandlerVK
         {
         public:
+            ~TextureHandlerVK();
+
             void Init(RenderDeviceVK* device, BufferHandlerVK* bufferHandler, UploadBufferHandlerVK* uploadBufferHandler);
 
             void InitDebugTexture();
@@ -32,12 +35,22 @@ namespace Renderer
             void UnloadTexture(const TextureID textureID);
             void UnloadTexturesInArray(const TextureArrayID textureArrayID, u32 unloadStartIndex);
 
+            void RequestTextureDetail(const std::vector<TextureStreamingRequest>& requests);
+            void UpdateStreaming(size_t vramUsage, size_t vramBudget);
+            void SetStreamingBudget(size_t budget);
+            TextureStreamingStats GetStreamingStats();
+
+            TextureLookupBenchmarkResult BenchmarkLookups(u32 numQueries);
+
             TextureArrayID CreateTextureArray(const TextureArrayDesc& desc);
 
             TextureID CreateDataTexture(const DataTextureDesc& desc);
             TextureID CreateDataTextureIntoArray(const DataTextureDesc& desc, TextureArrayID textureArrayID, u32& arrayIndex);
+            void UpdateDataTexture(TextureID textureID, const DataTextureDesc& desc);
+            void UpdateDataTexture(TextureID textureID, const DataTextureDesc& desc, const DataTextureRegion& region);
 
             void CopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, size_t srcOffset, TextureID dstTextureID);
+            void CopyBufferToImageRegion(VkCommandBuffer commandBuffer, VkBuffer srcBuffer, size_t srcOffset, TextureID dstTextureID, const DataTextureRegion& region);
             void TransitionImageLayout(VkCommandBuffer commandBuffer, TextureID textureID, VkImageAspectFlags aspects, VkImageLayout oldLayout, VkImageLayout newLayout);
 
             const SafeVector<TextureID>& GetTextureIDsInArray(const TextureArrayID textureID);
@@ -56,7 +69,8 @@ namespace Renderer
             bool TryFindExistingTexture(u64 descHash, size_t& id);
             bool TryFindExistingTextureInArray(TextureArrayID textureArrayID, u64 descHash, size_t& arrayIndex, TextureID& textureID);
 
-            void LoadFile(const std::string& filename, Texture& texture, TextureID textureID);
+            void RunLoadThread();
+            void LoadFile(const std::string& filename, TextureID textureID, u32 generation, bool isInitialLoad, u32 baseMip);
             void CreateTexture(Texture& texture);
 
         private:
@@ -56,6 +56,10 @@ namespace Renderer
             TextureID targetTexture = TextureID::Invalid();
             size_t targetOffset;
             size_t stagingBufferOffset;
+
+            bool isRegion = false; // Region uploads only cover part of the first mip
+            DataTextureRegion region;
+            size_t regionSize = 0;
         };
 
         struct CopyBufferToBufferTask : UploadTask
@@ -313,6 +317,38 @@ namespace Renderer
                 DebugHandler::PrintFatal("UploadBufferHandlerVK : Tried to create an upload buffer pointing at an invalid texture");
             }
 
+            size_t targetTextureSize = _textureHandler->GetTextureSize(targetTexture);
+            if (targetOffset + size > targetTextureSize)
+            {
+                DebugHandler::PrintFatal("UploadBufferHandlerVK : Upload Overflowed Target Buffer");
+            }
+
+            UploadToTextureTask* task = new UploadToTextureTask();
+            task->targetTexture = targetTexture;
+            task->targetOffset = targetOffset;
+
+            return CreateTextureUploadBuffer(task, size);
+        }
+
+        std::shared_ptr<UploadBuffer> UploadBufferHandlerVK::CreateUploadBuffer(TextureID targetTexture, const DataTextureRegion& region, size_t size)
+        {
+            if (targetTexture == TextureID::Invalid())
+            {
+                DebugHandler::PrintFatal("UploadBufferHandlerVK : Tried to create an upload buffer pointing at an invalid texture");
+            }
+
+            UploadToTextureTask* task = new UploadToTextureTask();
+            task->targetTexture = targetTexture;
+            task->targetOffset = 0;
+            task->isRegion = true;
+            task->region = region;
+            task->regionSize = size;
+
+            return CreateTextureUploadBuffer(task, size);
+        }
+
+        std::shared_ptr<UploadBuffer> UploadBufferHandlerVK::CreateTextureUploadBuffer(UploadToTextureTask* task, size_t size)
+        {
             if (size > Settings::STAGING_BUFFER_SIZE)
             {
                 DebugHandler::PrintFatal("UploadBufferHandlerVK : Requested bigger staging memory than our staging buffer size!");
@@ -324,17 +360,8 @@ namespace Renderer
             StagingBufferID stagingBufferID;
             size_t offset = Allocate(size, stagingBufferID, mappedMemory);
 
-            UploadToTextureTask* task = new UploadToTextureTask();
-            task->targetTexture = targetTexture;
-            task->targetOffset = targetOffset;
             task->stagingBufferOffset = offset;
 
-            size_t targetTextureSize = _textureHandler->GetTextureSize(targetTexture);
-            if (targetOffset + size > targetTextureSize)
-            {
-                DebugHandler::PrintFatal("UploadBufferHandlerVK : Upload Overflowed Target Buffer");
-            }
-
             StagingBuffer& stagingBuffer = data->stagingBuffers.Get(static_cast<StagingBufferID::type>(stagingBufferID));
             stagingBuffer.uploadTasks.enqueue(task);
 
@@ -616,14 +643,21 @@ namespace Renderer
             VkBuffer srcBuffer = _bufferHandler->GetBuffer(stagingBuffer.buffer);
 
             size_t srcBufferSize = _bufferHandler->GetBufferSize(stagingBuffer.buffer);
-            size_t textureSize = _textureHandler->GetTextureSize(uploadToTextureTask->targetTexture);
+            size_t copySize = (uploadToTextureTask->isRegion) ? uploadToTextureTask->regionSize : _textureHandler->GetTextureSize(uploadToTextureTask->targetTexture);
 
-            if (uploadToTextureTask->stagingBufferOffset + textureSize > srcBufferSize)
+            if (uploadToTextureTask->stagingBufferOffset + copySize > srcBufferSize)
             {
                 DebugHandler::PrintFatal("[UploadBufferHandlerVK::HandleUploadToTextureTask] Source Buffer out of bounds!");
             }
 
-            _textureHandler->CopyBufferToImage(commandBuffer, srcBuffer, uploadToTextureTask->stagingBufferOffset, uploadToTextureTask->targetTexture);
+            if (uploadToTextureTask->isRegion)
+            {
+                _textureHandler->CopyBufferToImageRegion(commandBuffer, srcBuffer, uploadToTextureTask->stagingBufferOffset, uploadToTextureTask->targetTexture, uploadToTextureTask->region);
+            }
+            else
+            {
+                _textureHandler->CopyBufferToImage(commandBuffer, srcBuffer, uploadToTextureTask->stagingBufferOffset, uploadToTextureTask->targetTexture);
+            }
         }
 
         void UploadBufferHandlerVK::HandleCopyBufferToBufferTask(VkCommandBuffer commandBuffer, CopyBufferToBufferTask* copyBufferToBufferTask)
@@ -38,6 +38,7 @@ namespace Renderer
 
             [[nodiscard]] std::shared_ptr<UploadBuffer> CreateUploadBuffer(BufferID targetBuffer, size_t targetOffset, size_t size);
             [[nodiscard]] std::shared_ptr<UploadBuffer> CreateUploadBuffer(TextureID targetTexture, size_t targetOffset, size_t size);
+            [[nodiscard]] std::shared_ptr<UploadBuffer> CreateUploadBuffer(TextureID targetTexture, const DataTextureRegion& region, size_t size);
             void CopyBufferToBuffer(BufferID targetBuffer, size_t targetOffset, BufferID sourceBuffer, size_t sourceOffset, size_t size);
             void QueueDestroyBuffer(BufferID buffer);
 
@@ -46,6 +47,7 @@ namespace Renderer
             void SetHasWaitedForUpload();
         private:
             size_t Allocate(size_t size, StagingBufferID& stagingBufferID, void*& mappedMemory);
+            std::shared_ptr<UploadBuffer> CreateTextureUploadBuffer(UploadToTextureTask* task, size_t size);
             void ExecuteStagingBuffer(VkCommandBuffer commandBuffer, StagingBuffer& stagingBuffer);
             void ExecuteStagingBuffer(StagingBuffer& stagingBuffer);
             void WaitForStagingBuffer(StagingBuffer& stagingBuffer);
@@ -3,6 +3,8 @@
 #include <Utils/StringUtils.h>
 #include <Utils/DebugHandler.h>
 #include <Utils/SafeVector.h>
+#include <Utils/XXHash64.h>
+#include <algorithm>
 #include <tracy/Tracy.hpp>
 #include <tracy/TracyVulkan.hpp>
 
@@ -19,12 +21,80 @@
 #include "Backend/SwapChainVK.h"
 #include "Backend/DebugMarkerUtilVK.h"
 #include "Backend/DescriptorSetBuilderVK.h"
+#include "Backend/DescriptorSetCacheVK.h"
 #include "Backend/FormatConverterVK.h"
 
 #include "imgui/imgui_impl_vulkan.h"
 
 namespace Renderer
 {
+    namespace Backend
+    {
+        // A descriptor resolved down to the Vulkan handles it binds
+        struct ResolvedDescriptorVK
+        {
+            u32 nameHash;
+            DescriptorType descriptorType;
+
+            VkDescriptorImageInfo* imageInfos; // Points into the DescriptorArenaVK
+            u32 numImageInfos;
+
+            VkDescriptorBufferInfo bufferInfo;
+        };
+
+        // Scratch memory for BindDescriptorSet, it gets reset every bind but keeps its blocks around so recording doesn't allocate once it has warmed up
+        struct DescriptorArenaVK
+        {
+            static constexpr size_t BLOCK_SIZE = 4096;
+
+            VkDescriptorImageInfo* AllocateImageInfos(size_t count)
+            {
+                // Blocks never grow, so the pointers we hand out stay valid until the next Reset
+                while (blockIndex < blocks.size())
+                {
+                    std::vector<VkDescriptorImageInfo>& block = blocks[blockIndex];
+
+                    if (blockOffset + count <= block.size())
+                    {
+                        VkDescriptorImageInfo* imageInfos = block.data() + blockOffset;
+                        blockOffset += count;
+
+                        return imageInfos;
+                    }
+
+                    blockIndex++;
+                    blockOffset = 0;
+                }
+
+                std::vector<VkDescriptorImageInfo>& block = blocks.emplace_back(std::max(count, BLOCK_SIZE));
+                blockOffset = count;
+
+                return block.data();
+            }
+
+            void Reset()
+            {
+                blockIndex = 0;
+                blockOffset = 0;
+
+                resolvedDescriptors.clear();
+                key.clear();
+                handles.clear();
+            }
+
+            std::vector<std::vector<VkDescriptorImageInfo>> blocks;
+            size_t blockIndex = 0;
+            size_t blockOffset = 0;
+
+            std::vector<ResolvedDescriptorVK> resolvedDescriptors;
+            std::vector<u64> key;
+            std::vector<u64> handles;
+        };
+    }
+
+    // Passes can be recorded from several threads, so each of them gets its own arena
+    static thread_local Backend::DescriptorArenaVK descriptorArena;
+
     RendererVK::RendererVK()
         : _device(new Backend::RenderDeviceVK())
     {
@@ -83,6 +153,7 @@ namespace Renderer
 
         _shaderHandler->ReloadShaders(forceRecompileAll);
         _pipelineHandler->DiscardPipelines();
+        _device->_descriptorSetCache->Clear(); // The cached sets were allocated with the layouts we just destroyed
 
         CreateDummyPipeline();
     }
@@ -94,11 +165,13 @@ namespace Renderer
 
     BufferID RendererVK::CreateBuffer(BufferDesc& desc)
     {
+        std::scoped_lock lock(_recordingMutex);
         return _bufferHandler->CreateBuffer(desc);
     }
 
     BufferID RendererVK::CreateTemporaryBuffer(BufferDesc& desc, u32 framesLifetime)
     {
+        std::scoped_lock lock(_recordingMutex);
         return _bufferHandler->CreateTemporaryBuffer(desc, framesLifetime);
     }
 
@@ -125,6 +198,7 @@ namespace Renderer
 
     SamplerID RendererVK::CreateSampler(SamplerDesc& desc)
     {
+        std::scoped_lock lock(_recordingMutex);
         return _samplerHandler->CreateSampler(desc);
     }
 
@@ -135,6 +209,8 @@ namespace Renderer
 
     GraphicsPipelineID RendererVK::CreatePipeline(GraphicsPipelineDesc& desc)
     {
+        std::scoped_lock lock(_recordingMutex);
+
 #if _DEBUG
         if (!_isExecutingCommandlist)
         {
@@ -147,6 +223,8 @@ namespace Renderer
 
     ComputePipelineID RendererVK::CreatePipeline(ComputePipelineDesc& desc)
     {
+        std::scoped_lock lock(_recordingMutex);
+
 #if _DEBUG
         if (!_isExecutingCommandlist)
         {
@@ -172,6 +250,16 @@ namespace Renderer
         return _textureHandler->CreateDataTextureIntoArray(desc, textureArray, arrayIndex);
     }
 
+    void RendererVK::UpdateDataTexture(TextureID textureID, DataTextureDesc& desc)
+    {
+        _textureHandler->UpdateDataTexture(textureID, desc);
+    }
+
+    void RendererVK::UpdateDataTexture(TextureID textureID, DataTextureDesc& desc, const DataTextureRegion& region)
+    {
+        _textureHandler->UpdateDataTexture(textureID, desc, region);
+    }
+
     TextureID RendererVK::LoadTexture(TextureDesc& desc)
     {
         return _textureHandler->LoadTexture(desc);
@@ -184,16 +272,19 @@ namespace Renderer
 
     VertexShaderID RendererVK::LoadShader(VertexShaderDesc& desc)
     {
+        std::scoped_lock lock(_recordingMutex);
         return _shaderHandler->LoadShader(desc);
     }
 
     PixelShaderID RendererVK::LoadShader(PixelShaderDesc& desc)
     {
+        std::scoped_lock lock(_recordingMutex);
         return _shaderHandler->LoadShader(desc);
     }
 
     ComputeShaderID RendererVK::LoadShader(ComputeShaderDesc& desc)
     {
+        std::scoped_lock lock(_recordingMutex);
         return _shaderHandler->LoadShader(desc);
     }
 
@@ -211,6 +302,26 @@ namespace Renderer
         _textureHandler->UnloadTexturesInArray(textureArrayID, unloadStartIndex);
     }
 
+    void RendererVK::RequestTextureDetail(const std::vector<TextureStreamingRequest>& requests)
+    {
+        _textureHandler->RequestTextureDetail(requests);
+    }
+
+    void RendererVK::SetTextureStreamingBudget(size_t budget)
+    {
+        _textureHandler->SetStreamingBudget(budget);
+    }
+
+    TextureStreamingStats RendererVK::GetTextureStreamingStats()
+    {
+        return _textureHandler->GetStreamingStats();
+    }
+
+    TextureLookupBenchmarkResult RendererVK::BenchmarkTextureLookups(u32 numQueries)
+    {
+        return _textureHandler->BenchmarkLookups(numQueries);
+    }
+
     static VmaBudget sBudgets[16] = { 0 };
 
     void RendererVK::FlipFrame(u32 frameIndex)
@@ -238,11 +349,15 @@ namespace Renderer
         }
 
         _commandListHandler->ResetCommandBuffers();
+        _device->_descriptorSetCache->FlipFrame();
         _uploadBufferHandler->ExecuteUploadTasks();
         _bufferHandler->OnFrameStart();
 
         vmaSetCurrentFrameIndex(_device->_allocator, frameIndex);
         vmaGetBudget(_device->_allocator, sBudgets);
+
+        // The frame fence we just waited on also retires the texture images streaming replaced a few frames ago
+        _textureHandler->UpdateStreaming(sBudgets[0].usage, sBudgets[0].budget);
     }
 
     ImageDesc RendererVK::GetImageDesc(ImageID ID)
@@ -711,157 +826,164 @@ namespace Renderer
         return false;
     }
 
-    void RendererVK::BindDescriptor(Backend::DescriptorSetBuilderVK* builder, void* imageInfosArraysVoid, Descriptor& descriptor)
+    void RendererVK::ResolveDescriptor(Backend::DescriptorArenaVK& arena, Descriptor& descriptor)
     {
-        std::vector<std::vector<VkDescriptorImageInfo>>& imageInfosArrays = *static_cast<std::vector<std::vector<VkDescriptorImageInfo>>*>(imageInfosArraysVoid);
+        Backend::ResolvedDescriptorVK& resolved = arena.resolvedDescriptors.emplace_back();
+        resolved.nameHash = descriptor.nameHash;
+        resolved.descriptorType = descriptor.descriptorType;
+        resolved.imageInfos = nullptr;
+        resolved.numImageInfos = 0;
+        resolved.bufferInfo = {};
 
         if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_SAMPLER)
         {
-            VkDescriptorImageInfo imageInfo = {};
+            VkDescriptorImageInfo& imageInfo = *arena.AllocateImageInfos(1);
+            imageInfo = {};
             imageInfo.sampler = _samplerHandler->GetSampler(descriptor.samplerID);
 
-            builder->BindSampler(descriptor.nameHash, imageInfo);
+            resolved.imageInfos = &imageInfo;
+            resolved.numImageInfos = 1;
         }
         else if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_TEXTURE)
         {
-            VkDescriptorImageInfo imageInfo = {};
+            VkDescriptorImageInfo& imageInfo = *arena.AllocateImageInfos(1);
+            imageInfo = {};
             imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             imageInfo.imageView = _textureHandler->GetImageView(descriptor.textureID);
 
-            builder->BindImage(descriptor.nameHash, imageInfo);
+            resolved.imageInfos = &imageInfo;
+            resolved.numImageInfos = 1;
         }
         else if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_TEXTURE_ARRAY)
         {
             const SafeVector<TextureID>& textureIDs = _textureHandler->GetTextureIDsInArray(descriptor.textureArrayID);
-            std::vector<VkDescriptorImageInfo>& imageInfos = imageInfosArrays.emplace_back();
-
             u32 textureArraySize = _textureHandler->GetTextureArraySize(descriptor.textureArrayID);
-            imageInfos.reserve(textureArraySize);
-            
-            u32 numTextures = static_cast<u32>(textureIDs.Size());
-
-            // From 0 to numTextures, add our actual textures
-            bool texturesAreOnionTextures = false;
 
             textureIDs.ReadLock(
-                [&](const std::vector<TextureID> textures)
+                [&](const std::vector<TextureID>& textures)
                 {
-                    for (auto textureID : textures)
+                    u32 numTextures = static_cast<u32>(textures.size());
+                    u32 numImageInfos = glm::max(numTextures, textureArraySize);
+
+                    VkDescriptorImageInfo* imageInfos = arena.AllocateImageInfos(numImageInfos);
+
+                    // From 0 to numTextures, add our actual textures
+                    bool texturesAreOnionTextures = false;
+
+                    for (u32 i = 0; i < numTextures; i++)
                     {
-                        VkDescriptorImageInfo& imageInfo = imageInfos.emplace_back();
+                        VkDescriptorImageInfo& imageInfo = imageInfos[i];
                         imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                        imageInfo.imageView = _textureHandler->GetImageView(textureID);
+                        imageInfo.imageView = _textureHandler->GetImageView(textures[i]);
                         imageInfo.sampler = VK_NULL_HANDLE;
 
-                        texturesAreOnionTextures = _textureHandler->IsOnionTexture(textureID);
+                        texturesAreOnionTextures = _textureHandler->IsOnionTexture(textures[i]);
                     }
-                });
 
-            // from numTextures to textureArraySize, add debug texture
-            VkDescriptorImageInfo imageInfoDebugTexture;
-            imageInfoDebugTexture.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                    // from numTextures to textureArraySize, add debug texture
+                    VkDescriptorImageInfo imageInfoDebugTexture;
+                    imageInfoDebugTexture.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-            if (texturesAreOnionTextures)
-            {
-                imageInfoDebugTexture.imageView = _textureHandler->GetDebugOnionTextureImageView();
-            }
-            else
-            {
-                imageInfoDebugTexture.imageView = _textureHandler->GetDebugTextureImageView();
-            }
-            
-            imageInfoDebugTexture.sampler = VK_NULL_HANDLE;
+                    if (texturesAreOnionTextures)
+                    {
+                        imageInfoDebugTexture.imageView = _textureHandler->GetDebugOnionTextureImageView();
+                    }
+                    else
+                    {
+                        imageInfoDebugTexture.imageView = _textureHandler->GetDebugTextureImageView();
+                    }
 
-            for (u32 i = numTextures; i < textureArraySize; i++)
-            {
-                imageInfos.push_back(imageInfoDebugTexture);
-            }
-            
-            builder->BindImageArray(descriptor.nameHash, imageInfos.data(), static_cast<i32>(imageInfos.size()));
+                    imageInfoDebugTexture.sampler = VK_NULL_HANDLE;
+
+                    for (u32 i = numTextures; i < numImageInfos; i++)
+                    {
+                        imageInfos[i] = imageInfoDebugTexture;
+                    }
+
+                    resolved.imageInfos = imageInfos;
+                    resolved.numImageInfos = numImageInfos;
+                });
         }
         else if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_IMAGE)
         {
-            VkDescriptorImageInfo imageInfo = {};
+            VkDescriptorImageInfo& imageInfo = *arena.AllocateImageInfos(1);
+            imageInfo = {};
             imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
             imageInfo.imageView = _imageHandler->GetColorView(descriptor.imageID,descriptor.imageMipLevel);
 
-            builder->BindImage(descriptor.nameHash, imageInfo);
+            resolved.imageInfos = &imageInfo;
+            resolved.numImageInfos = 1;
         }
         else if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_DEPTH_IMAGE)
         {
-            VkDescriptorImageInfo imageInfo = {};
+            VkDescriptorImageInfo& imageInfo = *arena.AllocateImageInfos(1);
+            imageInfo = {};
             imageInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
             imageInfo.imageView = _imageHandler->GetDepthView(descriptor.depthImageID);
 
-            builder->BindImage(descriptor.nameHash, imageInfo);
-        }
-        else if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_STORAGE_IMAGE)
-        {
-            std::vector<VkDescriptorImageInfo>& imageInfos = imageInfosArrays.emplace_back();
-            imageInfos.reserve(descriptor.count);
-
-            const ImageDesc& imageDesc = _imageHandler->GetImageDesc(descriptor.imageID);
-
-            for (u32 i = 0; i < descriptor.count; i++)
-            {
-                u32 mipLevel = descriptor.imageMipLevel + i;
-
-                if (mipLevel < imageDesc.mipLevels)
-                {
-                    VkDescriptorImageInfo& imageInfo = imageInfos.emplace_back();
-                    imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-                    imageInfo.imageView = _imageHandler->GetColorView(descriptor.imageID, mipLevel);
-                    imageInfo.sampler = VK_NULL_HANDLE;
-                }
-                else
-                {
-                    // Any imageInfos pointing to mips we don't have should point to the last mip
-                    VkDescriptorImageInfo& imageInfo = imageInfos.emplace_back();
-                    imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-                    imageInfo.imageView = _imageHandler->GetColorView(descriptor.imageID, imageDesc.mipLevels - 1);
-                    imageInfo.sampler = VK_NULL_HANDLE;
-                }
-            }
-
-            builder->BindStorageImage(descriptor.nameHash, imageInfos.data(), static_cast<i32>(imageInfos.size()));
+            resolved.imageInfos = &imageInfo;
+            resolved.numImageInfos = 1;
         }
-        else if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_STORAGE_IMAGE_ARRAY)
+        else if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_STORAGE_IMAGE || descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_STORAGE_IMAGE_ARRAY)
         {
-            std::vector<VkDescriptorImageInfo>& imageInfos = imageInfosArrays.emplace_back();
-            imageInfos.reserve(descriptor.count);
+            VkDescriptorImageInfo* imageInfos = arena.AllocateImageInfos(descriptor.count);
 
             const ImageDesc& imageDesc = _imageHandler->GetImageDesc(descriptor.imageID);
+            bool isArray = descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_STORAGE_IMAGE_ARRAY;
 
             for (u32 i = 0; i < descriptor.count; i++)
             {
-                u32 mipLevel = descriptor.imageMipLevel + i;
+                // Any imageInfos pointing to mips we don't have should point to the last mip
+                u32 mipLevel = glm::min(descriptor.imageMipLevel + i, imageDesc.mipLevels - 1);
 
-                if (mipLevel < imageDesc.mipLevels)
-                {
-                    VkDescriptorImageInfo& imageInfo = imageInfos.emplace_back();
-                    imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-                    imageInfo.imageView = _imageHandler->GetColorArrayView(descriptor.imageID, mipLevel);
-                    imageInfo.sampler = VK_NULL_HANDLE;
-                }
-                else
-                {
-                    // Any imageInfos pointing to mips we don't have should point to the last mip
-                    VkDescriptorImageInfo& imageInfo = imageInfos.emplace_back();
-                    imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
-                    imageInfo.imageView = _imageHandler->GetColorArrayView(descriptor.imageID, imageDesc.mipLevels - 1);
-                    imageInfo.sampler = VK_NULL_HANDLE;
-                }
+                VkDescriptorImageInfo& imageInfo = imageInfos[i];
+                imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                imageInfo.imageView = isArray ? _imageHandler->GetColorArrayView(descriptor.imageID, mipLevel) : _imageHandler->GetColorView(descriptor.imageID, mipLevel);
+                imageInfo.sampler = VK_NULL_HANDLE;
             }
 
-            builder->BindStorageImageArray(descriptor.nameHash, imageInfos.data(), static_cast<i32>(imageInfos.size()));
+            resolved.imageInfos = imageInfos;
+            resolved.numImageInfos = descriptor.count;
         }
         else if (descriptor.descriptorType == DescriptorType::DESCRIPTOR_TYPE_BUFFER)
         {
-            VkDescriptorBufferInfo bufferInfo = {};
-            bufferInfo.buffer = _bufferHandler->GetBuffer(descriptor.bufferID);
-            bufferInfo.range = _bufferHandler->GetBufferSize(descriptor.bufferID);
+            resolved.bufferInfo.buffer = _bufferHandler->GetBuffer(descriptor.bufferID);
+            resolved.bufferInfo.range = _bufferHandler->GetBufferSize(descriptor.bufferID);
+        }
+    }
 
-            builder->BindBuffer(descriptor.nameHash, bufferInfo);
+    void RendererVK::BindResolvedDescriptor(Backend::DescriptorSetBuilderVK* builder, Backend::ResolvedDescriptorVK& resolved)
+    {
+        switch (resolved.descriptorType)
+        {
+            case DescriptorType::DESCRIPTOR_TYPE_SAMPLER:
+                builder->BindSampler(resolved.nameHash, resolved.imageInfos[0]);
+                break;
+
+            case DescriptorType::DESCRIPTOR_TYPE_TEXTURE:
+            case DescriptorType::DESCRIPTOR_TYPE_IMAGE:
+            case DescriptorType::DESCRIPTOR_TYPE_DEPTH_IMAGE:
+                builder->BindImage(resolved.nameHash, resolved.imageInfos[0]);
+                break;
+
+            case DescriptorType::DESCRIPTOR_TYPE_TEXTURE_ARRAY:
+                builder->BindImageArray(resolved.nameHash, resolved.imageInfos, static_cast<i32>(resolved.numImageInfos));
+                break;
+
+            case DescriptorType::DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                builder->BindStorageImage(resolved.nameHash, resolved.imageInfos, static_cast<i32>(resolved.numImageInfos));
+                break;
+
+            case DescriptorType::DESCRIPTOR_TYPE_STORAGE_IMAGE_ARRAY:
+                builder->BindStorageImageArray(resolved.nameHash, resolved.imageInfos, static_cast<i32>(resolved.numImageInfos));
+                break;
+
+            case DescriptorType::DESCRIPTOR_TYPE_BUFFER:
+                builder->BindBuffer(resolved.nameHash, resolved.bufferInfo);
+                break;
+
+            default:
+                break;
         }
     }
 
@@ -870,6 +992,7 @@ namespace Renderer
         _device->RecreateSwapChain(_imageHandler, _semaphoreHandler, swapChain);
         
         _pipelineHandler->DiscardPipelines();
+        _device->_descriptorSetCache->Clear(); // This also drops every set referencing the images OnWindowResize recreates
         CreateDummyPipeline();
         
         _imageHandler->OnWindowResize();
@@ -905,6 +1028,10 @@ namespace Renderer
         GraphicsPipelineID graphicsPipelineID = _commandListHandler->GetBoundGraphicsPipeline(commandListID);
         ComputePipelineID computePipelineID = _commandListHandler->GetBoundComputePipeline(commandListID);
 
+        Backend::DescriptorSetBuilderVK* builder = nullptr;
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+        VkPipelineBindPoint bindPoint;
+
         if (graphicsPipelineID != GraphicsPipelineID::Invalid())
         {
             if (_pipelineHandler->GetNumDescriptorSetLayouts(graphicsPipelineID) <= static_cast<u32>(slot))
@@ -912,24 +1039,9 @@ namespace Renderer
                 return;
             }
 
-            std::vector<std::vector<VkDescriptorImageInfo>> imageInfosArrays; // These need to live until builder->BuildDescriptor()
-            imageInfosArrays.reserve(8);
-
-            Backend::DescriptorSetBuilderVK* builder = _pipelineHandler->GetDescriptorSetBuilder(graphicsPipelineID);
-
-            for (u32 i = 0; i < numDescriptors; i++)
-            {
-                ZoneScopedNC("BindDescriptor", tracy::Color::Red3);
-                Descriptor& descriptor = descriptors[i];
-                BindDescriptor(builder, &imageInfosArrays, descriptor);
-            }
-
-            VkDescriptorSet descriptorSet = builder->BuildDescriptor(static_cast<i32>(slot), Backend::DescriptorLifetime::PerFrame);
-
-            VkPipelineLayout pipelineLayout = _pipelineHandler->GetPipelineLayout(graphicsPipelineID);
-
-            // Bind descriptor set
-            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, slot, 1, &descriptorSet, 0, nullptr);
+            builder = _pipelineHandler->GetDescriptorSetBuilder(graphicsPipelineID);
+            pipelineLayout = _pipelineHandler->GetPipelineLayout(graphicsPipelineID);
+            bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
         } 
         else if (computePipelineID != ComputePipelineID::Invalid())
         {
@@ -938,25 +1050,83 @@ namespace Renderer
                 return;
             }
 
-            std::vector<std::vector<VkDescriptorImageInfo>> imageInfosArrays; // These need to live until builder->BuildDescriptor()
-            imageInfosArrays.reserve(8);
+            builder = _pipelineHandler->GetDescriptorSetBuilder(computePipelineID);
+            pipelineLayout = _pipelineHandler->GetPipelineLayout(computePipelineID);
+            bindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+        }
+        else
+        {
+            return;
+        }
 
-            Backend::DescriptorSetBuilderVK* builder = _pipelineHandler->GetDescriptorSetBuilder(computePipelineID);
+        Backend::DescriptorArenaVK& arena = descriptorArena;
+        arena.Reset(); // Whatever the last bind on this thread resolved has been consumed by now
+
+        for (u32 i = 0; i < numDescriptors; i++)
+        {
+            ZoneScopedNC("ResolveDescriptor", tracy::Color::Red3);
+            ResolveDescriptor(arena, descriptors[i]);
+        }
+
+        // The cache key is the layout plus every handle we're about to bind, so anything that changed what a descriptor resolves to (like a texture finishing loading) gets a new set
+        std::vector<u64>& key = arena.key;
+        key.push_back(reinterpret_cast<u64>(builder->GetDescriptorSetLayout(static_cast<i32>(slot))));
+        key.push_back(static_cast<u64>(slot));
+
+        for (const Backend::ResolvedDescriptorVK& resolved : arena.resolvedDescriptors)
+        {
+            key.push_back(resolved.nameHash);
+            key.push_back(static_cast<u64>(resolved.descriptorType));
+            key.push_back(resolved.numImageInfos);
 
-            for (u32 i = 0; i < numDescriptors; i++)
+            for (u32 i = 0; i < resolved.numImageInfos; i++)
             {
-                ZoneScopedNC("BindDescriptor", tracy::Color::Red3);
-                Descriptor& descriptor = descriptors[i];
-                BindDescriptor(builder, &imageInfosArrays, descriptor);
+                const VkDescriptorImageInfo& imageInfo = resolved.imageInfos[i];
+
+                key.push_back(reinterpret_cast<u64>(imageInfo.sampler));
+                key.push_back(reinterpret_cast<u64>(imageInfo.imageView));
+                key.push_back(static_cast<u64>(imageInfo.imageLayout));
             }
 
-            VkDescriptorSet descriptorSet = builder->BuildDescriptor(static_cast<i32>(slot), Backend::DescriptorLifetime::PerFrame);
+            key.push_back(reinterpret_cast<u64>(resolved.bufferInfo.buffer));
+            key.push_back(static_cast<u64>(resolved.bufferInfo.range));
+        }
+
+        u64 hash = XXHash64::hash(key.data(), key.size() * sizeof(u64), 0);
+
+        VkDescriptorSet descriptorSet;
+        if (!_device->_descriptorSetCache->TryGetDescriptorSet(hash, descriptorSet))
+        {
+            ZoneScopedNC("BuildDescriptorSet", tracy::Color::Red3);
+
+            std::vector<u64>& handles = arena.handles;
+            for (Backend::ResolvedDescriptorVK& resolved : arena.resolvedDescriptors)
+            {
+                BindResolvedDescriptor(builder, resolved);
+
+                // Samplers are never destroyed, so only image views and buffers can make a cached set go stale
+                for (u32 i = 0; i < resolved.numImageInfos; i++)
+                {
+                    if (resolved.imageInfos[i].imageView != VK_NULL_HANDLE)
+                    {
+                        handles.push_back(reinterpret_cast<u64>(resolved.imageInfos[i].imageView));
+                    }
+                }
+
+                if (resolved.bufferInfo.buffer != VK_NULL_HANDLE)
+                {
+                    handles.push_back(reinterpret_cast<u64>(resolved.bufferInfo.buffer));
+                }
+            }
 
-            VkPipelineLayout pipelineLayout = _pipelineHandler->GetPipelineLayout(computePipelineID);
+            std::sort(handles.begin(), handles.end());
+            handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
 
-            // Bind descriptor set
-            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, slot, 1, &descriptorSet, 0, nullptr);
+            descriptorSet = _device->_descriptorSetCache->AddDescriptorSet(hash, builder, static_cast<i32>(slot), handles.data(), static_cast<u32>(handles.size()));
         }
+
+        // Bind descriptor set
+        vkCmdBindDescriptorSets(commandBuffer, bindPoint, pipelineLayout, slot, 1, &descriptorSet, 0, nullptr);
     }
 
     void RendererVK::MarkFrameStart(CommandListID commandListID, u32 frameIndex)
@@ -1550,6 +1720,8 @@ namespace Renderer
 
     void* RendererVK::MapBuffer(BufferID buffer)
     {
+        std::scoped_lock lock(_recordingMutex);
+
         void* mappedMemory;
 
         VkResult result = vmaMapMemory(_device->_allocator, _bufferHandler->GetBufferAllocation(buffer), &mappedMemory);
@@ -1563,6 +1735,7 @@ namespace Renderer
     
     void RendererVK::UnmapBuffer(BufferID buffer)
     {
+        std::scoped_lock lock(_recordingMutex);
         vmaUnmapMemory(_device->_allocator, _bufferHandler->GetBufferAllocation(buffer));
     }
 
@@ -1585,16 +1758,31 @@ namespace Renderer
         return budget;
     }
 
+    u32 RendererVK::GetNumDescriptorSetCacheHits()
+    {
+        return _device->_descriptorSetCache->GetNumHits();
+    }
+
+    u32 RendererVK::GetNumDescriptorSetCacheMisses()
+    {
+        return _device->_descriptorSetCache->GetNumMisses();
+    }
+
+    u32 RendererVK::GetNumCachedDescriptorSets()
+    {
+        return _device->_descriptorSetCache->GetNumDescriptorSets();
+    }
+
     void RendererVK::InitImgui()
     {
         _device->InitializeImguiVulkan();
     }
 
-    void RendererVK::DrawImgui(CommandListID commandListID)
+    void RendererVK::DrawImgui(CommandListID commandListID, ImDrawData* drawData)
     {
         VkCommandBuffer cmd = _commandListHandler->GetCommandBuffer(commandListID);
 
-        ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cmd);
+        ImGui_ImplVulkan_RenderDrawData(drawData, cmd);
     }
 
     u32 RendererVK::GetNumImages()
@@ -21,6 +21,8 @@ namespace Renderer
         class UploadBufferHandlerVK;
         struct BindInfo;
         class DescriptorSetBuilderVK;
+        struct ResolvedDescriptorVK;
+        struct DescriptorArenaVK;
         struct SwapChainVK;
         class DescriptorSetBuilderVK;
     }
@@ -55,6 +57,8 @@ namespace Renderer
 
         [[nodiscard]] TextureID CreateDataTexture(DataTextureDesc& desc) override;
         [[nodiscard]] TextureID CreateDataTextureIntoArray(DataTextureDesc& desc, TextureArrayID textureArray, u32& arrayIndex) override;
+        void UpdateDataTexture(TextureID textureID, DataTextureDesc& desc) override;
+        void UpdateDataTexture(TextureID textureID, DataTextureDesc& desc, const DataTextureRegion& region) override;
 
         // Loading
         [[nodiscard]] TextureID LoadTexture(TextureDesc& desc) override;
@@ -68,6 +72,12 @@ namespace Renderer
         void UnloadTexture(TextureID textureID) override;
         void UnloadTexturesInArray(TextureArrayID textureArrayID, u32 unloadStartIndex) override;
 
+        void RequestTextureDetail(const std::vector<TextureStreamingRequest>& requests) override;
+        void SetTextureStreamingBudget(size_t budget) override;
+        [[nodiscard]] TextureStreamingStats GetTextureStreamingStats() override;
+
+        [[nodiscard]] TextureLookupBenchmarkResult BenchmarkTextureLookups(u32 numQueries) override;
+
         // Command List Functions
         [[nodiscard]] CommandListID BeginCommandList() override;
         void EndCommandList(CommandListID commandListID) override;
@@ -140,15 +150,20 @@ namespace Renderer
         [[nodiscard]] size_t GetVRAMUsage() override;
         [[nodiscard]] size_t GetVRAMBudget() override;
 
+        [[nodiscard]] u32 GetNumDescriptorSetCacheHits() override;
+        [[nodiscard]] u32 GetNumDescriptorSetCacheMisses() override;
+        [[nodiscard]] u32 GetNumCachedDescriptorSets() override;
+
         [[nodiscard]] u32 GetNumImages() override;
         [[nodiscard]] u32 GetNumDepthImages() override;
 
         void InitImgui() override;
-        void DrawImgui(CommandListID commandListID) override;
+        void DrawImgui(CommandListID commandListID, ImDrawData* drawData) override;
 
     private:
         [[nodiscard]] bool ReflectDescriptorSet(const std::string& name, u32 nameHash, u32 type, i32& set, const std::vector<Backend::BindInfo>& bindInfos, u32& outBindInfoIndex, VkDescriptorSetLayoutBinding* outDescriptorLayoutBinding);
-        void BindDescriptor(Backend::DescriptorSetBuilderVK* builder, void* imageInfosArraysVoid, Descriptor& descriptor);
+        void ResolveDescriptor(Backend::DescriptorArenaVK& arena, Descriptor& descriptor);
+        void BindResolvedDescriptor(Backend::DescriptorSetBuilderVK* builder, Backend::ResolvedDescriptorVK& resolved);
 
         void RecreateSwapChain(Backend::SwapChainVK* swapChain);
         void CreateDummyPipeline();
@@ -172,6 +187,7 @@ namespace Renderer
         ScissorRect _lastScissorRect;
 
         std::mutex _destroyListMutex;
+        std::mutex _recordingMutex; // Passes load shaders, create pipelines and buffers while recording, with parallel pass recording this happens from several threads
 
         struct ObjectDestroyList
         {
@@ -1,23 +1,10 @@
 
-struct PanelData
-{
-    float4 color;
-    uint4 borderSize;
-    uint4 borderInset;
-    uint4 slicingOffset;
-    float2 dimensions;
-};
+#include "UI/ui.inc.hlsl"
 
-[[vk::binding(0, PER_PASS)]] SamplerState _sampler;
-[[vk::binding(1, PER_DRAW)]] ConstantBuffer<PanelData> _panelData;
-[[vk::binding(2, PER_DRAW)]] Texture2D<float4> _texture;
-[[vk::binding(3, PER_DRAW)]] Texture2D<float4> _border;
+[[vk::binding(3, PER_PASS)]] Texture2D<float4> _textures[4096]; // This needs to be defined last since the array is variable sized
 
-struct VertexOutput
-{
-    float4 position : SV_POSITION;
-    float2 uv : TEXCOORD0;
-};
+static ElementRenderData _panelData;
+static uint _textureIndex;
 
 float Map(float value, float originalMin, float originalMax, float newMin, float newMax)
 {
@@ -41,7 +28,7 @@ float NineSliceAxis(float coord, float pixelBorderMin, float pixelBorderMax, flo
 float4 GetBorderColor(float2 uv)
 {
     float2 pixelTextureDimension; // Dimension of the actual texture, without any scaling
-    _border.GetDimensions(pixelTextureDimension.x, pixelTextureDimension.y);
+    _textures[NonUniformResourceIndex(_panelData.borderTextureIndex)].GetDimensions(pixelTextureDimension.x, pixelTextureDimension.y);
     
     // TODO: Maybe toggle BorderColor stuff through the constant buffer instead
     if (pixelTextureDimension.x == 1)
@@ -59,10 +46,10 @@ float4 GetBorderColor(float2 uv)
     float bottomBorderSize = _panelData.borderSize.z;
     float leftBorderSize = _panelData.borderSize.w;
     
-    float topBorderUVOffset = topBorderSize / _panelData.dimensions.y;
-    float rightBorderUVOffset = rightBorderSize / _panelData.dimensions.x;
-    float bottomBorderUVOffset = bottomBorderSize / _panelData.dimensions.y;
-    float leftBorderUVOffset = leftBorderSize / _panelData.dimensions.x;
+    float topBorderUVOffset = topBorderSize / _panelData.size.y;
+    float rightBorderUVOffset = rightBorderSize / _panelData.size.x;
+    float bottomBorderUVOffset = bottomBorderSize / _panelData.size.y;
+    float leftBorderUVOffset = leftBorderSize / _panelData.size.x;
     
     float2 adjustedUV = uv;
     
@@ -139,12 +126,12 @@ float4 GetBorderColor(float2 uv)
     }
     
     
-    return _border.SampleLevel(_sampler, adjustedUV, 0);
+    return _textures[NonUniformResourceIndex(_panelData.borderTextureIndex)].SampleLevel(_sampler, adjustedUV, 0);
 }
 
 float4 GetColor(float2 uv)
 {
-    float2 pixel = uv * _panelData.dimensions;
+    float2 pixel = uv * _panelData.size;
     
     float topBorderInset = _panelData.borderInset.x;
     float rightBorderInset = _panelData.borderInset.y;
@@ -154,24 +141,27 @@ float4 GetColor(float2 uv)
     if (pixel.x < leftBorderInset)
         return float4(0,0,0,0);
     
-    if (pixel.x > _panelData.dimensions.x - rightBorderInset)
+    if (pixel.x > _panelData.size.x - rightBorderInset)
         return float4(0,0,0,0);
     
     if (pixel.y < topBorderInset)
         return float4(0,0,0,0);
     
-    if (pixel.y > _panelData.dimensions.y - bottomBorderInset)
+    if (pixel.y > _panelData.size.y - bottomBorderInset)
         return float4(0,0,0,0);
     
-    return _texture.SampleLevel(_sampler, uv, 0) * _panelData.color;
+    return _textures[NonUniformResourceIndex(_textureIndex)].SampleLevel(_sampler, uv, 0) * _panelData.color;
 }
 
 float4 main(VertexOutput input) : SV_Target
 {
+    _panelData = _elementRenderDatas[input.elementIndex];
+    _textureIndex = input.textureIndex;
+
     float2 pixelTextureDimension; // Dimension of the actual texture, without any scaling
-    _texture.GetDimensions(pixelTextureDimension.x, pixelTextureDimension.y);
+    _textures[NonUniformResourceIndex(_textureIndex)].GetDimensions(pixelTextureDimension.x, pixelTextureDimension.y);
     
-    float2 scaledPixelTextureDimension = _panelData.dimensions; // Dimension of the scaled image in our engine
+    float2 scaledPixelTextureDimension = _panelData.size; // Dimension of the scaled image in our engine
     
     float topSlicingOffset = _panelData.slicingOffset.x;
     float rightSlicingOffset = _panelData.slicingOffset.y;
@@ -0,0 +1,58 @@
+struct Quad
+{
+    float4 rect; // left, top, right, bottom in UV space
+    float4 texCoord; // left, top, right, bottom
+    uint textureIndex;
+    uint elementIndex;
+    uint2 padding;
+};
+
+struct ElementRenderData
+{
+    float4 color;
+    float4 outlineColor;
+    uint4 borderSize;
+    uint4 borderInset;
+    uint4 slicingOffset;
+    float2 size;
+    float outlineWidth;
+    uint borderTextureIndex;
+};
+
+[[vk::binding(0, PER_PASS)]] SamplerState _sampler;
+[[vk::binding(1, PER_PASS)]] StructuredBuffer<Quad> _quads;
+[[vk::binding(2, PER_PASS)]] StructuredBuffer<ElementRenderData> _elementRenderDatas;
+
+struct VertexInput
+{
+    uint vertexID : SV_VertexID;
+    uint instanceID : SV_InstanceID; // Includes firstInstance, so it indexes straight into _quads
+};
+
+struct VertexOutput
+{
+    float4 position : SV_POSITION;
+    float2 uv : TEXCOORD0;
+    nointerpolation uint textureIndex : TEXCOORD1;
+    nointerpolation uint elementIndex : TEXCOORD2;
+};
+
+VertexOutput LoadQuadVertex(VertexInput input)
+{
+    Quad quad = _quads[input.instanceID];
+
+    // Vertex 0 is the upper left corner, 1 upper right, 2 lower left and 3 lower right
+    bool isRight = (input.vertexID & 1) != 0;
+    bool isBottom = (input.vertexID & 2) != 0;
+
+    float2 position = float2(isRight ? quad.rect.z : quad.rect.x, isBottom ? quad.rect.w : quad.rect.y);
+    float2 uv = float2(isRight ? quad.texCoord.z : quad.texCoord.x, isBottom ? quad.texCoord.w : quad.texCoord.y);
+
+    VertexOutput output;
+    output.position = float4((position * 2.0f) - 1.0f, 0.0f, 1.0f);
+    output.uv = uv;
+    output.textureIndex = quad.textureIndex;
+    output.elementIndex = quad.elementIndex;
+
+    return output;
+}
@@ -26,15 +26,15 @@ struct Constants
 [[vk::binding(6, TERRAIN)]] SamplerState _depthSampler;
 [[vk::binding(7, TERRAIN)]] Texture2D<float> _depthPyramid;
 
-float2 ReadHeightRange(uint instanceIndex)
+float2 ReadHeightRange(uint globalCellID)
 {
 #if USE_PACKED_HEIGHT_RANGE
-	const uint packed = _heightRanges[instanceIndex];
+	const uint packed = _heightRanges[globalCellID];
 	const float min = f16tof32(packed >> 16);
 	const float max = f16tof32(packed);
 	return float2(min, max);
 #else
-    const float2 minmax = asfloat(_heightRanges.Load2(instanceIndex * 8));
+    const float2 minmax = asfloat(_heightRanges.Load2(globalCellID * 8));
     return minmax;
 #endif
 }
@@ -103,7 +103,7 @@ void main(CSInput input)
     const uint cellID = instance.packedChunkCellID & 0xffff;
     const uint chunkID = instance.packedChunkCellID >> 16;
 
-    const float2 heightRange = ReadHeightRange(instanceIndex);
+    const float2 heightRange = ReadHeightRange(instance.globalCellID);
     AABB aabb = GetCellAABB(chunkID, cellID, heightRange);
     
     bool isVisible = true;